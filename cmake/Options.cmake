@@ -46,6 +46,15 @@ cmake_dependent_option(
   OFF
 )
 
+# option for the headless null backend, it records the GPU work without any
+# driver so the HW renderer can be benchmarked on machines without GPU
+cmake_dependent_option(
+  SKITY_NULL_BACKEND "option for headless null gpu backend"
+  ON
+  [[SKITY_HW_RENDERER AND SKITY_TEST]]
+  OFF
+)
+
 option(SKITY_LOG "option for logging" OFF)
 option(SKITY_CT_FONT "option for open CoreText font backend on Darwin" OFF)
 
@@ -5,6 +5,7 @@
 #ifndef INCLUDE_SKITY_GEOMETRY_MATRIX_HPP
 #define INCLUDE_SKITY_GEOMETRY_MATRIX_HPP
 
+#include <cstdint>
 #include <skity/geometry/point.hpp>
 #include <skity/macros.hpp>
 
@@ -180,6 +181,29 @@ struct SKITY_API Matrix {
 
   bool HasPersp() const;
 
+  struct TypeMask {
+    enum Value : uint32_t {
+      kIdentity = 0,
+      kTranslate = 0x0001,
+      kScale = 0x0002,
+      kAffine = 0x0004,
+      kPerspective = 0x0008,
+    };
+  };
+
+  /**
+   * Returns a mask, where each set bit corresponds to a TypeMask constant if
+   * the matrix contains that kind of transform. Returns zero for identity.
+   * Any z or w component outside of the 2D perspective row is reported as
+   * kPerspective, the mapping functions only specialize 2D transforms.
+   *
+   * The mask is computed on every call, it only looks at the 2D elements and
+   * is cheap compared to mapping a batch of points.
+   *
+   * @return  TypeMask bits or zero
+   */
+  uint32_t GetType() const;
+
   friend SKITY_API Matrix operator*(const Matrix& a, const Matrix& b);
 
   friend SKITY_API Vec4 operator*(const Matrix& m, const Vec4& v);
@@ -0,0 +1,54 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef INCLUDE_SKITY_GEOMETRY_RSXFORM_HPP
+#define INCLUDE_SKITY_GEOMETRY_RSXFORM_HPP
+
+#include <cmath>
+#include <skity/geometry/matrix.hpp>
+#include <skity/macros.hpp>
+
+namespace skity {
+
+/**
+ * @struct RSXform
+ *  A compressed form of a rotation + uniform scale + translation matrix:
+ *
+ *    [ scos  -ssin  tx ]
+ *    [ ssin   scos  ty ]
+ *    [   0      0    1 ]
+ *
+ *  Used by Canvas::DrawAtlas() to place each sprite.
+ */
+struct SKITY_API RSXform {
+  static constexpr RSXform Make(float scos, float ssin, float tx, float ty) {
+    return RSXform{scos, ssin, tx, ty};
+  }
+
+  /**
+   * Scale and rotate around the anchor point (ax, ay) of the sprite, then
+   * translate the anchor point to (tx, ty).
+   */
+  static RSXform MakeFromRadians(float scale, float radians, float tx,
+                                 float ty, float ax, float ay) {
+    const float s = std::sin(radians) * scale;
+    const float c = std::cos(radians) * scale;
+    return Make(c, s, tx + -c * ax + s * ay, ty + -s * ax - c * ay);
+  }
+
+  bool RectStaysRect() const { return scos == 0 || ssin == 0; }
+
+  Matrix ToMatrix() const {
+    return Matrix{scos, -ssin, tx, ssin, scos, ty, 0.f, 0.f, 1.f};
+  }
+
+  float scos;
+  float ssin;
+  float tx;
+  float ty;
+};
+
+}  // namespace skity
+
+#endif  // INCLUDE_SKITY_GEOMETRY_RSXFORM_HPP
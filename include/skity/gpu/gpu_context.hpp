@@ -13,6 +13,7 @@
 #include <skity/gpu/gpu_surface.hpp>
 #include <skity/gpu/texture.hpp>
 #include <skity/macros.hpp>
+#include <skity/render/frame_stats.hpp>
 
 namespace skity {
 
@@ -39,6 +40,26 @@ enum class GPUError {
 typedef void (*GPUErrorCallback)(GPUError error, char const* message,
                                  void* userdata);
 
+/**
+ * @struct GPUShaderCacheStats
+ *
+ * Counters of the persistent shader cache since the GPUContext was created.
+ */
+struct GPUShaderCacheStats {
+  /**
+   * shaders restored from the cache without running the shader translator
+   */
+  uint32_t hit_count = 0;
+  /**
+   * shaders not found in the cache which needed to be translated
+   */
+  uint32_t miss_count = 0;
+  /**
+   * shaders currently held by the cache
+   */
+  uint32_t entry_count = 0;
+};
+
 /**
  * @class GPUContext
  *
@@ -156,6 +177,42 @@ class SKITY_API GPUContext {
   SKITY_EXPERIMENTAL
   virtual void SetResourceCacheLimit(size_t size_in_bytes) = 0;
 
+  /**
+   * Enable the persistent shader cache. Shaders translated by previous runs
+   * are loaded from the file at `path`, so pipelines can be created without
+   * parsing and translating their WGSL source again. New shaders are written
+   * back by SaveShaderCache() and when this GPUContext is destroyed.
+   *
+   * Must be called before the first draw to be effective.
+   *
+   * @param path  file used to store the cache, it is created if needed
+   * @return      true if existing entries were loaded from the file
+   */
+  SKITY_EXPERIMENTAL
+  virtual bool SetShaderCachePath(const char* path) = 0;
+
+  /**
+   * Write the shaders translated since the cache was loaded to the file set by
+   * SetShaderCachePath().
+   *
+   * @return false if the shader cache is not enabled or the file can not be
+   *         written
+   */
+  SKITY_EXPERIMENTAL
+  virtual bool SaveShaderCache() = 0;
+
+  SKITY_EXPERIMENTAL
+  virtual GPUShaderCacheStats GetShaderCacheStats() const = 0;
+
+  /**
+   * Get the runtime counters of the last frame flushed by a GPU canvas
+   * created from this context. Must be called on the render thread.
+   *
+   * @see Canvas::GetFrameStats
+   */
+  SKITY_EXPERIMENTAL
+  virtual FrameStats GetFrameStats() const = 0;
+
   /**
    * Register a error callback for outside user.
    * Through this callback function, user can obtain the error information
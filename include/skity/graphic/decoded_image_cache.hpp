@@ -0,0 +1,61 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef INCLUDE_SKITY_GRAPHIC_DECODED_IMAGE_CACHE_HPP
+#define INCLUDE_SKITY_GRAPHIC_DECODED_IMAGE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <skity/macros.hpp>
+
+namespace skity {
+
+/**
+ * Process wide cache of the pixels generated for images created by
+ * Image::MakeLazyImage(). Entries are purged in least recently used order
+ * once the resident bytes exceed the budget. Pixels still referenced by a
+ * draw in flight stay alive until that draw is done, but no longer count
+ * against the budget.
+ *
+ * All functions are thread safe.
+ */
+class SKITY_API DecodedImageCache {
+ public:
+  struct Stats {
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    /**
+     * Total time spent in ImageGenerator::Generate() in microseconds.
+     */
+    uint64_t decode_time_us = 0;
+    size_t resident_count = 0;
+    size_t resident_bytes = 0;
+    size_t budget = 0;
+  };
+
+  static constexpr size_t kDefaultBudget = 64 * 1024 * 1024;
+
+  /**
+   * Set the maximum bytes of cached pixels, purging entries if needed.
+   */
+  static void SetBudget(size_t bytes);
+
+  static size_t GetBudget();
+
+  /**
+   * Drop all cached pixels.
+   */
+  static void Purge();
+
+  static Stats GetStats();
+
+  /**
+   * Reset the counters of GetStats(), the resident entries are kept.
+   */
+  static void ResetStats();
+};
+
+}  // namespace skity
+
+#endif  // INCLUDE_SKITY_GRAPHIC_DECODED_IMAGE_CACHE_HPP
@@ -14,6 +14,7 @@
 namespace skity {
 
 class DeferredTextureImage;
+class ImageGenerator;
 class PromiseTextureImage;
 
 class GPUContext;
@@ -30,6 +31,7 @@ enum class SKITY_API ImageType {
   kTexture,
   kDeferredTexture,
   kPromiseTexture,
+  kLazyGenerated,
 };
 
 class SKITY_API Image {
@@ -55,6 +57,19 @@ class SKITY_API Image {
       GetPromiseTexture2 get_promise_texture, ReleaseCallback release_callback,
       PromiseTextureContext promise_texture_context);
 
+  /**
+   * Create an image whose pixels are only generated when it is drawn, at the
+   * resolution the draw needs, and kept in the DecodedImageCache.
+   *
+   * Drawing the image through a shader needs the full size pixels for as long
+   * as the image lives, prefer drawing it with Canvas::DrawImage() or
+   * Canvas::DrawImageRect().
+   *
+   * @return nullptr if generator is null or has an empty size.
+   */
+  static std::shared_ptr<Image> MakeLazyImage(
+      std::shared_ptr<ImageGenerator> generator);
+
   virtual ~Image() = default;
 
   virtual bool IsTextureBackend() const = 0;
@@ -82,6 +97,18 @@ class SKITY_API Image {
     return false;
   }
 
+  /**
+   * Get the pixels of a lazily generated image, at a size close to but not
+   * smaller than width x height. See ImageGenerator::Generate().
+   *
+   * @return nullptr if this image is not lazily generated or the pixels can
+   *         not be generated.
+   */
+  virtual std::shared_ptr<Pixmap> GetDecodedPixmap(uint32_t width,
+                                                   uint32_t height) const {
+    return nullptr;
+  }
+
   bool IsLazy() const { return GetImageType() == ImageType::kPromiseTexture; }
 
   virtual ImageType GetImageType() const { return ImageType::kUnknown; }
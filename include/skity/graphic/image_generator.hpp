@@ -0,0 +1,53 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef INCLUDE_SKITY_GRAPHIC_IMAGE_GENERATOR_HPP
+#define INCLUDE_SKITY_GRAPHIC_IMAGE_GENERATOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <skity/graphic/alpha_type.hpp>
+#include <skity/io/pixmap.hpp>
+#include <skity/macros.hpp>
+
+namespace skity {
+
+/**
+ * Produces the pixels of an image created by Image::MakeLazyImage() on
+ * demand, e.g. by decoding encoded data. The pixels are kept in the
+ * DecodedImageCache and generated again once they were purged.
+ */
+class SKITY_API ImageGenerator {
+ public:
+  virtual ~ImageGenerator() = default;
+
+  /**
+   * Full size of the image.
+   */
+  virtual uint32_t Width() const = 0;
+
+  virtual uint32_t Height() const = 0;
+
+  virtual AlphaType GetAlphaType() const = 0;
+
+  /**
+   * Generate the pixels of the image at a size close to the target size.
+   *
+   * Generators able to produce a reduced resolution should return the
+   * smallest size they support that still covers the target size, keeping
+   * the aspect ratio. Others return the full size. The result is never
+   * larger than Width() x Height().
+   *
+   * Calls to the same generator are never concurrent, but may happen on
+   * different threads.
+   *
+   * @return nullptr if the pixels can not be generated.
+   */
+  virtual std::shared_ptr<Pixmap> Generate(uint32_t target_width,
+                                           uint32_t target_height) = 0;
+};
+
+}  // namespace skity
+
+#endif  // INCLUDE_SKITY_GRAPHIC_IMAGE_GENERATOR_HPP
@@ -479,6 +479,25 @@ class SKITY_API Path {
   bool IsRect(Rect* rect, bool* is_closed = nullptr,
               Direction* direction = nullptr) const;
 
+  /**
+   * Returns true if Path is the single contour written by AddOval().
+   * If false: oval is unchanged.
+   *
+   * @param oval    storage for bounds of the oval; may be nullptr
+   * @return true   Path is equivalent to oval
+   */
+  bool IsOval(Rect* oval) const;
+
+  /**
+   * Returns true if Path is the single contour written by AddRRect() for a
+   * RRect which is neither a rect nor an oval, see IsRect() and IsOval().
+   * If false: rrect is unchanged.
+   *
+   * @param rrect   storage for the RRect; may be nullptr
+   * @return true   Path is equivalent to rrect
+   */
+  bool IsRRect(RRect* rrect) const;
+
   /**
    * Returns true if point(x, y) is contained by Path. This taking PathFillType
    * into account.
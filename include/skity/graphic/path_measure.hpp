@@ -5,14 +5,119 @@
 #ifndef INCLUDE_SKITY_GRAPHIC_PATH_MEASURE_HPP
 #define INCLUDE_SKITY_GRAPHIC_PATH_MEASURE_HPP
 
+#include <cstddef>
 #include <memory>
 #include <skity/graphic/path.hpp>
+#include <vector>
 
 namespace skity {
 
 class ContourMeasure;
 class ContourMeasureIter;
 
+/**
+ * @class MeasuredPath
+ *  Lengths of all the contours of a path, measured once and immutable
+ *  afterwards, so it can be shared between threads. Distances are along the
+ *  whole path, with the contours placed one after another. Every lookup is a
+ *  binary search over the measured segments, independent of how the curves
+ *  were subdivided.
+ */
+class SKITY_API MeasuredPath final {
+ public:
+  /**
+   * @brief Measure the path. With cache set, return the measure made for an
+   *        identical path with the same parameters if it is still cached, and
+   *        cache a new measure otherwise.
+   *
+   * @param path        the Path need to be measured
+   * @param forceClosed insert close contour if needed
+   * @param resScale    controls the precision of the measure. values > 1
+   *                    increase the precision.
+   * @param cache       share the measure through the global cache, for paths
+   *                    which are measured again and again. The lookup hashes
+   *                    and compares the whole path under a global lock.
+   */
+  static std::shared_ptr<const MeasuredPath> Make(Path const& path,
+                                                  bool forceClosed,
+                                                  float resScale = 1.f,
+                                                  bool cache = false);
+
+  /**
+   * Drop every cached measure. Measures still referenced stay valid.
+   */
+  static void PurgeCache();
+
+  ~MeasuredPath();
+
+  /**
+   * @return total length of all contours
+   */
+  float GetLength() const { return length_; }
+
+  /**
+   * @return number of contours with a non zero length
+   */
+  size_t CountContours() const { return contours_.size(); }
+
+  float GetContourLength(size_t index) const;
+
+  bool IsContourClosed(size_t index) const;
+
+  /**
+   * @internal
+   */
+  const std::shared_ptr<ContourMeasure>& GetContour(size_t index) const {
+    return contours_[index];
+  }
+
+  /**
+   * @brief Get the position and tangent at the given distance of the path.
+   *
+   * @param [in] distance   pins distance to 0 <= distance <= GetLength()
+   * @param [out] position  position in path coordinate.
+   * @param [out] tangent   tangent vector in path coordinate, can be null.
+   * @return                false if the path has no length.
+   */
+  bool GetPosTan(float distance, Point* position, Vector* tangent) const;
+
+  /**
+   * @brief Batched GetPosTan() for count distances. Increasing distances are
+   *        found in a single pass over the segments, others fall back to a
+   *        search.
+   *
+   * @param [out] tangents  can be null.
+   * @return                false if the path has no length.
+   */
+  bool GetPosTans(const float distances[], size_t count, Point positions[],
+                  Vector tangents[]) const;
+
+  /**
+   * @brief Given a start and stop distance along the whole path, append the
+   *        sub-path between them to dst. Each contour it crosses starts with
+   *        a MoveTo, the first one only if startWithMoveTo is set.
+   *
+   * @return false  If segment is zero-length, or startD > stopD
+   */
+  bool GetSegment(float startD, float stopD, Path* dst,
+                  bool startWithMoveTo) const;
+
+ private:
+  explicit MeasuredPath(
+      std::vector<std::shared_ptr<ContourMeasure>> contours);
+
+  /**
+   * Index of the contour containing distance, which is pinned to the path.
+   */
+  size_t FindContour(float distance) const;
+
+ private:
+  std::vector<std::shared_ptr<ContourMeasure>> contours_;
+  // distance at the end of each contour
+  std::vector<float> contour_ends_;
+  float length_ = 0.f;
+};
+
 /**
  * @class PathMeasure
  *	Util class to measure path length
@@ -87,7 +192,8 @@ class SKITY_API PathMeasure final {
   bool NextContour();
 
  private:
-  std::unique_ptr<ContourMeasureIter> iter_;
+  std::shared_ptr<const MeasuredPath> measured_;
+  size_t contour_index_ = 0;
   std::shared_ptr<ContourMeasure> contour_;
 };
 
@@ -0,0 +1,102 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef INCLUDE_SKITY_GRAPHIC_VERTICES_HPP
+#define INCLUDE_SKITY_GRAPHIC_VERTICES_HPP
+
+#include <cstdint>
+#include <memory>
+#include <skity/geometry/rect.hpp>
+#include <skity/geometry/vector.hpp>
+#include <skity/graphic/color.hpp>
+#include <skity/macros.hpp>
+#include <vector>
+
+namespace skity {
+
+/**
+ * @class Vertices
+ * An immutable triangle mesh drawn by Canvas::DrawVertices().
+ *
+ * Every vertex has a position and optionally a texture coordinate and an
+ * unpremultiplied color. Strips and fans are turned into a plain triangle
+ * list when the mesh is created, so the backends only ever see triangles.
+ */
+class SKITY_API Vertices {
+ public:
+  enum class VertexMode {
+    kTriangles,
+    kTriangleStrip,
+    kTriangleFan,
+  };
+
+  /**
+   * Create a mesh by copying the given arrays.
+   *
+   * @param mode          how the vertices, or the indices if any, make
+   *                      triangles
+   * @param vertex_count  length of positions, texs and colors
+   * @param positions     position of each vertex in local space
+   * @param texs          optional texture coordinate of each vertex, the
+   *                      local coordinate the paint shader is sampled at. The
+   *                      position is used if nullptr
+   * @param colors        optional unpremultiplied color of each vertex
+   * @param index_count   length of indices
+   * @param indices       optional vertex indices, every index must be less
+   *                      than vertex_count
+   * @return              nullptr if the arrays do not make a valid mesh
+   */
+  static std::shared_ptr<Vertices> MakeCopy(
+      VertexMode mode, uint32_t vertex_count, const Vec2 positions[],
+      const Vec2 texs[], const Color colors[], uint32_t index_count = 0,
+      const uint32_t indices[] = nullptr);
+
+  Vertices(std::vector<Vec2> positions, std::vector<Vec2> texs,
+           std::vector<Color> colors, std::vector<uint32_t> indices);
+
+  ~Vertices() = default;
+
+  uint32_t VertexCount() const {
+    return static_cast<uint32_t>(positions_.size());
+  }
+
+  const Vec2* Positions() const { return positions_.data(); }
+
+  /**
+   * @return nullptr if the vertices have no texture coordinates
+   */
+  const Vec2* Texs() const { return texs_.empty() ? nullptr : texs_.data(); }
+
+  /**
+   * @return nullptr if the vertices have no colors
+   */
+  const Color* Colors() const {
+    return colors_.empty() ? nullptr : colors_.data();
+  }
+
+  /**
+   * Indices of the triangle list, three per triangle.
+   */
+  const uint32_t* Indices() const { return indices_.data(); }
+
+  uint32_t IndexCount() const { return static_cast<uint32_t>(indices_.size()); }
+
+  uint32_t TriangleCount() const { return IndexCount() / 3; }
+
+  /**
+   * Bounds of all the positions.
+   */
+  const Rect& Bounds() const { return bounds_; }
+
+ private:
+  std::vector<Vec2> positions_;
+  std::vector<Vec2> texs_;
+  std::vector<Color> colors_;
+  std::vector<uint32_t> indices_;
+  Rect bounds_;
+};
+
+}  // namespace skity
+
+#endif  // INCLUDE_SKITY_GRAPHIC_VERTICES_HPP
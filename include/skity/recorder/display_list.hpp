@@ -24,6 +24,8 @@ class RecordedOpOffset {
 };
 
 struct RecordedOp;
+class DisplayListPaintTable;
+class DisplayListRTree;
 
 // Manages a buffer allocated with malloc.
 class DisplayListStorage {
@@ -50,23 +52,51 @@ class SKITY_API DisplayList {
  public:
   DisplayList();
   DisplayList(DisplayListStorage&& storage, size_t byte_count,
-              uint32_t op_count, const Rect& bounds);
+              uint32_t op_count, const Rect& bounds,
+              std::unique_ptr<DisplayListPaintTable> paint_table,
+              std::unique_ptr<DisplayListRTree> rtree);
   ~DisplayList();
 
   bool Empty() const { return byte_count_ == 0; }
+
+  /**
+   * Replay all recorded ops into canvas.
+   *
+   * If this display list carries an R-tree, draw ops which do not intersect
+   * the local clip bounds of canvas are skipped. Bounds are captured at
+   * recording time, so changing a paint through GetOpPaintByOffset() in a way
+   * that grows the drawn area is not reflected in culling.
+   */
   void Draw(Canvas* canvas);
   void DisposeOps(uint8_t* ptr, uint8_t* end);
   uint32_t OpCount() const { return op_count_; }
 
   const Rect& GetBounds() const { return bounds_; }
 
+  bool HasRTree() const { return rtree_ != nullptr; }
+
+  /**
+   * Get a mutable paint of the op recorded at offset.
+   *
+   * Ops share interned paints, the returned paint is detached from the shared
+   * entry first so changing it only affects this op.
+   */
   Paint* GetOpPaintByOffset(RecordedOpOffset offset);
 
+  /**
+   * @return number of distinct paints referenced by the recorded ops
+   */
+  size_t PaintCount() const;
+
  private:
+  void DrawOp(Canvas* canvas, RecordedOp* op);
+  const Paint& GetPaint(uint32_t index) const;
   const DisplayListStorage storage_;
   size_t byte_count_ = 0;
   uint32_t op_count_ = 0u;
   Rect bounds_;
+  std::unique_ptr<DisplayListPaintTable> paint_table_;
+  std::unique_ptr<DisplayListRTree> rtree_;
 };
 
 }  // namespace skity
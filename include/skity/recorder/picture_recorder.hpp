@@ -22,6 +22,15 @@ class SKITY_API PictureRecorder {
   bool Empty();
   void BeginRecording();
   void BeginRecording(const Rect& bounds);
+  /**
+   * Begin recording with cull bounds.
+   *
+   * @param bounds       cull rect of the recording.
+   * @param build_rtree  if true, record device bounds of every draw op and
+   *                     build an R-tree so DisplayList::Draw can skip ops
+   *                     outside the clip of the target canvas.
+   */
+  void BeginRecording(const Rect& bounds, bool build_rtree);
   std::unique_ptr<DisplayList> FinishRecording();
 
  private:
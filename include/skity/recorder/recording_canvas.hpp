@@ -31,6 +31,7 @@ class SKITY_API RecordingCanvas : public Canvas {
 
  protected:
   void OnClipRect(Rect const& rect, ClipOp op) override;
+  void OnClipRRect(RRect const& rrect, ClipOp op) override;
   void OnClipPath(Path const& path, ClipOp op) override;
   void OnDrawRect(Rect const& rect, Paint const& paint) override;
   void OnDrawRRect(RRect const& rrect, Paint const& paint) override;
@@ -41,6 +42,12 @@ class SKITY_API RecordingCanvas : public Canvas {
   void OnDrawImageRect(std::shared_ptr<Image> image, const Rect& src,
                        const Rect& dst, const SamplingOptions& sampling,
                        Paint const* paint) override;
+  void OnDrawAtlas(const std::shared_ptr<Image>& atlas, const RSXform xform[],
+                   const Rect tex[], const Color colors[], int count,
+                   BlendMode mode, const SamplingOptions& sampling,
+                   const Rect* cull_rect, const Paint* paint) override;
+  void OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                      BlendMode mode, const Paint& paint) override;
   void OnDrawGlyphs(uint32_t count, const GlyphID glyphs[],
                     const float position_x[], const float position_y[],
                     const Font& font, const Paint& paint) override;
@@ -60,9 +67,13 @@ class SKITY_API RecordingCanvas : public Canvas {
   uint32_t OnGetWidth() const override;
   uint32_t OnGetHeight() const override;
   void OnUpdateViewport(uint32_t width, uint32_t height) override;
+  bool DecodeLazyImages() const override { return false; }
 
  private:
   void AccumulateOpBounds(const Rect& raw_bounds, const Paint* paint);
+  // `device_bounds` is already in device space, it is not mapped again.
+  void AccumulateDeviceBounds(const Rect& device_bounds);
+  void RecordSaveLayerBounds(const Rect& bounds, const Paint& paint);
 
   DisplayListBuilder* dp_builder_;
 };
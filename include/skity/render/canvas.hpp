@@ -7,11 +7,14 @@
 
 #include <memory>
 #include <skity/geometry/rect.hpp>
+#include <skity/geometry/rsxform.hpp>
 #include <skity/graphic/image.hpp>
 #include <skity/graphic/paint.hpp>
 #include <skity/graphic/path.hpp>
 #include <skity/graphic/sampling_options.hpp>
+#include <skity/graphic/vertices.hpp>
 #include <skity/macros.hpp>
+#include <skity/render/frame_stats.hpp>
 #include <skity/text/glyph.hpp>
 #include <skity/text/typeface.hpp>
 
@@ -137,6 +140,14 @@ class SKITY_API Canvas {
    */
   void ClipRect(Rect const& rect, ClipOp op = ClipOp::kIntersect);
 
+  /**
+   * Replaces clip with the intersection or difference of clip and rrect
+   *
+   * @param rrect RRect to combine with clip
+   * @param op    ClipOp to apply to clip
+   */
+  void ClipRRect(RRect const& rrect, ClipOp op = ClipOp::kIntersect);
+
   void ClipPath(Path const& path, ClipOp op = ClipOp::kIntersect);
 
   /**
@@ -282,6 +293,18 @@ class SKITY_API Canvas {
    */
   void Flush();
 
+  /**
+   * @brief Get the runtime counters of the last frame.
+   *
+   * Counters are accumulated per thread and collected by Flush(), so the
+   * result covers all the rendering work done on the calling thread between
+   * the last two Flush() calls, including the work of the flush itself.
+   *
+   * @note This is an experimental API which may be changed in the future.
+   */
+  SKITY_EXPERIMENTAL
+  const FrameStats& GetFrameStats() const { return frame_stats_; }
+
   /**
    * @deprecated  use drawSimpleText2 if need.
    */
@@ -321,6 +344,50 @@ class SKITY_API Canvas {
   void DrawGlyphs(int count, const GlyphID glyphs[], const float positions_x[],
                   const float positions_y[], const Font& font,
                   const Paint& paint);
+
+  /**
+   * @brief           Draw a batch of sprites from the same atlas image. Each
+   *                  sprite is a rect of the atlas placed on the canvas by its
+   *                  own RSXform, much cheaper than one DrawImageRect() with
+   *                  its own transform per sprite.
+   *
+   * @param atlas     image containing all the sprites
+   * @param xform     RSXform of each sprite, mapping its top left corner to
+   *                  the origin of the sprite rect
+   * @param tex       rect of each sprite in the atlas
+   * @param colors    optional unpremultiplied color of each sprite
+   * @param count     number of sprites, the length of every array
+   * @param mode      BlendMode combining a sprite color, as source, with the
+   *                  sprite, as destination. Ignored without colors
+   * @param sampling  sampling options used to read the atlas
+   * @param cull_rect optional bounds of all the sprites in local space, used
+   *                  to reject the whole draw quickly
+   * @param paint     apply alpha, ColorFilter and BlendMode of the whole
+   *                  draw, may be nullptr
+   */
+  void DrawAtlas(const std::shared_ptr<Image>& atlas, const RSXform xform[],
+                 const Rect tex[], const Color colors[], int count,
+                 BlendMode mode, const SamplingOptions& sampling,
+                 const Rect* cull_rect = nullptr,
+                 const Paint* paint = nullptr);
+
+  /**
+   * @brief           Draw a triangle mesh as it is, without going through path
+   *                  tessellation or rasterization.
+   *
+   * @param vertices  the mesh to draw
+   * @param mode      BlendMode combining the paint shader, as source, with the
+   *                  vertex colors, as destination. Ignored unless the mesh
+   *                  has colors and the paint has a shader
+   * @param paint     shader, alpha, ColorFilter and BlendMode of the draw.
+   *                  The shader is sampled at the texture coordinates of the
+   *                  mesh. The mesh is always filled without anti-aliasing,
+   *                  the style, PathEffect, MaskFilter and ImageFilter of the
+   *                  paint are ignored
+   */
+  void DrawVertices(const std::shared_ptr<Vertices>& vertices, BlendMode mode,
+                    const Paint& paint);
+
   SKITY_EXPERIMENTAL
   inline void DrawDebugLine(bool debug) { draw_debug_line_ = debug; }
 
@@ -342,6 +409,8 @@ class SKITY_API Canvas {
  protected:
   // default implement dispatch this to OnClipPath
   virtual void OnClipRect(Rect const& rect, ClipOp op);
+  // default implement dispatch this to OnClipPath
+  virtual void OnClipRRect(RRect const& rrect, ClipOp op);
   virtual void OnClipPath(Path const& path, ClipOp op) = 0;
 
   // default implement dispatch this to OnDrawPath
@@ -371,6 +440,18 @@ class SKITY_API Canvas {
                                const Rect& dst, const SamplingOptions& sampling,
                                Paint const* paint) = 0;
 
+  // default implement dispatch each sprite to OnDrawImageRect
+  virtual void OnDrawAtlas(const std::shared_ptr<Image>& atlas,
+                           const RSXform xform[], const Rect tex[],
+                           const Color colors[], int count, BlendMode mode,
+                           const SamplingOptions& sampling,
+                           const Rect* cull_rect, const Paint* paint);
+
+  // default implement dispatch each triangle to OnDrawPath, the vertex colors
+  // are averaged instead of interpolated and dropped if there is a shader
+  virtual void OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                              BlendMode mode, const Paint& paint);
+
   virtual void OnDrawGlyphs(uint32_t count, const GlyphID glyphs[],
                             const float position_x[], const float position_y[],
                             const Font& font, const Paint& paint) = 0;
@@ -394,6 +475,14 @@ class SKITY_API Canvas {
 
   virtual bool NeedGlyphPath(Paint const& paint);
 
+  // whether lazily generated images are decoded before they reach
+  // OnDrawImageRect and OnDrawAtlas. Canvases that only record the draws
+  // keep them lazy, so they are decoded at the size playback needs
+  virtual bool DecodeLazyImages() const { return true; }
+
+  // called by Flush() with the counters just collected
+  virtual void OnFrameStatsCollected(const FrameStats& stats) {}
+
   virtual void OnUpdateViewport(uint32_t width, uint32_t height) = 0;
   inline bool IsDrawDebugLine() const { return draw_debug_line_; }
 
@@ -415,6 +504,7 @@ class SKITY_API Canvas {
   std::vector<Rect> global_clip_bounds_stack_;
   bool tracing_canvas_state_ = true;
   std::unique_ptr<CanvasState> canvas_state_;
+  FrameStats frame_stats_;
 };
 
 }  // namespace skity
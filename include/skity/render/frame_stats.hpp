@@ -0,0 +1,89 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef INCLUDE_SKITY_RENDER_FRAME_STATS_HPP
+#define INCLUDE_SKITY_RENDER_FRAME_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <skity/macros.hpp>
+
+namespace skity {
+
+/**
+ * Runtime counters collected by the renderer.
+ */
+enum class RenderCounter : uint32_t {
+  /**
+   * glyphs found in the glyph atlas
+   */
+  kGlyphCacheHit,
+  /**
+   * glyphs rasterized and added to the glyph atlas
+   */
+  kGlyphCacheMiss,
+  /**
+   * bytes of glyph atlas pixels uploaded to textures
+   */
+  kAtlasUploadBytes,
+  /**
+   * bytes of vertices and uniforms uploaded through the stage buffer
+   */
+  kStageVertexBytes,
+  /**
+   * bytes of indices uploaded through the stage buffer
+   */
+  kStageIndexBytes,
+  /**
+   * GPU pipelines created, including blending and depth stencil variants
+   */
+  kPipelineCreated,
+  /**
+   * render targets allocated by the render target cache instead of reused
+   */
+  kRenderTargetAllocated,
+  /**
+   * coverage spans produced by the software rasterizer
+   */
+  kRasterSpan,
+  /**
+   * draws dropped by a HW layer because later opaque draws hide them
+   */
+  kDrawCulled,
+
+  kCount,
+};
+
+constexpr size_t kRenderCounterCount =
+    static_cast<size_t>(RenderCounter::kCount);
+
+/**
+ * @struct FrameStats
+ *
+ * Value of every RenderCounter accumulated between two Canvas::Flush() calls.
+ */
+struct SKITY_API FrameStats {
+  uint64_t counters[kRenderCounterCount] = {};
+
+  uint64_t Get(RenderCounter counter) const {
+    return counters[static_cast<size_t>(counter)];
+  }
+
+  /**
+   * Ratio of glyph atlas hits to all glyph lookups, 0 if there was none.
+   */
+  float GlyphCacheHitRate() const;
+
+  FrameStats& operator+=(const FrameStats& other);
+
+  /**
+   * Stable name of the counter, also used when it is reported to the trace
+   * counter hook.
+   */
+  static const char* GetCounterName(RenderCounter counter);
+};
+
+}  // namespace skity
+
+#endif  // INCLUDE_SKITY_RENDER_FRAME_STATS_HPP
@@ -23,6 +23,7 @@
 #include <skity/geometry/quaternion.hpp>
 #include <skity/geometry/rect.hpp>
 #include <skity/geometry/rrect.hpp>
+#include <skity/geometry/rsxform.hpp>
 #include <skity/geometry/stroke.hpp>
 #include <skity/geometry/vector.hpp>
 // graphic
@@ -37,6 +38,7 @@
 #include <skity/graphic/path_op.hpp>
 #include <skity/graphic/sampling_options.hpp>
 #include <skity/graphic/tile_mode.hpp>
+#include <skity/graphic/vertices.hpp>
 // render
 #include <skity/render/canvas.hpp>
 // recorder
@@ -0,0 +1,132 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MODULE_CODEC_INCLUDE_SKITY_CODEC_ANIMATED_IMAGE_PLAYER_HPP
+#define MODULE_CODEC_INCLUDE_SKITY_CODEC_ANIMATED_IMAGE_PLAYER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <skity/codec/codec.hpp>
+#include <skity/macros.hpp>
+
+namespace skity {
+
+/**
+ * Plays a multi-frame image on top of a MultiFrameDecoder.
+ *
+ * Decoded frames are kept in one cache shared by all players and limited to
+ * a process wide byte budget, see SetCacheBudget(). Every `keyframe_interval`
+ * frames a composed frame is kept as a keyframe, which is evicted last, so
+ * decoding an arbitrary frame only replays the frames since the closest
+ * cached one instead of the whole image. After each GetFrame() the next
+ * `decode_ahead` frames are decoded on a background thread shared by all
+ * players, so a caller stepping through the animation normally hits the
+ * cache.
+ *
+ * All methods are thread safe. The returned pixmaps are shared with the
+ * cache and must not be modified.
+ *
+ * @note The is a experimental API. The API is unstable and may change in the
+ * future.
+ */
+class SKITY_EXPERIMENTAL_API AnimatedImagePlayer {
+ public:
+  static constexpr size_t kDefaultCacheBudget = 32 * 1024 * 1024;
+
+  struct Options {
+    /**
+     * Distance in frames between two keyframes. 0 disables keyframes.
+     */
+    int32_t keyframe_interval = 8;
+
+    /**
+     * Number of frames decoded ahead on the background thread after each
+     * GetFrame(). 0 disables the background thread.
+     */
+    int32_t decode_ahead = 2;
+  };
+
+  struct Stats {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t decoded_frame_count = 0;
+    size_t cached_frame_count = 0;
+    size_t cached_keyframe_count = 0;
+    size_t cached_bytes = 0;
+  };
+
+  /**
+   * Create a player for the given decoder. The player takes over the decoder,
+   * it must not be used by anyone else afterwards.
+   *
+   * @return nullptr if decoder is null or has no frame.
+   */
+  static std::unique_ptr<AnimatedImagePlayer> Make(
+      std::shared_ptr<MultiFrameDecoder> decoder);
+
+  static std::unique_ptr<AnimatedImagePlayer> Make(
+      std::shared_ptr<MultiFrameDecoder> decoder, const Options& options);
+
+  /**
+   * Set the maximum bytes of decoded frames kept alive by all players
+   * together. Frames beyond the budget are evicted right away. A single frame
+   * larger than the budget is still returned, but not cached.
+   */
+  static void SetCacheBudget(size_t bytes);
+
+  static size_t GetCacheBudget();
+
+  ~AnimatedImagePlayer();
+
+  AnimatedImagePlayer(const AnimatedImagePlayer&) = delete;
+  AnimatedImagePlayer& operator=(const AnimatedImagePlayer&) = delete;
+
+  int32_t GetWidth() const;
+
+  int32_t GetHeight() const;
+
+  int32_t GetFrameCount() const;
+
+  /**
+   * Sum of the duration of all frames in milliseconds.
+   */
+  int64_t GetTotalDuration() const;
+
+  /**
+   * Get the frame shown at the given time of a looping playback.
+   *
+   * @param time_ms  Milliseconds since the playback started.
+   * @return         The 0 based frame ID. 0 if no frame has a duration.
+   */
+  int32_t GetFrameIDAtTime(int64_t time_ms) const;
+
+  /**
+   * Get the fully composed pixels of the given frame, decoding it on the
+   * calling thread if it is not cached yet.
+   *
+   * @param frame_id The 0 based frame ID.
+   * @return         nullptr if frame_id is invalid or decode failed.
+   */
+  std::shared_ptr<Pixmap> GetFrame(int32_t frame_id);
+
+  /**
+   * Drop all cached frames of this player, including keyframes.
+   */
+  void Purge();
+
+  Stats GetStats() const;
+
+ private:
+  class Impl;
+
+  explicit AnimatedImagePlayer(std::shared_ptr<Impl> impl);
+
+  // shared with the decode ahead thread while it works for this player
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace skity
+
+#endif  // MODULE_CODEC_INCLUDE_SKITY_CODEC_ANIMATED_IMAGE_PLAYER_HPP
@@ -15,6 +15,7 @@
 namespace skity {
 
 class Data;
+class Image;
 class Pixmap;
 
 /**
@@ -324,6 +325,59 @@ class SKITY_EXPERIMENTAL_API MultiFrameDecoder {
   void SetAlphaAndRequiredFrame(CodecFrame* frame);
 };
 
+/**
+ * A decoder producing the rows of a single frame image from top to bottom,
+ * into buffers owned by the caller. Large images can be decoded in bands
+ * without keeping the whole image in memory. Returned by
+ * Codec::DecodeScanlines().
+ *
+ * Rows are written with RGBA color type and unpremul alpha type, the same
+ * format Codec::Decode() produces.
+ *
+ * @note The is a experimental API. The API is unstable and may change in the
+ * future.
+ */
+class SKITY_EXPERIMENTAL_API ScanlineDecoder {
+ public:
+  virtual ~ScanlineDecoder() = default;
+
+  virtual int32_t GetWidth() const = 0;
+
+  virtual int32_t GetHeight() const = 0;
+
+  /**
+   * Get the index of the next row DecodeRows() writes. Equals GetHeight()
+   * once all rows are decoded.
+   */
+  int32_t GetNextRow() const { return next_row_; }
+
+  /**
+   * Decode the next rows of the image.
+   *
+   * @param dst       Destination of the first row. Must hold `row_count` rows.
+   * @param row_bytes Distance in bytes between two rows in `dst`. Must be at
+   *                  least GetWidth() * 4.
+   * @param row_count Maximum number of rows to decode.
+   *
+   * @return The number of rows written to `dst`. It is smaller than
+   *         `row_count` when the end of the image is reached. 0 if decode
+   *         failed, after which no more rows can be decoded.
+   */
+  int32_t DecodeRows(void* dst, size_t row_bytes, int32_t row_count);
+
+ protected:
+  /**
+   * Decode exactly `row_count` rows starting at GetNextRow(). Arguments are
+   * already validated and clamped to the image height.
+   */
+  virtual bool OnDecodeRows(uint8_t* dst, size_t row_bytes,
+                            int32_t row_count) = 0;
+
+ private:
+  int32_t next_row_ = 0;
+  bool failed_ = false;
+};
+
 /**
  * Codec interface for encoding and decoding image data.
  *
@@ -373,6 +427,25 @@ class SKITY_EXPERIMENTAL_API Codec {
    */
   virtual std::shared_ptr<Pixmap> Decode() = 0;
 
+  /**
+   * Decode the data to a pixmap close to the given size, e.g. to build a
+   * thumbnail. Codecs able to decode at a reduced resolution return the
+   * smallest size they support that still covers `target_width` x
+   * `target_height`, keeping the aspect ratio of the image. The result is
+   * never larger than the full image.
+   *
+   * The default implementation decodes the full image, callers must be
+   * prepared to scale the result themselves.
+   *
+   * @param target_width  The wanted width in pixels. The full image is
+   *                      decoded if either size is 0 or less.
+   * @param target_height The wanted height in pixels.
+   *
+   * @return The decoded pixmap. nullptr if decode failed.
+   */
+  virtual std::shared_ptr<Pixmap> DecodeToSize(int32_t target_width,
+                                               int32_t target_height);
+
   /**
    * Decode the data to pixmap. If decode a multi-frame image, this method will
    * return the pixmap of the specified frame.
@@ -383,6 +456,16 @@ class SKITY_EXPERIMENTAL_API Codec {
    */
   virtual std::shared_ptr<MultiFrameDecoder> DecodeMultiFrame() = 0;
 
+  /**
+   * Create a decoder producing the rows of the data incrementally. If the
+   * data is a multi-frame image, only the first frame is decoded.
+   *
+   * @return The scanline decoder. nullptr if the data is invalid, or if this
+   *         codec or this particular image can not be decoded by rows, e.g.
+   *         an interlaced PNG. Callers should fall back to Decode() then.
+   */
+  virtual std::shared_ptr<ScanlineDecoder> DecodeScanlines();
+
   /**
    * Create a codec from data. Will try to recognize the file type and create
    * the corresponding codec.
@@ -392,6 +475,18 @@ class SKITY_EXPERIMENTAL_API Codec {
    */
   static std::shared_ptr<Codec> MakeFromData(std::shared_ptr<Data> const& data);
 
+  /**
+   * Create an image from encoded data which is only decoded when drawn, at
+   * the size the draw needs. The decoded pixels live in the
+   * DecodedImageCache instead of the image. See Image::MakeLazyImage().
+   *
+   * @param data The encoded data.
+   * @return The image. nullptr if the file type is not supported or the
+   *         image size can not be read.
+   */
+  static std::shared_ptr<Image> MakeLazyImage(
+      std::shared_ptr<Data> const& data);
+
   static std::shared_ptr<Codec> MakePngCodec();
 
   static std::shared_ptr<Codec> MakeJPEGCodec();
@@ -0,0 +1,167 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/codec/animated_frame_cache.hpp"
+
+#include <iterator>
+#include <skity/codec/animated_image_player.hpp>
+
+namespace skity {
+
+AnimatedFrameCache* AnimatedFrameCache::GlobalAnimatedFrameCache() {
+  // never destroyed, players may be released on the worker thread at exit
+  static AnimatedFrameCache* cache = new AnimatedFrameCache();
+  return cache;
+}
+
+AnimatedFrameCache::AnimatedFrameCache()
+    : budget_(AnimatedImagePlayer::kDefaultCacheBudget) {}
+
+std::shared_ptr<Pixmap> AnimatedFrameCache::Find(uint32_t player_id,
+                                                 int32_t frame_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = entries_.find(MakeKey(player_id, frame_id));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+
+  auto& lru = LRUList(it->second->keyframe);
+  lru.splice(lru.begin(), lru, it->second);
+
+  return it->second->pixmap;
+}
+
+bool AnimatedFrameCache::Contains(uint32_t player_id, int32_t frame_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.count(MakeKey(player_id, frame_id)) != 0;
+}
+
+void AnimatedFrameCache::Insert(uint32_t player_id, int32_t frame_id,
+                                std::shared_ptr<Pixmap> pixmap, bool keyframe) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  uint64_t key = MakeKey(player_id, frame_id);
+  if (entries_.count(key) != 0) {
+    return;
+  }
+
+  size_t bytes = pixmap->RowBytes() * pixmap->Height();
+  if (bytes > budget_) {
+    return;
+  }
+
+  auto& lru = LRUList(keyframe);
+  lru.push_front(Entry{key, std::move(pixmap), bytes, keyframe});
+  entries_.emplace(key, lru.begin());
+  cached_bytes_ += bytes;
+
+  Usage& usage = usages_[player_id];
+  usage.frame_count++;
+  usage.keyframe_count += keyframe ? 1 : 0;
+  usage.bytes += bytes;
+
+  PurgeToBudget(key);
+}
+
+void AnimatedFrameCache::RemovePlayer(uint32_t player_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto* lru : {&frames_lru_, &keyframes_lru_}) {
+    for (auto it = lru->begin(); it != lru->end();) {
+      auto next = std::next(it);
+      if (static_cast<uint32_t>(it->key >> 32) == player_id) {
+        Remove(it);
+      }
+      it = next;
+    }
+  }
+
+  usages_.erase(player_id);
+}
+
+AnimatedFrameCache::Usage AnimatedFrameCache::GetUsage(uint32_t player_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = usages_.find(player_id);
+  return it == usages_.end() ? Usage{} : it->second;
+}
+
+void AnimatedFrameCache::SetBudget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  PurgeToBudget(0);
+}
+
+size_t AnimatedFrameCache::GetBudget() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+void AnimatedFrameCache::Remove(EntryList::iterator entry) {
+  auto player_id = static_cast<uint32_t>(entry->key >> 32);
+  auto usage = usages_.find(player_id);
+  if (usage != usages_.end()) {
+    usage->second.frame_count--;
+    usage->second.keyframe_count -= entry->keyframe ? 1 : 0;
+    usage->second.bytes -= entry->bytes;
+  }
+
+  entries_.erase(entry->key);
+  cached_bytes_ -= entry->bytes;
+  LRUList(entry->keyframe).erase(entry);
+}
+
+void AnimatedFrameCache::PurgeToBudget(uint64_t newest_key) {
+  // plain frames go first, keyframes are what keeps seeking cheap
+  while (cached_bytes_ > budget_) {
+    bool from_frames =
+        !frames_lru_.empty() && frames_lru_.back().key != newest_key;
+    auto& lru = from_frames ? frames_lru_ : keyframes_lru_;
+    if (lru.empty()) {
+      break;
+    }
+
+    Remove(std::prev(lru.end()));
+  }
+}
+
+DecodeAheadWorker* DecodeAheadWorker::GlobalDecodeAheadWorker() {
+  // never destroyed, its thread lives as long as the process
+  static DecodeAheadWorker* worker = new DecodeAheadWorker();
+  return worker;
+}
+
+void DecodeAheadWorker::Schedule(std::weak_ptr<DecodeAheadTask> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace_back(std::move(task));
+
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this]() { Loop(); });
+    }
+  }
+
+  cv_.notify_one();
+}
+
+void DecodeAheadWorker::Loop() {
+  while (true) {
+    std::weak_ptr<DecodeAheadTask> next;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return !tasks_.empty(); });
+
+      next = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    // the task may be released here, then its player is gone already
+    if (auto task = next.lock()) {
+      task->DecodeAhead();
+    }
+  }
+}
+
+}  // namespace skity
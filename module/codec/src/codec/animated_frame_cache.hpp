@@ -0,0 +1,133 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MODULE_CODEC_SRC_CODEC_ANIMATED_FRAME_CACHE_HPP
+#define MODULE_CODEC_SRC_CODEC_ANIMATED_FRAME_CACHE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <skity/io/pixmap.hpp>
+#include <thread>
+#include <unordered_map>
+
+namespace skity {
+
+/**
+ * The frame cache shared by all AnimatedImagePlayer instances. Entries are
+ * keyed by the id of the player and the frame id.
+ *
+ * Once the cached bytes exceed the process wide budget, plain frames are
+ * evicted in least recently used order before keyframes, whichever player
+ * they belong to.
+ */
+class AnimatedFrameCache final {
+ public:
+  struct Usage {
+    size_t frame_count = 0;
+    size_t keyframe_count = 0;
+    size_t bytes = 0;
+  };
+
+  static AnimatedFrameCache* GlobalAnimatedFrameCache();
+
+  AnimatedFrameCache();
+  ~AnimatedFrameCache() = default;
+
+  std::shared_ptr<Pixmap> Find(uint32_t player_id, int32_t frame_id);
+
+  bool Contains(uint32_t player_id, int32_t frame_id);
+
+  /**
+   * Cache a decoded frame. The newest frame survives the eviction it causes,
+   * otherwise a budget full of keyframes would never let playback cache
+   * anything. Frames larger than the whole budget are not cached.
+   */
+  void Insert(uint32_t player_id, int32_t frame_id,
+              std::shared_ptr<Pixmap> pixmap, bool keyframe);
+
+  void RemovePlayer(uint32_t player_id);
+
+  Usage GetUsage(uint32_t player_id);
+
+  void SetBudget(size_t bytes);
+
+  size_t GetBudget();
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::shared_ptr<Pixmap> pixmap;
+    size_t bytes;
+    bool keyframe;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static uint64_t MakeKey(uint32_t player_id, int32_t frame_id) {
+    return (static_cast<uint64_t>(player_id) << 32) |
+           static_cast<uint32_t>(frame_id);
+  }
+
+  EntryList& LRUList(bool keyframe) {
+    return keyframe ? keyframes_lru_ : frames_lru_;
+  }
+
+  void Remove(EntryList::iterator entry);
+
+  void PurgeToBudget(uint64_t newest_key);
+
+  std::mutex mutex_;
+  // most recently used first
+  EntryList frames_lru_;
+  EntryList keyframes_lru_;
+  std::unordered_map<uint64_t, EntryList::iterator> entries_;
+  std::unordered_map<uint32_t, Usage> usages_;
+  size_t budget_;
+  size_t cached_bytes_ = 0;
+};
+
+/**
+ * Work decoded ahead by the DecodeAheadWorker.
+ */
+class DecodeAheadTask {
+ public:
+  virtual ~DecodeAheadTask() = default;
+
+  /**
+   * Called on the worker thread.
+   */
+  virtual void DecodeAhead() = 0;
+};
+
+/**
+ * The single background thread decoding ahead for all players. Tasks run in
+ * the order they were scheduled. A task which is gone by the time its turn
+ * comes is skipped.
+ */
+class DecodeAheadWorker final {
+ public:
+  static DecodeAheadWorker* GlobalDecodeAheadWorker();
+
+  DecodeAheadWorker() = default;
+  ~DecodeAheadWorker() = default;
+
+  void Schedule(std::weak_ptr<DecodeAheadTask> task);
+
+ private:
+  void Loop();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::weak_ptr<DecodeAheadTask>> tasks_;
+  std::thread thread_;
+};
+
+}  // namespace skity
+
+#endif  // MODULE_CODEC_SRC_CODEC_ANIMATED_FRAME_CACHE_HPP
@@ -0,0 +1,338 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <skity/codec/animated_image_player.hpp>
+#include <skity/io/pixmap.hpp>
+#include <vector>
+
+#include "src/codec/animated_frame_cache.hpp"
+
+namespace skity {
+
+namespace {
+
+/**
+ * Copy the pixels of `required` and apply its disposal method, which gives
+ * the canvas the next frame is drawn on.
+ */
+std::shared_ptr<Pixmap> MakeFrameCanvas(const Pixmap& required,
+                                        const CodecFrame* required_frame) {
+  auto canvas = std::make_shared<Pixmap>(required.Width(), required.Height(),
+                                         required.GetAlphaType(),
+                                         required.GetColorType());
+
+  size_t row_bytes = std::min(canvas->RowBytes(), required.RowBytes());
+  for (uint32_t y = 0; y < required.Height(); y++) {
+    std::memcpy(canvas->WritableAddr8(0, y), required.Addr8(0, y), row_bytes);
+  }
+
+  if (required_frame->GetDisposalMethod() ==
+      CodecDisposalMethod::RestoreBGColor) {
+    CodecRect screen_rect{};
+    screen_rect.SetXYWH(0, 0, static_cast<int32_t>(canvas->Width()),
+                        static_cast<int32_t>(canvas->Height()));
+
+    CodecRect clear_rect = required_frame->GetRect();
+    if (clear_rect.Intersect(screen_rect)) {
+      size_t bytes_per_pixel = canvas->RowBytes() / canvas->Width();
+      for (int32_t y = clear_rect.top; y < clear_rect.bottom; y++) {
+        std::memset(canvas->WritableAddr8(clear_rect.left, y), 0,
+                    clear_rect.Width() * bytes_per_pixel);
+      }
+    }
+  }
+
+  return canvas;
+}
+
+}  // namespace
+
+class AnimatedImagePlayer::Impl
+    : public DecodeAheadTask,
+      public std::enable_shared_from_this<AnimatedImagePlayer::Impl> {
+ public:
+  Impl(std::shared_ptr<MultiFrameDecoder> decoder, const Options& options)
+      : decoder_(std::move(decoder)), options_(options), id_(NextID()) {
+    int32_t count = decoder_->GetFrameCount();
+    frame_end_times_.reserve(count);
+
+    int64_t end_time = 0;
+    for (int32_t i = 0; i < count; i++) {
+      auto frame = decoder_->GetFrameInfo(i);
+      if (frame != nullptr) {
+        end_time += std::max(frame->GetDuration(), 0);
+      }
+      frame_end_times_.emplace_back(end_time);
+    }
+  }
+
+  ~Impl() override {
+    AnimatedFrameCache::GlobalAnimatedFrameCache()->RemovePlayer(id_);
+  }
+
+  const MultiFrameDecoder* GetDecoder() const { return decoder_.get(); }
+
+  int64_t GetTotalDuration() const {
+    return frame_end_times_.empty() ? 0 : frame_end_times_.back();
+  }
+
+  int32_t GetFrameIDAtTime(int64_t time_ms) const {
+    int64_t total = GetTotalDuration();
+    if (total <= 0) {
+      return 0;
+    }
+
+    int64_t t = time_ms % total;
+    if (t < 0) {
+      t += total;
+    }
+
+    auto it = std::upper_bound(frame_end_times_.begin(),
+                               frame_end_times_.end(), t);
+
+    return static_cast<int32_t>(it - frame_end_times_.begin());
+  }
+
+  std::shared_ptr<Pixmap> GetFrame(int32_t frame_id) {
+    if (decoder_->GetFrameInfo(frame_id) == nullptr) {
+      return nullptr;
+    }
+
+    auto pixmap =
+        AnimatedFrameCache::GlobalAnimatedFrameCache()->Find(id_, frame_id);
+    {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      if (pixmap) {
+        stats_.hit_count++;
+      } else {
+        stats_.miss_count++;
+      }
+    }
+
+    if (!pixmap) {
+      std::lock_guard<std::mutex> lock(decode_mutex_);
+      pixmap = DecodeFrame(frame_id);
+    }
+
+    ScheduleDecodeAhead(frame_id);
+
+    return pixmap;
+  }
+
+  void Purge() {
+    AnimatedFrameCache::GlobalAnimatedFrameCache()->RemovePlayer(id_);
+  }
+
+  Stats GetStats() const {
+    auto usage = AnimatedFrameCache::GlobalAnimatedFrameCache()->GetUsage(id_);
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    Stats stats = stats_;
+    stats.cached_frame_count = usage.frame_count;
+    stats.cached_keyframe_count = usage.keyframe_count;
+    stats.cached_bytes = usage.bytes;
+
+    return stats;
+  }
+
+  /**
+   * Called when the player goes away. A decode ahead already running for it
+   * stops after the current frame.
+   */
+  void Stop() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stopped_ = true;
+  }
+
+  void DecodeAhead() override {
+    int32_t count = decoder_->GetFrameCount();
+    int32_t ahead = std::min(options_.decode_ahead, count - 1);
+
+    int32_t from;
+    {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      from = ahead_from_;
+      ahead_queued_ = false;
+    }
+
+    auto cache = AnimatedFrameCache::GlobalAnimatedFrameCache();
+    for (int32_t i = 1; i <= ahead; i++) {
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        // a newer request is queued again and restarts from its own position
+        if (stopped_ || ahead_queued_) {
+          break;
+        }
+      }
+
+      int32_t next = (from + i) % count;
+      if (cache->Contains(id_, next)) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(decode_mutex_);
+      DecodeFrame(next);
+    }
+  }
+
+ private:
+  static uint32_t NextID() {
+    static std::atomic<uint32_t> next_id{1};
+    return next_id++;
+  }
+
+  bool IsKeyframe(int32_t frame_id) const {
+    return options_.keyframe_interval > 0 &&
+           frame_id % options_.keyframe_interval == 0;
+  }
+
+  /**
+   * Decode the given frame, replaying the chain of required frames back to
+   * the closest cached or independent one. decode_mutex_ must be held.
+   */
+  std::shared_ptr<Pixmap> DecodeFrame(int32_t frame_id) {
+    auto cache = AnimatedFrameCache::GlobalAnimatedFrameCache();
+
+    std::vector<int32_t> chain;
+    std::shared_ptr<Pixmap> base;
+
+    int32_t current = frame_id;
+    while (current != CodecFrameInfo::kNoFrameRequired) {
+      base = cache->Find(id_, current);
+      if (base) {
+        break;
+      }
+
+      chain.emplace_back(current);
+      current = decoder_->GetFrameInfo(current)->GetRequiredFrame();
+    }
+
+    for (auto it = chain.rbegin(); it != chain.rend(); it++) {
+      auto frame = decoder_->GetFrameInfo(*it);
+
+      std::shared_ptr<Pixmap> canvas;
+      if (frame->GetRequiredFrame() != CodecFrameInfo::kNoFrameRequired) {
+        canvas = MakeFrameCanvas(
+            *base, decoder_->GetFrameInfo(frame->GetRequiredFrame()));
+      }
+
+      base = decoder_->DecodeFrame(frame, std::move(canvas));
+      if (!base) {
+        return nullptr;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stats_.decoded_frame_count++;
+      }
+
+      // frames only passed through on the way are not worth the budget
+      if (*it == frame_id || IsKeyframe(*it)) {
+        cache->Insert(id_, *it, base, IsKeyframe(*it));
+      }
+    }
+
+    return base;
+  }
+
+  void ScheduleDecodeAhead(int32_t frame_id) {
+    if (options_.decode_ahead <= 0 || decoder_->GetFrameCount() <= 1) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      ahead_from_ = frame_id;
+
+      // a queued task picks up the new position when it runs
+      if (ahead_queued_) {
+        return;
+      }
+      ahead_queued_ = true;
+    }
+
+    DecodeAheadWorker::GlobalDecodeAheadWorker()->Schedule(weak_from_this());
+  }
+
+ private:
+  std::shared_ptr<MultiFrameDecoder> decoder_;
+  Options options_;
+  std::vector<int64_t> frame_end_times_;
+  // the key of this player in the shared AnimatedFrameCache
+  uint32_t id_;
+
+  // serializes all calls into decoder_, taken before state_mutex_
+  std::mutex decode_mutex_;
+
+  mutable std::mutex state_mutex_;
+  Stats stats_;
+  int32_t ahead_from_ = 0;
+  bool ahead_queued_ = false;
+  bool stopped_ = false;
+};
+
+std::unique_ptr<AnimatedImagePlayer> AnimatedImagePlayer::Make(
+    std::shared_ptr<MultiFrameDecoder> decoder) {
+  return Make(std::move(decoder), Options{});
+}
+
+std::unique_ptr<AnimatedImagePlayer> AnimatedImagePlayer::Make(
+    std::shared_ptr<MultiFrameDecoder> decoder, const Options& options) {
+  if (decoder == nullptr || decoder->GetFrameCount() <= 0) {
+    return nullptr;
+  }
+
+  return std::unique_ptr<AnimatedImagePlayer>(new AnimatedImagePlayer(
+      std::make_shared<Impl>(std::move(decoder), options)));
+}
+
+void AnimatedImagePlayer::SetCacheBudget(size_t bytes) {
+  AnimatedFrameCache::GlobalAnimatedFrameCache()->SetBudget(bytes);
+}
+
+size_t AnimatedImagePlayer::GetCacheBudget() {
+  return AnimatedFrameCache::GlobalAnimatedFrameCache()->GetBudget();
+}
+
+AnimatedImagePlayer::AnimatedImagePlayer(std::shared_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+AnimatedImagePlayer::~AnimatedImagePlayer() { impl_->Stop(); }
+
+int32_t AnimatedImagePlayer::GetWidth() const {
+  return impl_->GetDecoder()->GetWidth();
+}
+
+int32_t AnimatedImagePlayer::GetHeight() const {
+  return impl_->GetDecoder()->GetHeight();
+}
+
+int32_t AnimatedImagePlayer::GetFrameCount() const {
+  return impl_->GetDecoder()->GetFrameCount();
+}
+
+int64_t AnimatedImagePlayer::GetTotalDuration() const {
+  return impl_->GetTotalDuration();
+}
+
+int32_t AnimatedImagePlayer::GetFrameIDAtTime(int64_t time_ms) const {
+  return impl_->GetFrameIDAtTime(time_ms);
+}
+
+std::shared_ptr<Pixmap> AnimatedImagePlayer::GetFrame(int32_t frame_id) {
+  return impl_->GetFrame(frame_id);
+}
+
+void AnimatedImagePlayer::Purge() { impl_->Purge(); }
+
+AnimatedImagePlayer::Stats AnimatedImagePlayer::GetStats() const {
+  return impl_->GetStats();
+}
+
+}  // namespace skity
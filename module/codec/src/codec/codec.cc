@@ -2,6 +2,7 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <skity/codec/codec.hpp>
 #include <skity/io/data.hpp>
 #include <vector>
@@ -44,6 +45,35 @@ std::shared_ptr<Codec> Codec::MakeFromData(const std::shared_ptr<Data>& data) {
   return nullptr;
 }
 
+int32_t ScanlineDecoder::DecodeRows(void* dst, size_t row_bytes,
+                                    int32_t row_count) {
+  if (failed_ || dst == nullptr || row_count <= 0 ||
+      row_bytes < static_cast<size_t>(GetWidth()) * 4) {
+    return 0;
+  }
+
+  row_count = std::min(row_count, GetHeight() - next_row_);
+
+  if (row_count <= 0) {
+    return 0;
+  }
+
+  if (!OnDecodeRows(reinterpret_cast<uint8_t*>(dst), row_bytes, row_count)) {
+    failed_ = true;
+    return 0;
+  }
+
+  next_row_ += row_count;
+
+  return row_count;
+}
+
+std::shared_ptr<ScanlineDecoder> Codec::DecodeScanlines() { return {}; }
+
+std::shared_ptr<Pixmap> Codec::DecodeToSize(int32_t, int32_t) {
+  return Decode();
+}
+
 std::shared_ptr<Codec> Codec::MakePngCodec() {
   return std::make_shared<PNGCodec>();
 }
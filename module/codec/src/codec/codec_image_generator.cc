@@ -0,0 +1,82 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/codec/codec_image_generator.hpp"
+
+#include <algorithm>
+#include <skity/graphic/image.hpp>
+#include <skity/io/data.hpp>
+#include <skity/io/pixmap.hpp>
+
+namespace skity {
+
+namespace {
+
+std::shared_ptr<Codec> MakeCodecInstance(std::shared_ptr<Data> const& data) {
+  if (!data || data->Size() <= 20) {
+    return nullptr;
+  }
+
+  const char* header = reinterpret_cast<const char*>(data->RawData());
+
+  for (auto factory : {Codec::MakePngCodec, Codec::MakeJPEGCodec,
+                       Codec::MakeGIFCodec, Codec::MakeWebpCodec}) {
+    auto codec = factory();
+    if (codec && codec->RecognizeFileType(header, data->Size())) {
+      codec->SetData(data);
+      return codec;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+std::shared_ptr<CodecImageGenerator> CodecImageGenerator::Make(
+    std::shared_ptr<Data> const& data) {
+  auto codec = MakeCodecInstance(data);
+  if (!codec) {
+    return nullptr;
+  }
+
+  // prefer the decoders that only read the header to get the size
+  int32_t width = 0;
+  int32_t height = 0;
+  if (auto scanline_decoder = codec->DecodeScanlines()) {
+    width = scanline_decoder->GetWidth();
+    height = scanline_decoder->GetHeight();
+  } else if (auto frame_decoder = codec->DecodeMultiFrame()) {
+    width = frame_decoder->GetWidth();
+    height = frame_decoder->GetHeight();
+  } else if (auto pixmap = codec->Decode()) {
+    width = static_cast<int32_t>(pixmap->Width());
+    height = static_cast<int32_t>(pixmap->Height());
+  }
+
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+
+  return std::make_shared<CodecImageGenerator>(std::move(codec), width,
+                                               height);
+}
+
+CodecImageGenerator::CodecImageGenerator(std::shared_ptr<Codec> codec,
+                                         uint32_t width, uint32_t height)
+    : codec_(std::move(codec)), width_(width), height_(height) {}
+
+std::shared_ptr<Pixmap> CodecImageGenerator::Generate(uint32_t target_width,
+                                                      uint32_t target_height) {
+  // the full size is requested explicitly, never through a 0 x 0 target
+  return codec_->DecodeToSize(
+      static_cast<int32_t>(std::min(target_width, width_)),
+      static_cast<int32_t>(std::min(target_height, height_)));
+}
+
+std::shared_ptr<Image> Codec::MakeLazyImage(std::shared_ptr<Data> const& data) {
+  return Image::MakeLazyImage(CodecImageGenerator::Make(data));
+}
+
+}  // namespace skity
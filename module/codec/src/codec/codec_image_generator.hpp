@@ -0,0 +1,51 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MODULE_CODEC_SRC_CODEC_CODEC_IMAGE_GENERATOR_HPP
+#define MODULE_CODEC_SRC_CODEC_CODEC_IMAGE_GENERATOR_HPP
+
+#include <memory>
+#include <skity/codec/codec.hpp>
+#include <skity/graphic/image_generator.hpp>
+
+namespace skity {
+
+/**
+ * Generates the pixels of an encoded image by decoding it with its own codec
+ * instance, since the codecs returned by Codec::MakeFromData() are shared.
+ */
+class CodecImageGenerator : public ImageGenerator {
+ public:
+  /**
+   * @return nullptr if the data is not a supported image or its size can not
+   *         be read.
+   */
+  static std::shared_ptr<CodecImageGenerator> Make(
+      std::shared_ptr<Data> const& data);
+
+  CodecImageGenerator(std::shared_ptr<Codec> codec, uint32_t width,
+                      uint32_t height);
+
+  ~CodecImageGenerator() override = default;
+
+  uint32_t Width() const override { return width_; }
+
+  uint32_t Height() const override { return height_; }
+
+  AlphaType GetAlphaType() const override {
+    return AlphaType::kUnpremul_AlphaType;
+  }
+
+  std::shared_ptr<Pixmap> Generate(uint32_t target_width,
+                                   uint32_t target_height) override;
+
+ private:
+  std::shared_ptr<Codec> codec_;
+  uint32_t width_;
+  uint32_t height_;
+};
+
+}  // namespace skity
+
+#endif  // MODULE_CODEC_SRC_CODEC_CODEC_IMAGE_GENERATOR_HPP
@@ -13,6 +13,7 @@ extern "C" {
 #include <turbojpeg.h>
 
 #include <array>
+#include <csetjmp>
 #include <skity/io/data.hpp>
 #include <skity/io/pixmap.hpp>
 
@@ -78,6 +79,136 @@ void term_jpeg_destination(j_compress_ptr cinfo) {
   }
 }
 
+struct skity_jpeg_error_mgr : jpeg_error_mgr {
+  std::jmp_buf jump_buffer;
+};
+
+void skity_jpeg_error_exit(j_common_ptr cinfo) {
+  // the default handler terminates the process
+  auto err = reinterpret_cast<skity_jpeg_error_mgr*>(cinfo->err);
+  std::longjmp(err->jump_buffer, 1);
+}
+
+/**
+ * Uses the libjpeg scanline API, turbojpeg only decodes whole images. libjpeg
+ * reports errors through skity_jpeg_error_exit, so every call into it is
+ * guarded by setjmp.
+ */
+class JPEGScanlineDecoder : public ScanlineDecoder {
+ public:
+  explicit JPEGScanlineDecoder(std::shared_ptr<Data> data)
+      : data_(std::move(data)) {
+    cinfo_.err = jpeg_std_error(&err_);
+    err_.error_exit = skity_jpeg_error_exit;
+  }
+
+  // also safe if jpeg_create_decompress did not run or failed, libjpeg only
+  // releases the memory manager it created
+  ~JPEGScanlineDecoder() override { jpeg_destroy_decompress(&cinfo_); }
+
+  bool Init() {
+    if (setjmp(err_.jump_buffer)) {
+      return false;
+    }
+
+    // can fail when allocating, so only after the jump buffer is armed
+    jpeg_create_decompress(&cinfo_);
+
+    jpeg_mem_src(&cinfo_, (unsigned char*)data_->RawData(),  // NOLINT
+                 data_->Size());
+
+    if (jpeg_read_header(&cinfo_, TRUE) != JPEG_HEADER_OK) {
+      return false;
+    }
+
+    cinfo_.out_color_space = JCS_EXT_RGBA;
+
+    if (!jpeg_start_decompress(&cinfo_)) {
+      return false;
+    }
+
+    return cinfo_.output_width > 0 && cinfo_.output_height > 0;
+  }
+
+  int32_t GetWidth() const override {
+    return static_cast<int32_t>(cinfo_.output_width);
+  }
+
+  int32_t GetHeight() const override {
+    return static_cast<int32_t>(cinfo_.output_height);
+  }
+
+ protected:
+  bool OnDecodeRows(uint8_t* dst, size_t row_bytes,
+                    int32_t row_count) override {
+    if (setjmp(err_.jump_buffer)) {
+      return false;
+    }
+
+    for (int32_t i = 0; i < row_count; i++) {
+      JSAMPROW row = dst + i * row_bytes;
+
+      if (jpeg_read_scanlines(&cinfo_, &row, 1) != 1) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  std::shared_ptr<Data> data_;
+  skity_jpeg_error_mgr err_{};
+  jpeg_decompress_struct cinfo_{};
+};
+
+/**
+ * Pick the smallest scaling factor not above 1/1 whose output still covers the
+ * target size. An empty target selects 1/1, it means the full image.
+ */
+tjscalingfactor choose_scaling_factor(int32_t width, int32_t height,
+                                      int32_t target_width,
+                                      int32_t target_height) {
+  tjscalingfactor result = {1, 1};
+
+  if (target_width <= 0 || target_height <= 0) {
+    return result;
+  }
+
+  int32_t count = 0;
+  tjscalingfactor* factors = tjGetScalingFactors(&count);
+
+  if (factors == nullptr) {
+    return result;
+  }
+
+  int64_t result_area = static_cast<int64_t>(width) * height;
+
+  for (int32_t i = 0; i < count; i++) {
+    const auto& factor = factors[i];
+
+    if (factor.num > factor.denom) {
+      continue;
+    }
+
+    int32_t scaled_width = TJSCALED(width, factor);
+    int32_t scaled_height = TJSCALED(height, factor);
+
+    if (scaled_width < target_width || scaled_height < target_height) {
+      continue;
+    }
+
+    int64_t area = static_cast<int64_t>(scaled_width) * scaled_height;
+
+    if (area < result_area) {
+      result = factor;
+      result_area = area;
+    }
+  }
+
+  return result;
+}
+
 }  // namespace
 
 bool JPEGCodec::RecognizeFileType(const char* header, size_t size) {
@@ -100,7 +231,10 @@ bool JPEGCodec::RecognizeFileType(const char* header, size_t size) {
   }
 }
 
-std::shared_ptr<Pixmap> JPEGCodec::Decode() {
+std::shared_ptr<Pixmap> JPEGCodec::Decode() { return DecodeToSize(0, 0); }
+
+std::shared_ptr<Pixmap> JPEGCodec::DecodeToSize(int32_t target_width,
+                                                int32_t target_height) {
   TJHandlerWrapper hw{tjInitDecompress()};
 
   if (!hw.handle) {
@@ -118,9 +252,22 @@ std::shared_ptr<Pixmap> JPEGCodec::Decode() {
     return nullptr;
   }
 
-  uint8_t* buffer = reinterpret_cast<uint8_t*>(
-      tjAlloc(width * height * tjPixelSize[TJPF_RGBA]));
+  tjscalingfactor factor =
+      choose_scaling_factor(width, height, target_width, target_height);
+
+  width = TJSCALED(width, factor);
+  height = TJSCALED(height, factor);
+
+  size_t row_bytes = width * tjPixelSize[TJPF_RGBA];
+  size_t size = row_bytes * height;
+
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(tjAlloc(size));
 
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+
+  // turbojpeg scales to the output size passed here
   ret = tjDecompress2(hw.handle, (const unsigned char*)data_->RawData(),
                       data_->Size(), (unsigned char*)buffer, width, 0, height,
                       TJPF_RGBA, 0);
@@ -129,16 +276,33 @@ std::shared_ptr<Pixmap> JPEGCodec::Decode() {
     return nullptr;
   }
 
-  auto image_data = skity::Data::MakeWithCopy(
-      buffer, width * height * tjPixelSize[TJPF_RGBA]);
+  // hand the decode buffer over to the pixmap instead of copying it
+  auto image_data = skity::Data::MakeWithProc(
+      buffer, size,
+      [](const void* ptr, void*) {
+        tjFree(reinterpret_cast<unsigned char*>(const_cast<void*>(ptr)));
+      },
+      nullptr);
 
-  tjFree(buffer);
-  return std::make_shared<Pixmap>(image_data, width * tjPixelSize[TJPF_RGBA],
-                                  width, height);
+  return std::make_shared<Pixmap>(image_data, row_bytes, width, height);
 }
 
 std::shared_ptr<MultiFrameDecoder> JPEGCodec::DecodeMultiFrame() { return {}; }
 
+std::shared_ptr<ScanlineDecoder> JPEGCodec::DecodeScanlines() {
+  if (!data_) {
+    return nullptr;
+  }
+
+  auto decoder = std::make_shared<JPEGScanlineDecoder>(data_);
+
+  if (!decoder->Init()) {
+    return nullptr;
+  }
+
+  return decoder;
+}
+
 std::shared_ptr<Data> JPEGCodec::Encode(const Pixmap* pixmap) {
   if (!pixmap || pixmap->Width() == 0 || pixmap->Height() == 0) {
     return nullptr;
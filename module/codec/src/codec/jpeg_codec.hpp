@@ -16,8 +16,17 @@ class JPEGCodec : public Codec {
 
   std::shared_ptr<Pixmap> Decode() override;
 
+  /**
+   * Uses the DCT scaling of libjpeg-turbo, which supports factors from 1/8 to
+   * 1/1. Decoding at 1/8 touches 64 times less pixels than a full decode.
+   */
+  std::shared_ptr<Pixmap> DecodeToSize(int32_t target_width,
+                                       int32_t target_height) override;
+
   std::shared_ptr<MultiFrameDecoder> DecodeMultiFrame() override;
 
+  std::shared_ptr<ScanlineDecoder> DecodeScanlines() override;
+
   std::shared_ptr<Data> Encode(const Pixmap* pixmap) override;
 
   bool RecognizeFileType(const char* header, size_t size) override;
@@ -4,6 +4,7 @@
 
 #include "src/codec/png_codec.hpp"
 
+#include <csetjmp>
 #include <cstdlib>
 #include <cstring>
 #include <skity/io/data.hpp>
@@ -26,6 +27,141 @@ static void png_write_callback(png_structp png_ptr, png_bytep data,
   }
 }
 
+namespace {
+
+struct PNGReadSource {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+};
+
+void png_read_callback(png_structp png_ptr, png_bytep data,
+                       png_size_t length) {
+  auto source = reinterpret_cast<PNGReadSource*>(png_get_io_ptr(png_ptr));
+
+  if (source->size - source->offset < length) {
+    png_error(png_ptr, "read past end of data");
+  }
+
+  std::memcpy(data, source->data + source->offset, length);
+  source->offset += length;
+}
+
+/**
+ * Uses the low level libpng API, which reads one row at a time. libpng
+ * reports errors with longjmp, so every call into it is guarded by setjmp.
+ */
+class PNGScanlineDecoder : public ScanlineDecoder {
+ public:
+  explicit PNGScanlineDecoder(std::shared_ptr<Data> data)
+      : data_(std::move(data)) {
+    source_.data = data_->Bytes();
+    source_.size = data_->Size();
+  }
+
+  ~PNGScanlineDecoder() override {
+    png_destroy_read_struct(&png_ptr_, &info_ptr_, nullptr);
+  }
+
+  bool Init() {
+    png_ptr_ = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr,
+                                      nullptr);
+    if (!png_ptr_) {
+      return false;
+    }
+
+    info_ptr_ = png_create_info_struct(png_ptr_);
+    if (!info_ptr_) {
+      return false;
+    }
+
+    if (setjmp(png_jmpbuf(png_ptr_))) {
+      return false;
+    }
+
+    png_set_read_fn(png_ptr_, &source_, png_read_callback);
+    png_read_info(png_ptr_, info_ptr_);
+
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    int bit_depth = 0;
+    int color_type = 0;
+    int interlace_type = 0;
+    png_get_IHDR(png_ptr_, info_ptr_, &width, &height, &bit_depth, &color_type,
+                 &interlace_type, nullptr, nullptr);
+
+    // Adam7 rows are only final after the last pass over the whole image.
+    if (interlace_type != PNG_INTERLACE_NONE) {
+      return false;
+    }
+
+    // expand everything to 8 bits RGBA
+    if (bit_depth == 16) {
+      png_set_strip_16(png_ptr_);
+    }
+
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+      png_set_palette_to_rgb(png_ptr_);
+    }
+
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) {
+      png_set_expand_gray_1_2_4_to_8(png_ptr_);
+    }
+
+    bool has_alpha = (color_type & PNG_COLOR_MASK_ALPHA) != 0;
+
+    if (png_get_valid(png_ptr_, info_ptr_, PNG_INFO_tRNS)) {
+      png_set_tRNS_to_alpha(png_ptr_);
+      has_alpha = true;
+    }
+
+    if ((color_type & PNG_COLOR_MASK_COLOR) == 0) {
+      png_set_gray_to_rgb(png_ptr_);
+    }
+
+    if (!has_alpha) {
+      png_set_filler(png_ptr_, 0xFF, PNG_FILLER_AFTER);
+    }
+
+    png_read_update_info(png_ptr_, info_ptr_);
+
+    width_ = static_cast<int32_t>(width);
+    height_ = static_cast<int32_t>(height);
+
+    return width_ > 0 && height_ > 0;
+  }
+
+  int32_t GetWidth() const override { return width_; }
+
+  int32_t GetHeight() const override { return height_; }
+
+ protected:
+  bool OnDecodeRows(uint8_t* dst, size_t row_bytes,
+                    int32_t row_count) override {
+    if (setjmp(png_jmpbuf(png_ptr_))) {
+      return false;
+    }
+
+    for (int32_t i = 0; i < row_count; i++) {
+      png_read_row(png_ptr_, dst + i * row_bytes, nullptr);
+    }
+
+    return true;
+  }
+
+ private:
+  std::shared_ptr<Data> data_;
+  PNGReadSource source_;
+
+  png_structp png_ptr_ = nullptr;
+  png_infop info_ptr_ = nullptr;
+
+  int32_t width_ = 0;
+  int32_t height_ = 0;
+};
+
+}  // namespace
+
 PNGCodec::PNGCodec() = default;
 
 PNGCodec::~PNGCodec() { png_image_free(&image_); }
@@ -67,6 +203,20 @@ std::shared_ptr<Pixmap> skity::PNGCodec::Decode() {
 
 std::shared_ptr<MultiFrameDecoder> PNGCodec::DecodeMultiFrame() { return {}; }
 
+std::shared_ptr<ScanlineDecoder> PNGCodec::DecodeScanlines() {
+  if (!data_) {
+    return nullptr;
+  }
+
+  auto decoder = std::make_shared<PNGScanlineDecoder>(data_);
+
+  if (!decoder->Init()) {
+    return nullptr;
+  }
+
+  return decoder;
+}
+
 struct PNGDestructor {
   png_structp p;
   explicit PNGDestructor(png_structp p) : p(p) {}
@@ -17,6 +17,7 @@ class PNGCodec : public Codec {
   ~PNGCodec() override;
   std::shared_ptr<Pixmap> Decode() override;
   std::shared_ptr<MultiFrameDecoder> DecodeMultiFrame() override;
+  std::shared_ptr<ScanlineDecoder> DecodeScanlines() override;
   std::shared_ptr<Data> Encode(const Pixmap* pixmap) override;
   bool RecognizeFileType(const char* header, size_t size) override;
 
@@ -5,6 +5,7 @@
 #include "src/codec/webp_codec.hpp"
 
 #include <cstring>
+#include <vector>
 
 #include "src/codec/webp/webp_decoder.hpp"
 
@@ -29,6 +30,85 @@ std::shared_ptr<WebpDecoder> CreateWebpDecoder(std::shared_ptr<Data> data) {
   return std::make_shared<WebpDecoder>(std::move(demuxer), std::move(data));
 }
 
+/**
+ * libwebp has no public row callback, each band is decoded with its cropping
+ * option straight into the caller buffer. Rows above the band are still
+ * processed by libwebp, so bands should be large to limit the extra work.
+ */
+class WebpScanlineDecoder : public ScanlineDecoder {
+ public:
+  WebpScanlineDecoder(std::shared_ptr<Data> data, int32_t width,
+                      int32_t height)
+      : data_(std::move(data)), width_(width), height_(height) {}
+
+  ~WebpScanlineDecoder() override = default;
+
+  int32_t GetWidth() const override { return width_; }
+
+  int32_t GetHeight() const override { return height_; }
+
+ protected:
+  bool OnDecodeRows(uint8_t* dst, size_t row_bytes,
+                    int32_t row_count) override {
+    int32_t top = GetNextRow();
+
+    // libwebp snaps the crop origin to even coordinates, an odd band starts
+    // one row earlier in a scratch buffer.
+    if (top % 2 == 0) {
+      return DecodeBand(dst, row_bytes, top, row_count);
+    }
+
+    size_t scratch_row_bytes = static_cast<size_t>(width_) * 4;
+    std::vector<uint8_t> scratch(scratch_row_bytes * (row_count + 1));
+
+    if (!DecodeBand(scratch.data(), scratch_row_bytes, top - 1,
+                    row_count + 1)) {
+      return false;
+    }
+
+    for (int32_t i = 0; i < row_count; i++) {
+      std::memcpy(dst + i * row_bytes,
+                  scratch.data() + (i + 1) * scratch_row_bytes,
+                  scratch_row_bytes);
+    }
+
+    return true;
+  }
+
+ private:
+  bool DecodeBand(uint8_t* dst, size_t row_bytes, int32_t top,
+                  int32_t row_count) {
+    WebPDecoderConfig config;
+
+    if (WebPInitDecoderConfig(&config) == 0) {
+      return false;
+    }
+
+    config.options.use_cropping = 1;
+    config.options.crop_left = 0;
+    config.options.crop_top = top;
+    config.options.crop_width = width_;
+    config.options.crop_height = row_count;
+
+    config.output.colorspace = MODE_RGBA;  // RGBA unpremultiplied alpha
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = dst;
+    config.output.u.RGBA.stride = static_cast<int>(row_bytes);
+    config.output.u.RGBA.size = row_bytes * row_count;
+
+    auto status = WebPDecode(data_->Bytes(), data_->Size(), &config);
+
+    WebPFreeDecBuffer(&config.output);
+
+    return status == VP8_STATUS_OK;
+  }
+
+ private:
+  std::shared_ptr<Data> data_;
+  int32_t width_;
+  int32_t height_;
+};
+
 }  // namespace
 
 WEBPCodec::WEBPCodec() = default;
@@ -57,6 +137,27 @@ std::shared_ptr<MultiFrameDecoder> WEBPCodec::DecodeMultiFrame() {
   return decoder_;
 }
 
+std::shared_ptr<ScanlineDecoder> WEBPCodec::DecodeScanlines() {
+  if (data_ == nullptr) {
+    return {};
+  }
+
+  WebPBitstreamFeatures features;
+
+  if (WebPGetFeatures(data_->Bytes(), data_->Size(), &features) !=
+      VP8_STATUS_OK) {
+    return {};
+  }
+
+  // animated images need to be composited frame by frame
+  if (features.has_animation || features.width <= 0 || features.height <= 0) {
+    return {};
+  }
+
+  return std::make_shared<WebpScanlineDecoder>(data_, features.width,
+                                               features.height);
+}
+
 bool WEBPCodec::RecognizeFileType(const char* header, size_t size) {
   return size >= 14 && std::memcmp(header, "RIFF", 4) == 0 &&
          std::memcmp(header + 8, "WEBPVP", 6) == 0;
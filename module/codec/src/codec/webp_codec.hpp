@@ -27,6 +27,8 @@ class WEBPCodec : public Codec {
 
   std::shared_ptr<MultiFrameDecoder> DecodeMultiFrame() override;
 
+  std::shared_ptr<ScanlineDecoder> DecodeScanlines() override;
+
  private:
   void CreateDecoderIfNeed();
 
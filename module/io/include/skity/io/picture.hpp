@@ -69,7 +69,11 @@ class SKITY_API Picture final {
 
   static std::unique_ptr<Picture> MakeFromStream(ReadStream& stream);
 
-  void Serialize(WriteStream& stream, const SerialProc* proc,
+  /**
+   * @return false if the picture could not be written consistently, the
+   *         stream then holds a corrupt picture
+   */
+  bool Serialize(WriteStream& stream, const SerialProc* proc,
                  TypefaceSet* typeface_set = nullptr);
 
   void PlayBack(Canvas* canvas);
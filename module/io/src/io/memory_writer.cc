@@ -53,6 +53,31 @@ std::shared_ptr<Data> image_to_data(const Image* image,
 
 }  // namespace
 
+std::shared_ptr<Data> EncodedImageCache::Encode(const Image* image,
+                                                const SerialProc* proc) {
+  auto it = entries_.find(image);
+
+  if (it == entries_.end()) {
+    // failed encodings are cached as well so they are not retried
+    it = entries_.emplace(image, Entry{image_to_data(image, proc), 0}).first;
+  }
+
+  if (measuring_) {
+    it->second.uses++;
+    return it->second.data;
+  }
+
+  auto data = it->second.data;
+
+  if (it->second.uses > 1) {
+    it->second.uses--;
+  } else {
+    entries_.erase(it);
+  }
+
+  return data;
+}
+
 void MemoryWriter32::WriteBool(bool b) { WriteUint32(b ? 1 : 0); }
 
 void MemoryWriter32::WriteInt32(int32_t i) { WriteUint32(i); }
@@ -353,7 +378,8 @@ void BinaryWriteBuffer::WriteSampling(const SamplingOptions& sampling) {
 void BinaryWriteBuffer::WritePath(const Path& path) { writer_.WritePath(path); }
 
 void BinaryWriteBuffer::WriteImage(const Image* image) {
-  auto data = image_to_data(image, serial_proc_);
+  auto data = image_cache_ ? image_cache_->Encode(image, serial_proc_)
+                           : image_to_data(image, serial_proc_);
 
   if (!data) {
     return;
@@ -390,6 +416,18 @@ void BinaryWriteBuffer::WriteTextBlob(const TextBlob& blob) {
   FlatIntoMemory(blob, *this);
 }
 
+size_t BinaryWriteBuffer::Flush(WriteStream* stream) {
+  auto size = writer_.BytesWritten();
+
+  if (stream) {
+    writer_.WriteToStream(*stream);
+  }
+
+  writer_.Reset();
+
+  return size;
+}
+
 void BinaryWriteBuffer::WriteFlattenable(const Flattenable* flattenable) {
   if (flattenable == nullptr) {
     WriteInt32(0);
@@ -5,10 +5,12 @@
 #ifndef MODULE_IO_SRC_IO_MEMORY_WRITER_HPP
 #define MODULE_IO_SRC_IO_MEMORY_WRITER_HPP
 
+#include <memory>
 #include <skity/io/flattenable.hpp>
 #include <skity/io/stream.hpp>
 #include <skity/skity.hpp>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace skity {
@@ -78,6 +80,11 @@ class MemoryWriter32 final {
 
   std::shared_ptr<Data> MakeSnapshot();
 
+  /**
+   * Drop all written bytes but keep the allocated memory for reuse.
+   */
+  void Reset() { memory_data_.clear(); }
+
  private:
   void GrowToAtLeast(size_t size);
 
@@ -136,6 +143,34 @@ enum WriteBufferImageFlags {
   kUnpremul = 1 << 10,
 };
 
+/**
+ * Encoded data of the images flattened by the two passes of a serialization.
+ * The measuring pass encodes each image once and counts how often it is
+ * flattened, the writing pass reuses the same bytes and drops them after
+ * their last use.
+ */
+class EncodedImageCache final {
+ public:
+  /**
+   * @return the encoded data of `image`, null if it can not be encoded
+   */
+  std::shared_ptr<Data> Encode(const Image* image, const SerialProc* proc);
+
+  /**
+   * Switch to the writing pass.
+   */
+  void EndMeasuring() { measuring_ = false; }
+
+ private:
+  struct Entry {
+    std::shared_ptr<Data> data;
+    size_t uses = 0;
+  };
+
+  std::unordered_map<const Image*, Entry> entries_;
+  bool measuring_ = true;
+};
+
 /**
  * Convert draw object into flat buffer
  */
@@ -152,6 +187,8 @@ class BinaryWriteBuffer : public WriteBuffer {
 
   void SetSerialProc(const SerialProc* proc) { serial_proc_ = proc; }
 
+  void SetEncodedImageCache(EncodedImageCache* cache) { image_cache_ = cache; }
+
   size_t BytesWritten() const { return writer_.BytesWritten(); }
 
   void WriteByteArray(const uint8_t* data, size_t size) override;
@@ -196,10 +233,20 @@ class BinaryWriteBuffer : public WriteBuffer {
 
   void WriteToStream(WriteStream& stream) { writer_.WriteToStream(stream); }
 
+  /**
+   * Move the bytes written so far into `stream`, or discard them if `stream`
+   * is null, and start over with an empty buffer. This keeps the buffer as
+   * small as the largest object flattened between two flushes.
+   *
+   * @return number of bytes flushed
+   */
+  size_t Flush(WriteStream* stream);
+
  private:
   TypefaceSet* typeface_set_ = nullptr;
   FactorySet* factory_set_ = nullptr;
   const SerialProc* serial_proc_ = nullptr;
+  EncodedImageCache* image_cache_ = nullptr;
 
   MemoryWriter32 writer_;
 };
@@ -198,7 +198,7 @@ std::unique_ptr<Picture> Picture::MakeFromStream(ReadStream& stream) {
   return MakeFromStream(stream, nullptr, kDefaultRecursionLimit);
 }
 
-void Picture::Serialize(WriteStream& stream, const SerialProc* proc,
+bool Picture::Serialize(WriteStream& stream, const SerialProc* proc,
                         TypefaceSet* typeface_set) {
   auto info = create_header(cull_rect_);
 
@@ -206,10 +206,12 @@ void Picture::Serialize(WriteStream& stream, const SerialProc* proc,
 
   if (playback_) {
     stream.WriteU8(kPictureData_TrailingStreamByteAfterPictInfo);
-    playback_->Serialize(stream, proc, typeface_set);
-  } else {
-    stream.WriteU8(kFailure_TrailingStreamByteAfterPictInfo);
+    return playback_->Serialize(stream, proc, typeface_set);
   }
+
+  stream.WriteU8(kFailure_TrailingStreamByteAfterPictInfo);
+
+  return true;
 }
 
 void Picture::PlayBack(Canvas* canvas) {
@@ -498,7 +500,8 @@ void Picture::HandleOp(ReadBuffer& buffer, uint32_t type, size_t size,
 
       auto count = buffer.ReadU32();
 
-      buffer.Skip(count * 16);  // skip RSXform
+      const RSXform* xform = reinterpret_cast<const RSXform*>(
+          buffer.Skip(count * sizeof(RSXform)));
 
       const Rect* tex =
           reinterpret_cast<const Rect*>(buffer.Skip(count * sizeof(Rect)));
@@ -531,7 +534,8 @@ void Picture::HandleOp(ReadBuffer& buffer, uint32_t type, size_t size,
         BREAK_IF_ERROR(buffer);
       }
 
-      // Draw atlas
+      canvas->DrawAtlas(image, xform, tex, colors, static_cast<int>(count),
+                        blend_mode, sampling, cull, paint);
     } break;
 
     case DrawType::DRAW_CLEAR: {
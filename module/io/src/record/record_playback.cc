@@ -111,25 +111,33 @@ void RecordPlayback::BeginRecording() { init_save_count = Save(); }
 
 void RecordPlayback::EndRecording() { RestoreToCount(init_save_count); }
 
-void RecordPlayback::Serialize(WriteStream& stream, const SerialProc* proc,
+bool RecordPlayback::Serialize(WriteStream& stream, const SerialProc* proc,
                                TypefaceSet* top_typeface_set) {
-  auto op_data = writer32_.MakeSnapshot();
-
-  write_tag_size(stream, SK_PICT_READER_TAG, op_data->Size());
-  stream.Write(op_data->Bytes(), op_data->Size());
+  // op data is already laid out in its final form, write it without copying
+  write_tag_size(stream, SK_PICT_READER_TAG, writer32_.BytesWritten());
+  writer32_.WriteToStream(stream);
 
   TypefaceSet local_typeface_set;
 
   TypefaceSet* typeface_set =
       top_typeface_set ? top_typeface_set : &local_typeface_set;
   FactorySet factory_set;
+  EncodedImageCache image_cache;
 
   BinaryWriteBuffer buffer;
 
   buffer.SetTypefaceSet(typeface_set);
   buffer.SetFactorySet(&factory_set);
+  buffer.SetSerialProc(proc);
+  buffer.SetEncodedImageCache(&image_cache);
 
-  FlattenToBuffer(buffer);
+  // The factory and typeface sections come before the data section, but are
+  // only known once everything has been flattened. Measure the data section
+  // first, then flatten it again straight into the stream. Both passes add
+  // factories and typefaces in the same order, so indices match, and write
+  // the same encoded bytes of each image.
+  size_t data_size = FlattenToBuffer(buffer, nullptr);
+  image_cache.EndMeasuring();
 
   // will support recursive flatten sub picture
 
@@ -140,12 +148,21 @@ void RecordPlayback::Serialize(WriteStream& stream, const SerialProc* proc,
   WriteTypefaces(stream, *typeface_set);
 
   // write the data section
-  write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.BytesWritten());
-  buffer.WriteToStream(stream);
+  write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, data_size);
+  size_t written = FlattenToBuffer(buffer, &stream);
 
   // do not support recursive flatten sub picture
 
   stream.WriteU32(SK_PICT_EOF_TAG);
+
+  if (written != data_size) {
+    std::cerr << "Serialize data section size not match" << std::endl;
+    std::cerr << "expect size: " << data_size << std::endl;
+    std::cerr << "actual size: " << written << std::endl;
+    return false;
+  }
+
+  return true;
 }
 
 std::unique_ptr<RecordPlayback> RecordPlayback::CreateFromStream(
@@ -297,6 +314,53 @@ void RecordPlayback::OnDrawImageRect(std::shared_ptr<Image> image,
   Validate(offset, size);
 }
 
+void RecordPlayback::OnDrawAtlas(const std::shared_ptr<Image>& atlas,
+                                 const RSXform xform[], const Rect tex[],
+                                 const Color colors[], int count,
+                                 BlendMode mode,
+                                 const SamplingOptions& sampling,
+                                 const Rect* cull_rect, const Paint* paint) {
+  // op + paint index + image index + flags + count + xforms + texs
+  size_t size = 5 * kUInt32Size + count * sizeof(RSXform) +
+                count * sizeof(Rect);
+  // sampling options, same layout as DRAW_IMAGE_RECT2
+  size += 4 * kUInt32Size;
+
+  uint32_t flags = DRAW_ATLAS_HAS_SAMPLING;
+  if (colors) {
+    flags |= DRAW_ATLAS_HAS_COLORS;
+    size += count * sizeof(Color);
+    size += kUInt32Size;  // blend mode
+  }
+  if (cull_rect) {
+    flags |= DRAW_ATLAS_HAS_CULL;
+    size += sizeof(Rect);
+  }
+
+  auto offset = AddDraw(DrawType::DRAW_ATLAS, size);
+
+  AddPaintPtr(paint);
+  AddImage(atlas);
+  AddInt(static_cast<int32_t>(flags));
+  AddInt(count);
+
+  writer32_.Write(xform, count * sizeof(RSXform));
+  writer32_.Write(tex, count * sizeof(Rect));
+
+  if (colors) {
+    writer32_.Write(colors, count * sizeof(Color));
+    AddInt(static_cast<int32_t>(mode));
+  }
+
+  if (cull_rect) {
+    AddRect(*cull_rect);
+  }
+
+  writer32_.WriteSampling(sampling);
+
+  Validate(offset, size);
+}
+
 void RecordPlayback::OnDrawGlyphs(uint32_t count, const GlyphID glyphs[],
                                   const float position_x[],
                                   const float position_y[], const Font& font,
@@ -438,7 +502,10 @@ bool RecordPlayback::ParseStream(ReadStream& stream, TypefaceSet* typeface_set,
   return true;
 }
 
-void RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer) {
+size_t RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer,
+                                       WriteStream* stream) {
+  size_t size = 0;
+
   auto num_paints = static_cast<int32_t>(paints_.size());
   if (num_paints > 0) {
     // write paint section
@@ -446,6 +513,7 @@ void RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer) {
 
     for (const auto& paint : paints_) {
       buffer.WritePaint(paint);
+      size += buffer.Flush(stream);
     }
   }
 
@@ -458,6 +526,7 @@ void RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer) {
 
     for (const auto& path : paths_) {
       buffer.WritePath(path);
+      size += buffer.Flush(stream);
     }
   }
 
@@ -467,6 +536,7 @@ void RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer) {
 
     for (const auto& text_blob : text_blobs_) {
       buffer.WriteTextBlob(*text_blob);
+      size += buffer.Flush(stream);
     }
   }
 
@@ -476,8 +546,11 @@ void RecordPlayback::FlattenToBuffer(BinaryWriteBuffer& buffer) {
 
     for (const auto& image : images_) {
       buffer.WriteImage(image.get());
+      size += buffer.Flush(stream);
     }
   }
+
+  return size;
 }
 
 void RecordPlayback::WriteFactories(WriteStream& stream,
@@ -14,6 +14,8 @@
 #include "src/io/memory_writer.hpp"
 #include "src/record/draw_type.hpp"
 
+class PictureSerializeTest;
+
 namespace skity {
 
 #define MASK_24 0x00FFFFFF
@@ -37,7 +39,11 @@ class RecordPlayback : public Canvas {
   void BeginRecording();
   void EndRecording();
 
-  void Serialize(WriteStream& stream, const SerialProc* proc,
+  /**
+   * @return false if the data section did not match its measured size, the
+   *         stream then holds a corrupt picture
+   */
+  bool Serialize(WriteStream& stream, const SerialProc* proc,
                  TypefaceSet* typeface_set);
 
   static std::unique_ptr<RecordPlayback> CreateFromStream(
@@ -57,6 +63,8 @@ class RecordPlayback : public Canvas {
   const std::shared_ptr<Image>& GetImage(ReadBuffer& buffer) const;
   const std::shared_ptr<TextBlob>& GetTextBlob(ReadBuffer& buffer) const;
 
+  friend class ::PictureSerializeTest;
+
  protected:
   void OnClipRect(Rect const& rect, ClipOp op) override;
   void OnClipPath(Path const& path, ClipOp op) override;
@@ -68,6 +76,10 @@ class RecordPlayback : public Canvas {
   void OnDrawImageRect(std::shared_ptr<Image> image, const Rect& src,
                        const Rect& dst, const SamplingOptions& sampling,
                        Paint const* paint) override;
+  void OnDrawAtlas(const std::shared_ptr<Image>& atlas, const RSXform xform[],
+                   const Rect tex[], const Color colors[], int count,
+                   BlendMode mode, const SamplingOptions& sampling,
+                   const Rect* cull_rect, const Paint* paint) override;
   void OnDrawGlyphs(uint32_t count, const GlyphID glyphs[],
                     const float position_x[], const float position_y[],
                     const Font& font, const Paint& paint) override;
@@ -92,7 +104,14 @@ class RecordPlayback : public Canvas {
   bool ParseStream(ReadStream& stream, TypefaceSet* typeface_set,
                    int32_t recursion_limit);
 
-  void FlattenToBuffer(BinaryWriteBuffer& buffer);
+  /**
+   * Flatten paints, paths, text blobs and images one at a time, flushing
+   * `buffer` into `stream` after each of them. A null `stream` only measures
+   * the section and collects the factories and typefaces it references.
+   *
+   * @return size in bytes of the flattened data section
+   */
+  size_t FlattenToBuffer(BinaryWriteBuffer& buffer, WriteStream* stream);
 
   void WriteFactories(WriteStream& stream, const FactorySet& factory_set);
   void WriteTypefaces(WriteStream& stream, const TypefaceSet& typeface_set);
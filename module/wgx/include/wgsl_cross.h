@@ -261,6 +261,36 @@ struct WGX_API Result {
   operator bool() const { return success; }
 };
 
+/**
+ * Serialize a successful translation result, including the reflection of its
+ * bind groups, so it can be cached and restored without the WGSL source.
+ *
+ * @param result The result returned by Program::WriteToGlsl or WriteToMsl.
+ *
+ * @return The serialized data, or an empty string if the result is not
+ *         successful.
+ */
+WGX_API std::string SerializeResult(const Result& result);
+
+/**
+ * Restore a result written by SerializeResult.
+ *
+ * @param data The serialized data.
+ *
+ * @return The restored result. Result::success is false if the data is
+ *         malformed.
+ */
+WGX_API Result DeserializeResult(std::string_view data);
+
+/**
+ * Identify the translator of this build. The same input may translate
+ * differently with another build, so results cached across runs must be keyed
+ * by it as well.
+ *
+ * @return A hash of the translator sources, stable for a given build.
+ */
+WGX_API const char* GetTranslatorVersion();
+
 struct WGX_API Diagnosis {
   std::string message = {};
 
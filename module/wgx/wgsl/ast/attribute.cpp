@@ -40,10 +40,10 @@ namespace ast {
 
 void Attribute::Accept(AstVisitor* visitor) { visitor->Visit(this); }
 
-NamedAttribute::NamedAttribute(std::string name, AttributeType type)
-    : name_(std::move(name)), type_(type) {}
+NamedAttribute::NamedAttribute(std::string_view name, AttributeType type)
+    : name_(name), type_(type) {}
 
-std::string NamedAttribute::GetName() const { return name_; }
+std::string NamedAttribute::GetName() const { return std::string(name_); }
 
 AttributeType NamedAttribute::GetType() const { return type_; }
 
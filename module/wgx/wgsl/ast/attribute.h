@@ -87,9 +87,11 @@ struct Attribute : public Node {
  * For example:
  *   `@vertex`
  *   `@fragment`
+ *
+ * The name is not copied, it must outlive the attribute.
  */
 struct NamedAttribute : public Attribute {
-  NamedAttribute(std::string name, AttributeType type);
+  NamedAttribute(std::string_view name, AttributeType type);
 
   ~NamedAttribute() override = default;
 
@@ -98,7 +100,7 @@ struct NamedAttribute : public Attribute {
   AttributeType GetType() const override;
 
  private:
-  std::string name_;
+  std::string_view name_;
   AttributeType type_;
 };
 
@@ -0,0 +1,43 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "wgsl/ast/node.h"
+
+#include <algorithm>
+
+namespace wgx {
+namespace ast {
+
+NodeAllocator::~NodeAllocator() {
+  // nodes only point to nodes allocated before them, destroy in reverse order
+  for (auto it = nodes_.rbegin(); it != nodes_.rend(); ++it) {
+    (*it)->~Node();
+  }
+}
+
+void* NodeAllocator::AllocateBytes(size_t size, size_t alignment) {
+  auto address = reinterpret_cast<uintptr_t>(cursor_);
+  auto aligned = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+
+  if (cursor_ == nullptr ||
+      aligned + size > reinterpret_cast<uintptr_t>(end_)) {
+    // nodes are tiny, but never fail on a large one
+    size_t block_size = std::max(kBlockSize, size + alignment);
+
+    blocks_.emplace_back(new uint8_t[block_size]);
+
+    cursor_ = blocks_.back().get();
+    end_ = cursor_ + block_size;
+
+    address = reinterpret_cast<uintptr_t>(cursor_);
+    aligned = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+  }
+
+  cursor_ += (aligned - address) + size;
+
+  return reinterpret_cast<void*>(aligned);
+}
+
+}  // namespace ast
+}  // namespace wgx
@@ -33,7 +33,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace wgx {
@@ -47,21 +52,51 @@ struct Node {
   virtual void Accept(AstVisitor* visitor) = 0;
 };
 
+/**
+ * Bump allocator owning all nodes of one AST.
+ *
+ * Nodes are placement constructed into large blocks instead of being
+ * allocated one by one, and the whole tree is released together with the
+ * allocator. Destructors still run, in reverse order of allocation, since
+ * nodes may own containers.
+ */
 class NodeAllocator final {
  public:
   NodeAllocator() = default;
-  ~NodeAllocator() = default;
+  ~NodeAllocator();
+
+  NodeAllocator(const NodeAllocator&) = delete;
+  NodeAllocator& operator=(const NodeAllocator&) = delete;
 
   template <class T, class... Args>
   T* Allocate(Args&&... args) {
-    nodes_.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+    static_assert(std::is_base_of<Node, T>::value,
+                  "NodeAllocator can only allocate ast::Node");
+
+    void* memory = AllocateBytes(sizeof(T), alignof(T));
+
+    T* node = new (memory) T(std::forward<Args>(args)...);
 
-    return static_cast<T*>(nodes_.back().get());
+    nodes_.emplace_back(node);
+
+    return node;
   }
 
+  size_t GetNodeCount() const { return nodes_.size(); }
+
+  size_t GetBlockCount() const { return blocks_.size(); }
+
+ private:
+  void* AllocateBytes(size_t size, size_t alignment);
+
  private:
-  std::vector<std::unique_ptr<Node>> nodes_ = {};
+  static constexpr size_t kBlockSize = 16 * 1024;
+
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_ = {};
+  uint8_t* cursor_ = nullptr;
+  uint8_t* end_ = nullptr;
+  std::vector<Node*> nodes_ = {};
 };
 
 }  // namespace ast
-}  // namespace wgx
\ No newline at end of file
+}  // namespace wgx
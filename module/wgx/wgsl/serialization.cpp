@@ -0,0 +1,446 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <wgsl_cross.h>
+
+#include <cstring>
+
+#include "wgsl/type_definition.h"
+
+// set by the build from the translator sources
+#ifndef WGX_SOURCE_HASH
+#define WGX_SOURCE_HASH "unknown"
+#endif
+
+namespace wgx {
+
+namespace {
+
+enum class TypeTag : uint8_t {
+  kPrimitive = 0,
+  kArray = 1,
+  kStruct = 2,
+};
+
+// Arrays and structs can nest, but shaders never go deep or wide. These only
+// protect against corrupted data.
+constexpr uint32_t kMaxTypeDepth = 16;
+constexpr uint32_t kMaxArrayCount = 1 << 16;
+
+class Writer {
+ public:
+  explicit Writer(std::string& out) : out_(out) {}
+
+  void WriteU8(uint8_t value) { out_.push_back(static_cast<char>(value)); }
+
+  void WriteU32(uint32_t value) {
+    char bytes[4];
+    std::memcpy(bytes, &value, sizeof(value));
+    out_.append(bytes, sizeof(bytes));
+  }
+
+  void WriteString(std::string_view value) {
+    WriteU32(static_cast<uint32_t>(value.size()));
+    out_.append(value.data(), value.size());
+  }
+
+ private:
+  std::string& out_;
+};
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  bool ReadU8(uint8_t& value) {
+    if (data_.size() < 1) {
+      return false;
+    }
+
+    value = static_cast<uint8_t>(data_[0]);
+    data_.remove_prefix(1);
+    return true;
+  }
+
+  bool ReadU32(uint32_t& value) {
+    if (data_.size() < sizeof(value)) {
+      return false;
+    }
+
+    std::memcpy(&value, data_.data(), sizeof(value));
+    data_.remove_prefix(sizeof(value));
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint32_t size = 0;
+    if (!ReadU32(size) || data_.size() < size) {
+      return false;
+    }
+
+    value.assign(data_.data(), size);
+    data_.remove_prefix(size);
+    return true;
+  }
+
+  bool IsEnd() const { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+std::unique_ptr<TypeDefinition> CreatePrimitive(std::string_view name,
+                                                size_t size) {
+  if (name == F32::NAME) {
+    return std::make_unique<F32>();
+  } else if (name == F16::NAME) {
+    return std::make_unique<F16>();
+  } else if (name == I32::NAME) {
+    return std::make_unique<I32>();
+  } else if (name == U32::NAME) {
+    return std::make_unique<U32>();
+  } else if (name == Bool::NAME) {
+    return std::make_unique<Bool>();
+  } else if (name == Vec2F32::NAME) {
+    return std::make_unique<Vec2F32>();
+  } else if (name == "vec2<i32>") {
+    return std::make_unique<Vec2I32>();
+  } else if (name == "vec2<u32>") {
+    return std::make_unique<Vec2U32>();
+  } else if (name == "vec3<f32>") {
+    // the MSL layout pads vec3 to the size of vec4
+    if (size == 16) {
+      return std::make_unique<Vec3F32MSL>();
+    }
+    return std::make_unique<Vec3F32>();
+  } else if (name == "vec3<i32>") {
+    if (size == 16) {
+      return std::make_unique<Vec3I32MSL>();
+    }
+    return std::make_unique<Vec3I32>();
+  } else if (name == "vec3<u32>") {
+    if (size == 16) {
+      return std::make_unique<Vec3U32MSL>();
+    }
+    return std::make_unique<Vec3U32>();
+  } else if (name == "vec4<f32>") {
+    return std::make_unique<Vec4F32>();
+  } else if (name == "vec4<i32>") {
+    return std::make_unique<Vec4I32>();
+  } else if (name == "vec4<u32>") {
+    return std::make_unique<Vec4U32>();
+  } else if (name == "mat2x2<f32>") {
+    return std::make_unique<Mat2x2F32>();
+  } else if (name == "mat3x3<f32>") {
+    return std::make_unique<Mat3x3F32>();
+  } else if (name == "mat4x4<f32>") {
+    return std::make_unique<Mat4x4F32>();
+  }
+
+  return {};
+}
+
+std::unique_ptr<TypeDefinition> CloneTypeDefinition(
+    const TypeDefinition* type) {
+  std::unique_ptr<TypeDefinition> clone;
+
+  if (type->IsArray()) {
+    auto array =
+        const_cast<ArrayDefinition*>(static_cast<const ArrayDefinition*>(type));
+    std::vector<std::unique_ptr<TypeDefinition>> elements{array->count};
+    for (size_t i = 0; i < array->count; i++) {
+      elements[i] = CloneTypeDefinition(array->GetElementAt(i));
+      if (!elements[i]) {
+        return {};
+      }
+    }
+
+    MemoryLayout layout = array->alignment != elements[0]->alignment
+                              ? MemoryLayout::kStd140
+                              : MemoryLayout::kStd430;
+
+    clone = std::make_unique<CommonArray>(std::move(elements), layout);
+  } else if (type->IsStruct()) {
+    auto st = static_cast<const StructDefinition*>(type);
+    std::vector<Field*> members{};
+    for (auto* member : st->members) {
+      auto member_type = CloneTypeDefinition(member->type);
+      if (!member_type) {
+        for (auto* field : members) {
+          delete field;
+        }
+        return {};
+      }
+
+      members.push_back(new Field{member->name, member_type.release()});
+    }
+
+    clone = std::make_unique<StructDefinition>(st->name, std::move(members));
+  } else {
+    clone = CreatePrimitive(type->name, type->size);
+  }
+
+  if (clone) {
+    clone->alignment = type->alignment;
+  }
+
+  return clone;
+}
+
+void WriteTypeDefinition(Writer& writer, const TypeDefinition* type) {
+  if (type->IsArray()) {
+    auto array = static_cast<const ArrayDefinition*>(type);
+    writer.WriteU8(static_cast<uint8_t>(TypeTag::kArray));
+    writer.WriteU32(static_cast<uint32_t>(array->count));
+    writer.WriteU32(static_cast<uint32_t>(array->alignment));
+    // all elements share the same type
+    WriteTypeDefinition(
+        writer, const_cast<ArrayDefinition*>(array)->GetElementAt(0));
+  } else if (type->IsStruct()) {
+    auto st = static_cast<const StructDefinition*>(type);
+    writer.WriteU8(static_cast<uint8_t>(TypeTag::kStruct));
+    writer.WriteString(st->name);
+    writer.WriteU32(static_cast<uint32_t>(st->members.size()));
+    for (auto* member : st->members) {
+      writer.WriteString(member->name);
+      WriteTypeDefinition(writer, member->type);
+    }
+  } else {
+    writer.WriteU8(static_cast<uint8_t>(TypeTag::kPrimitive));
+    writer.WriteString(type->name);
+    writer.WriteU32(static_cast<uint32_t>(type->size));
+  }
+
+  // may be changed by an @align attribute
+  writer.WriteU32(static_cast<uint32_t>(type->alignment));
+}
+
+std::unique_ptr<TypeDefinition> ReadTypeDefinition(Reader& reader,
+                                                   uint32_t depth) {
+  uint8_t tag = 0;
+  if (depth > kMaxTypeDepth || !reader.ReadU8(tag)) {
+    return {};
+  }
+
+  std::unique_ptr<TypeDefinition> type;
+
+  if (tag == static_cast<uint8_t>(TypeTag::kArray)) {
+    uint32_t count = 0;
+    uint32_t alignment = 0;
+    if (!reader.ReadU32(count) || !reader.ReadU32(alignment) || count == 0 ||
+        count > kMaxArrayCount) {
+      return {};
+    }
+
+    // the element type is only written once, copy it for the other elements
+    std::vector<std::unique_ptr<TypeDefinition>> elements{count};
+    elements[0] = ReadTypeDefinition(reader, depth + 1);
+    if (!elements[0]) {
+      return {};
+    }
+    for (uint32_t i = 1; i < count; i++) {
+      elements[i] = CloneTypeDefinition(elements[0].get());
+      if (!elements[i]) {
+        return {};
+      }
+    }
+
+    // std140 is the only layout rounding the array alignment up to 16 bytes
+    MemoryLayout layout = alignment != elements[0]->alignment
+                              ? MemoryLayout::kStd140
+                              : MemoryLayout::kStd430;
+
+    type = std::make_unique<CommonArray>(std::move(elements), layout);
+  } else if (tag == static_cast<uint8_t>(TypeTag::kStruct)) {
+    std::string name;
+    uint32_t member_count = 0;
+    if (!reader.ReadString(name) || !reader.ReadU32(member_count)) {
+      return {};
+    }
+
+    std::vector<Field*> members{};
+    bool success = true;
+    for (uint32_t i = 0; i < member_count; i++) {
+      std::string member_name;
+      if (!reader.ReadString(member_name)) {
+        success = false;
+        break;
+      }
+
+      auto member_type = ReadTypeDefinition(reader, depth + 1);
+      if (!member_type) {
+        success = false;
+        break;
+      }
+
+      members.push_back(new Field{member_name, member_type.release()});
+    }
+
+    if (!success || members.empty()) {
+      for (auto* member : members) {
+        delete member;
+      }
+      return {};
+    }
+
+    type = std::make_unique<StructDefinition>(name, std::move(members));
+  } else if (tag == static_cast<uint8_t>(TypeTag::kPrimitive)) {
+    std::string name;
+    uint32_t size = 0;
+    if (!reader.ReadString(name) || !reader.ReadU32(size)) {
+      return {};
+    }
+
+    type = CreatePrimitive(name, size);
+  }
+
+  uint32_t alignment = 0;
+  if (!type || !reader.ReadU32(alignment)) {
+    return {};
+  }
+
+  type->alignment = alignment;
+
+  return type;
+}
+
+}  // namespace
+
+std::string SerializeResult(const Result& result) {
+  std::string out;
+
+  if (!result.success) {
+    return out;
+  }
+
+  Writer writer{out};
+
+  writer.WriteString(result.content);
+
+  writer.WriteU32(result.context.last_ubo_binding);
+  writer.WriteU32(result.context.last_texture_binding);
+  writer.WriteU32(result.context.last_sampler_binding);
+
+  writer.WriteU32(static_cast<uint32_t>(result.bind_groups.size()));
+  for (const auto& group : result.bind_groups) {
+    writer.WriteU32(group.group);
+    writer.WriteU32(static_cast<uint32_t>(group.entries.size()));
+
+    for (const auto& entry : group.entries) {
+      writer.WriteU8(static_cast<uint8_t>(entry.type));
+      writer.WriteU32(entry.binding);
+      writer.WriteString(entry.name);
+      writer.WriteU32(entry.index);
+      writer.WriteU32(static_cast<uint32_t>(entry.stage));
+
+      writer.WriteU8(entry.units.has_value() ? 1 : 0);
+      if (entry.units.has_value()) {
+        writer.WriteU32(static_cast<uint32_t>(entry.units->size()));
+        for (uint32_t unit : *entry.units) {
+          writer.WriteU32(unit);
+        }
+      }
+
+      writer.WriteU8(entry.type_definition ? 1 : 0);
+      if (entry.type_definition) {
+        WriteTypeDefinition(writer, entry.type_definition.get());
+      }
+    }
+  }
+
+  return out;
+}
+
+const char* GetTranslatorVersion() { return WGX_SOURCE_HASH; }
+
+Result DeserializeResult(std::string_view data) {
+  Reader reader{data};
+
+  std::string content;
+  CompilerContext context{};
+  uint32_t group_count = 0;
+
+  if (!reader.ReadString(content) ||
+      !reader.ReadU32(context.last_ubo_binding) ||
+      !reader.ReadU32(context.last_texture_binding) ||
+      !reader.ReadU32(context.last_sampler_binding) ||
+      !reader.ReadU32(group_count)) {
+    return {};
+  }
+
+  std::vector<BindGroup> groups{};
+
+  for (uint32_t i = 0; i < group_count; i++) {
+    BindGroup group{};
+    uint32_t entry_count = 0;
+
+    if (!reader.ReadU32(group.group) || !reader.ReadU32(entry_count)) {
+      return {};
+    }
+
+    for (uint32_t j = 0; j < entry_count; j++) {
+      BindGroupEntry entry{};
+      uint8_t type = 0;
+      uint32_t stage = 0;
+      uint8_t has_units = 0;
+      uint8_t has_type_definition = 0;
+
+      if (!reader.ReadU8(type) || !reader.ReadU32(entry.binding) ||
+          !reader.ReadString(entry.name) || !reader.ReadU32(entry.index) ||
+          !reader.ReadU32(stage) || !reader.ReadU8(has_units)) {
+        return {};
+      }
+
+      if (type > static_cast<uint8_t>(BindingType::kSampler)) {
+        return {};
+      }
+
+      entry.type = static_cast<BindingType>(type);
+      entry.stage = static_cast<ShaderStage>(stage);
+
+      if (has_units) {
+        uint32_t unit_count = 0;
+        if (!reader.ReadU32(unit_count)) {
+          return {};
+        }
+
+        std::vector<uint32_t> units{};
+        for (uint32_t k = 0; k < unit_count; k++) {
+          uint32_t unit = 0;
+          if (!reader.ReadU32(unit)) {
+            return {};
+          }
+          units.push_back(unit);
+        }
+
+        entry.units = std::move(units);
+      }
+
+      if (!reader.ReadU8(has_type_definition)) {
+        return {};
+      }
+
+      if (has_type_definition) {
+        auto type_definition = ReadTypeDefinition(reader, 0);
+        if (!type_definition) {
+          return {};
+        }
+
+        entry.type_definition = std::move(type_definition);
+      }
+
+      group.entries.emplace_back(std::move(entry));
+    }
+
+    groups.emplace_back(std::move(group));
+  }
+
+  if (!reader.IsEnd()) {
+    return {};
+  }
+
+  return {std::move(content), std::move(groups), context};
+}
+
+}  // namespace wgx
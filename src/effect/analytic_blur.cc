@@ -0,0 +1,61 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/effect/analytic_blur.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <skity/effect/mask_filter.hpp>
+
+#include "src/effect/image_filter_base.hpp"
+#include "src/geometry/math.hpp"
+
+namespace skity {
+
+std::optional<AnalyticBlurRRect> AnalyticBlurRRect::Make(const RRect& rrect,
+                                                         const Paint& paint,
+                                                         float scale) {
+  auto mask_filter = paint.GetMaskFilter();
+  if (mask_filter == nullptr ||
+      mask_filter->GetBlurStyle() != BlurStyle::kNormal) {
+    return std::nullopt;
+  }
+
+  // the color filter and the blend mode apply to the blurred result
+  if (paint.GetStyle() != Paint::kFill_Style || paint.GetShader() ||
+      paint.GetImageFilter() || paint.GetPathEffect() ||
+      paint.GetColorFilter() || paint.GetBlendMode() != BlendMode::kSrcOver) {
+    return std::nullopt;
+  }
+
+  if (rrect.IsEmpty() || !(scale > 0.f) || !std::isfinite(scale)) {
+    return std::nullopt;
+  }
+
+  const Rect& rect = rrect.GetRect();
+  float corner_radius = 0.f;
+  if (rrect.IsSimple() || rrect.IsOval()) {
+    Vec2 radii = rrect.GetSimpleRadii();
+    if (!FloatNearlyZero(radii.x - radii.y)) {
+      return std::nullopt;
+    }
+    corner_radius = std::min(radii.x, radii.y);
+  } else if (!rrect.IsRect()) {
+    return std::nullopt;
+  }
+
+  float sigma =
+      ConvertRadiusToSigma(mask_filter->GetBlurRadius() * scale) / scale;
+  if (!(sigma > 0.f) || !std::isfinite(sigma) || !rect.IsFinite()) {
+    return std::nullopt;
+  }
+
+  return AnalyticBlurRRect(rect, corner_radius, sigma);
+}
+
+Rect AnalyticBlurRRect::GetBounds() const {
+  return rect_.MakeOutset(3.f * sigma_, 3.f * sigma_);
+}
+
+}  // namespace skity
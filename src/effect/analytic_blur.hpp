@@ -0,0 +1,69 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_EFFECT_ANALYTIC_BLUR_HPP
+#define SRC_EFFECT_ANALYTIC_BLUR_HPP
+
+#include <optional>
+#include <skity/geometry/rect.hpp>
+#include <skity/geometry/rrect.hpp>
+#include <skity/graphic/paint.hpp>
+
+namespace skity {
+
+/**
+ * A filled rect or rrect with circular corners blurred by a normal style blur
+ * mask filter.
+ *
+ * The blurred coverage is the integral of a Gaussian over the shape, which has
+ * a closed form for a rect and is integrated with a few samples along y for
+ * the rounded corners, see
+ * https://madebyevan.com/shaders/fast-rounded-rectangle-shadows/
+ * The HW renderer evaluates it per pixel instead of rendering the shape into
+ * an offscreen target and blurring it. The SW renderer keeps the stack blur
+ * for every shape, so a rect blurs the same as the path of the rect.
+ */
+class AnalyticBlurRRect {
+ public:
+  /**
+   * Checks whether the paint and the shape can be blurred analytically.
+   *
+   * @param scale  uniform scale from the local space to the device space, the
+   *               blur radius is converted to a sigma in device pixels like
+   *               the blur filters do, then back to the local space
+   * @return       std::nullopt if the draw needs the generic blur
+   */
+  static std::optional<AnalyticBlurRRect> Make(const RRect& rrect,
+                                               const Paint& paint,
+                                               float scale = 1.f);
+
+  static std::optional<AnalyticBlurRRect> Make(const Rect& rect,
+                                               const Paint& paint,
+                                               float scale = 1.f) {
+    return Make(RRect::MakeRect(rect), paint, scale);
+  }
+
+  const Rect& GetRect() const { return rect_; }
+
+  float GetCornerRadius() const { return corner_radius_; }
+
+  float GetSigma() const { return sigma_; }
+
+  /**
+   * The rect outset by three sigma, where the coverage becomes negligible.
+   */
+  Rect GetBounds() const;
+
+ private:
+  AnalyticBlurRRect(const Rect& rect, float corner_radius, float sigma)
+      : rect_(rect), corner_radius_(corner_radius), sigma_(sigma) {}
+
+  Rect rect_;
+  float corner_radius_;
+  float sigma_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_EFFECT_ANALYTIC_BLUR_HPP
@@ -2,6 +2,7 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <cstring>
 #include <skity/io/pixmap.hpp>
 
@@ -10,6 +11,14 @@
 #include "src/graphic/color_priv.hpp"
 #include "src/logging.hpp"
 
+#ifdef SKITY_CPU
+#if defined(SKITY_ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#endif
+
 namespace skity {
 
 namespace {
@@ -51,6 +60,129 @@ struct ColorSpaceHeader {
   uint8_t reserved2 = 0;
 };
 
+#ifdef SKITY_CPU
+
+// The four channels of a color in the byte order of a PMColor in memory:
+// b, g, r, a.
+#if defined(SKITY_ARM_NEON)
+
+using Float4 = float32x4_t;
+
+inline Float4 Splat(float v) { return vdupq_n_f32(v); }
+
+inline Float4 Load(const float v[4]) { return vld1q_f32(v); }
+
+inline Float4 Set(float b, float g, float r, float a) {
+  const float v[4] = {b, g, r, a};
+  return vld1q_f32(v);
+}
+
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+  return vmlaq_f32(c, a, b);
+}
+
+inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+inline Float4 Clamp01(Float4 v) {
+  return vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.f)), vdupq_n_f32(1.f));
+}
+
+inline float GetAlpha(Float4 v) { return vgetq_lane_f32(v, 3); }
+
+// v in [0, 255]
+inline uint32_t StoreColor(Float4 v) {
+  uint32x4_t u32 = vcvtq_u32_f32(vaddq_f32(v, vdupq_n_f32(0.5f)));
+  uint16x4_t u16 = vmovn_u32(u32);
+  uint8x8_t u8 = vmovn_u16(vcombine_u16(u16, u16));
+  return vget_lane_u32(vreinterpret_u32_u8(u8), 0);
+}
+
+#elif defined(__SSE2__)
+
+using Float4 = __m128;
+
+inline Float4 Splat(float v) { return _mm_set1_ps(v); }
+
+inline Float4 Load(const float v[4]) { return _mm_loadu_ps(v); }
+
+inline Float4 Set(float b, float g, float r, float a) {
+  return _mm_setr_ps(b, g, r, a);
+}
+
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+inline Float4 Clamp01(Float4 v) {
+  return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+}
+
+inline float GetAlpha(Float4 v) {
+  return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+// v in [0, 255], rounds half up like the other paths, _mm_cvtps_epi32 would
+// round half to even
+inline uint32_t StoreColor(Float4 v) {
+  __m128i i32 = _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f)));
+  __m128i i16 = _mm_packs_epi32(i32, i32);
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(i16, i16)));
+}
+
+#else
+
+struct Float4 {
+  float v[4];
+};
+
+inline Float4 Splat(float v) { return Float4{{v, v, v, v}}; }
+
+inline Float4 Load(const float v[4]) {
+  return Float4{{v[0], v[1], v[2], v[3]}};
+}
+
+inline Float4 Set(float b, float g, float r, float a) {
+  return Float4{{b, g, r, a}};
+}
+
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+  for (int i = 0; i < 4; i++) {
+    c.v[i] += a.v[i] * b.v[i];
+  }
+  return c;
+}
+
+inline Float4 Mul(Float4 a, Float4 b) {
+  for (int i = 0; i < 4; i++) {
+    a.v[i] *= b.v[i];
+  }
+  return a;
+}
+
+inline Float4 Clamp01(Float4 v) {
+  for (int i = 0; i < 4; i++) {
+    v.v[i] = std::clamp(v.v[i], 0.f, 1.f);
+  }
+  return v;
+}
+
+inline float GetAlpha(Float4 v) { return v.v[3]; }
+
+// v in [0, 255]
+inline uint32_t StoreColor(Float4 v) {
+  uint32_t c = 0;
+  for (int i = 0; i < 4; i++) {
+    c |= static_cast<uint32_t>(v.v[i] + 0.5f) << (i * 8);
+  }
+  return c;
+}
+
+#endif
+
+#endif
+
 }  // namespace
 
 PMColor ColorFilter::FilterColor(PMColor c) const {
@@ -108,21 +240,67 @@ std::shared_ptr<ColorFilter> ColorFilters::Compose(
 BlendColorFilter::BlendColorFilter(Color c, BlendMode m)
     : color_(c), pm_color_(ColorToPMColor(c)), mode_(m) {}
 
+void MatrixColorFilter::Concat(float result[20],
+                               const MatrixColorFilter& outer,
+                               const MatrixColorFilter& inner) {
+  const float* a = outer.matrix_;
+  const float* b = inner.matrix_;
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) {
+      float value = j == 4 ? a[i * 5 + 4] : 0.f;
+      for (int k = 0; k < 4; k++) {
+        value += a[i * 5 + k] * b[k * 5 + j];
+      }
+      result[i * 5 + j] = value;
+    }
+  }
+}
+
 #ifdef SKITY_CPU
 
 PMColor MatrixColorFilter::OnFilterColor(PMColor src_pm) const {
-  Color src = PMColorToColor(src_pm);
-  int32_t src_u32[4] = {int32_t(ColorGetR(src)), int32_t(ColorGetG(src)),
-                        int32_t(ColorGetB(src)), int32_t(ColorGetA(src))};
-  uint8_t dst_u8[4];
-  for (size_t i = 0; i < 4; ++i) {
-    int32_t mul_u32 =
-        src_u32[0] * matrix_i16_[i][0] + src_u32[1] * matrix_i16_[i][1] +
-        src_u32[2] * matrix_i16_[i][2] + src_u32[3] * matrix_i16_[i][3];
-    dst_u8[i] = std::clamp(mul_u32 / 255 + matrix_i16_[i][4], 0, 255);
+  OnFilterColors(&src_pm, 1);
+  return src_pm;
+}
+
+void MatrixColorFilter::OnFilterColors(PMColor* colors, size_t count) const {
+  const Float4 r_column = Load(columns_[0]);
+  const Float4 g_column = Load(columns_[1]);
+  const Float4 b_column = Load(columns_[2]);
+  const Float4 a_column = Load(columns_[3]);
+  const Float4 translate = Load(columns_[4]);
+
+  PMColor last_src = 0;
+  PMColor last_dst = 0;
+  bool has_last = false;
+
+  for (size_t i = 0; i < count; i++) {
+    PMColor src = colors[i];
+    // runs of the same color are common in solid and image spans
+    if (has_last && src == last_src) {
+      colors[i] = last_dst;
+      continue;
+    }
+
+    uint32_t a = ColorGetA(src);
+    float unpremul = a == 0 ? 0.f : 1.f / static_cast<float>(a);
+
+    Float4 dst = translate;
+    dst = MulAdd(r_column, Splat(ColorGetR(src) * unpremul), dst);
+    dst = MulAdd(g_column, Splat(ColorGetG(src) * unpremul), dst);
+    dst = MulAdd(b_column, Splat(ColorGetB(src) * unpremul), dst);
+    dst = MulAdd(a_column, Splat(a * (1.f / 255.f)), dst);
+    dst = Clamp01(dst);
+
+    float dst_a = GetAlpha(dst) * 255.f;
+    Float4 premul = Mul(dst, Set(dst_a, dst_a, dst_a, 255.f));
+
+    last_src = src;
+    last_dst = StoreColor(premul);
+    has_last = true;
+    colors[i] = last_dst;
   }
-  return ColorToPMColor(
-      ColorSetARGB(dst_u8[3], dst_u8[0], dst_u8[1], dst_u8[2]));
 }
 
 static constexpr uint8_t linear_to_srgb_table[256] = {
@@ -166,24 +344,78 @@ static constexpr uint8_t srgb_to_linear_table[256] = {
     255};
 
 PMColor SRGBGammaColorFilter::OnFilterColor(PMColor src_pm) const {
-  Color src = PMColorToColor(src_pm);
+  OnFilterColors(&src_pm, 1);
+  return src_pm;
+}
+
+void SRGBGammaColorFilter::OnFilterColors(PMColor* colors,
+                                          size_t count) const {
   auto* table = type_ == ColorFilterType::kLinearToSRGBGamma
                     ? linear_to_srgb_table
                     : srgb_to_linear_table;
-  return ColorToPMColor(ColorSetARGB(ColorGetA(src), table[ColorGetR(src)],
-                                     table[ColorGetG(src)],
-                                     table[ColorGetB(src)]));
+
+  for (size_t i = 0; i < count; i++) {
+    PMColor src = colors[i];
+    uint32_t a = ColorGetA(src);
+
+    // opaque colors need no unpremultiply
+    if (a == 255) {
+      colors[i] = ColorSetARGB(255, table[ColorGetR(src)],
+                               table[ColorGetG(src)], table[ColorGetB(src)]);
+      continue;
+    }
+
+    Color color = PMColorToColor(src);
+    colors[i] = ColorToPMColor(ColorSetARGB(a, table[ColorGetR(color)],
+                                            table[ColorGetG(color)],
+                                            table[ColorGetB(color)]));
+  }
 }
 
 PMColor BlendColorFilter::OnFilterColor(PMColor src) const {
   return PorterDuffBlend(pm_color_, src, mode_);
 }
 
+void BlendColorFilter::OnFilterColors(PMColor* colors, size_t count) const {
+  for (size_t i = 0; i < count; i++) {
+    colors[i] = PorterDuffBlend(pm_color_, colors[i], mode_);
+  }
+}
+
 PMColor ComposeColorFilter::OnFilterColor(PMColor src) const {
-  // TODO(zhangzhijian): Fix it.
+  for (auto stage : stages_) {
+    src = stage->OnFilterColor(src);
+  }
   return src;
 }
 
+void ComposeColorFilter::OnFilterColors(PMColor* colors, size_t count) const {
+  for (auto stage : stages_) {
+    stage->OnFilterColors(colors, count);
+  }
+}
+
+void ComposeColorFilter::ComputeStages() {
+  for (auto filter : filters_) {
+    auto stage = As_CFB(filter);
+
+    if (stage->GetType() == ColorFilterType::kMatrix && !stages_.empty() &&
+        stages_.back()->GetType() == ColorFilterType::kMatrix) {
+      float matrix[20];
+      MatrixColorFilter::Concat(
+          matrix, *static_cast<const MatrixColorFilter*>(stage),
+          *static_cast<const MatrixColorFilter*>(stages_.back()));
+
+      folded_matrices_.emplace_back(
+          std::make_unique<MatrixColorFilter>(matrix));
+      stages_.back() = folded_matrices_.back().get();
+      continue;
+    }
+
+    stages_.emplace_back(stage);
+  }
+}
+
 #endif
 
 std::string_view BlendColorFilter::ProcName() const {
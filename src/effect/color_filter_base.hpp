@@ -30,6 +30,16 @@ class ColorFilterBase : public ColorFilter {
  public:
 #ifdef SKITY_CPU
   virtual PMColor OnFilterColor(PMColor c) const { return c; }
+
+  /**
+   * Filters a span of premultiplied colors in place. Filters override it to
+   * avoid a virtual call and the setup of their kernel per pixel.
+   */
+  virtual void OnFilterColors(PMColor* colors, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+      colors[i] = OnFilterColor(colors[i]);
+    }
+  }
 #endif
 
   virtual ~ColorFilterBase() = default;
@@ -54,6 +64,8 @@ class BlendColorFilter : public ColorFilterBase {
  public:
 #ifdef SKITY_CPU
   PMColor OnFilterColor(PMColor c) const override;
+
+  void OnFilterColors(PMColor* colors, size_t count) const override;
 #endif
   BlendColorFilter(Color c, BlendMode m);
 
@@ -76,19 +88,31 @@ class MatrixColorFilter : public ColorFilterBase {
  public:
 #ifdef SKITY_CPU
   PMColor OnFilterColor(PMColor c) const override;
+
+  void OnFilterColors(PMColor* colors, size_t count) const override;
 #endif
 
   explicit MatrixColorFilter(const float row_major[20]) {
     memcpy(matrix_, row_major, 20 * sizeof(float));
 
 #ifdef SKITY_CPU
-    auto p = reinterpret_cast<int16_t*>(matrix_i16_);
-    for (int i = 0; i < 20; i++) {
-      p[i] = (int16_t)(row_major[i] * 255);
+    // one column per input channel and the translation, each holding the
+    // outputs in the byte order of a PMColor in memory: b, g, r, a
+    for (int i = 0; i < 5; i++) {
+      columns_[i][0] = row_major[10 + i];
+      columns_[i][1] = row_major[5 + i];
+      columns_[i][2] = row_major[i];
+      columns_[i][3] = row_major[15 + i];
     }
 #endif
   }
-  explicit MatrixColorFilter(const int16_t row_major[20]) {}
+
+  /**
+   * The row major matrix of `outer` applied to the result of `inner`, without
+   * clamping the intermediate color.
+   */
+  static void Concat(float result[20], const MatrixColorFilter& outer,
+                     const MatrixColorFilter& inner);
 
   std::tuple<Matrix, Vec4> GetMatrix() {
     auto& m = matrix_;
@@ -112,7 +136,7 @@ class MatrixColorFilter : public ColorFilterBase {
  private:
   float matrix_[20];
 #ifdef SKITY_CPU
-  int16_t matrix_i16_[4][5];
+  float columns_[5][4];
 #endif
 };
 
@@ -121,6 +145,8 @@ class SRGBGammaColorFilter : public ColorFilterBase {
   explicit SRGBGammaColorFilter(ColorFilterType type) : type_(type) {}
 #ifdef SKITY_CPU
   PMColor OnFilterColor(PMColor c) const override;
+
+  void OnFilterColors(PMColor* colors, size_t count) const override;
 #endif
   ColorFilterType GetType() const override { return type_; }
 
@@ -136,12 +162,17 @@ class ComposeColorFilter : public ColorFilterBase {
  public:
 #ifdef SKITY_CPU
   PMColor OnFilterColor(PMColor c) const override;
+
+  void OnFilterColors(PMColor* colors, size_t count) const override;
 #endif
 
   ComposeColorFilter(std::shared_ptr<ColorFilter> outer,
                      std::shared_ptr<ColorFilter> inner)
       : outer_(outer), inner_(inner) {
     ComputeFilters();
+#ifdef SKITY_CPU
+    ComputeStages();
+#endif
   }
 
   ColorFilterType GetType() const override { return ColorFilterType::kCompose; }
@@ -183,9 +214,19 @@ class ComposeColorFilter : public ColorFilterBase {
     }
   }
 
+#ifdef SKITY_CPU
+  // folds the consecutive matrix filters into one
+  void ComputeStages();
+#endif
+
   std::shared_ptr<ColorFilter> outer_;
   std::shared_ptr<ColorFilter> inner_;
   std::vector<ColorFilter*> filters_;
+#ifdef SKITY_CPU
+  // the filters applied on CPU, from the innermost one
+  std::vector<const ColorFilterBase*> stages_;
+  std::vector<std::unique_ptr<MatrixColorFilter>> folded_matrices_;
+#endif
 };
 
 }  // namespace skity
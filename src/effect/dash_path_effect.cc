@@ -15,6 +15,8 @@
 
 #include "src/geometry/math.hpp"
 #include "src/geometry/point_priv.hpp"
+#include "src/geometry/stroke_priv.hpp"
+#include "src/graphic/contour_measure.hpp"
 
 namespace skity {
 
@@ -41,45 +43,43 @@ static float find_first_interval(const float intervals[], float phase,
   return intervals[0];
 }
 
-class SpecialLineRec final {
+// Appends the dashes to a path, which is what FilterPath() returns.
+class PathDashSink final : public DashSink {
  public:
-  SpecialLineRec() = default;
-  ~SpecialLineRec() = default;
+  explicit PathDashSink(Path* dst) : dst_(dst) {}
 
-  bool Init(Path const& src, Path*, Paint const& paint, int32_t interval_count,
-            float interval_length) {
-    if (paint.GetStrokeCap() != Paint::kButt_Cap) {
-      return false;
-    }
-
-    if (!src.IsLine(pts_.data())) {
-      return false;
-    }
+  void AddLine(const Point& start, const Point& stop) override {
+    dst_->MoveTo(start);
+    dst_->LineTo(stop);
+  }
 
-    float path_length = PointDistance(pts_[0], pts_[1]);
+  Path* BeginDash() override { return dst_; }
 
-    tangent_ = pts_[1] - pts_[0];
-    if (tangent_.x == 0 && tangent_.y == 0) {
-      return false;
-    }
+ private:
+  Path* dst_;
+};
 
-    path_length_ = path_length;
-    tangent_ *= FloatInvert(path_length);
-    PointRotateCCW(tangent_, &normal_);
-    normal_ *= SkityFloatHalf(paint.GetStrokeWidth());
+// Strokes the dashes as they come, only their outlines are kept.
+class StrokeDashSink final : public DashSink {
+ public:
+  explicit StrokeDashSink(const Paint& paint) : stroker_(paint) {}
 
-    float pt_count =
-        path_length * interval_count / static_cast<float>(interval_length);
-    pt_count = std::min(pt_count, static_cast<float>(kMaxDashCount));
+  void AddLine(const Point& start, const Point& stop) override {
+    stroker_.StrokeLine(start, stop);
+  }
 
-    return true;
+  Path* BeginDash() override {
+    dash_.Reset();
+    return &dash_;
   }
 
+  void EndDash() override { stroker_.StrokeContours(dash_); }
+
+  void Done(Path* dst) { stroker_.Done(dst); }
+
  private:
-  std::array<Point, 2> pts_ = {};
-  Vector tangent_ = {};
-  Vector normal_ = {};
-  float path_length_ = 0.f;
+  StreamStroker stroker_;
+  Path dash_;
 };
 
 DashPathEffect::DashPathEffect(const float* intervals, int32_t count,
@@ -115,17 +115,24 @@ bool DashPathEffect::OnFilterPath(Path* dst, const Path& src, bool stroke,
     return false;
   }
 
-  float dash_count = 0;
+  PathDashSink sink(dst);
+  if (!Dash(src, &sink)) {
+    dst->Reset();
+    return false;
+  }
 
-  Path cull_path_storage;
-  const Path* src_ptr = &src;
+  return true;
+}
 
-  PathMeasure meas{*src_ptr, false};
+bool DashPathEffect::Dash(const Path& src, DashSink* sink) const {
+  float dash_count = 0;
 
-  do {
-    bool skip_first_segment = meas.IsClosed();
+  auto measured = MeasuredPath::Make(src, false);
+  for (size_t i = 0; i < measured->CountContours(); i++) {
+    const auto& contour = measured->GetContour(i);
+    bool skip_first_segment = contour->isClosed();
     bool added_segment = false;
-    float length = meas.GetLength();
+    float length = contour->length();
     int32_t index = initial_dash_index_;
 
     // Since the path length / dash length ratio may be arbitrarily large, we
@@ -134,10 +141,22 @@ bool DashPathEffect::OnFilterPath(Path* dst, const Path& src, bool stroke,
     // threshold.
     dash_count += length * (count_ >> 1) / interval_length_;
     if (dash_count > kMaxDashCount) {
-      dst->Reset();
       return false;
     }
 
+    // The last dash of a closed contour is joined with the first one, which
+    // was skipped, so it is only complete after the loop.
+    bool join_first_segment = contour->isClosed() &&
+                              is_even(initial_dash_index_) &&
+                              initial_dash_length_ >= 0;
+
+    // The dashes come in increasing distance, so the cursor finds their
+    // segments by walking forward instead of searching the whole contour.
+    ContourMeasure::Cursor cursor;
+    Point start;
+    Point stop;
+    Path* dash = nullptr;
+
     // Using double precision to avoid looping indefinitely due to single
     // precision rounding (for extreme path_length/dash_length ratios).
     double distance = 0;
@@ -149,9 +168,21 @@ bool DashPathEffect::OnFilterPath(Path* dst, const Path& src, bool stroke,
       if (is_even(index) && !skip_first_segment) {
         added_segment = true;
 
-        // TODO(tangruiwen): handle special line
-        meas.GetSegment(static_cast<float>(distance),
-                        static_cast<float>(distance + dlen), dst, true);
+        float start_d = static_cast<float>(distance);
+        float stop_d = static_cast<float>(std::min<double>(distance + dlen,
+                                                           length));
+        bool last = distance + dlen >= length;
+
+        if (!(last && join_first_segment) &&
+            contour->getLine(start_d, stop_d, &start, &stop, &cursor)) {
+          sink->AddLine(start, stop);
+        } else {
+          dash = sink->BeginDash();
+          contour->getSegment(start_d, stop_d, dash, true, &cursor);
+          if (!(last && join_first_segment)) {
+            sink->EndDash();
+          }
+        }
       }
 
       distance += dlen;
@@ -172,11 +203,20 @@ bool DashPathEffect::OnFilterPath(Path* dst, const Path& src, bool stroke,
 
     // extend if we ended on a segment and we need to join up with the (skipped)
     // initial segment
-    if (meas.IsClosed() && is_even(initial_dash_index_) &&
-        initial_dash_length_ >= 0) {
-      meas.GetSegment(0, initial_dash_length_, dst, !added_segment);
+    if (join_first_segment) {
+      if (added_segment) {
+        contour->getSegment(0, initial_dash_length_, dash, false, &cursor);
+        sink->EndDash();
+      } else if (contour->getLine(0, std::min(initial_dash_length_, length),
+                                  &start, &stop, &cursor)) {
+        sink->AddLine(start, stop);
+      } else {
+        contour->getSegment(0, initial_dash_length_, sink->BeginDash(), true,
+                            &cursor);
+        sink->EndDash();
+      }
     }
-  } while (meas.NextContour());
+  }
 
   return true;
 }
@@ -235,4 +275,19 @@ void DashPathEffect::CalcDashParameters(float phase) {
   assert(initial_dash_index_ >= 0 && initial_dash_index_ < count_);
 }
 
+bool StrokeDashedPath(const Path& src, const Paint& paint, Path* dst) {
+  const auto& effect = paint.GetPathEffect();
+  if (!effect || effect->AsADash(nullptr) != PathEffect::DashType::kDash) {
+    return false;
+  }
+
+  StrokeDashSink sink(paint);
+  if (!static_cast<const DashPathEffect*>(effect.get())->Dash(src, &sink)) {
+    return false;
+  }
+
+  sink.Done(dst);
+  return true;
+}
+
 }  // namespace skity
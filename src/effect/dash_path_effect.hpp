@@ -7,9 +7,35 @@
 
 #include <memory>
 #include <skity/effect/path_effect.hpp>
+#include <skity/geometry/point.hpp>
 
 namespace skity {
 
+/**
+ * Receives the dashes of a path one by one, as DashPathEffect::Dash()
+ * generates them.
+ */
+class DashSink {
+ public:
+  virtual ~DashSink() = default;
+
+  /**
+   * A dash lying on a single line of the path.
+   */
+  virtual void AddLine(const Point& start, const Point& stop) = 0;
+
+  /**
+   * Path the next dash is appended to, starting with MoveTo. Used for the
+   * dashes which are not a single line.
+   */
+  virtual Path* BeginDash() = 0;
+
+  /**
+   * The dash appended to the path returned by BeginDash() is complete.
+   */
+  virtual void EndDash() {}
+};
+
 class DashPathEffect : public PathEffect {
  public:
   DashPathEffect(const float intervals[], int32_t count, float phase);
@@ -20,6 +46,14 @@ class DashPathEffect : public PathEffect {
 
   void FlattenToBuffer(WriteBuffer &buffer) const override;
 
+  /**
+   * Walk every contour of src once and pass each dash to sink.
+   *
+   * @return false  if src has too many dashes, some may have been passed to
+   *                sink already
+   */
+  bool Dash(const Path &src, DashSink *sink) const;
+
  protected:
   bool OnFilterPath(Path *, const Path &, bool, Paint const &) const override;
 
@@ -42,6 +76,16 @@ class DashPathEffect : public PathEffect {
   float interval_length_;
 };
 
+/**
+ * Stroke the dashes of src if the path effect of paint is a dash. Every dash
+ * goes to the stroker as it is generated, instead of collecting the dashes
+ * into a path which is then stroked.
+ *
+ * @return false  if paint has no dash path effect, or src has too many dashes
+ *                like DashPathEffect::FilterPath()
+ */
+bool StrokeDashedPath(const Path &src, const Paint &paint, Path *dst);
+
 }  // namespace skity
 
 #endif  // SRC_EFFECT_DASH_PATH_EFFECT_HPP
@@ -5,11 +5,12 @@
 #include <cmath>
 #include <skity/effect/mask_filter.hpp>
 
+#include "src/effect/image_filter_base.hpp"
+
 #if defined(SKITY_CPU)
 #include <skity/graphic/bitmap.hpp>
 #include <skity/render/canvas.hpp>
 
-#include "src/effect/image_filter_base.hpp"
 #include "src/effect/mask_filter_priv.hpp"
 #include "src/graphic/blend_mode_priv.hpp"
 #include "src/graphic/color_priv.hpp"
@@ -18,18 +19,10 @@
 
 namespace skity {
 
-namespace {
-
-constexpr float radial_to_sigma(float radius) {
-  return radius > 0.f ? radius * 0.57735f + 0.5f : 0.f;
-}
-
-}  // namespace
-
 std::string_view MaskFilter::ProcName() const { return "SkBlurMaskFilterImpl"; }
 
 void MaskFilter::FlattenToBuffer(WriteBuffer& buffer) const {
-  buffer.WriteFloat(radial_to_sigma(radius_));
+  buffer.WriteFloat(ConvertRadiusToSigma(radius_));
   buffer.WriteInt32(static_cast<int32_t>(style_) - 1);
   buffer.WriteUint32(0);  // respectCTM, ignore it
 }
@@ -348,6 +348,53 @@ int ChopQuadAtYExtrema(const Point src[3], Point dst[5]) {
   return 0;
 }
 
+int ChopCubicAtYExtrema(const Point src[4], Point dst[10]) {
+  float a = src[0].y;
+  float b = src[1].y;
+  float c = src[2].y;
+  float d = src[3].y;
+
+  // roots of the derivative, divided by 3
+  float t_values[2];
+  int roots = FindUnitQuadRoots(d - a + 3 * (b - c), 2 * (a - b - b + c),
+                                b - a, t_values);
+
+  dst[0] = src[0];
+  dst[1] = src[1];
+  dst[2] = src[2];
+  dst[3] = src[3];
+
+  Point* cubic = dst;
+  float t = roots > 0 ? t_values[0] : 0.f;
+  for (int i = 0; i < roots; i++) {
+    CubicCoeff::ChopCubicAt(cubic, cubic, t);
+    cubic += 3;
+
+    if (i == roots - 1) {
+      break;
+    }
+
+    // map the next root into the remaining part of the cubic
+    if (!valid_unit_divide(t_values[i + 1] - t_values[i], 1.f - t_values[i],
+                           &t)) {
+      // the roots are too close, so the remaining piece degenerates
+      cubic[4] = cubic[5] = cubic[6] = cubic[3];
+      break;
+    }
+  }
+
+  // Same as ChopQuadAtYExtrema, the tangent at a y extremum is horizontal, so
+  // make the points around it share its y despite the float error.
+  if (roots > 0) {
+    dst[2].y = dst[4].y = dst[3].y;
+    if (roots == 2) {
+      dst[5].y = dst[7].y = dst[6].y;
+    }
+  }
+
+  return roots;
+}
+
 std::vector<Vec2> CircleInterpolation(Vec2 start, Vec2 end, size_t num) {
   std::vector<Vec2> result(num);
   const auto cos_theta = Vec2::Dot(start, end);
@@ -402,4 +449,22 @@ std::vector<Vec2> CircleInterpolation(Vec2 start, Vec2 end, size_t num) {
   return result;
 }
 
+bool TriangleToTriangle(const Vec2 src[3], const Vec2 dst[3], Matrix* matrix) {
+  // both triangles as the basis (p1 - p0, p2 - p0) at p0
+  Matrix src_basis{src[1].x - src[0].x, src[2].x - src[0].x, src[0].x,  //
+                   src[1].y - src[0].y, src[2].y - src[0].y, src[0].y,  //
+                   0.f,                 0.f,                 1.f};
+  Matrix dst_basis{dst[1].x - dst[0].x, dst[2].x - dst[0].x, dst[0].x,  //
+                   dst[1].y - dst[0].y, dst[2].y - dst[0].y, dst[0].y,  //
+                   0.f,                 0.f,                 1.f};
+
+  Matrix inverse;
+  if (!src_basis.Invert(&inverse)) {
+    return false;
+  }
+
+  *matrix = dst_basis * inverse;
+  return true;
+}
+
 }  // namespace skity
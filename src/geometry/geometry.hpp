@@ -8,6 +8,7 @@
 #define SRC_GEOMETRY_GEOMETRY_HPP
 
 #include <array>
+#include <skity/geometry/matrix.hpp>
 #include <skity/geometry/point.hpp>
 #include <vector>
 
@@ -179,6 +180,16 @@ void SubDividedQuad(const Point quad[3], Point sub_quad1[3],
 
 int ChopQuadAtYExtrema(const Point src[3], Point dst[5]);
 
+/**
+ * Chop the cubic at its y extrema so every piece is monotonic in y.
+ *
+ * @param src   the cubic
+ * @param dst   the 1, 2 or 3 cubics, sharing their end points
+ *
+ * @return      number of times the cubic was chopped, 0, 1 or 2
+ */
+int ChopCubicAtYExtrema(const Point src[4], Point dst[10]);
+
 /**
  * Returns the interpolated unit vectors under constant angular speed.
  *
@@ -191,6 +202,13 @@ int ChopQuadAtYExtrema(const Point src[3], Point dst[5]);
  */
 std::vector<Vec2> CircleInterpolation(Vec2 start, Vec2 end, size_t num);
 
+/**
+ * Computes the affine matrix mapping the triangle src onto the triangle dst.
+ *
+ * @return false if src is degenerate
+ */
+bool TriangleToTriangle(const Vec2 src[3], const Vec2 dst[3], Matrix* matrix);
+
 }  // namespace skity
 
 #endif  // SRC_GEOMETRY_GEOMETRY_HPP
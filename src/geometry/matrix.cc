@@ -10,6 +10,7 @@
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/scalar_constants.hpp>
 #include <glm/gtx/matrix_query.hpp>
+#include <cstring>
 #include <memory>
 #include <skity/geometry/matrix.hpp>
 #include <skity/geometry/rect.hpp>
@@ -17,8 +18,162 @@
 #include "src/geometry/glm_helper.hpp"
 #include "src/geometry/math.hpp"
 
+#ifdef SKITY_ARM_NEON
+#include <arm_neon.h>
+#endif
+
 namespace skity {
 
+namespace {
+
+// The routines below map a whole batch with the same transform class, so the
+// per point work is a few multiply-adds and the loops can be vectorized. dst
+// and src may be the same array, but must not partially overlap.
+
+void MapVec2Translate(const Matrix& m, Vec2 dst[], const Vec2 src[],
+                      int count) {
+  float tx = m.GetTranslateX();
+  float ty = m.GetTranslateY();
+  int i = 0;
+#ifdef SKITY_ARM_NEON
+  float32x4_t trans = {tx, ty, tx, ty};
+  for (; i + 2 <= count; i += 2) {
+    float32x4_t p = vld1q_f32(&src[i].x);
+    vst1q_f32(&dst[i].x, vaddq_f32(p, trans));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i].x = src[i].x + tx;
+    dst[i].y = src[i].y + ty;
+  }
+}
+
+void MapVec2ScaleTranslate(const Matrix& m, Vec2 dst[], const Vec2 src[],
+                           int count) {
+  float sx = m.GetScaleX();
+  float sy = m.GetScaleY();
+  float tx = m.GetTranslateX();
+  float ty = m.GetTranslateY();
+  int i = 0;
+#ifdef SKITY_ARM_NEON
+  float32x4_t scale = {sx, sy, sx, sy};
+  float32x4_t trans = {tx, ty, tx, ty};
+  for (; i + 2 <= count; i += 2) {
+    float32x4_t p = vld1q_f32(&src[i].x);
+    vst1q_f32(&dst[i].x, vmlaq_f32(trans, p, scale));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i].x = src[i].x * sx + tx;
+    dst[i].y = src[i].y * sy + ty;
+  }
+}
+
+void MapVec2Affine(const Matrix& m, Vec2 dst[], const Vec2 src[], int count) {
+  float sx = m.GetScaleX();
+  float kx = m.GetSkewX();
+  float tx = m.GetTranslateX();
+  float ky = m.GetSkewY();
+  float sy = m.GetScaleY();
+  float ty = m.GetTranslateY();
+  int i = 0;
+#ifdef SKITY_ARM_NEON
+  for (; i + 4 <= count; i += 4) {
+    float32x4x2_t p = vld2q_f32(&src[i].x);
+    float32x4x2_t r;
+    // same evaluation order as the scalar loop, results match bit by bit
+    r.val[0] = vmlaq_n_f32(vmulq_n_f32(p.val[0], sx), p.val[1], kx);
+    r.val[0] = vaddq_f32(r.val[0], vdupq_n_f32(tx));
+    r.val[1] = vmlaq_n_f32(vmulq_n_f32(p.val[0], ky), p.val[1], sy);
+    r.val[1] = vaddq_f32(r.val[1], vdupq_n_f32(ty));
+    vst2q_f32(&dst[i].x, r);
+  }
+#endif
+  for (; i < count; i++) {
+    float x = src[i].x;
+    float y = src[i].y;
+    dst[i].x = x * sx + y * kx + tx;
+    dst[i].y = x * ky + y * sy + ty;
+  }
+}
+
+void MapVec2Persp(const Matrix& m, Vec2 dst[], const Vec2 src[], int count) {
+  for (int i = 0; i < count; ++i) {
+    auto v = Vec4(src[i].x, src[i].y, 0.f, 1.f);
+    auto r = m * v;
+    float w = r.w;
+    if (w != 0) {
+      w = 1.f / w;
+    }
+    dst[i].x = r.x * w;
+    dst[i].y = r.y * w;
+  }
+}
+
+// Points are homogeneous, the translation is scaled by w and z passes through
+// untouched for every class but the general one.
+
+void MapPointTranslate(const Matrix& m, Point dst[], const Point src[],
+                       int count) {
+  float tx = m.GetTranslateX();
+  float ty = m.GetTranslateY();
+  for (int i = 0; i < count; i++) {
+    Point p = src[i];
+    dst[i] = Point{p.x + tx * p.w, p.y + ty * p.w, p.z, p.w};
+  }
+}
+
+void MapPointScaleTranslate(const Matrix& m, Point dst[], const Point src[],
+                            int count) {
+  float sx = m.GetScaleX();
+  float sy = m.GetScaleY();
+  float tx = m.GetTranslateX();
+  float ty = m.GetTranslateY();
+  for (int i = 0; i < count; i++) {
+    Point p = src[i];
+    dst[i] = Point{p.x * sx + tx * p.w, p.y * sy + ty * p.w, p.z, p.w};
+  }
+}
+
+void MapPointAffine(const Matrix& m, Point dst[], const Point src[],
+                    int count) {
+  float sx = m.GetScaleX();
+  float kx = m.GetSkewX();
+  float tx = m.GetTranslateX();
+  float ky = m.GetSkewY();
+  float sy = m.GetScaleY();
+  float ty = m.GetTranslateY();
+  for (int i = 0; i < count; i++) {
+    Point p = src[i];
+    dst[i] = Point{p.x * sx + p.y * kx + tx * p.w,
+                   p.x * ky + p.y * sy + ty * p.w, p.z, p.w};
+  }
+}
+
+void MapPointGeneral(const Matrix& m, Point dst[], const Point src[],
+                     int count) {
+#ifdef SKITY_ARM_NEON
+  float32x4_t c0 = vld1q_f32(&m[0].x);
+  float32x4_t c1 = vld1q_f32(&m[1].x);
+  float32x4_t c2 = vld1q_f32(&m[2].x);
+  float32x4_t c3 = vld1q_f32(&m[3].x);
+  for (int i = 0; i < count; i++) {
+    float32x4_t p = vld1q_f32(&src[i].x);
+    float32x4_t r = vmulq_n_f32(c0, vgetq_lane_f32(p, 0));
+    r = vmlaq_n_f32(r, c1, vgetq_lane_f32(p, 1));
+    r = vmlaq_n_f32(r, c2, vgetq_lane_f32(p, 2));
+    r = vmlaq_n_f32(r, c3, vgetq_lane_f32(p, 3));
+    vst1q_f32(&dst[i].x, r);
+  }
+#else
+  for (int i = 0; i < count; i++) {
+    dst[i] = m * src[i];
+  }
+#endif
+}
+
+}  // namespace
+
 // static
 Matrix Matrix::RotateDeg(float deg) {
   return Matrix::RotateRad(FloatDegreesToRadians(deg), {0, 0});
@@ -231,6 +386,26 @@ bool Matrix::HasPersp() const {
   return false;
 }
 
+uint32_t Matrix::GetType() const {
+  const Matrix& m = *this;
+  uint32_t type = TypeMask::kIdentity;
+  if (m[3][0] != 0 || m[3][1] != 0) {
+    type |= TypeMask::kTranslate;
+  }
+  if (m[0][0] != 1 || m[1][1] != 1) {
+    type |= TypeMask::kScale;
+  }
+  if (m[0][1] != 0 || m[1][0] != 0) {
+    type |= TypeMask::kAffine;
+  }
+  // anything reaching into z or w needs the full 4x4 multiply
+  if (m[0][2] != 0 || m[1][2] != 0 || m[2][2] != 1 || m[3][2] != 0 ||
+      m[2][0] != 0 || m[2][1] != 0 || HasPersp()) {
+    type |= TypeMask::kPerspective;
+  }
+  return type;
+}
+
 bool Matrix::InvertNonIdentity(Matrix* inverse) const {
   Matrix temp_inverse;
   Matrix* p_inverse =
@@ -274,15 +449,21 @@ void Matrix::MapPoints(Vec2 dst[], const Vec2 src[], int count) const {
   if (dst == nullptr || src == nullptr || count <= 0) {
     return;
   }
-  for (int i = 0; i < count; ++i) {
-    auto v = Vec4(src[i].x, src[i].y, 0.f, 1.f);
-    auto r = (*this) * v;
-    float w = r.w;
-    if (w != 0) {
-      w = 1.f / w;
+
+  uint32_t type = GetType();
+
+  if (type == TypeMask::kIdentity) {
+    if (dst != src) {
+      std::memcpy(dst, src, count * sizeof(Vec2));
     }
-    dst[i].x = r.x * w;
-    dst[i].y = r.y * w;
+  } else if (type == TypeMask::kTranslate) {
+    MapVec2Translate(*this, dst, src, count);
+  } else if (type & TypeMask::kPerspective) {
+    MapVec2Persp(*this, dst, src, count);
+  } else if (type & TypeMask::kAffine) {
+    MapVec2Affine(*this, dst, src, count);
+  } else {
+    MapVec2ScaleTranslate(*this, dst, src, count);
   }
 }
 
@@ -290,8 +471,21 @@ void Matrix::MapPoints(Point dst[], const Point src[], int count) const {
   if (dst == nullptr || src == nullptr || count <= 0) {
     return;
   }
-  for (int i = 0; i < count; ++i) {
-    dst[i] = (*this) * src[i];
+
+  uint32_t type = GetType();
+
+  if (type == TypeMask::kIdentity) {
+    if (dst != src) {
+      std::memcpy(dst, src, count * sizeof(Point));
+    }
+  } else if (type == TypeMask::kTranslate) {
+    MapPointTranslate(*this, dst, src, count);
+  } else if (type & TypeMask::kPerspective) {
+    MapPointGeneral(*this, dst, src, count);
+  } else if (type & TypeMask::kAffine) {
+    MapPointAffine(*this, dst, src, count);
+  } else {
+    MapPointScaleTranslate(*this, dst, src, count);
   }
 }
 
@@ -300,28 +494,38 @@ bool Matrix::MapRect(Rect* dst, const Rect& src) const {
     return false;
   }
 
-  Vec4 src_quad[4] = {{src.Left(), src.Top(), 0.f, 1.f},
-                      {src.Right(), src.Top(), 0.f, 1.f},
-                      {src.Right(), src.Bottom(), 0.f, 1.f},
-                      {src.Left(), src.Bottom(), 0.f, 1.f}};
-  Vec4 dst_quad[4];
-  for (size_t i = 0; i < 4; ++i) {
-    dst_quad[i] = (*this) * src_quad[i];
-    float w = dst_quad[i].w;
-    if (w != 0) {
-      w = 1.0f / w;
-    }
-    dst_quad[i] = dst_quad[i] * w;
-  }
-  float left = dst_quad[0].x;
-  float right = dst_quad[0].x;
-  float top = dst_quad[0].y;
-  float bottom = dst_quad[0].y;
+  uint32_t type = GetType();
+
+  if (!(type & (TypeMask::kAffine | TypeMask::kPerspective))) {
+    // two opposite corners are enough, the sort handles negative scales
+    float sx = GetScaleX();
+    float sy = GetScaleY();
+    float tx = GetTranslateX();
+    float ty = GetTranslateY();
+    float l = src.Left() * sx + tx;
+    float r = src.Right() * sx + tx;
+    float t = src.Top() * sy + ty;
+    float b = src.Bottom() * sy + ty;
+    dst->SetLTRB(std::min(l, r), std::min(t, b), std::max(l, r),
+                 std::max(t, b));
+    return RectStaysRect();
+  }
+
+  Vec2 quad[4] = {{src.Left(), src.Top()},
+                  {src.Right(), src.Top()},
+                  {src.Right(), src.Bottom()},
+                  {src.Left(), src.Bottom()}};
+  MapPoints(quad, quad, 4);
+
+  float left = quad[0].x;
+  float right = quad[0].x;
+  float top = quad[0].y;
+  float bottom = quad[0].y;
   for (size_t i = 1; i < 4; i++) {
-    left = std::min(dst_quad[i].x, left);
-    right = std::max(dst_quad[i].x, right);
-    top = std::min(dst_quad[i].y, top);
-    bottom = std::max(dst_quad[i].y, bottom);
+    left = std::min(quad[i].x, left);
+    right = std::max(quad[i].x, right);
+    top = std::min(quad[i].y, top);
+    bottom = std::max(quad[i].y, bottom);
   }
   dst->SetLTRB(left, top, right, bottom);
 
@@ -9,6 +9,7 @@
 #include "src/geometry/conic.hpp"
 #include "src/geometry/cubic.hpp"
 #include "src/geometry/point_priv.hpp"
+#include "src/geometry/stroke_priv.hpp"
 
 namespace skity {
 
@@ -900,6 +901,104 @@ DONE:
   stroker.Done(dst, last_verb == Path::Verb::kLine);
 }
 
+StreamStroker::StreamStroker(const Paint& paint)
+    : stroke_(paint),
+      stroker_(std::make_unique<PathStroker>(
+          Path{}, paint.GetStrokeWidth() * 0.5f, paint.GetStrokeMiter(),
+          paint.GetStrokeCap(), paint.GetStrokeJoin(), 1.f)),
+      radius_(paint.GetStrokeWidth() * 0.5f),
+      cap_(paint.GetStrokeCap()) {}
+
+StreamStroker::~StreamStroker() = default;
+
+void StreamStroker::StrokeLine(const Point& start, const Point& stop) {
+  // same tolerance as PathStroker::LineTo() with a scale of 1
+  bool teeny_line = PointEqualsWithinTolerance(start, stop, kNearlyZero / 4);
+  if (teeny_line && cap_ == Paint::kButt_Cap) {
+    return;
+  }
+
+  Vector unit;
+  if (cap_ == Paint::kRound_Cap || teeny_line ||
+      !VectorSetNormal(unit, stop.x - start.x, stop.y - start.y)) {
+    stroker_->MoveTo(start);
+    stroker_->LineTo(stop);
+    stroker_used_ = true;
+    return;
+  }
+
+  Vector normal;
+  PointRotateCCW(unit, &normal);
+  normal *= radius_;
+
+  // the same winding as the outline PathStroker makes for the line
+  outline_.MoveTo(start + normal);
+  outline_.LineTo(stop + normal);
+
+  // Square caps keep the vertices PathStroker puts at the ends of the line.
+  // The rasterizer sets up each edge on its own, so a side split there is
+  // not covered the same as one long edge on shallow lines.
+  if (cap_ == Paint::kSquare_Cap) {
+    Vector parallel = unit * radius_;
+    outline_.LineTo(stop + normal + parallel);
+    outline_.LineTo(stop - normal + parallel);
+    outline_.LineTo(stop - normal);
+    outline_.LineTo(start - normal);
+    outline_.LineTo(start - normal - parallel);
+    outline_.LineTo(start + normal - parallel);
+  } else {
+    outline_.LineTo(stop - normal);
+    outline_.LineTo(start - normal);
+  }
+
+  outline_.Close();
+}
+
+void StreamStroker::StrokeContours(const Path& path) {
+  quads_.Reset();
+  stroke_.QuadPath(path, &quads_);
+
+  Path::Iter iter{quads_, false};
+  std::array<Point, 4> pts = {};
+  Path::Verb last_verb = Path::Verb::kMove;
+  for (;;) {
+    Path::Verb verb = iter.Next(pts.data());
+    switch (verb) {
+      case Path::Verb::kMove:
+        stroker_->MoveTo(pts[0]);
+        break;
+      case Path::Verb::kLine:
+        stroker_->LineTo(pts[1]);
+        last_verb = Path::Verb::kLine;
+        break;
+      case Path::Verb::kQuad:
+        stroker_->QuadTo(pts[1], pts[2]);
+        last_verb = Path::Verb::kQuad;
+        break;
+      case Path::Verb::kClose:
+        stroker_->Close(last_verb == Path::Verb::kLine);
+        break;
+      case Path::Verb::kDone:
+        stroker_used_ = true;
+        return;
+      default:
+        break;
+    }
+  }
+}
+
+void StreamStroker::Done(Path* dst) {
+  if (stroker_used_) {
+    Path curves;
+    stroker_->Done(&curves, false);
+    outline_.AddPath(curves);
+  }
+
+  dst->Swap(outline_);
+  outline_.Reset();
+  stroker_used_ = false;
+}
+
 [[maybe_unused]] static void mark_point(Path* dst, Point point) {
   dst->LineTo(point.x + 50, point.y);
   dst->LineTo(point.x, point.y);
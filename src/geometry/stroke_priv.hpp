@@ -0,0 +1,56 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GEOMETRY_STROKE_PRIV_HPP
+#define SRC_GEOMETRY_STROKE_PRIV_HPP
+
+#include <memory>
+#include <skity/geometry/stroke.hpp>
+#include <skity/graphic/paint.hpp>
+#include <skity/graphic/path.hpp>
+
+namespace skity {
+
+class PathStroker;
+
+/**
+ * Strokes open contours as they are generated, like the dashes of a path,
+ * appending all their outlines to one path. Unlike Stroke::StrokePath() the
+ * contours never have to be collected into a path first.
+ */
+class StreamStroker {
+ public:
+  explicit StreamStroker(const Paint& paint);
+
+  ~StreamStroker();
+
+  /**
+   * Stroke the line from start to stop. With butt or square caps the outline
+   * is a rectangle, which is added without running the stroker.
+   */
+  void StrokeLine(const Point& start, const Point& stop);
+
+  /**
+   * Stroke every contour of the path, curves included.
+   */
+  void StrokeContours(const Path& path);
+
+  /**
+   * Move the outline of everything stroked so far into dst.
+   */
+  void Done(Path* dst);
+
+ private:
+  Stroke stroke_;
+  std::unique_ptr<PathStroker> stroker_;
+  float radius_;
+  Paint::Cap cap_;
+  bool stroker_used_ = false;
+  Path outline_;
+  Path quads_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GEOMETRY_STROKE_PRIV_HPP
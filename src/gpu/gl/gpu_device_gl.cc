@@ -5,6 +5,7 @@
 #include "src/gpu/gl/gpu_device_gl.hpp"
 
 #include <cstring>
+#include <string>
 
 #include "src/gpu/gl/gl_interface.hpp"
 #include "src/gpu/gl/gpu_buffer_gl.hpp"
@@ -163,8 +164,7 @@ std::shared_ptr<GPUShaderFunction> GPUDeviceGL::CreateShaderFunctionFromModule(
   GPUShaderSourceWGX* source =
       reinterpret_cast<GPUShaderSourceWGX*>(desc.shader_source);
 
-  if (!source->module || source->module->GetProgram() == nullptr ||
-      source->entry_point == nullptr) {
+  if (!source->module || source->entry_point == nullptr) {
     return {};
   }
 
@@ -175,8 +175,16 @@ std::shared_ptr<GPUShaderFunction> GPUDeviceGL::CreateShaderFunctionFromModule(
   options.major_version = gl_version_major_;
   options.minor_version = gl_version_minor_;
 
-  auto wgx_result = source->module->GetProgram()->WriteToGlsl(
-      source->entry_point, options, source->context);
+  std::string target = is_gles_ ? "glsl-es-" : "glsl-";
+  target += std::to_string(options.major_version);
+  target += ".";
+  target += std::to_string(options.minor_version);
+
+  auto wgx_result = TranslateShaderSource(
+      *source, target, [&](const wgx::Program& program) {
+        return program.WriteToGlsl(source->entry_point, options,
+                                   source->context);
+      });
 
   if (!wgx_result.success) {
     if (desc.error_callback) {
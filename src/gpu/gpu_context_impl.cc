@@ -6,6 +6,8 @@
 
 namespace skity {
 
+GPUContextImpl::~GPUContextImpl() { SaveShaderCache(); }
+
 bool GPUContextImpl::Init() {
   gpu_device_ = CreateGPUDevice();
 
@@ -53,6 +55,35 @@ void GPUContextImpl::SetResourceCacheLimit(size_t size_in_bytes) {
   render_target_cache_->SetMaxBytes(size_in_bytes);
 }
 
+bool GPUContextImpl::SetShaderCachePath(const char* path) {
+  if (gpu_device_ == nullptr || path == nullptr) {
+    return false;
+  }
+
+  SaveShaderCache();
+
+  shader_cache_ = std::make_unique<GPUShaderCache>(path);
+  gpu_device_->SetShaderCache(shader_cache_.get());
+
+  return shader_cache_->Load();
+}
+
+bool GPUContextImpl::SaveShaderCache() {
+  if (shader_cache_ == nullptr) {
+    return false;
+  }
+
+  return shader_cache_->Save();
+}
+
+GPUShaderCacheStats GPUContextImpl::GetShaderCacheStats() const {
+  if (shader_cache_ == nullptr) {
+    return {};
+  }
+
+  return shader_cache_->GetStats();
+}
+
 std::unique_ptr<GPURenderTarget> GPUContextImpl::CreateRenderTarget(
     const GPURenderTargetDescriptor& desc) {
   if (desc.width == 0 || desc.height == 0) {
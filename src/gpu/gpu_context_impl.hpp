@@ -7,6 +7,7 @@
 
 #include <skity/gpu/gpu_context.hpp>
 
+#include "src/gpu/gpu_shader_cache.hpp"
 #include "src/gpu/texture_manager.hpp"
 #include "src/render/hw/hw_pipeline_lib.hpp"
 #include "src/render/hw/hw_render_target_cache.hpp"
@@ -18,7 +19,7 @@ class GPUContextImpl : public GPUContext {
  public:
   explicit GPUContextImpl(GPUBackendType backend) : backend_type_(backend) {}
 
-  ~GPUContextImpl() override = default;
+  ~GPUContextImpl() override;
 
   bool Init();
 
@@ -34,6 +35,16 @@ class GPUContextImpl : public GPUContext {
 
   void SetResourceCacheLimit(size_t size_in_bytes) override;
 
+  bool SetShaderCachePath(const char* path) override;
+
+  bool SaveShaderCache() override;
+
+  GPUShaderCacheStats GetShaderCacheStats() const override;
+
+  FrameStats GetFrameStats() const override { return frame_stats_; }
+
+  void SetFrameStats(const FrameStats& stats) { frame_stats_ = stats; }
+
   GPUDevice* GetGPUDevice() const { return gpu_device_.get(); }
 
   HWRenderTargetCache* GetRenderTargetCache() const {
@@ -70,11 +81,14 @@ class GPUContextImpl : public GPUContext {
 
  private:
   GPUBackendType backend_type_;
+  // declared before the device which keeps a raw pointer to it
+  std::unique_ptr<GPUShaderCache> shader_cache_ = {};
   std::unique_ptr<GPUDevice> gpu_device_ = {};
   std::shared_ptr<TextureManager> texture_manager_ = {};
   std::unique_ptr<HWRenderTargetCache> render_target_cache_ = {};
   std::unique_ptr<HWPipelineLib> pipeline_lib_ = {};
   std::unique_ptr<AtlasManager> atlas_manager_ = {};
+  FrameStats frame_stats_ = {};
 };
 
 }  // namespace skity
@@ -4,6 +4,8 @@
 
 #include "src/gpu/gpu_device.hpp"
 
+#include "src/gpu/gpu_shader_cache.hpp"
+
 namespace skity {
 
 std::shared_ptr<GPUShaderModule> GPUDevice::CreateShaderModule(
@@ -11,4 +13,36 @@ std::shared_ptr<GPUShaderModule> GPUDevice::CreateShaderModule(
   return GPUShaderModule::Create(desc);
 }
 
+wgx::Result GPUDevice::TranslateShaderSource(
+    const GPUShaderSourceWGX& source, const std::string& target,
+    const std::function<wgx::Result(const wgx::Program&)>& translate) {
+  if (!source.module || source.entry_point == nullptr) {
+    return {};
+  }
+
+  uint64_t key = 0;
+  if (shader_cache_) {
+    key = GPUShaderCache::MakeKey(source.module->GetSource(),
+                                  source.entry_point, target, source.context);
+
+    auto result = shader_cache_->Find(key);
+    if (result.success) {
+      return result;
+    }
+  }
+
+  auto program = source.module->GetProgram();
+  if (program == nullptr) {
+    return {};
+  }
+
+  auto result = translate(*program);
+
+  if (result.success && shader_cache_) {
+    shader_cache_->Store(key, result);
+  }
+
+  return result;
+}
+
 }  // namespace skity
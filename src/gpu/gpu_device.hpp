@@ -5,7 +5,9 @@
 #ifndef SRC_GPU_GPU_DEVICE_HPP
 #define SRC_GPU_GPU_DEVICE_HPP
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "src/gpu/gpu_buffer.hpp"
@@ -18,6 +20,8 @@
 
 namespace skity {
 
+class GPUShaderCache;
+
 class GPUDevice {
  public:
   GPUDevice() = default;
@@ -67,6 +71,33 @@ class GPUDevice {
 
   virtual std::shared_ptr<GPUShaderModule> CreateShaderModule(
       const GPUShaderModuleDescriptor& desc);
+
+  /**
+   * Set the persistent cache used by TranslateShaderSource(). The cache is
+   * owned by the caller and must outlive this device, pass null to disable.
+   */
+  void SetShaderCache(GPUShaderCache* shader_cache) {
+    shader_cache_ = shader_cache;
+  }
+
+ protected:
+  /**
+   * Translate the entry point of a WGX shader source, looking it up in the
+   * shader cache first. The module is only parsed on a cache miss.
+   *
+   * @param source    the WGX source, its context is used as the input binding
+   *                  slots of the translation
+   * @param target    identify the shading language and version `translate`
+   *                  generates, e.g. "glsl-es-3.0"
+   * @param translate run the actual translation on the parsed program
+   * @return          the translation result
+   */
+  wgx::Result TranslateShaderSource(
+      const GPUShaderSourceWGX& source, const std::string& target,
+      const std::function<wgx::Result(const wgx::Program&)>& translate);
+
+ private:
+  GPUShaderCache* shader_cache_ = nullptr;
 };
 
 }  // namespace skity
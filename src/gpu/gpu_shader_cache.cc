@@ -0,0 +1,210 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/gpu_shader_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <skity/io/data.hpp>
+
+#include "src/base/hash.hpp"
+#include "src/logging.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+namespace {
+
+// 'SKSC'
+constexpr uint32_t kShaderCacheMagic = 0x43534B53;
+
+struct ShaderCacheHeader {
+  uint32_t magic = kShaderCacheMagic;
+  uint32_t version = GPUShaderCache::kVersion;
+  uint32_t translator = 0;
+  uint32_t entry_count = 0;
+};
+
+struct ShaderCacheEntryHeader {
+  uint64_t key = 0;
+  uint32_t size = 0;
+  uint32_t reserved = 0;
+};
+
+// the same source may translate differently with another build of wgx
+uint32_t TranslatorHash() {
+  const char* version = wgx::GetTranslatorVersion();
+  return Hash32(version, std::strlen(version), 0);
+}
+
+template <typename T>
+void AppendPOD(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+uint64_t GPUShaderCache::MakeKey(const std::string& source,
+                                 const char* entry_point,
+                                 const std::string& target,
+                                 const wgx::CompilerContext& context) {
+  std::string material;
+  material.reserve(source.size() + target.size() + 64);
+
+  material.append(wgx::GetTranslatorVersion());
+  material.push_back('\0');
+  material.append(target);
+  material.push_back('\0');
+  material.append(entry_point);
+  material.push_back('\0');
+  AppendPOD(material, context.last_ubo_binding);
+  AppendPOD(material, context.last_texture_binding);
+  AppendPOD(material, context.last_sampler_binding);
+  material.append(source);
+
+  // two differently seeded 32 bits hashes make collisions between the few
+  // hundreds of shaders an application uses practically impossible
+  uint64_t high = Hash32(material.data(), material.size(), 0);
+  uint64_t low = Hash32(material.data(), material.size(), kVersion);
+
+  return high << 32 | low;
+}
+
+bool GPUShaderCache::Load() {
+  SKITY_TRACE_EVENT(GPUShaderCache_Load);
+
+  auto data = Data::MakeFromFileName(path_.c_str());
+
+  if (data == nullptr || data->Size() < sizeof(ShaderCacheHeader)) {
+    return false;
+  }
+
+  const uint8_t* ptr = data->Bytes();
+  const uint8_t* end = ptr + data->Size();
+
+  ShaderCacheHeader header{};
+  std::memcpy(&header, ptr, sizeof(header));
+  ptr += sizeof(header);
+
+  if (header.magic != kShaderCacheMagic || header.version != kVersion ||
+      header.translator != TranslatorHash()) {
+    LOGW("Ignore shader cache {} written by another version", path_);
+    return false;
+  }
+
+  std::unordered_map<uint64_t, std::string> entries{};
+
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    ShaderCacheEntryHeader entry{};
+    if (static_cast<size_t>(end - ptr) < sizeof(entry)) {
+      return false;
+    }
+
+    std::memcpy(&entry, ptr, sizeof(entry));
+    ptr += sizeof(entry);
+
+    if (static_cast<size_t>(end - ptr) < entry.size) {
+      return false;
+    }
+
+    entries[entry.key].assign(reinterpret_cast<const char*>(ptr), entry.size);
+    ptr += entry.size;
+  }
+
+  if (ptr != end) {
+    return false;
+  }
+
+  entries_ = std::move(entries);
+  dirty_ = false;
+
+  return true;
+}
+
+bool GPUShaderCache::Save() {
+  if (!dirty_) {
+    return true;
+  }
+
+  SKITY_TRACE_EVENT(GPUShaderCache_Save);
+
+  std::string out;
+
+  ShaderCacheHeader header{};
+  header.translator = TranslatorHash();
+  header.entry_count = static_cast<uint32_t>(entries_.size());
+  AppendPOD(out, header);
+
+  for (const auto& pair : entries_) {
+    ShaderCacheEntryHeader entry{};
+    entry.key = pair.first;
+    entry.size = static_cast<uint32_t>(pair.second.size());
+
+    AppendPOD(out, entry);
+    out.append(pair.second);
+  }
+
+  // write to a temporary file first, a crash in the middle of writing must not
+  // leave a truncated cache behind
+  std::string temp_path = path_ + ".tmp";
+
+  auto data = Data::MakeWithProc(out.data(), out.size(), nullptr, nullptr);
+
+  if (!data->WriteToFile(temp_path.c_str())) {
+    return false;
+  }
+
+  if (std::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    return false;
+  }
+
+  dirty_ = false;
+
+  return true;
+}
+
+wgx::Result GPUShaderCache::Find(uint64_t key) {
+  auto it = entries_.find(key);
+
+  if (it == entries_.end()) {
+    miss_count_++;
+    return {};
+  }
+
+  auto result = wgx::DeserializeResult(it->second);
+
+  if (!result.success) {
+    // corrupted entry, translate again and replace it
+    entries_.erase(it);
+    miss_count_++;
+    return {};
+  }
+
+  hit_count_++;
+
+  return result;
+}
+
+void GPUShaderCache::Store(uint64_t key, const wgx::Result& result) {
+  auto data = wgx::SerializeResult(result);
+
+  if (data.empty()) {
+    return;
+  }
+
+  entries_[key] = std::move(data);
+  dirty_ = true;
+}
+
+GPUShaderCacheStats GPUShaderCache::GetStats() const {
+  GPUShaderCacheStats stats{};
+  stats.hit_count = hit_count_;
+  stats.miss_count = miss_count_;
+  stats.entry_count = static_cast<uint32_t>(entries_.size());
+
+  return stats;
+}
+
+}  // namespace skity
@@ -0,0 +1,80 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_GPU_SHADER_CACHE_HPP
+#define SRC_GPU_GPU_SHADER_CACHE_HPP
+
+#include <wgsl_cross.h>
+
+#include <cstdint>
+#include <skity/gpu/gpu_context.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace skity {
+
+/**
+ * Persistent cache of WGX translation results.
+ *
+ * Entries are addressed by a hash of everything the translation depends on:
+ * the WGSL source, the entry point, the target shading language and the
+ * binding slots already used by the previous stage. The translated source and
+ * its bind group reflection are stored together, so a hit does not need to
+ * parse the WGSL source at all.
+ *
+ * The file starts with a magic number, kVersion and a hash of the wgx
+ * translator version. A file written by another version or another build of
+ * wgx is ignored and overwritten on the next Save().
+ */
+class GPUShaderCache {
+ public:
+  /**
+   * Bump this whenever the file layout changes. Changes of the wgx output are
+   * covered by wgx::GetTranslatorVersion().
+   */
+  static constexpr uint32_t kVersion = 2;
+
+  explicit GPUShaderCache(std::string path) : path_(std::move(path)) {}
+
+  ~GPUShaderCache() = default;
+
+  static uint64_t MakeKey(const std::string& source, const char* entry_point,
+                          const std::string& target,
+                          const wgx::CompilerContext& context);
+
+  /**
+   * Load entries from the cache file.
+   *
+   * @return false if the file does not exist, is corrupted or was written by
+   *         another version
+   */
+  bool Load();
+
+  /**
+   * Write all entries to the cache file if new ones were stored since the
+   * last Load() or Save().
+   */
+  bool Save();
+
+  /**
+   * @return the cached result of `key`, with Result::success set to false if
+   *         there is none
+   */
+  wgx::Result Find(uint64_t key);
+
+  void Store(uint64_t key, const wgx::Result& result);
+
+  GPUShaderCacheStats GetStats() const;
+
+ private:
+  std::string path_;
+  std::unordered_map<uint64_t, std::string> entries_ = {};
+  uint32_t hit_count_ = 0;
+  uint32_t miss_count_ = 0;
+  bool dirty_ = false;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_GPU_SHADER_CACHE_HPP
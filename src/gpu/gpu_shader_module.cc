@@ -10,28 +10,43 @@
 namespace skity {
 
 GPUShaderModule::GPUShaderModule(GPUShaderModule& base)
-    : label_(std::move(base.label_)), program_(std::move(base.program_)) {}
+    : label_(std::move(base.label_)),
+      source_(std::move(base.source_)),
+      parsed_(base.parsed_),
+      program_(std::move(base.program_)) {}
 
 std::shared_ptr<GPUShaderModule> GPUShaderModule::Create(
     const GPUShaderModuleDescriptor& desc) {
-  SKITY_TRACE_EVENT(GPUShaderModule_CreateWGX);
+  auto module = std::make_shared<GPUShaderModule>();
+  module->label_ = desc.label;
+  module->source_ = desc.source;
+
+  return module;
+}
+
+wgx::Program* GPUShaderModule::GetProgram() const {
+  if (parsed_) {
+    return program_.get();
+  }
+
+  SKITY_TRACE_EVENT(GPUShaderModule_ParseWGX);
+
+  parsed_ = true;
 
-  auto program = wgx::Program::Parse(desc.source);
+  auto program = wgx::Program::Parse(source_);
 
   if (program->GetDiagnosis()) {
     auto diagnosis = *(program->GetDiagnosis());
 
     LOGE("WGX: Failed to parse shader source > {} <, at {}:{} error : {}",
-         desc.label, diagnosis.line, diagnosis.column, diagnosis.message);
+         label_, diagnosis.line, diagnosis.column, diagnosis.message);
 
     return nullptr;
   }
 
-  auto module = std::make_shared<GPUShaderModule>();
-  module->label_ = desc.label;
-  module->program_ = std::move(program);
+  program_ = std::move(program);
 
-  return module;
+  return program_.get();
 }
 
 }  // namespace skity
@@ -18,6 +18,9 @@ struct GPUShaderModuleDescriptor {
  * Shader module just holding the AST for given WGSL source code.
  * The actual shader translation is happend when create GPUShaderFunction from
  * this module.
+ *
+ * The source is only parsed the first time GetProgram() is called, so modules
+ * whose translation is found in the shader cache never touch wgx.
  */
 class GPUShaderModule {
  public:
@@ -32,11 +35,20 @@ class GPUShaderModule {
 
   const std::string& GetLabel() const { return label_; }
 
-  wgx::Program* GetProgram() const { return program_.get(); }
+  const std::string& GetSource() const { return source_; }
+
+  /**
+   * Get the parsed program of this module.
+   *
+   * @return the program or null if the source failed to parse
+   */
+  wgx::Program* GetProgram() const;
 
  private:
   std::string label_ = {};
-  std::unique_ptr<wgx::Program> program_ = {};
+  std::string source_ = {};
+  mutable bool parsed_ = false;
+  mutable std::unique_ptr<wgx::Program> program_ = {};
 };
 
 struct GPUShaderSourceWGX {
@@ -197,8 +197,7 @@ std::shared_ptr<GPUShaderFunction> GPUDeviceMTL::CreateShaderFunctionFromModule(
 
   GPUShaderSourceWGX* source = reinterpret_cast<GPUShaderSourceWGX*>(desc.shader_source);
 
-  if (!source->module || source->module->GetProgram() == nullptr ||
-      source->entry_point == nullptr) {
+  if (!source->module || source->entry_point == nullptr) {
     return {};
   }
 
@@ -209,7 +208,9 @@ std::shared_ptr<GPUShaderFunction> GPUDeviceMTL::CreateShaderFunctionFromModule(
   options.msl_version_minor = 0;
 
   auto wgx_result =
-      source->module->GetProgram()->WriteToMsl(source->entry_point, options, source->context);
+      TranslateShaderSource(*source, "msl-2.0", [&](const wgx::Program& program) {
+        return program.WriteToMsl(source->entry_point, options, source->context);
+      });
 
   if (!wgx_result.success) {
     if (desc.error_callback) {
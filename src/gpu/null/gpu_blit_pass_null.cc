@@ -0,0 +1,35 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_blit_pass_null.hpp"
+
+#include "src/gpu/null/gpu_buffer_null.hpp"
+#include "src/gpu/null/gpu_device_null.hpp"
+
+namespace skity {
+
+void GPUBlitPassNull::UploadTextureData(std::shared_ptr<GPUTexture> texture,
+                                        uint32_t offset_x, uint32_t offset_y,
+                                        uint32_t width, uint32_t height,
+                                        void* data) {
+  if (!texture) {
+    return;
+  }
+
+  // the texture counts the uploaded bytes itself
+  texture->UploadData(offset_x, offset_y, width, height, data);
+}
+
+void GPUBlitPassNull::UploadBufferData(GPUBuffer* buffer, void* data,
+                                       size_t size) {
+  if (buffer == nullptr) {
+    return;
+  }
+
+  GPUBufferNull::Cast(buffer)->UploadData(data, size);
+
+  device_->GetMutableStats().buffer_upload_bytes += size;
+}
+
+}  // namespace skity
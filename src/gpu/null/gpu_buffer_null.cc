@@ -0,0 +1,19 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_buffer_null.hpp"
+
+namespace skity {
+
+GPUBufferNull::GPUBufferNull(GPUBufferUsageMask usage) : GPUBuffer(usage) {}
+
+GPUBufferNull::~GPUBufferNull() = default;
+
+void GPUBufferNull::UploadData(const void* data, size_t size) {
+  auto bytes = static_cast<const uint8_t*>(data);
+
+  data_.assign(bytes, bytes + size);
+}
+
+}  // namespace skity
@@ -0,0 +1,37 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_BUFFER_NULL_HPP
+#define SRC_GPU_NULL_GPU_BUFFER_NULL_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "src/gpu/backend_cast.hpp"
+#include "src/gpu/gpu_buffer.hpp"
+
+namespace skity {
+
+class GPUBufferNull : public GPUBuffer {
+ public:
+  explicit GPUBufferNull(GPUBufferUsageMask usage);
+
+  ~GPUBufferNull() override;
+
+  /**
+   * Replace the content of this buffer, the same as glBufferData.
+   */
+  void UploadData(const void* data, size_t size);
+
+  const std::vector<uint8_t>& GetData() const { return data_; }
+
+  SKT_BACKEND_CAST(GPUBufferNull, GPUBuffer)
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_BUFFER_NULL_HPP
@@ -0,0 +1,28 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_command_buffer_null.hpp"
+
+#include "src/gpu/null/gpu_blit_pass_null.hpp"
+#include "src/gpu/null/gpu_device_null.hpp"
+#include "src/gpu/null/gpu_render_pass_null.hpp"
+
+namespace skity {
+
+std::shared_ptr<GPURenderPass> GPUCommandBufferNull::BeginRenderPass(
+    const GPURenderPassDescriptor& desc) {
+  return std::make_shared<GPURenderPassNull>(desc, device_);
+}
+
+std::shared_ptr<GPUBlitPass> GPUCommandBufferNull::BeginBlitPass() {
+  return std::make_shared<GPUBlitPassNull>(device_);
+}
+
+bool GPUCommandBufferNull::Submit() {
+  device_->GetMutableStats().submit_count++;
+
+  return true;
+}
+
+}  // namespace skity
@@ -0,0 +1,35 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_COMMAND_BUFFER_NULL_HPP
+#define SRC_GPU_NULL_GPU_COMMAND_BUFFER_NULL_HPP
+
+#include <memory>
+
+#include "src/gpu/gpu_command_buffer.hpp"
+
+namespace skity {
+
+class GPUDeviceNull;
+
+class GPUCommandBufferNull : public GPUCommandBuffer {
+ public:
+  explicit GPUCommandBufferNull(GPUDeviceNull* device) : device_(device) {}
+
+  ~GPUCommandBufferNull() override = default;
+
+  std::shared_ptr<GPURenderPass> BeginRenderPass(
+      const GPURenderPassDescriptor& desc) override;
+
+  std::shared_ptr<GPUBlitPass> BeginBlitPass() override;
+
+  bool Submit() override;
+
+ private:
+  GPUDeviceNull* device_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_COMMAND_BUFFER_NULL_HPP
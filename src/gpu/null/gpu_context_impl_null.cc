@@ -0,0 +1,108 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_context_impl_null.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <skity/io/data.hpp>
+
+#include "src/gpu/null/gpu_surface_null.hpp"
+#include "src/gpu/null/gpu_texture_null.hpp"
+
+namespace skity {
+
+std::unique_ptr<GPUContextImplNull> NullContextCreate() {
+  auto ctx = std::make_unique<GPUContextImplNull>();
+
+  if (!ctx->Init()) {
+    return nullptr;
+  }
+
+  return ctx;
+}
+
+GPUContextImplNull::GPUContextImplNull()
+    : GPUContextImpl(GPUBackendType::kNone) {}
+
+std::unique_ptr<GPUSurface> GPUContextImplNull::CreateSurface(
+    GPUSurfaceDescriptor* desc) {
+  if (desc == nullptr || desc->backend != GPUBackendType::kNone ||
+      desc->width == 0 || desc->height == 0) {
+    return {};
+  }
+
+  auto surface = std::make_unique<GPUSurfaceNull>(*desc, this, nullptr);
+
+  surface->Init();
+
+  return surface;
+}
+
+std::unique_ptr<GPUSurface> GPUContextImplNull::CreateFxaaSurface(
+    GPUSurfaceDescriptor* desc) {
+  return {};
+}
+
+std::unique_ptr<GPUDevice> GPUContextImplNull::CreateGPUDevice() {
+  return std::make_unique<GPUDeviceNull>();
+}
+
+std::shared_ptr<GPUTexture> GPUContextImplNull::OnWrapTexture(
+    GPUBackendTextureInfo* info, ReleaseCallback callback,
+    ReleaseUserData user_data) {
+  // there is no backend object to wrap, a new empty texture stands in for it
+  GPUTextureDescriptor desc{};
+  desc.width = info->width;
+  desc.height = info->height;
+  desc.format = static_cast<GPUTextureFormat>(info->format);
+  desc.usage =
+      static_cast<GPUTextureUsageMask>(GPUTextureUsage::kTextureBinding);
+  desc.storage_mode = GPUTextureStorageMode::kHostVisible;
+
+  auto texture = GetGPUDevice()->CreateTexture(desc);
+
+  if (texture) {
+    texture->SetRelease(callback, user_data);
+  }
+
+  return texture;
+}
+
+std::unique_ptr<GPURenderTarget> GPUContextImplNull::OnCreateRenderTarget(
+    const GPURenderTargetDescriptor& desc, std::shared_ptr<Texture> texture) {
+  GPUSurfaceDescriptor surface_desc{};
+  surface_desc.backend = GetBackendType();
+  surface_desc.width = desc.width;
+  surface_desc.height = desc.height;
+  surface_desc.content_scale = 1.0;
+  surface_desc.sample_count = desc.sample_count;
+
+  auto surface = std::make_unique<GPUSurfaceNull>(surface_desc, this,
+                                                  texture->GetGPUTexture());
+
+  surface->Init();
+
+  return std::make_unique<GPURenderTarget>(std::move(surface), texture);
+}
+
+std::shared_ptr<Data> GPUContextImplNull::OnReadPixels(
+    const std::shared_ptr<GPUTexture>& texture) const {
+  const auto& pixels = GPUTextureNull::Cast(texture.get())->GetPixels();
+
+  void* buffer = std::calloc(1, texture->GetBytes());
+
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+
+  // nothing is rasterized, only uploaded pixels can be read back
+  std::memcpy(buffer, pixels.data(),
+              std::min(pixels.size(), texture->GetBytes()));
+
+  return Data::MakeFromMalloc(buffer, texture->GetBytes());
+}
+
+}  // namespace skity
@@ -0,0 +1,64 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_CONTEXT_IMPL_NULL_HPP
+#define SRC_GPU_NULL_GPU_CONTEXT_IMPL_NULL_HPP
+
+#include <memory>
+
+#include "src/gpu/gpu_context_impl.hpp"
+#include "src/gpu/null/gpu_device_null.hpp"
+
+namespace skity {
+
+/**
+ * GPUContext backed by GPUDeviceNull. Surfaces created by this context accept
+ * any drawing without rendering it, see GPUNullStats for what is recorded.
+ *
+ * Surfaces are created with a GPUSurfaceDescriptor whose backend is
+ * GPUBackendType::kNone.
+ */
+class GPUContextImplNull : public GPUContextImpl {
+ public:
+  GPUContextImplNull();
+
+  ~GPUContextImplNull() override = default;
+
+  std::unique_ptr<GPUSurface> CreateSurface(
+      GPUSurfaceDescriptor* desc) override;
+
+  std::unique_ptr<GPUSurface> CreateFxaaSurface(
+      GPUSurfaceDescriptor* desc) override;
+
+  const GPUNullStats& GetStats() const {
+    return GPUDeviceNull::Cast(GetGPUDevice())->GetStats();
+  }
+
+  void ResetStats() { GPUDeviceNull::Cast(GetGPUDevice())->ResetStats(); }
+
+ protected:
+  std::unique_ptr<GPUDevice> CreateGPUDevice() override;
+
+  std::shared_ptr<GPUTexture> OnWrapTexture(GPUBackendTextureInfo* info,
+                                            ReleaseCallback callback,
+                                            ReleaseUserData user_data) override;
+
+  std::unique_ptr<GPURenderTarget> OnCreateRenderTarget(
+      const GPURenderTargetDescriptor& desc,
+      std::shared_ptr<Texture> texture) override;
+
+  std::shared_ptr<Data> OnReadPixels(
+      const std::shared_ptr<GPUTexture>& texture) const override;
+};
+
+/**
+ * Create a GPUContext running the HW renderer without any GPU.
+ *
+ * @return the context or null if initialization failed
+ */
+std::unique_ptr<GPUContextImplNull> NullContextCreate();
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_CONTEXT_IMPL_NULL_HPP
@@ -0,0 +1,107 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_device_null.hpp"
+
+#include "src/gpu/null/gpu_buffer_null.hpp"
+#include "src/gpu/null/gpu_command_buffer_null.hpp"
+#include "src/gpu/null/gpu_sampler_null.hpp"
+#include "src/gpu/null/gpu_shader_function_null.hpp"
+#include "src/gpu/null/gpu_texture_null.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+GPUDeviceNull::GPUDeviceNull() = default;
+
+GPUDeviceNull::~GPUDeviceNull() = default;
+
+std::unique_ptr<GPUBuffer> GPUDeviceNull::CreateBuffer(
+    GPUBufferUsageMask usage) {
+  return std::make_unique<GPUBufferNull>(usage);
+}
+
+std::shared_ptr<GPUShaderFunction> GPUDeviceNull::CreateShaderFunction(
+    const GPUShaderFunctionDescriptor& desc) {
+  SKITY_TRACE_EVENT(GPUDeviceNull_CreateShaderFunction);
+
+  auto function = std::make_shared<GPUShaderFunctionNull>(desc.label);
+
+  if (desc.source_type != GPUShaderSourceType::kWGX) {
+    // raw sources are already in a target shading language and have no
+    // reflection information
+    return function;
+  }
+
+  auto source = reinterpret_cast<GPUShaderSourceWGX*>(desc.shader_source);
+
+  if (source == nullptr || !source->module || source->entry_point == nullptr) {
+    return {};
+  }
+
+  // there is no target language, the bind groups are taken from the WGSL
+  // source the same way as the WebGPU backend does
+  auto program = source->module->GetProgram();
+
+  if (program == nullptr) {
+    if (desc.error_callback) {
+      desc.error_callback("WGX parse error");
+    }
+
+    return {};
+  }
+
+  function->SetBindGroups(program->GetWGSLBindGroups(source->entry_point));
+  function->SetWGXContext(source->context);
+
+  return function;
+}
+
+std::unique_ptr<GPURenderPipeline> GPUDeviceNull::CreateRenderPipeline(
+    const GPURenderPipelineDescriptor& desc) {
+  if (!desc.vertex_function || !desc.fragment_function) {
+    return nullptr;
+  }
+
+  auto pipeline = std::make_unique<GPURenderPipeline>(desc);
+
+  if (!pipeline->IsValid()) {
+    return nullptr;
+  }
+
+  stats_.pipeline_count++;
+
+  return pipeline;
+}
+
+std::unique_ptr<GPURenderPipeline> GPUDeviceNull::ClonePipeline(
+    GPURenderPipeline* base, const GPURenderPipelineDescriptor& desc) {
+  if (!base->IsValid()) {
+    return nullptr;
+  }
+
+  return CreateRenderPipeline(desc);
+}
+
+std::shared_ptr<GPUCommandBuffer> GPUDeviceNull::CreateCommandBuffer() {
+  return std::make_shared<GPUCommandBufferNull>(this);
+}
+
+std::shared_ptr<GPUSampler> GPUDeviceNull::CreateSampler(
+    const GPUSamplerDescriptor& desc) {
+  auto it = sampler_map_.find(desc);
+  if (it != sampler_map_.end()) {
+    return it->second;
+  }
+  auto sampler = std::make_shared<GPUSamplerNull>(desc);
+  sampler_map_.insert({desc, sampler});
+  return sampler;
+}
+
+std::shared_ptr<GPUTexture> GPUDeviceNull::CreateTexture(
+    const GPUTextureDescriptor& desc) {
+  return GPUTextureNull::Create(this, desc);
+}
+
+}  // namespace skity
@@ -0,0 +1,126 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_DEVICE_NULL_HPP
+#define SRC_GPU_NULL_GPU_DEVICE_NULL_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "src/gpu/backend_cast.hpp"
+#include "src/gpu/gpu_device.hpp"
+
+namespace skity {
+
+/**
+ * @struct GPUNullStats
+ *
+ * Work recorded by the null backend since the device was created or the last
+ * call to GPUDeviceNull::ResetStats().
+ */
+struct GPUNullStats {
+  /**
+   * command buffers submitted
+   */
+  uint32_t submit_count = 0;
+  /**
+   * render passes encoded
+   */
+  uint32_t render_pass_count = 0;
+  /**
+   * valid commands encoded in all render passes
+   */
+  uint32_t draw_call_count = 0;
+  /**
+   * draw calls using an instance buffer
+   */
+  uint32_t instanced_draw_call_count = 0;
+  /**
+   * draw calls using a different pipeline than the previous one in the same
+   * render pass
+   */
+  uint32_t pipeline_switch_count = 0;
+  /**
+   * uniform buffers bound by all draw calls
+   */
+  uint32_t uniform_binding_count = 0;
+  /**
+   * textures bound by all draw calls
+   */
+  uint32_t texture_binding_count = 0;
+  /**
+   * indices drawn by all draw calls
+   */
+  uint64_t index_count = 0;
+  /**
+   * bytes uploaded into vertex, index and uniform buffers
+   */
+  uint64_t buffer_upload_bytes = 0;
+  /**
+   * bytes uploaded into textures
+   */
+  uint64_t texture_upload_bytes = 0;
+  /**
+   * render pipelines created, including clones
+   */
+  uint32_t pipeline_count = 0;
+  /**
+   * textures created
+   */
+  uint32_t texture_count = 0;
+};
+
+/**
+ * A GPUDevice without a driver. Buffers and textures keep the uploaded data in
+ * memory and render passes only record and count their commands, so the CPU
+ * side of the HW renderer can run and be measured on a machine without GPU.
+ */
+class GPUDeviceNull : public GPUDevice {
+ public:
+  GPUDeviceNull();
+
+  ~GPUDeviceNull() override;
+
+  std::unique_ptr<GPUBuffer> CreateBuffer(GPUBufferUsageMask usage) override;
+
+  std::shared_ptr<GPUShaderFunction> CreateShaderFunction(
+      const GPUShaderFunctionDescriptor& desc) override;
+
+  std::unique_ptr<GPURenderPipeline> CreateRenderPipeline(
+      const GPURenderPipelineDescriptor& desc) override;
+
+  std::unique_ptr<GPURenderPipeline> ClonePipeline(
+      GPURenderPipeline* base,
+      const GPURenderPipelineDescriptor& desc) override;
+
+  std::shared_ptr<GPUCommandBuffer> CreateCommandBuffer() override;
+
+  std::shared_ptr<GPUSampler> CreateSampler(
+      const GPUSamplerDescriptor& desc) override;
+
+  std::shared_ptr<GPUTexture> CreateTexture(
+      const GPUTextureDescriptor& desc) override;
+
+  bool CanUseMSAA() override { return true; }
+
+  uint32_t GetBufferAlignment() override { return 256; }
+
+  uint32_t GetMaxTextureSize() override { return 16384; }
+
+  const GPUNullStats& GetStats() const { return stats_; }
+
+  GPUNullStats& GetMutableStats() { return stats_; }
+
+  void ResetStats() { stats_ = {}; }
+
+  SKT_BACKEND_CAST(GPUDeviceNull, GPUDevice)
+
+ private:
+  GPUSamplerMap sampler_map_;
+  GPUNullStats stats_ = {};
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_DEVICE_NULL_HPP
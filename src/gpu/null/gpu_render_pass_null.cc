@@ -0,0 +1,38 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_render_pass_null.hpp"
+
+#include "src/gpu/null/gpu_device_null.hpp"
+
+namespace skity {
+
+void GPURenderPassNull::EncodeCommands(std::optional<GPUViewport> viewport,
+                                       std::optional<GPUScissorRect> scissor) {
+  auto& stats = device_->GetMutableStats();
+
+  stats.render_pass_count++;
+
+  GPURenderPipeline* current_pipeline = nullptr;
+
+  for (auto* command : GetCommands()) {
+    stats.draw_call_count++;
+    stats.index_count += command->index_count;
+
+    if (command->IsInstanced()) {
+      stats.instanced_draw_call_count++;
+    }
+
+    if (command->pipeline != current_pipeline) {
+      current_pipeline = command->pipeline;
+      stats.pipeline_switch_count++;
+    }
+
+    stats.uniform_binding_count += command->uniform_bindings.size();
+    stats.texture_binding_count += command->texture_sampler_bindings.size() +
+                                   command->texture_bindings.size();
+  }
+}
+
+}  // namespace skity
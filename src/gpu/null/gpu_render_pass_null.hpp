@@ -0,0 +1,35 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_RENDER_PASS_NULL_HPP
+#define SRC_GPU_NULL_GPU_RENDER_PASS_NULL_HPP
+
+#include "src/gpu/gpu_render_pass.hpp"
+
+namespace skity {
+
+class GPUDeviceNull;
+
+/**
+ * Render pass of the null backend. The commands are only walked to count the
+ * work a real backend would have to submit.
+ */
+class GPURenderPassNull : public GPURenderPass {
+ public:
+  GPURenderPassNull(const GPURenderPassDescriptor& desc, GPUDeviceNull* device)
+      : GPURenderPass(desc), device_(device) {}
+
+  ~GPURenderPassNull() override = default;
+
+  void EncodeCommands(
+      std::optional<GPUViewport> viewport = std::nullopt,
+      std::optional<GPUScissorRect> scissor = std::nullopt) override;
+
+ private:
+  GPUDeviceNull* device_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_RENDER_PASS_NULL_HPP
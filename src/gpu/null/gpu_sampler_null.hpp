@@ -0,0 +1,22 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_SAMPLER_NULL_HPP
+#define SRC_GPU_NULL_GPU_SAMPLER_NULL_HPP
+
+#include "src/gpu/gpu_sampler.hpp"
+
+namespace skity {
+
+class GPUSamplerNull : public GPUSampler {
+ public:
+  explicit GPUSamplerNull(const GPUSamplerDescriptor& descriptor)
+      : GPUSampler(descriptor) {}
+
+  ~GPUSamplerNull() override = default;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_SAMPLER_NULL_HPP
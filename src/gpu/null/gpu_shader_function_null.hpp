@@ -0,0 +1,30 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_SHADER_FUNCTION_NULL_HPP
+#define SRC_GPU_NULL_GPU_SHADER_FUNCTION_NULL_HPP
+
+#include <string>
+
+#include "src/gpu/gpu_shader_function.hpp"
+
+namespace skity {
+
+/**
+ * Shader function of the null backend. Nothing is compiled, only the bind
+ * groups of the WGSL entry point are kept so draws can bind their resources.
+ */
+class GPUShaderFunctionNull : public GPUShaderFunction {
+ public:
+  explicit GPUShaderFunctionNull(std::string label)
+      : GPUShaderFunction(std::move(label)) {}
+
+  ~GPUShaderFunctionNull() override = default;
+
+  bool IsValid() const override { return true; }
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_SHADER_FUNCTION_NULL_HPP
@@ -0,0 +1,45 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_surface_null.hpp"
+
+#include <cmath>
+
+#include "src/render/hw/null/null_root_layer.hpp"
+
+namespace skity {
+
+GPUSurfaceNull::GPUSurfaceNull(const GPUSurfaceDescriptor& desc,
+                               GPUContextImpl* ctx,
+                               std::shared_ptr<GPUTexture> texture)
+    : GPUSurfaceImpl(desc, ctx), color_attachment_(std::move(texture)) {}
+
+void GPUSurfaceNull::Init() {
+  if (color_attachment_) {
+    return;
+  }
+
+  GPUTextureDescriptor desc{};
+  desc.format = GetGPUFormat();
+  desc.width = static_cast<uint32_t>(std::floor(GetWidth() * ContentScale()));
+  desc.height = static_cast<uint32_t>(std::floor(GetHeight() * ContentScale()));
+  desc.usage =
+      static_cast<GPUTextureUsageMask>(GPUTextureUsage::kRenderAttachment);
+  desc.storage_mode = GPUTextureStorageMode::kPrivate;
+
+  color_attachment_ = GetGPUContext()->GetGPUDevice()->CreateTexture(desc);
+}
+
+HWRootLayer* GPUSurfaceNull::OnBeginNextFrame(bool clear) {
+  auto root_layer = GetArenaAllocator()->Make<NullRootLayer>(
+      color_attachment_, Rect::MakeWH(GetWidth(), GetHeight()));
+
+  root_layer->SetClearSurface(clear);
+  root_layer->SetSampleCount(GetSampleCount());
+  root_layer->SetArenaAllocator(GetArenaAllocator());
+
+  return root_layer;
+}
+
+}  // namespace skity
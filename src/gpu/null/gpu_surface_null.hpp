@@ -0,0 +1,46 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_SURFACE_NULL_HPP
+#define SRC_GPU_NULL_GPU_SURFACE_NULL_HPP
+
+#include <memory>
+
+#include "src/gpu/gpu_surface_impl.hpp"
+
+namespace skity {
+
+class GPUSurfaceNull : public GPUSurfaceImpl {
+ public:
+  /**
+   * @param texture the color attachment, or null to let Init() create one
+   *                matching the surface size
+   */
+  GPUSurfaceNull(const GPUSurfaceDescriptor& desc, GPUContextImpl* ctx,
+                 std::shared_ptr<GPUTexture> texture);
+
+  ~GPUSurfaceNull() override = default;
+
+  void Init();
+
+  std::shared_ptr<Pixmap> ReadPixels(const Rect& rect) override {
+    return nullptr;
+  }
+
+  GPUTextureFormat GetGPUFormat() const override {
+    return GPUTextureFormat::kRGBA8Unorm;
+  }
+
+ protected:
+  HWRootLayer* OnBeginNextFrame(bool clear) override;
+
+  void OnFlush() override {}
+
+ private:
+  std::shared_ptr<GPUTexture> color_attachment_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_SURFACE_NULL_HPP
@@ -0,0 +1,63 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/null/gpu_texture_null.hpp"
+
+#include <cstring>
+
+#include "src/gpu/null/gpu_device_null.hpp"
+
+namespace skity {
+
+GPUTextureNull::GPUTextureNull(const GPUTextureDescriptor& descriptor,
+                               GPUDeviceNull* device)
+    : GPUTexture(descriptor), device_(device) {}
+
+GPUTextureNull::~GPUTextureNull() = default;
+
+size_t GPUTextureNull::GetBytes() const {
+  auto& desc = GetDescriptor();
+  return desc.width * desc.height * GetTextureFormatBytesPerPixel(desc.format) *
+         desc.sample_count;
+}
+
+void GPUTextureNull::UploadData(uint32_t offset_x, uint32_t offset_y,
+                                uint32_t width, uint32_t height, void* data) {
+  auto& desc = GetDescriptor();
+  size_t bpp = GetTextureFormatBytesPerPixel(desc.format);
+
+  if (data == nullptr || bpp == 0 || offset_x + width > desc.width ||
+      offset_y + height > desc.height) {
+    return;
+  }
+
+  // only allocated on the first upload, most render attachments never need it
+  if (pixels_.empty()) {
+    pixels_.resize(desc.width * desc.height * bpp);
+  }
+
+  auto src = static_cast<const uint8_t*>(data);
+  size_t row_bytes = width * bpp;
+
+  for (uint32_t y = 0; y < height; y++) {
+    std::memcpy(pixels_.data() + ((offset_y + y) * desc.width + offset_x) * bpp,
+                src + y * row_bytes, row_bytes);
+  }
+
+  device_->GetMutableStats().texture_upload_bytes += row_bytes * height;
+}
+
+std::shared_ptr<GPUTexture> GPUTextureNull::Create(
+    GPUDeviceNull* device, const GPUTextureDescriptor& desc) {
+  if (desc.width == 0 || desc.height == 0 ||
+      desc.format == GPUTextureFormat::kInvalid) {
+    return nullptr;
+  }
+
+  device->GetMutableStats().texture_count++;
+
+  return std::make_shared<GPUTextureNull>(desc, device);
+}
+
+}  // namespace skity
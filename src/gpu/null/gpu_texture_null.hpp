@@ -0,0 +1,49 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GPU_NULL_GPU_TEXTURE_NULL_HPP
+#define SRC_GPU_NULL_GPU_TEXTURE_NULL_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "src/gpu/backend_cast.hpp"
+#include "src/gpu/gpu_texture.hpp"
+
+namespace skity {
+
+class GPUDeviceNull;
+
+class GPUTextureNull : public GPUTexture {
+ public:
+  GPUTextureNull(const GPUTextureDescriptor& descriptor,
+                 GPUDeviceNull* device);
+
+  ~GPUTextureNull() override;
+
+  size_t GetBytes() const override;
+
+  void UploadData(uint32_t offset_x, uint32_t offset_y, uint32_t width,
+                  uint32_t height, void* data) override;
+
+  /**
+   * The uploaded pixels, tightly packed. Empty if nothing was ever uploaded,
+   * render attachments are never written since nothing is rasterized.
+   */
+  const std::vector<uint8_t>& GetPixels() const { return pixels_; }
+
+  static std::shared_ptr<GPUTexture> Create(GPUDeviceNull* device,
+                                            const GPUTextureDescriptor& desc);
+
+  SKT_BACKEND_CAST(GPUTextureNull, GPUTexture)
+
+ private:
+  GPUDeviceNull* device_;
+  std::vector<uint8_t> pixels_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GPU_NULL_GPU_TEXTURE_NULL_HPP
@@ -49,7 +49,7 @@ std::shared_ptr<GPUShaderModule> GPUShaderModuleWEB::Create(
   // to get the reflect info from WGPUShaderModule
   auto base_module = GPUShaderModule::Create(desc);
 
-  if (!base_module) {
+  if (!base_module || base_module->GetProgram() == nullptr) {
     return {};
   }
 
@@ -6,6 +6,7 @@
 
 #include "src/graphic/contour_measure.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <tuple>
@@ -553,6 +554,13 @@ ContourMeasure::ContourMeasure(std::vector<Segment>&& segs,
 
 bool ContourMeasure::getPosTan(float distance, Point* position,
                                Vector* tangent) const {
+  Cursor cursor;
+  cursor.index = static_cast<uint32_t>(segments_.size());
+  return getPosTan(distance, position, tangent, &cursor);
+}
+
+bool ContourMeasure::getPosTan(float distance, Point* position,
+                               Vector* tangent, Cursor* cursor) const {
   if (FloatIsNan(distance)) {
     return false;
   }
@@ -568,7 +576,7 @@ bool ContourMeasure::getPosTan(float distance, Point* position,
 
   float t;
 
-  const Segment* seg = this->distanceToSegment(distance, &t);
+  const Segment* seg = this->distanceToSegment(distance, &t, cursor);
   if (FloatIsNan(t)) {
     return false;
   }
@@ -580,6 +588,13 @@ bool ContourMeasure::getPosTan(float distance, Point* position,
 
 bool ContourMeasure::getSegment(float startD, float stopD, Path* dst,
                                 bool startWithMoveTo) const {
+  Cursor cursor;
+  cursor.index = static_cast<uint32_t>(segments_.size());
+  return getSegment(startD, stopD, dst, startWithMoveTo, &cursor);
+}
+
+bool ContourMeasure::getSegment(float startD, float stopD, Path* dst,
+                                bool startWithMoveTo, Cursor* cursor) const {
   assert(dst);
 
   float length = this->length();
@@ -601,12 +616,12 @@ bool ContourMeasure::getSegment(float startD, float stopD, Path* dst,
 
   Point p;
   float startT, stopT;
-  const Segment* seg = this->distanceToSegment(startD, &startT);
+  const Segment* seg = this->distanceToSegment(startD, &startT, cursor);
   if (!FloatIsFinite(startT)) {
     return false;
   }
 
-  const Segment* stopSeg = this->distanceToSegment(stopD, &stopT);
+  const Segment* stopSeg = this->distanceToSegment(stopD, &stopT, cursor);
   if (!FloatIsFinite(stopT)) {
     return false;
   }
@@ -633,6 +648,34 @@ bool ContourMeasure::getSegment(float startD, float stopD, Path* dst,
   return true;
 }
 
+bool ContourMeasure::getLine(float startD, float stopD, Point* start,
+                             Point* stop, Cursor* cursor) const {
+  if (!(startD >= 0 && startD <= stopD && stopD <= length_)) {
+    return false;
+  }
+
+  float startT, stopT;
+  const Segment* seg = this->distanceToSegment(startD, &startT, cursor);
+  if (seg->type != kLine_SegType) {
+    return false;
+  }
+
+  const Segment* stopSeg = this->distanceToSegment(stopD, &stopT, cursor);
+  if (stopSeg != seg || !FloatIsFinite(startT) || !FloatIsFinite(stopT)) {
+    return false;
+  }
+
+  // same as contour_measure_seg_to(), the end of the line is exact
+  const Point* pts = &pts_[seg->pt_index];
+  *start = Point{FloatInterp(pts[0].x, pts[1].x, startT),
+                 FloatInterp(pts[0].y, pts[1].y, startT), 0.f, 1.f};
+  *stop = stopT == Float1
+              ? pts[1]
+              : Point{FloatInterp(pts[0].x, pts[1].x, stopT),
+                      FloatInterp(pts[0].y, pts[1].y, stopT), 0.f, 1.f};
+  return true;
+}
+
 float ContourMeasure::Segment::getScalarT() const {
   return tValue2Float(t_value);
 }
@@ -648,10 +691,51 @@ const ContourMeasure::Segment* ContourMeasure::distanceToSegment(
   index ^= (index >> 31);
   seg = &seg[index];
 
+  *t = interpolateT(seg, distance);
+  return seg;
+}
+
+const ContourMeasure::Segment* ContourMeasure::distanceToSegment(
+    float distance, float* t, Cursor* cursor) const {
+  assert(distance >= 0 && distance <= this->length());
+
+  uint32_t count = static_cast<uint32_t>(segments_.size());
+  uint32_t index = cursor->index;
+
+  // the cursor is only valid if it is at or before the segment we want
+  if (index >= count ||
+      (index > 0 && segments_[index - 1].distance >= distance)) {
+    const Segment* seg = this->distanceToSegment(distance, t);
+    cursor->index = static_cast<uint32_t>(seg - segments_.data());
+    return seg;
+  }
+
+  // same result as the search, the first segment ending at or after distance.
+  // Close targets are walked to, far ones searched for in what is left.
+  constexpr uint32_t kMaxWalk = 8;
+  uint32_t walk_end = std::min(count - 1, index + kMaxWalk);
+  while (index < walk_end && segments_[index].distance < distance) {
+    index++;
+  }
+
+  if (index == walk_end && segments_[index].distance < distance) {
+    int found = TKSearch<Segment, float>(&segments_[index], count - index,
+                                         distance);
+    index += found ^ (found >> 31);
+    index = std::min(index, count - 1);
+  }
+  cursor->index = index;
+
+  const Segment* seg = &segments_[index];
+  *t = interpolateT(seg, distance);
+  return seg;
+}
+
+float ContourMeasure::interpolateT(const Segment* seg, float distance) const {
   // now interpolate t-values with prev segment (if possible)
   float startT = 0, startD = 0;
   // check if the prev segment is legal, and references the same set of points
-  if (index > 0) {
+  if (seg > segments_.data()) {
     startD = seg[-1].distance;
     if (seg[-1].pt_index == seg->pt_index) {
       assert(seg[-1].type == seg->type);
@@ -662,9 +746,8 @@ const ContourMeasure::Segment* ContourMeasure::distanceToSegment(
   assert(distance >= startD);
   assert(seg->distance > startD);
 
-  *t = startT + (seg->getScalarT() - startT) * (distance - startD) /
-                    (seg->distance - startD);
-  return seg;
+  return startT + (seg->getScalarT() - startT) * (distance - startD) /
+                      (seg->distance - startD);
 }
 
 }  // namespace skity
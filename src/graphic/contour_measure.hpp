@@ -31,6 +31,37 @@ class ContourMeasure {
   bool getSegment(float startD, float stopD, Path* dst,
                   bool startWithMoveTo) const;
 
+  /**
+   * Remembers the segment of the last lookup. Callers asking for increasing
+   * distances, like the dasher, walk the segments from there instead of
+   * searching them every time, far away distances are still searched.
+   */
+  struct Cursor {
+    uint32_t index = 0;
+  };
+
+  bool getSegment(float startD, float stopD, Path* dst, bool startWithMoveTo,
+                  Cursor* cursor) const;
+
+  /**
+   * If startD and stopD are on the same line of the contour, return the end
+   * points of the part between them. Otherwise return false, the part must
+   * be taken with getSegment().
+   */
+  bool getLine(float startD, float stopD, Point* start, Point* stop,
+               Cursor* cursor) const;
+
+  bool getPosTan(float distance, Point* position, Vector* tangent,
+                 Cursor* cursor) const;
+
+  /**
+   * Approximate memory held by the measured segments and points.
+   */
+  size_t approximateBytes() const {
+    return segments_.capacity() * sizeof(Segment) +
+           pts_.capacity() * sizeof(Point);
+  }
+
   bool isClosed() const { return is_closed_; }
 
   struct Segment {
@@ -58,6 +89,11 @@ class ContourMeasure {
  private:
   const Segment* distanceToSegment(float distance, float* t) const;
 
+  const Segment* distanceToSegment(float distance, float* t,
+                                   Cursor* cursor) const;
+
+  float interpolateT(const Segment* seg, float distance) const;
+
   friend class ContourMeasureiter;
 
  private:
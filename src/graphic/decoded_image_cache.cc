@@ -0,0 +1,153 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <iterator>
+#include <skity/graphic/decoded_image_cache.hpp>
+
+#include "src/graphic/decoded_image_cache_priv.hpp"
+#include "src/utils/no_destructor.hpp"
+
+namespace skity {
+
+DecodedPixelCache* DecodedPixelCache::GlobalDecodedPixelCache() {
+  static NoDestructor<DecodedPixelCache> cache;
+  return cache.get();
+}
+
+DecodedPixelCache::DecodedPixelCache()
+    : budget_(DecodedImageCache::kDefaultBudget) {}
+
+std::shared_ptr<Pixmap> DecodedPixelCache::Find(size_t image_id,
+                                                uint32_t width,
+                                                uint32_t height) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto range = entries_.equal_range(image_id);
+  auto best = lru_.end();
+  for (auto it = range.first; it != range.second; it++) {
+    const auto& pixmap = it->second->pixmap;
+    if (pixmap->Width() < width || pixmap->Height() < height) {
+      continue;
+    }
+
+    if (best == lru_.end() || it->second->bytes < best->bytes) {
+      best = it->second;
+    }
+  }
+
+  if (best == lru_.end()) {
+    stats_.miss_count++;
+    return nullptr;
+  }
+
+  stats_.hit_count++;
+  lru_.splice(lru_.begin(), lru_, best);
+
+  return best->pixmap;
+}
+
+void DecodedPixelCache::Insert(size_t image_id, std::shared_ptr<Pixmap> pixmap,
+                               uint64_t decode_time_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  stats_.decode_time_us += decode_time_us;
+
+  size_t bytes = pixmap->RowBytes() * pixmap->Height();
+  if (bytes > budget_) {
+    return;
+  }
+
+  lru_.push_front(Entry{image_id, std::move(pixmap), bytes});
+  entries_.emplace(image_id, lru_.begin());
+  resident_bytes_ += bytes;
+
+  PurgeToBudget();
+}
+
+void DecodedPixelCache::RemoveImage(size_t image_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto range = entries_.equal_range(image_id);
+  for (auto it = range.first; it != range.second; it++) {
+    resident_bytes_ -= it->second->bytes;
+    lru_.erase(it->second);
+  }
+
+  entries_.erase(range.first, range.second);
+}
+
+void DecodedPixelCache::SetBudget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  PurgeToBudget();
+}
+
+size_t DecodedPixelCache::GetBudget() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+void DecodedPixelCache::Purge() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  entries_.clear();
+  resident_bytes_ = 0;
+}
+
+DecodedImageCache::Stats DecodedPixelCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  DecodedImageCache::Stats stats = stats_;
+  stats.resident_count = lru_.size();
+  stats.resident_bytes = resident_bytes_;
+  stats.budget = budget_;
+
+  return stats;
+}
+
+void DecodedPixelCache::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = DecodedImageCache::Stats{};
+}
+
+void DecodedPixelCache::Remove(EntryList::iterator entry) {
+  auto range = entries_.equal_range(entry->image_id);
+  for (auto it = range.first; it != range.second; it++) {
+    if (it->second == entry) {
+      entries_.erase(it);
+      break;
+    }
+  }
+
+  resident_bytes_ -= entry->bytes;
+  lru_.erase(entry);
+}
+
+void DecodedPixelCache::PurgeToBudget() {
+  while (resident_bytes_ > budget_ && !lru_.empty()) {
+    Remove(std::prev(lru_.end()));
+  }
+}
+
+void DecodedImageCache::SetBudget(size_t bytes) {
+  DecodedPixelCache::GlobalDecodedPixelCache()->SetBudget(bytes);
+}
+
+size_t DecodedImageCache::GetBudget() {
+  return DecodedPixelCache::GlobalDecodedPixelCache()->GetBudget();
+}
+
+void DecodedImageCache::Purge() {
+  DecodedPixelCache::GlobalDecodedPixelCache()->Purge();
+}
+
+DecodedImageCache::Stats DecodedImageCache::GetStats() {
+  return DecodedPixelCache::GlobalDecodedPixelCache()->GetStats();
+}
+
+void DecodedImageCache::ResetStats() {
+  DecodedPixelCache::GlobalDecodedPixelCache()->ResetStats();
+}
+
+}  // namespace skity
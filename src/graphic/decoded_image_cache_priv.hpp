@@ -0,0 +1,79 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_GRAPHIC_DECODED_IMAGE_CACHE_PRIV_HPP
+#define SRC_GRAPHIC_DECODED_IMAGE_CACHE_PRIV_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <skity/graphic/decoded_image_cache.hpp>
+#include <skity/io/pixmap.hpp>
+#include <unordered_map>
+
+namespace skity {
+
+/**
+ * The cache behind DecodedImageCache. Entries are keyed by the unique id of
+ * the lazy image, an image may have several entries of different sizes.
+ */
+class DecodedPixelCache final {
+ public:
+  static DecodedPixelCache* GlobalDecodedPixelCache();
+
+  DecodedPixelCache();
+  ~DecodedPixelCache() = default;
+
+  /**
+   * Find the smallest cached pixels of the image covering width x height and
+   * count a hit or a miss.
+   */
+  std::shared_ptr<Pixmap> Find(size_t image_id, uint32_t width,
+                               uint32_t height);
+
+  /**
+   * Cache freshly generated pixels of the image. Pixels larger than the
+   * whole budget are not cached.
+   */
+  void Insert(size_t image_id, std::shared_ptr<Pixmap> pixmap,
+              uint64_t decode_time_us);
+
+  void RemoveImage(size_t image_id);
+
+  void SetBudget(size_t bytes);
+
+  size_t GetBudget();
+
+  void Purge();
+
+  DecodedImageCache::Stats GetStats();
+
+  void ResetStats();
+
+ private:
+  struct Entry {
+    size_t image_id;
+    std::shared_ptr<Pixmap> pixmap;
+    size_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void Remove(EntryList::iterator entry);
+
+  void PurgeToBudget();
+
+  std::mutex mutex_;
+  // most recently used first
+  EntryList lru_;
+  std::unordered_multimap<size_t, EntryList::iterator> entries_;
+  size_t budget_;
+  size_t resident_bytes_ = 0;
+  DecodedImageCache::Stats stats_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_GRAPHIC_DECODED_IMAGE_CACHE_PRIV_HPP
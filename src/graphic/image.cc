@@ -4,18 +4,23 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <mutex>
 #include <skity/gpu/gpu_context.hpp>
 #include <skity/gpu/gpu_render_target.hpp>
 #include <skity/gpu/texture.hpp>
 #include <skity/graphic/bitmap.hpp>
 #include <skity/graphic/image.hpp>
+#include <skity/graphic/image_generator.hpp>
 #include <skity/graphic/tile_mode.hpp>
 
 #include "src/gpu/gpu_context_impl.hpp"
 #include "src/gpu/texture_manager.hpp"
 #include "src/graphic/bitmap_sampler.hpp"
 #include "src/graphic/color_priv.hpp"
+#include "src/graphic/decoded_image_cache_priv.hpp"
+#include "src/utils/unique_id.hpp"
 
 namespace skity {
 namespace {
@@ -168,6 +173,97 @@ class PixmapImage : public Image {
   std::shared_ptr<Pixmap> pixmap_;
 };
 
+class LazyImage : public Image {
+ public:
+  explicit LazyImage(std::shared_ptr<ImageGenerator> generator)
+      : generator_(std::move(generator)) {
+    assert(generator_ != nullptr);
+  }
+
+  ~LazyImage() override {
+    DecodedPixelCache::GlobalDecodedPixelCache()->RemoveImage(id_.id);
+  }
+
+  bool IsTextureBackend() const override { return false; }
+
+  const std::shared_ptr<Texture>* GetTexture() const override {
+    return nullptr;
+  }
+
+  const std::shared_ptr<Pixmap>* GetPixmap() const override {
+    // callers expect pixels owned by the image, so the full size pixels stay
+    // alive with the image once they are asked for this way
+    {
+      std::lock_guard<std::mutex> lock(generate_mutex_);
+      if (full_pixmap_) {
+        return &full_pixmap_;
+      }
+    }
+
+    auto pixmap = GetDecodedPixmap(Width(), Height());
+
+    std::lock_guard<std::mutex> lock(generate_mutex_);
+    if (!full_pixmap_) {
+      full_pixmap_ = std::move(pixmap);
+    }
+
+    return full_pixmap_ ? &full_pixmap_ : nullptr;
+  }
+
+  size_t Width() const override { return generator_->Width(); }
+
+  size_t Height() const override { return generator_->Height(); }
+
+  AlphaType GetAlphaType() const override {
+    return generator_->GetAlphaType();
+  }
+
+  bool ScalePixels(std::shared_ptr<Pixmap> dst, GPUContext* context,
+                   const SamplingOptions& sampling_options) const override {
+    if (!dst) {
+      return false;
+    }
+
+    return ScalePixelsForPixmap(
+        dst, GetDecodedPixmap(dst->Width(), dst->Height()), sampling_options);
+  }
+
+  std::shared_ptr<Pixmap> GetDecodedPixmap(uint32_t width,
+                                           uint32_t height) const override {
+    auto cache = DecodedPixelCache::GlobalDecodedPixelCache();
+
+    // held across the lookup so concurrent draws of the same image wait for
+    // one generation instead of each generating the pixels
+    std::lock_guard<std::mutex> lock(generate_mutex_);
+
+    auto pixmap = cache->Find(id_.id, width, height);
+    if (pixmap) {
+      return pixmap;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pixmap = generator_->Generate(width, height);
+    auto decode_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    if (!pixmap || pixmap->Width() == 0 || pixmap->Height() == 0) {
+      return nullptr;
+    }
+
+    cache->Insert(id_.id, pixmap, decode_time.count());
+
+    return pixmap;
+  }
+
+  ImageType GetImageType() const override { return ImageType::kLazyGenerated; }
+
+ private:
+  std::shared_ptr<ImageGenerator> generator_;
+  UniqueID id_;
+  mutable std::mutex generate_mutex_;
+  mutable std::shared_ptr<Pixmap> full_pixmap_;
+};
+
 std::shared_ptr<Image> Image::MakeHWImage(std::shared_ptr<Texture> texture) {
   return std::shared_ptr<Image>(new TextureImage(texture));
 }
@@ -185,6 +281,16 @@ std::shared_ptr<Image> Image::MakeImage(std::shared_ptr<Pixmap> pixmap,
   }
 }
 
+std::shared_ptr<Image> Image::MakeLazyImage(
+    std::shared_ptr<ImageGenerator> generator) {
+  if (generator == nullptr || generator->Width() == 0 ||
+      generator->Height() == 0) {
+    return nullptr;
+  }
+
+  return std::shared_ptr<Image>(new LazyImage(std::move(generator)));
+}
+
 std::shared_ptr<DeferredTextureImage> Image::MakeDeferredTextureImage(
     TextureFormat format, size_t width, size_t height, AlphaType alpha_type) {
   return std::shared_ptr<DeferredTextureImage>(
@@ -4,6 +4,7 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <glm/gtc/matrix_transform.hpp>
@@ -1238,9 +1239,9 @@ Path Path::CopyWithMatrix(const Matrix& matrix) const {
   ret.fill_type_ = fill_type_;
 
   ret.points_.reserve(this->points_.capacity());
-  for (const auto& p : this->points_) {
-    ret.points_.emplace_back(matrix * p);
-  }
+  ret.points_.resize(this->points_.size());
+  matrix.MapPoints(ret.points_.data(), this->points_.data(),
+                   static_cast<int>(this->points_.size()));
 
   ret.conic_weights_ = conic_weights_;
   ret.verbs_ = verbs_;
@@ -1487,6 +1488,133 @@ bool Path::IsRect(Rect* rect, bool* is_closed, Direction* direction) const {
   return true;
 }
 
+// Whether `path` has the verbs and conic weights of `shape`, and points within
+// a small distance of the points of `shape`.
+static bool IsNearlyShape(const Path& path, const Path& shape) {
+  if (path.CountVerbs() != shape.CountVerbs() ||
+      path.CountPoints() != shape.CountPoints()) {
+    return false;
+  }
+
+  size_t conic_count = 0;
+  for (size_t i = 0; i < path.CountVerbs(); i++) {
+    if (path.GetVerb(i) != shape.GetVerb(i)) {
+      return false;
+    }
+    conic_count += path.GetVerb(i) == Path::Verb::kConic ? 1 : 0;
+  }
+
+  if (!std::equal(path.ConicWeights(), path.ConicWeights() + conic_count,
+                  shape.ConicWeights())) {
+    return false;
+  }
+
+  Rect bounds = shape.GetBounds();
+  float tolerance =
+      kNearlyZero * std::max({1.f, std::abs(bounds.Left()),
+                              std::abs(bounds.Right()), std::abs(bounds.Top()),
+                              std::abs(bounds.Bottom())});
+  for (size_t i = 0; i < path.CountPoints(); i++) {
+    Point a = path.GetPoint(i);
+    Point b = shape.GetPoint(i);
+    if (std::abs(a.x - b.x) > tolerance || std::abs(a.y - b.y) > tolerance) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Path::IsOval(Rect* oval) const {
+  // AddOval() writes kMove, four kConic and kClose
+  if (verbs_.size() != 6 || segment_masks_ != SegmentMask::kConic ||
+      !IsFinite()) {
+    return false;
+  }
+
+  Rect bounds = GetBounds();
+  if (bounds.IsEmpty()) {
+    return false;
+  }
+
+  for (auto dir : {Direction::kCW, Direction::kCCW}) {
+    for (uint32_t start = 0; start < 4; start++) {
+      Path shape;
+      shape.AddOval(bounds, dir, start);
+      if (IsNearlyShape(*this, shape)) {
+        if (oval) {
+          *oval = bounds;
+        }
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool Path::IsRRect(RRect* rrect) const {
+  // AddRRect() writes kMove, four kConic, three or four kLine and kClose,
+  // rects and ovals are written by AddRect() and AddOval() instead
+  if ((verbs_.size() != 9 && verbs_.size() != 10) ||
+      segment_masks_ != (SegmentMask::kLine | SegmentMask::kConic) ||
+      !IsFinite()) {
+    return false;
+  }
+
+  Rect bounds = GetBounds();
+  if (bounds.IsEmpty()) {
+    return false;
+  }
+
+  // the control point of every conic is a corner of the bounds, its end
+  // points are the radii away from that corner
+  std::array<Vec2, 4> radii{};
+  size_t pt_index = 0;
+  for (auto verb : verbs_) {
+    if (verb == Verb::kConic) {
+      const Point& from = points_[pt_index - 1];
+      const Point& ctrl = points_[pt_index];
+      const Point& to = points_[pt_index + 1];
+
+      bool left = std::abs(ctrl.x - bounds.Left()) <
+                  std::abs(ctrl.x - bounds.Right());
+      bool top = std::abs(ctrl.y - bounds.Top()) <
+                 std::abs(ctrl.y - bounds.Bottom());
+      RRect::Corner corner =
+          top ? (left ? RRect::kUpperLeft : RRect::kUpperRight)
+              : (left ? RRect::kLowerLeft : RRect::kLowerRight);
+
+      radii[corner] = Vec2{
+          std::max(std::abs(from.x - ctrl.x), std::abs(to.x - ctrl.x)),
+          std::max(std::abs(from.y - ctrl.y), std::abs(to.y - ctrl.y))};
+    }
+
+    pt_index += verb == Verb::kConic ? 2 : (verb == Verb::kClose ? 0 : 1);
+  }
+
+  RRect candidate;
+  candidate.SetRectRadii(bounds, radii.data());
+  if (candidate.IsRect() || candidate.IsOval() || candidate.IsEmpty()) {
+    return false;
+  }
+
+  for (auto dir : {Direction::kCW, Direction::kCCW}) {
+    for (uint32_t start = 0; start < 8; start++) {
+      Path shape;
+      shape.AddRRect(candidate, dir, start);
+      if (IsNearlyShape(*this, shape)) {
+        if (rrect) {
+          *rrect = candidate;
+        }
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 bool Path::Contains(float x, float y) const {
   if (IsEmpty()) {
     return false;
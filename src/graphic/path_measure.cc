@@ -4,27 +4,313 @@
 
 #include <skity/graphic/path_measure.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "src/base/hash.hpp"
+#include "src/geometry/math.hpp"
 #include "src/graphic/contour_measure.hpp"
+#include "src/utils/no_destructor.hpp"
 
 namespace skity {
+
+namespace {
+
+size_t CountConics(const Path& path) {
+  return std::count(path.VerbsBegin(), path.VerbsEnd(), Path::Verb::kConic);
+}
+
+uint32_t HashPath(const Path& path, bool force_closed, float res_scale) {
+  uint32_t hash = Hash32(&res_scale, sizeof(res_scale), force_closed);
+  hash = Hash32(path.VerbsBegin(), path.CountVerbs() * sizeof(Path::Verb),
+                hash);
+  hash = Hash32(path.Points(), path.CountPoints() * sizeof(Point), hash);
+  return Hash32(path.ConicWeights(), CountConics(path) * sizeof(float), hash);
+}
+
+bool SamePath(const Path& a, const Path& b) {
+  if (a.CountVerbs() != b.CountVerbs() || a.CountPoints() != b.CountPoints()) {
+    return false;
+  }
+
+  // same verbs means the same number of conic weights
+  return std::memcmp(a.VerbsBegin(), b.VerbsBegin(),
+                     a.CountVerbs() * sizeof(Path::Verb)) == 0 &&
+         std::memcmp(a.Points(), b.Points(),
+                     a.CountPoints() * sizeof(Point)) == 0 &&
+         std::memcmp(a.ConicWeights(), b.ConicWeights(),
+                     CountConics(a) * sizeof(float)) == 0;
+}
+
+/**
+ * Measures of recently measured paths, keyed by their content. Entries are
+ * purged in least recently used order once their memory exceeds the budget.
+ */
+class MeasuredPathCache final {
+ public:
+  static constexpr size_t kBudget = 4 * 1024 * 1024;
+
+  static MeasuredPathCache* GlobalMeasuredPathCache() {
+    static NoDestructor<MeasuredPathCache> cache;
+    return cache.get();
+  }
+
+  std::shared_ptr<const MeasuredPath> Find(uint32_t hash, const Path& path,
+                                           bool force_closed,
+                                           float res_scale) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = FindEntry(hash, path, force_closed, res_scale);
+    if (it == lru_.end()) {
+      return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it);
+    return it->measured;
+  }
+
+  void Insert(uint32_t hash, const Path& path, bool force_closed,
+              float res_scale, std::shared_ptr<const MeasuredPath> measured) {
+    size_t bytes = path.CountPoints() * sizeof(Point) + path.CountVerbs();
+    for (size_t i = 0; i < measured->CountContours(); i++) {
+      bytes += measured->GetContour(i)->approximateBytes();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // another thread measured the same path meanwhile
+    if (bytes > kBudget ||
+        FindEntry(hash, path, force_closed, res_scale) != lru_.end()) {
+      return;
+    }
+
+    lru_.push_front(
+        Entry{hash, path, force_closed, res_scale, std::move(measured), bytes});
+    entries_.emplace(hash, lru_.begin());
+    resident_bytes_ += bytes;
+
+    while (resident_bytes_ > kBudget) {
+      Remove(std::prev(lru_.end()));
+    }
+  }
+
+  void Purge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    lru_.clear();
+    entries_.clear();
+    resident_bytes_ = 0;
+  }
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    Path path;
+    bool force_closed;
+    float res_scale;
+    std::shared_ptr<const MeasuredPath> measured;
+    size_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // mutex_ must be held
+  EntryList::iterator FindEntry(uint32_t hash, const Path& path,
+                                bool force_closed, float res_scale) {
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; it++) {
+      const auto& entry = *it->second;
+      if (entry.force_closed == force_closed &&
+          entry.res_scale == res_scale && SamePath(entry.path, path)) {
+        return it->second;
+      }
+    }
+
+    return lru_.end();
+  }
+
+  // mutex_ must be held
+  void Remove(EntryList::iterator entry) {
+    auto range = entries_.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; it++) {
+      if (it->second == entry) {
+        entries_.erase(it);
+        break;
+      }
+    }
+
+    resident_bytes_ -= entry->bytes;
+    lru_.erase(entry);
+  }
+
+ private:
+  std::mutex mutex_;
+  EntryList lru_;
+  std::unordered_multimap<uint32_t, EntryList::iterator> entries_;
+  size_t resident_bytes_ = 0;
+};
+
+}  // namespace
+
+//--------------------------------- MeasuredPath --------------------
+
+std::shared_ptr<const MeasuredPath> MeasuredPath::Make(Path const& path,
+                                                       bool forceClosed,
+                                                       float resScale,
+                                                       bool cache) {
+  auto measured_cache = MeasuredPathCache::GlobalMeasuredPathCache();
+
+  uint32_t hash = 0;
+  if (cache) {
+    hash = HashPath(path, forceClosed, resScale);
+    auto measured = measured_cache->Find(hash, path, forceClosed, resScale);
+    if (measured) {
+      return measured;
+    }
+  }
+
+  std::vector<std::shared_ptr<ContourMeasure>> contours;
+  ContourMeasureIter iter(path, forceClosed, resScale);
+  while (auto contour = iter.next()) {
+    contours.emplace_back(std::move(contour));
+  }
+
+  auto measured = std::shared_ptr<const MeasuredPath>(
+      new MeasuredPath(std::move(contours)));
+
+  if (cache && measured->CountContours() > 0) {
+    measured_cache->Insert(hash, path, forceClosed, resScale, measured);
+  }
+
+  return measured;
+}
+
+void MeasuredPath::PurgeCache() {
+  MeasuredPathCache::GlobalMeasuredPathCache()->Purge();
+}
+
+MeasuredPath::MeasuredPath(
+    std::vector<std::shared_ptr<ContourMeasure>> contours)
+    : contours_(std::move(contours)) {
+  contour_ends_.reserve(contours_.size());
+  for (const auto& contour : contours_) {
+    length_ += contour->length();
+    contour_ends_.emplace_back(length_);
+  }
+}
+
+MeasuredPath::~MeasuredPath() = default;
+
+float MeasuredPath::GetContourLength(size_t index) const {
+  return contours_[index]->length();
+}
+
+bool MeasuredPath::IsContourClosed(size_t index) const {
+  return contours_[index]->isClosed();
+}
+
+size_t MeasuredPath::FindContour(float distance) const {
+  auto it =
+      std::lower_bound(contour_ends_.begin(), contour_ends_.end(), distance);
+  if (it == contour_ends_.end()) {
+    return contours_.size() - 1;
+  }
+
+  return static_cast<size_t>(it - contour_ends_.begin());
+}
+
+bool MeasuredPath::GetPosTan(float distance, Point* position,
+                             Vector* tangent) const {
+  return GetPosTans(&distance, 1, position, tangent);
+}
+
+bool MeasuredPath::GetPosTans(const float distances[], size_t count,
+                              Point positions[], Vector tangents[]) const {
+  if (contours_.empty()) {
+    return false;
+  }
+
+  size_t index = 0;
+  ContourMeasure::Cursor cursor;
+  for (size_t i = 0; i < count; i++) {
+    float distance = distances[i];
+    if (FloatIsNan(distance)) {
+      return false;
+    }
+
+    size_t found = index;
+    float start = found > 0 ? contour_ends_[found - 1] : 0.f;
+    if (distance < start) {
+      found = FindContour(distance);
+    } else {
+      // increasing distances walk forward like the segment cursor does
+      while (found + 1 < contours_.size() && contour_ends_[found] < distance) {
+        found++;
+      }
+    }
+
+    if (found != index) {
+      index = found;
+      cursor = ContourMeasure::Cursor{};
+    }
+
+    float offset = index > 0 ? contour_ends_[index - 1] : 0.f;
+    if (!contours_[index]->getPosTan(distance - offset, positions + i,
+                                     tangents ? tangents + i : nullptr,
+                                     &cursor)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool MeasuredPath::GetSegment(float startD, float stopD, Path* dst,
+                              bool startWithMoveTo) const {
+  startD = std::max(startD, 0.f);
+  stopD = std::min(stopD, length_);
+
+  if (!(startD <= stopD) || contours_.empty()) {  // catch NaN values as well
+    return false;
+  }
+
+  size_t first = FindContour(startD);
+  size_t last = FindContour(stopD);
+
+  bool result = false;
+  for (size_t i = first; i <= last; i++) {
+    float offset = i > 0 ? contour_ends_[i - 1] : 0.f;
+    float start = i == first ? startD - offset : 0.f;
+    float stop = i == last ? stopD - offset : contours_[i]->length();
+
+    result |= contours_[i]->getSegment(start, stop, dst,
+                                       i == first ? startWithMoveTo : true);
+  }
+
+  return result;
+}
+
+//--------------------------------- PathMeasure --------------------
+
 PathMeasure::PathMeasure() = default;
 
 PathMeasure::PathMeasure(Path const& path, bool forceClosed, float resScale)
-    : iter_(new ContourMeasureIter(path, forceClosed, resScale)) {
-  contour_ = iter_->next();
+    : measured_(MeasuredPath::Make(path, forceClosed, resScale)) {
+  if (measured_->CountContours() > 0) {
+    contour_ = measured_->GetContour(0);
+  }
 }
 
 PathMeasure::~PathMeasure() = default;
 
 void PathMeasure::SetPath(const Path* path, bool forceClosed) {
-  if (!iter_) {
-    skity::Path tmp{};
-    iter_ = std::make_unique<ContourMeasureIter>(path != nullptr ? *path : tmp,
-                                                 forceClosed, 1.f);
-  }
-
-  iter_->reset(path ? *path : Path{}, forceClosed);
-  contour_ = iter_->next();
+  measured_ = MeasuredPath::Make(path ? *path : Path{}, forceClosed);
+  contour_index_ = 0;
+  contour_ = measured_->CountContours() > 0 ? measured_->GetContour(0)
+                                            : nullptr;
 }
 
 float PathMeasure::GetLength() {
@@ -47,8 +333,13 @@ bool PathMeasure::GetSegment(float startD, float stopD, Path* dst,
 bool PathMeasure::IsClosed() { return contour_ && contour_->isClosed(); }
 
 bool PathMeasure::NextContour() {
-  contour_ = iter_->next();
-  return !!contour_;
+  if (!measured_ || contour_index_ + 1 >= measured_->CountContours()) {
+    contour_ = nullptr;
+    return false;
+  }
+
+  contour_ = measured_->GetContour(++contour_index_);
+  return true;
 }
 
 }  // namespace skity
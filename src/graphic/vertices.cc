@@ -0,0 +1,114 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <skity/graphic/vertices.hpp>
+
+namespace skity {
+
+namespace {
+
+std::vector<uint32_t> ToTriangleList(Vertices::VertexMode mode,
+                                     uint32_t vertex_count,
+                                     uint32_t index_count,
+                                     const uint32_t indices[]) {
+  uint32_t count = indices != nullptr ? index_count : vertex_count;
+  auto index_at = [&](uint32_t i) { return indices ? indices[i] : i; };
+
+  std::vector<uint32_t> triangles;
+  if (count < 3) {
+    return triangles;
+  }
+
+  switch (mode) {
+    case Vertices::VertexMode::kTriangles:
+      triangles.reserve(count - count % 3);
+      for (uint32_t i = 0; i + 2 < count; i += 3) {
+        triangles.push_back(index_at(i));
+        triangles.push_back(index_at(i + 1));
+        triangles.push_back(index_at(i + 2));
+      }
+      break;
+    case Vertices::VertexMode::kTriangleStrip:
+      triangles.reserve((count - 2) * 3);
+      for (uint32_t i = 0; i + 2 < count; i++) {
+        // swap the first two vertices of every odd triangle to keep the
+        // winding of the strip
+        bool odd = (i & 1) != 0;
+        triangles.push_back(index_at(odd ? i + 1 : i));
+        triangles.push_back(index_at(odd ? i : i + 1));
+        triangles.push_back(index_at(i + 2));
+      }
+      break;
+    case Vertices::VertexMode::kTriangleFan:
+      triangles.reserve((count - 2) * 3);
+      for (uint32_t i = 1; i + 1 < count; i++) {
+        triangles.push_back(index_at(0));
+        triangles.push_back(index_at(i));
+        triangles.push_back(index_at(i + 1));
+      }
+      break;
+  }
+
+  return triangles;
+}
+
+}  // namespace
+
+std::shared_ptr<Vertices> Vertices::MakeCopy(VertexMode mode,
+                                             uint32_t vertex_count,
+                                             const Vec2 positions[],
+                                             const Vec2 texs[],
+                                             const Color colors[],
+                                             uint32_t index_count,
+                                             const uint32_t indices[]) {
+  if (vertex_count == 0 || positions == nullptr) {
+    return nullptr;
+  }
+
+  if (indices != nullptr) {
+    for (uint32_t i = 0; i < index_count; i++) {
+      if (indices[i] >= vertex_count) {
+        return nullptr;
+      }
+    }
+  }
+
+  std::vector<Vec2> copied_texs;
+  if (texs != nullptr) {
+    copied_texs.assign(texs, texs + vertex_count);
+  }
+
+  std::vector<Color> copied_colors;
+  if (colors != nullptr) {
+    copied_colors.assign(colors, colors + vertex_count);
+  }
+
+  return std::make_shared<Vertices>(
+      std::vector<Vec2>(positions, positions + vertex_count),
+      std::move(copied_texs), std::move(copied_colors),
+      ToTriangleList(mode, vertex_count, index_count, indices));
+}
+
+Vertices::Vertices(std::vector<Vec2> positions, std::vector<Vec2> texs,
+                   std::vector<Color> colors, std::vector<uint32_t> indices)
+    : positions_(std::move(positions)),
+      texs_(std::move(texs)),
+      colors_(std::move(colors)),
+      indices_(std::move(indices)),
+      bounds_(Rect::MakeEmpty()) {
+  if (positions_.empty()) {
+    return;
+  }
+
+  Vec2 min = positions_.front();
+  Vec2 max = positions_.front();
+  for (const Vec2& p : positions_) {
+    min = Vec2::Min(min, p);
+    max = Vec2::Max(max, p);
+  }
+
+  bounds_.SetLTRB(min.x, min.y, max.x, max.y);
+}
+
+}  // namespace skity
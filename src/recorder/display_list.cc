@@ -4,18 +4,54 @@
 
 #include <skity/recorder/display_list.hpp>
 
+#include <vector>
+
+#include "src/recorder/display_list_paint_table.hpp"
+#include "src/recorder/display_list_rtree.hpp"
 #include "src/recorder/recorded_op.hpp"
 
 namespace skity {
 
+namespace {
+
+// Ops which have their device bounds recorded in the R-tree.
+bool IsCullableOp(RecordedOpType type) {
+  switch (type) {
+    case RecordedOpType::kDrawLine:
+    case RecordedOpType::kDrawCircle:
+    case RecordedOpType::kDrawArc:
+    case RecordedOpType::kDrawOval:
+    case RecordedOpType::kDrawRect:
+    case RecordedOpType::kDrawRRect:
+    case RecordedOpType::kDrawRoundRect:
+    case RecordedOpType::kDrawPath:
+    case RecordedOpType::kDrawPaint:
+    case RecordedOpType::kSaveLayer:
+    case RecordedOpType::kDrawTextBlob:
+    case RecordedOpType::kDrawImage:
+    case RecordedOpType::kDrawGlyphs:
+    case RecordedOpType::kDrawAtlas:
+    case RecordedOpType::kDrawVertices:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 DisplayList::DisplayList() {}
 
 DisplayList::DisplayList(DisplayListStorage &&storage, size_t byte_count,
-                         uint32_t op_count, const Rect &bounds)
+                         uint32_t op_count, const Rect &bounds,
+                         std::unique_ptr<DisplayListPaintTable> paint_table,
+                         std::unique_ptr<DisplayListRTree> rtree)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
       op_count_(op_count),
-      bounds_(bounds) {}
+      bounds_(bounds),
+      paint_table_(std::move(paint_table)),
+      rtree_(std::move(rtree)) {}
 
 DisplayList::~DisplayList() {
   uint8_t *ptr = storage_.get();
@@ -35,66 +71,67 @@ Paint *DisplayList::GetOpPaintByOffset(RecordedOpOffset offset) {
   }
 
   auto op = reinterpret_cast<RecordedOp *>(ptr);
+  uint32_t *paint_index = nullptr;
   switch (op->type) {
     case RecordedOpType::kDrawLine: {
-      struct DrawLineOp *drawLineOp = static_cast<struct DrawLineOp *>(op);
-      return &drawLineOp->paint;
+      paint_index = &static_cast<struct DrawLineOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawCircle: {
-      struct DrawCircleOp *drawCircleOp =
-          static_cast<struct DrawCircleOp *>(op);
-      return &drawCircleOp->paint;
+      paint_index = &static_cast<struct DrawCircleOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawArc: {
-      struct DrawArcOp *drawArcOp = static_cast<struct DrawArcOp *>(op);
-      return &drawArcOp->paint;
+      paint_index = &static_cast<struct DrawArcOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawOval: {
-      struct DrawOvalOp *drawOvalOp = static_cast<struct DrawOvalOp *>(op);
-      return &drawOvalOp->paint;
+      paint_index = &static_cast<struct DrawOvalOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawRect: {
-      struct DrawRectOp *drawRectOp = static_cast<struct DrawRectOp *>(op);
-      return &drawRectOp->paint;
+      paint_index = &static_cast<struct DrawRectOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawRRect: {
-      struct DrawRRectOp *drawRRectOp = static_cast<struct DrawRRectOp *>(op);
-      return &drawRRectOp->paint;
+      paint_index = &static_cast<struct DrawRRectOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawRoundRect: {
-      struct DrawRoundRectOp *drawRoundRectOp =
-          static_cast<struct DrawRoundRectOp *>(op);
-      return &drawRoundRectOp->paint;
+      paint_index = &static_cast<struct DrawRoundRectOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawPath: {
-      struct DrawPathOp *drawPathOp = static_cast<struct DrawPathOp *>(op);
-      return &drawPathOp->paint;
+      paint_index = &static_cast<struct DrawPathOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawPaint: {
-      struct DrawPaintOp *drawPaintOp = static_cast<struct DrawPaintOp *>(op);
-      return &drawPaintOp->paint;
+      paint_index = &static_cast<struct DrawPaintOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kSaveLayer: {
-      struct SaveLayerOp *saveLayerOp = static_cast<struct SaveLayerOp *>(op);
-      return &saveLayerOp->paint;
+      paint_index = &static_cast<struct SaveLayerOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawTextBlob: {
-      struct DrawTextBlobOp *drawTextBlobOp =
-          static_cast<struct DrawTextBlobOp *>(op);
-      return &drawTextBlobOp->paint;
+      paint_index = &static_cast<struct DrawTextBlobOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawImage: {
-      struct DrawImageOp *drawImageOp = static_cast<struct DrawImageOp *>(op);
-      return &drawImageOp->paint;
+      paint_index = &static_cast<struct DrawImageOp *>(op)->paint_index;
     } break;
     case RecordedOpType::kDrawGlyphs: {
-      struct DrawGlyphsOp *drawGlyphsOp =
-          static_cast<struct DrawGlyphsOp *>(op);
-      return &drawGlyphsOp->paint;
+      paint_index = &static_cast<struct DrawGlyphsOp *>(op)->paint_index;
+    } break;
+    case RecordedOpType::kDrawAtlas: {
+      paint_index = &static_cast<struct DrawAtlasOp *>(op)->paint_index;
+    } break;
+    case RecordedOpType::kDrawVertices: {
+      paint_index = &static_cast<struct DrawVerticesOp *>(op)->paint_index;
     } break;
     default:
       return nullptr;
   }
+
+  *paint_index = paint_table_->Detach(*paint_index);
+  return &paint_table_->GetMutablePaint(*paint_index);
+}
+
+size_t DisplayList::PaintCount() const {
+  return paint_table_ != nullptr ? paint_table_->Size() : 0;
+}
+
+const Paint &DisplayList::GetPaint(uint32_t index) const {
+  return paint_table_->GetPaint(index);
 }
 
 void DisplayList::DisposeOps(uint8_t *ptr, uint8_t *end) {
@@ -120,134 +157,201 @@ void DisplayList::DisposeOps(uint8_t *ptr, uint8_t *end) {
 }
 
 void DisplayList::Draw(Canvas *canvas) {
-  uint8_t *ptr = storage_.get();
+  uint8_t *start = storage_.get();
+  uint8_t *ptr = start;
   uint8_t *end = ptr + byte_count_;
 
+  std::vector<int32_t> visible_ops;
+  bool cull = false;
+  if (rtree_ != nullptr) {
+    Rect clip_bounds = canvas->GetLocalClipBounds();
+    if (!clip_bounds.Contains(rtree_->GetBounds())) {
+      rtree_->Search(clip_bounds, &visible_ops);
+      cull = true;
+    }
+  }
+
+  if (!cull) {
+    while (ptr < end) {
+      auto op = reinterpret_cast<RecordedOp *>(ptr);
+      ptr += op->size;
+      DrawOp(canvas, op);
+    }
+    return;
+  }
+
+  // Save, restore, transform and clip ops are always replayed so the canvas
+  // state stays identical for the ops which do intersect the clip.
+  auto next_visible = visible_ops.begin();
   while (ptr < end) {
     auto op = reinterpret_cast<RecordedOp *>(ptr);
+    auto offset = static_cast<int32_t>(ptr - start);
     ptr += op->size;
-    switch (op->type) {
-      case RecordedOpType::kSave: {
-        canvas->Save();
-      } break;
-      case RecordedOpType::kRestore: {
-        canvas->Restore();
-      } break;
-      case RecordedOpType::kRestoreToCount: {
-        struct RestoreToCountOp *restoreToCountOp =
-            static_cast<struct RestoreToCountOp *>(op);
-        canvas->RestoreToCount(restoreToCountOp->saveCount);
-      } break;
-      case RecordedOpType::kTranslate: {
-        struct TranslateOp *translateOp = static_cast<struct TranslateOp *>(op);
-        canvas->Translate(translateOp->dx, translateOp->dy);
-      } break;
-      case RecordedOpType::kScale: {
-        struct ScaleOp *scaleOp = static_cast<struct ScaleOp *>(op);
-        canvas->Scale(scaleOp->sx, scaleOp->sy);
-      } break;
-      case RecordedOpType::kRotateByDegree: {
-        struct RotateByDegreeOp *rotateByDegreeOp =
-            static_cast<struct RotateByDegreeOp *>(op);
-        canvas->Rotate(rotateByDegreeOp->degrees);
-      } break;
-      case RecordedOpType::kRotateByPoint: {
-        struct RotateByPointOp *rotateByPointOp =
-            static_cast<struct RotateByPointOp *>(op);
-        canvas->Rotate(rotateByPointOp->degrees, rotateByPointOp->px,
-                       rotateByPointOp->py);
-      } break;
-      case RecordedOpType::kSkew: {
-        struct SkewOp *skewOp = static_cast<struct SkewOp *>(op);
-        canvas->Skew(skewOp->sx, skewOp->sy);
-      } break;
-      case RecordedOpType::kConcat: {
-        struct ConcatOp *concatOp = static_cast<struct ConcatOp *>(op);
-        canvas->Concat(concatOp->matrix);
-      } break;
-      case RecordedOpType::kSetMatrix: {
-        struct SetMatrixOp *setMatrixOp = static_cast<struct SetMatrixOp *>(op);
-        canvas->SetMatrix(setMatrixOp->matrix);
-      } break;
-      case RecordedOpType::kResetMatrix: {
-        canvas->ResetMatrix();
-      } break;
-      case RecordedOpType::kClipRect: {
-        struct ClipRectOp *clipRectOp = static_cast<struct ClipRectOp *>(op);
-        canvas->ClipRect(clipRectOp->rect, clipRectOp->op);
-      } break;
-      case RecordedOpType::kClipPath: {
-        struct ClipPathOp *clipPathOp = static_cast<struct ClipPathOp *>(op);
-        canvas->ClipPath(clipPathOp->path, clipPathOp->op);
-      } break;
-      case RecordedOpType::kDrawLine: {
-        struct DrawLineOp *drawLineOp = static_cast<struct DrawLineOp *>(op);
-        canvas->DrawLine(drawLineOp->x0, drawLineOp->y0, drawLineOp->x1,
-                         drawLineOp->y1, drawLineOp->paint);
-      } break;
-      case RecordedOpType::kDrawCircle: {
-        struct DrawCircleOp *drawCircleOp =
-            static_cast<struct DrawCircleOp *>(op);
-        canvas->DrawCircle(drawCircleOp->cx, drawCircleOp->cy,
-                           drawCircleOp->radius, drawCircleOp->paint);
-      } break;
-      case RecordedOpType::kDrawArc: {
-        struct DrawArcOp *drawArcOp = static_cast<struct DrawArcOp *>(op);
-        canvas->DrawArc(drawArcOp->oval, drawArcOp->startAngle,
-                        drawArcOp->sweepAngle, drawArcOp->useCenter,
-                        drawArcOp->paint);
-      } break;
-      case RecordedOpType::kDrawOval: {
-        struct DrawOvalOp *drawOvalOp = static_cast<struct DrawOvalOp *>(op);
-        canvas->DrawOval(drawOvalOp->oval, drawOvalOp->paint);
-      } break;
-      case RecordedOpType::kDrawRect: {
-        struct DrawRectOp *drawRectOp = static_cast<struct DrawRectOp *>(op);
-        canvas->DrawRect(drawRectOp->rect, drawRectOp->paint);
-      } break;
-      case RecordedOpType::kDrawRRect: {
-        struct DrawRRectOp *drawRRectOp = static_cast<struct DrawRRectOp *>(op);
-        canvas->DrawRRect(drawRRectOp->rrect, drawRRectOp->paint);
-      } break;
-      case RecordedOpType::kDrawRoundRect: {
-        struct DrawRoundRectOp *drawRoundRectOp =
-            static_cast<struct DrawRoundRectOp *>(op);
-        canvas->DrawRoundRect(drawRoundRectOp->rect, drawRoundRectOp->rx,
-                              drawRoundRectOp->ry, drawRoundRectOp->paint);
-      } break;
-      case RecordedOpType::kDrawPath: {
-        struct DrawPathOp *drawPathOp = static_cast<struct DrawPathOp *>(op);
-        canvas->DrawPath(drawPathOp->path, drawPathOp->paint);
-      } break;
-      case RecordedOpType::kDrawPaint: {
-        struct DrawPaintOp *drawPaintOp = static_cast<struct DrawPaintOp *>(op);
-        canvas->DrawPaint(drawPaintOp->paint);
-      } break;
-      case RecordedOpType::kSaveLayer: {
-        struct SaveLayerOp *saveLayerOp = static_cast<struct SaveLayerOp *>(op);
-        canvas->SaveLayer(saveLayerOp->bounds, saveLayerOp->paint);
-      } break;
-      case RecordedOpType::kDrawTextBlob: {
-        struct DrawTextBlobOp *drawTextBlobOp =
-            static_cast<struct DrawTextBlobOp *>(op);
-        canvas->DrawTextBlob(drawTextBlobOp->blob_ptr.get(), drawTextBlobOp->x,
-                             drawTextBlobOp->y, drawTextBlobOp->paint);
-      } break;
-      case RecordedOpType::kDrawImage: {
-        struct DrawImageOp *drawImageOp = static_cast<struct DrawImageOp *>(op);
-        canvas->DrawImageRect(drawImageOp->image, drawImageOp->src,
-                              drawImageOp->dst, drawImageOp->sampling,
-                              &drawImageOp->paint);
-      } break;
-      case RecordedOpType::kDrawGlyphs: {
-        struct DrawGlyphsOp *drawGlyphsOp =
-            static_cast<struct DrawGlyphsOp *>(op);
-        canvas->DrawGlyphs(drawGlyphsOp->count, &drawGlyphsOp->m_glyphs[0],
-                           &drawGlyphsOp->m_positions_x[0],
-                           &drawGlyphsOp->m_positions_y[0], drawGlyphsOp->font,
-                           drawGlyphsOp->paint);
-      } break;
+
+    if (IsCullableOp(op->type)) {
+      if (next_visible == visible_ops.end() || *next_visible != offset) {
+        if (op->type == RecordedOpType::kSaveLayer) {
+          // Keep the save stack balanced for the matching restore.
+          canvas->Save();
+        }
+        continue;
+      }
+      ++next_visible;
     }
+
+    DrawOp(canvas, op);
+  }
+}
+
+void DisplayList::DrawOp(Canvas *canvas, RecordedOp *op) {
+  switch (op->type) {
+    case RecordedOpType::kSave: {
+      canvas->Save();
+    } break;
+    case RecordedOpType::kRestore: {
+      canvas->Restore();
+    } break;
+    case RecordedOpType::kRestoreToCount: {
+      struct RestoreToCountOp *restoreToCountOp =
+          static_cast<struct RestoreToCountOp *>(op);
+      canvas->RestoreToCount(restoreToCountOp->saveCount);
+    } break;
+    case RecordedOpType::kTranslate: {
+      struct TranslateOp *translateOp = static_cast<struct TranslateOp *>(op);
+      canvas->Translate(translateOp->dx, translateOp->dy);
+    } break;
+    case RecordedOpType::kScale: {
+      struct ScaleOp *scaleOp = static_cast<struct ScaleOp *>(op);
+      canvas->Scale(scaleOp->sx, scaleOp->sy);
+    } break;
+    case RecordedOpType::kRotateByDegree: {
+      struct RotateByDegreeOp *rotateByDegreeOp =
+          static_cast<struct RotateByDegreeOp *>(op);
+      canvas->Rotate(rotateByDegreeOp->degrees);
+    } break;
+    case RecordedOpType::kRotateByPoint: {
+      struct RotateByPointOp *rotateByPointOp =
+          static_cast<struct RotateByPointOp *>(op);
+      canvas->Rotate(rotateByPointOp->degrees, rotateByPointOp->px,
+                     rotateByPointOp->py);
+    } break;
+    case RecordedOpType::kSkew: {
+      struct SkewOp *skewOp = static_cast<struct SkewOp *>(op);
+      canvas->Skew(skewOp->sx, skewOp->sy);
+    } break;
+    case RecordedOpType::kConcat: {
+      struct ConcatOp *concatOp = static_cast<struct ConcatOp *>(op);
+      canvas->Concat(concatOp->matrix);
+    } break;
+    case RecordedOpType::kSetMatrix: {
+      struct SetMatrixOp *setMatrixOp = static_cast<struct SetMatrixOp *>(op);
+      canvas->SetMatrix(setMatrixOp->matrix);
+    } break;
+    case RecordedOpType::kResetMatrix: {
+      canvas->ResetMatrix();
+    } break;
+    case RecordedOpType::kClipRect: {
+      struct ClipRectOp *clipRectOp = static_cast<struct ClipRectOp *>(op);
+      canvas->ClipRect(clipRectOp->rect, clipRectOp->op);
+    } break;
+    case RecordedOpType::kClipRRect: {
+      struct ClipRRectOp *clipRRectOp = static_cast<struct ClipRRectOp *>(op);
+      canvas->ClipRRect(clipRRectOp->rrect, clipRRectOp->op);
+    } break;
+    case RecordedOpType::kClipPath: {
+      struct ClipPathOp *clipPathOp = static_cast<struct ClipPathOp *>(op);
+      canvas->ClipPath(clipPathOp->path, clipPathOp->op);
+    } break;
+    case RecordedOpType::kDrawLine: {
+      struct DrawLineOp *drawLineOp = static_cast<struct DrawLineOp *>(op);
+      canvas->DrawLine(drawLineOp->x0, drawLineOp->y0, drawLineOp->x1,
+                       drawLineOp->y1, GetPaint(drawLineOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawCircle: {
+      struct DrawCircleOp *drawCircleOp =
+          static_cast<struct DrawCircleOp *>(op);
+      canvas->DrawCircle(drawCircleOp->cx, drawCircleOp->cy,
+                         drawCircleOp->radius,
+                         GetPaint(drawCircleOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawArc: {
+      struct DrawArcOp *drawArcOp = static_cast<struct DrawArcOp *>(op);
+      canvas->DrawArc(drawArcOp->oval, drawArcOp->startAngle,
+                      drawArcOp->sweepAngle, drawArcOp->useCenter,
+                      GetPaint(drawArcOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawOval: {
+      struct DrawOvalOp *drawOvalOp = static_cast<struct DrawOvalOp *>(op);
+      canvas->DrawOval(drawOvalOp->oval, GetPaint(drawOvalOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawRect: {
+      struct DrawRectOp *drawRectOp = static_cast<struct DrawRectOp *>(op);
+      canvas->DrawRect(drawRectOp->rect, GetPaint(drawRectOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawRRect: {
+      struct DrawRRectOp *drawRRectOp = static_cast<struct DrawRRectOp *>(op);
+      canvas->DrawRRect(drawRRectOp->rrect,
+                        GetPaint(drawRRectOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawRoundRect: {
+      struct DrawRoundRectOp *drawRoundRectOp =
+          static_cast<struct DrawRoundRectOp *>(op);
+      canvas->DrawRoundRect(drawRoundRectOp->rect, drawRoundRectOp->rx,
+                            drawRoundRectOp->ry,
+                            GetPaint(drawRoundRectOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawPath: {
+      struct DrawPathOp *drawPathOp = static_cast<struct DrawPathOp *>(op);
+      canvas->DrawPath(drawPathOp->path, GetPaint(drawPathOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawPaint: {
+      struct DrawPaintOp *drawPaintOp = static_cast<struct DrawPaintOp *>(op);
+      canvas->DrawPaint(GetPaint(drawPaintOp->paint_index));
+    } break;
+    case RecordedOpType::kSaveLayer: {
+      struct SaveLayerOp *saveLayerOp = static_cast<struct SaveLayerOp *>(op);
+      canvas->SaveLayer(saveLayerOp->bounds,
+                        GetPaint(saveLayerOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawTextBlob: {
+      struct DrawTextBlobOp *drawTextBlobOp =
+          static_cast<struct DrawTextBlobOp *>(op);
+      canvas->DrawTextBlob(drawTextBlobOp->blob_ptr.get(), drawTextBlobOp->x,
+                           drawTextBlobOp->y,
+                           GetPaint(drawTextBlobOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawImage: {
+      struct DrawImageOp *drawImageOp = static_cast<struct DrawImageOp *>(op);
+      canvas->DrawImageRect(drawImageOp->image, drawImageOp->src,
+                            drawImageOp->dst, drawImageOp->sampling,
+                            &GetPaint(drawImageOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawGlyphs: {
+      struct DrawGlyphsOp *drawGlyphsOp =
+          static_cast<struct DrawGlyphsOp *>(op);
+      canvas->DrawGlyphs(drawGlyphsOp->count, &drawGlyphsOp->m_glyphs[0],
+                         &drawGlyphsOp->m_positions_x[0],
+                         &drawGlyphsOp->m_positions_y[0], drawGlyphsOp->font,
+                         GetPaint(drawGlyphsOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawAtlas: {
+      struct DrawAtlasOp *drawAtlasOp = static_cast<struct DrawAtlasOp *>(op);
+      canvas->DrawAtlas(
+          drawAtlasOp->atlas, drawAtlasOp->m_xform.data(),
+          drawAtlasOp->m_tex.data(),
+          drawAtlasOp->m_colors.empty() ? nullptr
+                                        : drawAtlasOp->m_colors.data(),
+          static_cast<int>(drawAtlasOp->m_xform.size()), drawAtlasOp->mode,
+          drawAtlasOp->sampling,
+          drawAtlasOp->has_cull_rect ? &drawAtlasOp->cull_rect : nullptr,
+          &GetPaint(drawAtlasOp->paint_index));
+    } break;
+    case RecordedOpType::kDrawVertices: {
+      struct DrawVerticesOp *drawVerticesOp =
+          static_cast<struct DrawVerticesOp *>(op);
+      canvas->DrawVertices(drawVerticesOp->vertices, drawVerticesOp->mode,
+                           GetPaint(drawVerticesOp->paint_index));
+    } break;
   }
 }
 
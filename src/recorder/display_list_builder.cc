@@ -0,0 +1,104 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/recorder/display_list_builder.hpp"
+
+#include "src/recorder/display_list_rtree.hpp"
+
+namespace skity {
+
+std::unique_ptr<DisplayList> DisplayListBuilder::GetDisplayList() {
+  paint_table_->FinishRecording();
+
+  std::unique_ptr<DisplayListRTree> rtree;
+  if (build_rtree_) {
+    // Layers left open at the end of recording are closed by the canvas on
+    // playback, so treat them as restored here.
+    while (!save_stack_.empty()) {
+      RecordRestore();
+    }
+
+    rtree = std::make_unique<DisplayListRTree>(
+        op_rects_.data(), op_offsets_.data(), op_rects_.size());
+  }
+
+  return std::make_unique<DisplayList>(std::move(storage_), used_,
+                                       render_op_count_, bounds_,
+                                       std::move(paint_table_),
+                                       std::move(rtree));
+}
+
+void DisplayListBuilder::RecordOpBounds(const Rect& device_bounds) {
+  if (!build_rtree_) {
+    return;
+  }
+
+  op_rects_.push_back(device_bounds);
+  op_offsets_.push_back(last_op_offset_);
+}
+
+void DisplayListBuilder::RecordSave() {
+  if (!build_rtree_) {
+    return;
+  }
+
+  SaveRecord record;
+  record.first_child_index = op_rects_.size();
+  save_stack_.push_back(record);
+}
+
+void DisplayListBuilder::RecordSaveLayer(const Rect& layer_bounds,
+                                         bool unbounded) {
+  if (!build_rtree_) {
+    return;
+  }
+
+  SaveRecord record;
+  record.layer_rect_index = static_cast<int32_t>(op_rects_.size());
+  record.layer_bounds = layer_bounds;
+  record.unbounded = unbounded;
+
+  // The final bounds of the layer op are only known once it is restored.
+  op_rects_.push_back(Rect::MakeEmpty());
+  op_offsets_.push_back(last_op_offset_);
+
+  record.first_child_index = op_rects_.size();
+  save_stack_.push_back(record);
+}
+
+void DisplayListBuilder::RecordRestore() {
+  if (!build_rtree_ || save_stack_.empty()) {
+    return;
+  }
+
+  SaveRecord record = save_stack_.back();
+  save_stack_.pop_back();
+
+  if (record.layer_rect_index < 0) {
+    return;
+  }
+
+  Rect& layer_rect = op_rects_[record.layer_rect_index];
+
+  if (record.unbounded) {
+    // Any visible pixel of the layer may depend on any op inside it, so all
+    // of them share the bounds of the layer.
+    layer_rect = record.layer_bounds;
+    for (size_t i = record.first_child_index; i < op_rects_.size(); i++) {
+      op_rects_[i] = layer_rect;
+    }
+    return;
+  }
+
+  // A plain layer only touches pixels covered by its content.
+  layer_rect.SetEmpty();
+  for (size_t i = record.first_child_index; i < op_rects_.size(); i++) {
+    layer_rect.Join(op_rects_[i]);
+  }
+  if (!layer_rect.Intersect(record.layer_bounds)) {
+    layer_rect.SetEmpty();
+  }
+}
+
+}  // namespace skity
@@ -6,14 +6,21 @@
 #define SRC_RECORDER_DISPLAY_LIST_BUILDER_HPP
 
 #include <skity/recorder/display_list.hpp>
+#include <vector>
+
+#include "src/recorder/display_list_paint_table.hpp"
 
 namespace skity {
 
 struct DisplayListBuilder {
   static constexpr Rect kMaxCullRect = Rect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
-  explicit DisplayListBuilder(const Rect& cull_rect = kMaxCullRect)
-      : bounds_(Rect::MakeEmpty()), cull_rect_(cull_rect) {}
+  explicit DisplayListBuilder(const Rect& cull_rect = kMaxCullRect,
+                              bool build_rtree = false)
+      : bounds_(Rect::MakeEmpty()),
+        cull_rect_(cull_rect),
+        paint_table_(std::make_unique<DisplayListPaintTable>()),
+        build_rtree_(build_rtree) {}
 
   DisplayListStorage storage_;
   size_t used_ = 0;
@@ -22,12 +29,38 @@ struct DisplayListBuilder {
   Rect cull_rect_;
   int32_t last_op_offset_ = -1;
 
-  std::unique_ptr<DisplayList> GetDisplayList() {
-    return std::make_unique<DisplayList>(std::move(storage_), used_,
-                                         render_op_count_, bounds_);
+  std::unique_ptr<DisplayList> GetDisplayList();
+
+  uint32_t InternPaint(const Paint& paint) {
+    return paint_table_->Intern(paint);
   }
 
   uint32_t render_op_count_ = 0u;
+
+  std::unique_ptr<DisplayListPaintTable> paint_table_;
+
+  // Per-op device bounds, only collected when `build_rtree_` is true.
+  bool build_rtree_;
+  std::vector<Rect> op_rects_;
+  std::vector<int32_t> op_offsets_;
+
+  struct SaveRecord {
+    // Index into `op_rects_` of the SaveLayerOp, or -1 for a plain save.
+    int32_t layer_rect_index = -1;
+    // First entry of `op_rects_` recorded inside this save.
+    size_t first_child_index = 0;
+    // Device bounds the layer may touch when composited back.
+    Rect layer_bounds;
+    // Layer paint can touch pixels outside of its content, e.g. an image
+    // filter. Every op inside must then be replayed whenever the layer is.
+    bool unbounded = false;
+  };
+  std::vector<SaveRecord> save_stack_;
+
+  void RecordOpBounds(const Rect& device_bounds);
+  void RecordSave();
+  void RecordSaveLayer(const Rect& layer_bounds, bool unbounded);
+  void RecordRestore();
 };
 
 }  // namespace skity
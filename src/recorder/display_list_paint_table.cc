@@ -0,0 +1,96 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/recorder/display_list_paint_table.hpp"
+
+#include "src/base/hash.hpp"
+
+namespace skity {
+
+uint32_t DisplayListPaintTable::Intern(const Paint& paint) {
+  // Consecutive ops very often share the same paint.
+  if (last_index_ != kInvalidIndex && paints_[last_index_] == paint) {
+    use_counts_[last_index_]++;
+    return last_index_;
+  }
+
+  uint32_t hash = HashPaint(paint);
+  auto it = lookup_.find(hash);
+  uint32_t bucket_head = kInvalidIndex;
+  if (it != lookup_.end()) {
+    bucket_head = it->second;
+    for (uint32_t i = bucket_head; i != kInvalidIndex; i = next_in_bucket_[i]) {
+      if (paints_[i] == paint) {
+        use_counts_[i]++;
+        last_index_ = i;
+        return i;
+      }
+    }
+  }
+
+  auto index = static_cast<uint32_t>(paints_.size());
+  paints_.emplace_back(paint);
+  use_counts_.emplace_back(1);
+  next_in_bucket_.emplace_back(bucket_head);
+  lookup_[hash] = index;
+  last_index_ = index;
+
+  return index;
+}
+
+void DisplayListPaintTable::FinishRecording() {
+  lookup_ = {};
+  next_in_bucket_ = {};
+  last_index_ = kInvalidIndex;
+}
+
+uint32_t DisplayListPaintTable::Detach(uint32_t index) {
+  if (use_counts_[index] <= 1) {
+    return index;
+  }
+
+  use_counts_[index]--;
+
+  auto detached = static_cast<uint32_t>(paints_.size());
+  // Appending to a deque keeps references to existing entries valid.
+  paints_.emplace_back(paints_[index]);
+  use_counts_.emplace_back(1);
+
+  return detached;
+}
+
+uint32_t DisplayListPaintTable::HashPaint(const Paint& paint) {
+  // Only cheap, by value properties are hashed. Paints that only differ in
+  // their effects land in the same bucket and are told apart by operator==.
+  Vector fill_color = paint.GetFillColor();
+  Vector stroke_color = paint.GetStrokeColor();
+
+  struct {
+    float values[11];
+    uint32_t flags;
+  } key = {
+      {
+          fill_color.x,
+          fill_color.y,
+          fill_color.z,
+          fill_color.w,
+          stroke_color.x,
+          stroke_color.y,
+          stroke_color.z,
+          stroke_color.w,
+          paint.GetStrokeWidth(),
+          paint.GetStrokeMiter(),
+          paint.GetTextSize(),
+      },
+      static_cast<uint32_t>(paint.GetStyle()) |
+          static_cast<uint32_t>(paint.GetStrokeCap()) << 4 |
+          static_cast<uint32_t>(paint.GetStrokeJoin()) << 8 |
+          static_cast<uint32_t>(paint.IsAntiAlias()) << 12 |
+          static_cast<uint32_t>(paint.GetBlendMode()) << 16,
+  };
+
+  return Hash32(&key, sizeof(key));
+}
+
+}  // namespace skity
@@ -0,0 +1,66 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RECORDER_DISPLAY_LIST_PAINT_TABLE_HPP
+#define SRC_RECORDER_DISPLAY_LIST_PAINT_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <skity/graphic/paint.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace skity {
+
+/**
+ * Interned paints referenced by index from recorded ops.
+ *
+ * Paints are stored in a deque so pointers handed out by GetPaint() stay valid
+ * while new entries are appended.
+ */
+class DisplayListPaintTable {
+ public:
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  /**
+   * Return the index of a paint equal to `paint`, adding it to the table if
+   * it is not present yet. Only valid until FinishRecording() is called.
+   */
+  uint32_t Intern(const Paint& paint);
+
+  /**
+   * Drop the lookup structures only needed while recording.
+   */
+  void FinishRecording();
+
+  const Paint& GetPaint(uint32_t index) const { return paints_[index]; }
+
+  /**
+   * Give the caller a private copy of the paint at `index` so it can be
+   * modified without affecting other ops sharing the same entry.
+   *
+   * @return index of the entry owned exclusively by the caller
+   */
+  uint32_t Detach(uint32_t index);
+
+  Paint& GetMutablePaint(uint32_t index) { return paints_[index]; }
+
+  size_t Size() const { return paints_.size(); }
+
+ private:
+  static uint32_t HashPaint(const Paint& paint);
+
+  std::deque<Paint> paints_;
+  std::vector<uint32_t> use_counts_;
+
+  // Recording only: first entry for each hash, and the next entry sharing the
+  // same hash for every paint.
+  std::unordered_map<uint32_t, uint32_t> lookup_;
+  std::vector<uint32_t> next_in_bucket_;
+  uint32_t last_index_ = kInvalidIndex;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RECORDER_DISPLAY_LIST_PAINT_TABLE_HPP
@@ -0,0 +1,79 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/recorder/display_list_rtree.hpp"
+
+#include <algorithm>
+
+namespace skity {
+
+DisplayListRTree::DisplayListRTree(const Rect rects[], const int32_t ids[],
+                                   size_t count) {
+  // A full tree with a fanout of N has at most count / (N - 1) internal nodes.
+  nodes_.reserve(count + count / (kMaxChildren - 1) + 1);
+
+  for (size_t i = 0; i < count; i++) {
+    if (rects[i].IsEmpty()) {
+      continue;
+    }
+    nodes_.push_back(Node{rects[i], static_cast<uint32_t>(ids[i]), 0});
+  }
+
+  leaf_count_ = nodes_.size();
+
+  size_t level_start = 0;
+  size_t level_count = leaf_count_;
+  while (level_count > 1) {
+    size_t next_level_start = nodes_.size();
+    for (size_t i = 0; i < level_count; i += kMaxChildren) {
+      auto child_count = static_cast<uint32_t>(
+          std::min<size_t>(kMaxChildren, level_count - i));
+      auto first_child = static_cast<uint32_t>(level_start + i);
+
+      Rect bounds = nodes_[first_child].bounds;
+      for (uint32_t j = 1; j < child_count; j++) {
+        bounds.Join(nodes_[first_child + j].bounds);
+      }
+
+      nodes_.push_back(Node{bounds, first_child, child_count});
+    }
+
+    level_start = next_level_start;
+    level_count = nodes_.size() - next_level_start;
+  }
+}
+
+void DisplayListRTree::Search(const Rect& query,
+                              std::vector<int32_t>* results) const {
+  if (nodes_.empty() || query.IsEmpty()) {
+    return;
+  }
+
+  const Node& root = nodes_.back();
+  if (Rect::Intersect(root.bounds, query)) {
+    SearchNode(root, query, results);
+  }
+}
+
+const Rect& DisplayListRTree::GetBounds() const {
+  static const Rect kEmpty = Rect::MakeEmpty();
+  return nodes_.empty() ? kEmpty : nodes_.back().bounds;
+}
+
+void DisplayListRTree::SearchNode(const Node& node, const Rect& query,
+                                  std::vector<int32_t>* results) const {
+  if (node.child_count == 0) {
+    results->push_back(static_cast<int32_t>(node.index));
+    return;
+  }
+
+  for (uint32_t i = 0; i < node.child_count; i++) {
+    const Node& child = nodes_[node.index + i];
+    if (Rect::Intersect(child.bounds, query)) {
+      SearchNode(child, query, results);
+    }
+  }
+}
+
+}  // namespace skity
@@ -0,0 +1,61 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RECORDER_DISPLAY_LIST_RTREE_HPP
+#define SRC_RECORDER_DISPLAY_LIST_RTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <skity/geometry/rect.hpp>
+#include <vector>
+
+namespace skity {
+
+/**
+ * A static, bulk loaded R-tree over the device bounds of recorded ops.
+ *
+ * Leaves are kept in recording order and grouped bottom-up, which keeps the
+ * tree cheap to build and makes every search return ids in ascending order.
+ * Recorded content is usually spatially coherent in recording order, so this
+ * simple grouping gives tight enough nodes without any sorting.
+ */
+class DisplayListRTree {
+ public:
+  static constexpr uint32_t kMaxChildren = 8;
+
+  /**
+   * Build the tree from `count` rects and the ids associated with them. Empty
+   * rects are dropped since they can never intersect a query.
+   */
+  DisplayListRTree(const Rect rects[], const int32_t ids[], size_t count);
+
+  /**
+   * Append the ids of all leaves intersecting `query` into `results`, in the
+   * same order as they were passed to the constructor.
+   */
+  void Search(const Rect& query, std::vector<int32_t>* results) const;
+
+  const Rect& GetBounds() const;
+
+  size_t GetLeafCount() const { return leaf_count_; }
+
+ private:
+  struct Node {
+    Rect bounds;
+    // Index of the first child for internal nodes, or the leaf id.
+    uint32_t index;
+    // Zero for leaves.
+    uint32_t child_count;
+  };
+
+  void SearchNode(const Node& node, const Rect& query,
+                  std::vector<int32_t>* results) const;
+
+  std::vector<Node> nodes_;
+  size_t leaf_count_ = 0;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RECORDER_DISPLAY_LIST_RTREE_HPP
@@ -17,7 +17,11 @@ void PictureRecorder::BeginRecording() {
 }
 
 void PictureRecorder::BeginRecording(const Rect& bounds) {
-  dp_builder_ = std::make_unique<DisplayListBuilder>(bounds);
+  BeginRecording(bounds, false);
+}
+
+void PictureRecorder::BeginRecording(const Rect& bounds, bool build_rtree) {
+  dp_builder_ = std::make_unique<DisplayListBuilder>(bounds, build_rtree);
   canvas_->BindDisplayListBuilder(dp_builder_.get());
 }
 
@@ -29,6 +29,7 @@ namespace skity {
   V(SetMatrix)                  \
   V(ResetMatrix)                \
   V(ClipRect)                   \
+  V(ClipRRect)                  \
   V(ClipPath)                   \
   V(DrawLine)                   \
   V(DrawCircle)                 \
@@ -42,7 +43,9 @@ namespace skity {
   V(SaveLayer)                  \
   V(DrawTextBlob)               \
   V(DrawImage)                  \
-  V(DrawGlyphs)
+  V(DrawGlyphs)                 \
+  V(DrawAtlas)                  \
+  V(DrawVertices)
 
 #define OP_TO_ENUM_VALUE(name) k##name,
 enum class RecordedOpType { FOR_EACH_RECORDED_OP(OP_TO_ENUM_VALUE) };
@@ -134,6 +137,14 @@ struct ClipRectOp : RecordedOp {
   Canvas::ClipOp op;
 };
 
+struct ClipRRectOp : RecordedOp {
+  explicit ClipRRectOp(RRect const& rrect,
+                       Canvas::ClipOp op = Canvas::ClipOp::kIntersect)
+      : RecordedOp(RecordedOpType::kClipRRect), rrect(rrect), op(op) {}
+  RRect rrect;
+  Canvas::ClipOp op;
+};
+
 struct ClipPathOp : RecordedOp {
   explicit ClipPathOp(Path const& path,
                       Canvas::ClipOp op = Canvas::ClipOp::kIntersect)
@@ -143,141 +154,152 @@ struct ClipPathOp : RecordedOp {
 };
 
 struct DrawLineOp : RecordedOp {
-  DrawLineOp(float& x0, float& y0, float& x1, float& y1, Paint const& paint)
+  DrawLineOp(float& x0, float& y0, float& x1, float& y1, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawLine),
         x0(x0),
         y0(y0),
         x1(x1),
         y1(y1),
-        paint(paint) {}
+        paint_index(paint_index) {}
   float x0;
   float y0;
   float x1;
   float y1;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawCircleOp : RecordedOp {
-  DrawCircleOp(float& cx, float& cy, float& radius, Paint const& paint)
+  DrawCircleOp(float& cx, float& cy, float& radius, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawCircle),
         cx(cx),
         cy(cy),
         radius(radius),
-        paint(paint) {}
+        paint_index(paint_index) {}
   float cx;
   float cy;
   float radius;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawArcOp : RecordedOp {
   DrawArcOp(Rect const& oval, float& startAngle, float& sweepAngle,
-            bool useCenter, Paint const& paint)
+            bool useCenter, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawArc),
         oval(oval),
         startAngle(startAngle),
         sweepAngle(sweepAngle),
         useCenter(useCenter),
-        paint(paint) {}
+        paint_index(paint_index) {}
   Rect oval;
   float startAngle;
   float sweepAngle;
   bool useCenter;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawOvalOp : RecordedOp {
-  DrawOvalOp(Rect const& oval, Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawOval), oval(oval), paint(paint) {}
+  DrawOvalOp(Rect const& oval, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawOval),
+        oval(oval),
+        paint_index(paint_index) {}
   Rect oval;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawRectOp : RecordedOp {
-  DrawRectOp(Rect const& rect, Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawRect), rect(rect), paint(paint) {}
+  DrawRectOp(Rect const& rect, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawRect),
+        rect(rect),
+        paint_index(paint_index) {}
   Rect rect;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawRRectOp : RecordedOp {
-  DrawRRectOp(RRect const& rrect, Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawRRect), rrect(rrect), paint(paint) {}
+  DrawRRectOp(RRect const& rrect, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawRRect),
+        rrect(rrect),
+        paint_index(paint_index) {}
   RRect rrect;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawRoundRectOp : RecordedOp {
-  DrawRoundRectOp(Rect const& rect, float& rx, float& ry, Paint const& paint)
+  DrawRoundRectOp(Rect const& rect, float& rx, float& ry, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawRoundRect),
         rect(rect),
         rx(rx),
         ry(ry),
-        paint(paint) {}
+        paint_index(paint_index) {}
   Rect rect;
   float rx;
   float ry;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawPathOp : RecordedOp {
-  DrawPathOp(Path const& path, Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawPath), path(path), paint(paint) {}
+  DrawPathOp(Path const& path, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawPath),
+        path(path),
+        paint_index(paint_index) {}
   Path path;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawPaintOp : RecordedOp {
-  explicit DrawPaintOp(Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawPaint), paint(paint) {}
-  Paint paint;
+  explicit DrawPaintOp(uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawPaint), paint_index(paint_index) {}
+  uint32_t paint_index;
 };
 
 struct SaveLayerOp : RecordedOp {
-  SaveLayerOp(Rect const& bounds, Paint const& paint)
-      : RecordedOp(RecordedOpType::kSaveLayer), bounds(bounds), paint(paint) {}
+  SaveLayerOp(Rect const& bounds, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kSaveLayer),
+        bounds(bounds),
+        paint_index(paint_index) {}
   Rect bounds;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawTextBlobOp : RecordedOp {
-  DrawTextBlobOp(const TextBlob* blob, float& x, float& y, Paint const& paint)
-      : RecordedOp(RecordedOpType::kDrawTextBlob), x(x), y(y), paint(paint) {
+  DrawTextBlobOp(const TextBlob* blob, float& x, float& y,
+                 uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawTextBlob),
+        x(x),
+        y(y),
+        paint_index(paint_index) {
     blob_ptr = std::make_unique<TextBlob>(blob->GetTextRun());
   }
   std::unique_ptr<TextBlob> blob_ptr;
   float x;
   float y;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawImageOp : RecordedOp {
   DrawImageOp(std::shared_ptr<Image> image, const Rect& src, const Rect& dst,
-              const SamplingOptions& sampling, const Paint* paint_ = nullptr)
+              const SamplingOptions& sampling, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawImage),
         image(image),
         src(src),
         dst(dst),
-        sampling(sampling) {
-    if (paint_ != nullptr) {
-      paint = *paint_;
-    }
-  }
+        sampling(sampling),
+        paint_index(paint_index) {}
   std::shared_ptr<Image> image;
   Rect src;
   Rect dst;
   SamplingOptions sampling;
-  Paint paint;
+  uint32_t paint_index;
 };
 
 struct DrawGlyphsOp : RecordedOp {
   DrawGlyphsOp(uint32_t& count, const GlyphID glyphs[],
                const float positions_x[], const float positions_y[],
-               const Font& font, const Paint& paint)
+               const Font& font, uint32_t paint_index)
       : RecordedOp(RecordedOpType::kDrawGlyphs),
         count(count),
         font(font),
-        paint(paint) {
+        paint_index(paint_index) {
     m_glyphs.assign(glyphs, glyphs + count);
     m_positions_x.assign(positions_x, positions_x + count);
     m_positions_y.assign(positions_y, positions_y + count);
@@ -288,7 +310,50 @@ struct DrawGlyphsOp : RecordedOp {
   std::vector<float> m_positions_x;
   std::vector<float> m_positions_y;
   const Font font;
-  Paint paint;
+  uint32_t paint_index;
+};
+
+struct DrawAtlasOp : RecordedOp {
+  DrawAtlasOp(std::shared_ptr<Image> atlas, const RSXform xform[],
+              const Rect tex[], const Color colors[], int count,
+              BlendMode mode, const SamplingOptions& sampling,
+              const Rect* cull_rect, uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawAtlas),
+        atlas(std::move(atlas)),
+        mode(mode),
+        sampling(sampling),
+        has_cull_rect(cull_rect != nullptr),
+        cull_rect(cull_rect != nullptr ? *cull_rect : Rect{}),
+        paint_index(paint_index) {
+    m_xform.assign(xform, xform + count);
+    m_tex.assign(tex, tex + count);
+    if (colors != nullptr) {
+      m_colors.assign(colors, colors + count);
+    }
+  }
+
+  std::shared_ptr<Image> atlas;
+  std::vector<RSXform> m_xform;
+  std::vector<Rect> m_tex;
+  std::vector<Color> m_colors;
+  BlendMode mode;
+  SamplingOptions sampling;
+  bool has_cull_rect;
+  Rect cull_rect;
+  uint32_t paint_index;
+};
+
+struct DrawVerticesOp : RecordedOp {
+  DrawVerticesOp(std::shared_ptr<Vertices> vertices, BlendMode mode,
+                 uint32_t paint_index)
+      : RecordedOp(RecordedOpType::kDrawVertices),
+        vertices(std::move(vertices)),
+        mode(mode),
+        paint_index(paint_index) {}
+
+  std::shared_ptr<Vertices> vertices;
+  BlendMode mode;
+  uint32_t paint_index;
 };
 
 }  // namespace skity
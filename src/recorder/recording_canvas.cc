@@ -77,32 +77,39 @@ void RecordingCanvas::OnClipRect(Rect const& rect, ClipOp op) {
   Push<ClipRectOp>(rect, op);
 }
 
+void RecordingCanvas::OnClipRRect(RRect const& rrect, ClipOp op) {
+  Push<ClipRRectOp>(rrect, op);
+}
+
 void RecordingCanvas::OnClipPath(Path const& path, ClipOp op) {
   Push<ClipPathOp>(path, op);
 }
 
 void RecordingCanvas::OnDrawRect(Rect const& rect, Paint const& paint) {
-  Push<DrawRectOp>(rect, paint);
+  Push<DrawRectOp>(rect, dp_builder_->InternPaint(paint));
   AccumulateOpBounds(rect, &paint);
 }
 
 void RecordingCanvas::OnDrawRRect(RRect const& rrect, Paint const& paint) {
-  Push<DrawRRectOp>(rrect, paint);
+  Push<DrawRRectOp>(rrect, dp_builder_->InternPaint(paint));
   AccumulateOpBounds(rrect.GetBounds(), &paint);
 }
 
 void RecordingCanvas::OnDrawPath(Path const& path, Paint const& paint) {
-  Push<DrawPathOp>(path, paint);
+  Push<DrawPathOp>(path, dp_builder_->InternPaint(paint));
   AccumulateOpBounds(path.GetBounds(), &paint);
 }
 
 void RecordingCanvas::OnSaveLayer(const Rect& bounds, const Paint& paint) {
-  Push<SaveLayerOp>(bounds, paint);
+  Push<SaveLayerOp>(bounds, dp_builder_->InternPaint(paint));
+  if (dp_builder_->build_rtree_) {
+    RecordSaveLayerBounds(bounds, paint);
+  }
 }
 
 void RecordingCanvas::OnDrawBlob(const TextBlob* blob, float x, float y,
                                  Paint const& paint) {
-  Push<DrawTextBlobOp>(blob, x, y, paint);
+  Push<DrawTextBlobOp>(blob, x, y, dp_builder_->InternPaint(paint));
   auto bounds = blob->GetBoundsRect().MakeOffset(x, y);
   // Expand outward a little to prevent incomplete display of text content
   bounds = bounds.MakeOutset(1, 1);
@@ -113,24 +120,61 @@ void RecordingCanvas::OnDrawImageRect(std::shared_ptr<Image> image,
                                       const Rect& src, const Rect& dst,
                                       const SamplingOptions& sampling,
                                       Paint const* paint) {
-  Push<DrawImageOp>(std::move(image), src, dst, sampling, paint);
+  uint32_t paint_index =
+      dp_builder_->InternPaint(paint != nullptr ? *paint : Paint());
+  Push<DrawImageOp>(std::move(image), src, dst, sampling, paint_index);
   AccumulateOpBounds(dst, paint);
 }
+void RecordingCanvas::OnDrawAtlas(const std::shared_ptr<Image>& atlas,
+                                  const RSXform xform[], const Rect tex[],
+                                  const Color colors[], int count,
+                                  BlendMode mode,
+                                  const SamplingOptions& sampling,
+                                  const Rect* cull_rect, const Paint* paint) {
+  uint32_t paint_index =
+      dp_builder_->InternPaint(paint != nullptr ? *paint : Paint());
+  Push<DrawAtlasOp>(atlas, xform, tex, colors, count, mode, sampling,
+                    cull_rect, paint_index);
+
+  Rect bounds = Rect::MakeEmpty();
+  if (cull_rect != nullptr) {
+    bounds = *cull_rect;
+  } else {
+    for (int i = 0; i < count; i++) {
+      Rect sprite = Rect::MakeWH(tex[i].Width(), tex[i].Height());
+      bounds.Join(xform[i].ToMatrix().MapRect(sprite));
+    }
+  }
+  AccumulateOpBounds(bounds, paint);
+}
+
+void RecordingCanvas::OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                                     BlendMode mode, const Paint& paint) {
+  Push<DrawVerticesOp>(vertices, mode, dp_builder_->InternPaint(paint));
+  AccumulateOpBounds(vertices->Bounds(), &paint);
+}
 void RecordingCanvas::OnDrawGlyphs(uint32_t count, const GlyphID glyphs[],
                                    const float position_x[],
                                    const float position_y[], const Font& font,
                                    const Paint& paint) {
-  Push<DrawGlyphsOp>(count, glyphs, position_x, position_y, font, paint);
+  Push<DrawGlyphsOp>(count, glyphs, position_x, position_y, font,
+                     dp_builder_->InternPaint(paint));
   // Since we only receive glyphs IDs, we cannot quickly calculate the bounds of
   // the drawing area.
-  AccumulateOpBounds(GetGlobalClipBounds(), nullptr);
+  AccumulateDeviceBounds(GetGlobalClipBounds());
 }
 void RecordingCanvas::OnDrawPaint(Paint const& paint) {
-  Push<DrawPaintOp>(paint);
-  AccumulateOpBounds(GetGlobalClipBounds(), nullptr);
+  Push<DrawPaintOp>(dp_builder_->InternPaint(paint));
+  AccumulateDeviceBounds(GetGlobalClipBounds());
+}
+void RecordingCanvas::OnSave() {
+  Push<SaveOp>();
+  dp_builder_->RecordSave();
+}
+void RecordingCanvas::OnRestore() {
+  Push<RestoreOp>();
+  dp_builder_->RecordRestore();
 }
-void RecordingCanvas::OnSave() { Push<SaveOp>(); }
-void RecordingCanvas::OnRestore() { Push<RestoreOp>(); }
 void RecordingCanvas::OnRestoreToCount(int saveCount) {
   Push<RestoreToCountOp>(saveCount);
 }
@@ -161,10 +205,46 @@ void RecordingCanvas::AccumulateOpBounds(const Rect& raw_bounds,
       paint != nullptr ? paint->ComputeFastBounds(raw_bounds) : raw_bounds;
   Rect mapped_bounds;
   GetTotalMatrix().MapRect(&mapped_bounds, bounds);
+
+  AccumulateDeviceBounds(mapped_bounds);
+}
+
+void RecordingCanvas::AccumulateDeviceBounds(const Rect& device_bounds) {
+  Rect mapped_bounds = device_bounds;
+
+  if (dp_builder_->build_rtree_) {
+    // Anti-aliasing and hairlines may touch one pixel outside of the
+    // geometry, which also keeps zero sized bounds from being dropped.
+    Rect op_bounds = mapped_bounds.MakeOutset(1, 1);
+    if (!op_bounds.Intersect(GetGlobalClipBounds())) {
+      op_bounds.SetEmpty();
+    }
+    dp_builder_->RecordOpBounds(op_bounds);
+  }
+
   if (!mapped_bounds.Intersect(GetGlobalClipBounds())) {
     return;
   }
   dp_builder_->bounds_.Join(mapped_bounds);
 }
 
+void RecordingCanvas::RecordSaveLayerBounds(const Rect& bounds,
+                                            const Paint& paint) {
+  // Canvas has already intersected the global clip with the layer bounds.
+  Rect layer_bounds = GetGlobalClipBounds();
+
+  bool unbounded = paint.GetImageFilter() != nullptr ||
+                   paint.GetColorFilter() != nullptr ||
+                   paint.GetMaskFilter() != nullptr ||
+                   paint.GetBlendMode() != BlendMode::kSrcOver;
+  if (unbounded) {
+    // Filters may move content across the layer bounds, fall back to the
+    // filtered bounds of the whole layer.
+    GetTotalMatrix().MapRect(&layer_bounds, paint.ComputeFastBounds(bounds));
+    layer_bounds.Outset(1, 1);
+  }
+
+  dp_builder_->RecordSaveLayer(layer_bounds, unbounded);
+}
+
 }  // namespace skity
@@ -2,20 +2,71 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
+#include <skity/effect/color_filter.hpp>
 #include <skity/render/canvas.hpp>
 #include <skity/text/font.hpp>
 #include <skity/text/text_blob.hpp>
 #include <skity/text/utf.hpp>
 
+#include "src/geometry/geometry.hpp"
 #include "src/geometry/math.hpp"
 #include "src/graphic/path_priv.hpp"
 #include "src/logging.hpp"
 #include "src/render/canvas_state.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
+namespace {
+
+uint32_t DecodeExtent(size_t full, float scale) {
+  if (!std::isfinite(scale) || scale <= 0.f) {
+    return static_cast<uint32_t>(full);
+  }
+
+  float extent = std::ceil(static_cast<float>(full) * scale);
+  return static_cast<uint32_t>(
+      std::clamp(extent, 1.f, static_cast<float>(full)));
+}
+
+// Generate the pixels of a lazy image at the resolution `src` covers when
+// drawn into `dst` under `matrix`, and map `src` onto the generated pixels.
+std::shared_ptr<Image> DecodeLazyImage(const std::shared_ptr<Image>& image,
+                                       const Matrix& matrix, const Rect& dst,
+                                       Rect* src) {
+  float scale_x = 1.f;
+  float scale_y = 1.f;
+  if (!matrix.HasPersp() && src->Width() > 0.f && src->Height() > 0.f) {
+    scale_x = std::hypot(matrix.GetScaleX(), matrix.GetSkewY()) *
+              dst.Width() / src->Width();
+    scale_y = std::hypot(matrix.GetSkewX(), matrix.GetScaleY()) *
+              dst.Height() / src->Height();
+  }
+
+  auto pixmap =
+      image->GetDecodedPixmap(DecodeExtent(image->Width(), scale_x),
+                              DecodeExtent(image->Height(), scale_y));
+  if (!pixmap) {
+    return nullptr;
+  }
+
+  if (pixmap->Width() != image->Width() ||
+      pixmap->Height() != image->Height()) {
+    float sx = static_cast<float>(pixmap->Width()) / image->Width();
+    float sy = static_cast<float>(pixmap->Height()) / image->Height();
+    src->SetLTRB(src->Left() * sx, src->Top() * sy, src->Right() * sx,
+                 src->Bottom() * sy);
+  }
+
+  return Image::MakeImage(std::move(pixmap));
+}
+
+}  // namespace
+
 Canvas::Canvas(Rect cull_rect) {
   canvas_state_ = std::make_unique<CanvasState>();
   global_clip_bounds_stack_.push_back(cull_rect);
@@ -142,6 +193,20 @@ void Canvas::OnClipRect(const Rect &rect, ClipOp op) {
   this->OnClipPath(path, op);
 }
 
+void Canvas::ClipRRect(const RRect &rrect, ClipOp op) {
+  if (tracing_canvas_state_) {
+    CalculateGlobalClipBounds(rrect.GetBounds(), op);
+  }
+  this->OnClipRRect(rrect, op);
+}
+
+void Canvas::OnClipRRect(const RRect &rrect, ClipOp op) {
+  Path path;
+  path.AddRRect(rrect);
+
+  this->OnClipPath(path, op);
+}
+
 void Canvas::ClipPath(const Path &path, ClipOp op) {
   if (tracing_canvas_state_) {
     CalculateGlobalClipBounds(path.GetBounds(), op);
@@ -245,7 +310,12 @@ int Canvas::SaveLayer(const Rect &bounds, const Paint &paint) {
   return save_count_ - 1;
 }
 
-void Canvas::Flush() { this->OnFlush(); }
+void Canvas::Flush() {
+  this->OnFlush();
+
+  frame_stats_ = CollectRenderCounters();
+  this->OnFrameStatsCollected(frame_stats_);
+}
 
 void Canvas::DrawSimpleText(const char *text, float x, float y,
                             Paint const &paint) {
@@ -337,7 +407,7 @@ void Canvas::DrawImage(const std::shared_ptr<Image> &image, const Rect &rect,
     return;
   }
   auto src = Rect::MakeWH(image->Width(), image->Height());
-  this->OnDrawImageRect(image, src, rect, sampling, paint);
+  this->DrawImageRect(image, src, rect, sampling, paint);
 }
 
 void Canvas::DrawImageRect(const std::shared_ptr<Image> &image, const Rect &src,
@@ -346,15 +416,166 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image> &image, const Rect &src,
   if (!image) {
     return;
   }
+
+  if (image->GetImageType() == ImageType::kLazyGenerated &&
+      DecodeLazyImages()) {
+    if (QuickReject(dst)) {
+      return;
+    }
+
+    Rect decoded_src = src;
+    auto decoded = DecodeLazyImage(image, GetTotalMatrix(), dst, &decoded_src);
+    if (decoded) {
+      this->OnDrawImageRect(std::move(decoded), decoded_src, dst, sampling,
+                            paint);
+    }
+    return;
+  }
+
   this->OnDrawImageRect(image, src, dst, sampling, paint);
 }
 
+void Canvas::DrawAtlas(const std::shared_ptr<Image> &atlas,
+                       const RSXform xform[], const Rect tex[],
+                       const Color colors[], int count, BlendMode mode,
+                       const SamplingOptions &sampling, const Rect *cull_rect,
+                       const Paint *paint) {
+  if (!atlas || count <= 0 || xform == nullptr || tex == nullptr) {
+    return;
+  }
+
+  if (cull_rect != nullptr && QuickReject(*cull_rect)) {
+    return;
+  }
+
+  if (atlas->GetImageType() == ImageType::kLazyGenerated &&
+      DecodeLazyImages()) {
+    // sprites address the atlas in full size coordinates
+    auto pixmap = atlas->GetDecodedPixmap(atlas->Width(), atlas->Height());
+    if (pixmap) {
+      this->OnDrawAtlas(Image::MakeImage(std::move(pixmap)), xform, tex,
+                        colors, count, mode, sampling, cull_rect, paint);
+    }
+    return;
+  }
+
+  this->OnDrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                    cull_rect, paint);
+}
+
+void Canvas::DrawVertices(const std::shared_ptr<Vertices> &vertices,
+                          BlendMode mode, const Paint &paint) {
+  if (!vertices || vertices->TriangleCount() == 0) {
+    return;
+  }
+
+  if (QuickReject(vertices->Bounds())) {
+    return;
+  }
+
+  this->OnDrawVertices(vertices, mode, paint);
+}
+
 void Canvas::DrawGlyphs(int count, const GlyphID *glyphs,
                         const float *position_x, const float *position_y,
                         const Font &font, const Paint &paint) {
   this->OnDrawGlyphs(count, glyphs, position_x, position_y, font, paint);
 }
 
+void Canvas::OnDrawAtlas(const std::shared_ptr<Image> &atlas,
+                         const RSXform xform[], const Rect tex[],
+                         const Color colors[], int count, BlendMode mode,
+                         const SamplingOptions &sampling, const Rect *cull_rect,
+                         const Paint *paint) {
+  Paint work_paint = paint != nullptr ? *paint : Paint();
+  auto color_filter = work_paint.GetColorFilter();
+
+  for (int i = 0; i < count; i++) {
+    if (colors != nullptr) {
+      // the sprite color is the source of the blend and the sprite is the
+      // destination, which is what a blend color filter does
+      auto blend = ColorFilters::Blend(colors[i], mode);
+      work_paint.SetColorFilter(
+          color_filter ? ColorFilters::Compose(color_filter, blend) : blend);
+    }
+
+    this->Save();
+    this->Concat(xform[i].ToMatrix());
+    this->OnDrawImageRect(atlas, tex[i],
+                          Rect::MakeWH(tex[i].Width(), tex[i].Height()),
+                          sampling, &work_paint);
+    this->Restore();
+  }
+}
+
+void Canvas::OnDrawVertices(const std::shared_ptr<Vertices> &vertices,
+                            BlendMode mode, const Paint &paint) {
+  Paint work_paint = paint;
+  work_paint.SetStyle(Paint::kFill_Style);
+  work_paint.SetAntiAlias(false);
+  work_paint.SetPathEffect(nullptr);
+  work_paint.SetMaskFilter(nullptr);
+  work_paint.SetImageFilter(nullptr);
+
+  const Vec2 *positions = vertices->Positions();
+  const Vec2 *texs = vertices->Texs();
+  const Color *colors = vertices->Colors();
+  const uint32_t *indices = vertices->Indices();
+
+  bool use_shader = paint.GetShader() != nullptr &&
+                    (colors == nullptr || mode != BlendMode::kDst);
+  if (!use_shader) {
+    work_paint.SetShader(nullptr);
+  }
+
+  for (uint32_t i = 0; i < vertices->TriangleCount(); i++) {
+    Vec2 pos[3];
+    Vec2 tex[3];
+    Color4f color{};
+    for (uint32_t v = 0; v < 3; v++) {
+      uint32_t index = indices[i * 3 + v];
+      pos[v] = positions[index];
+      tex[v] = texs ? texs[index] : positions[index];
+      if (colors) {
+        color += Color4fFromColor(colors[index]) * (1.f / 3.f);
+      }
+    }
+
+    if (colors && !use_shader) {
+      color.a *= paint.GetAlphaF();
+      work_paint.SetFillColor(color);
+    }
+
+    if (!use_shader || texs == nullptr) {
+      Path path;
+      path.MoveTo(pos[0].x, pos[0].y);
+      path.LineTo(pos[1].x, pos[1].y);
+      path.LineTo(pos[2].x, pos[2].y);
+      path.Close();
+      this->OnDrawPath(path, work_paint);
+      continue;
+    }
+
+    // draw the triangle in texture space so the shader is sampled at the
+    // texture coordinates
+    Matrix tex_to_pos;
+    if (!TriangleToTriangle(tex, pos, &tex_to_pos)) {
+      continue;
+    }
+
+    Path path;
+    path.MoveTo(tex[0].x, tex[0].y);
+    path.LineTo(tex[1].x, tex[1].y);
+    path.LineTo(tex[2].x, tex[2].y);
+    path.Close();
+
+    this->Save();
+    this->Concat(tex_to_pos);
+    this->OnDrawPath(path, work_paint);
+    this->Restore();
+  }
+}
+
 void Canvas::UpdateViewport(uint32_t width, uint32_t height) {
   this->OnUpdateViewport(width, height);
 }
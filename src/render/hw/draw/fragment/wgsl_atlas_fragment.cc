@@ -0,0 +1,200 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/fragment/wgsl_atlas_fragment.hpp"
+
+#include "src/render/hw/draw/wgx_utils.hpp"
+#include "src/render/hw/hw_draw.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+bool WGSLAtlasFragment::ComputeBlendCoeffs(BlendMode mode,
+                                           BlendCoeffs* coeffs) {
+  // k.xy weights the sprite color with (k.x + k.y * dst alpha), k.zw weights
+  // the atlas pixel with (k.z + k.w * src alpha)
+  switch (mode) {
+    case BlendMode::kClear:
+      *coeffs = {Vec4{0.f, 0.f, 0.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kSrc:
+      *coeffs = {Vec4{1.f, 0.f, 0.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kDst:
+      *coeffs = {Vec4{0.f, 0.f, 1.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kSrcOver:
+      *coeffs = {Vec4{1.f, 0.f, 1.f, -1.f}, 0.f};
+      return true;
+    case BlendMode::kDstOver:
+      *coeffs = {Vec4{1.f, -1.f, 1.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kSrcIn:
+      *coeffs = {Vec4{0.f, 1.f, 0.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kDstIn:
+      *coeffs = {Vec4{0.f, 0.f, 0.f, 1.f}, 0.f};
+      return true;
+    case BlendMode::kSrcOut:
+      *coeffs = {Vec4{1.f, -1.f, 0.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kDstOut:
+      *coeffs = {Vec4{0.f, 0.f, 1.f, -1.f}, 0.f};
+      return true;
+    case BlendMode::kSrcATop:
+      *coeffs = {Vec4{0.f, 1.f, 1.f, -1.f}, 0.f};
+      return true;
+    case BlendMode::kDstATop:
+      *coeffs = {Vec4{1.f, -1.f, 0.f, 1.f}, 0.f};
+      return true;
+    case BlendMode::kXor:
+      *coeffs = {Vec4{1.f, -1.f, 1.f, -1.f}, 0.f};
+      return true;
+    case BlendMode::kPlus:
+      *coeffs = {Vec4{1.f, 0.f, 1.f, 0.f}, 0.f};
+      return true;
+    case BlendMode::kModulate:
+      *coeffs = {Vec4{0.f, 0.f, 0.f, 0.f}, 1.f};
+      return true;
+    case BlendMode::kScreen:
+      *coeffs = {Vec4{1.f, 0.f, 1.f, 0.f}, -1.f};
+      return true;
+    default:
+      return false;
+  }
+}
+
+WGSLAtlasFragment::WGSLAtlasFragment(std::shared_ptr<GPUTexture> texture,
+                                     std::shared_ptr<GPUSampler> sampler,
+                                     AlphaType alpha_type,
+                                     const BlendCoeffs& coeffs,
+                                     float global_alpha)
+    : texture_(std::move(texture)),
+      sampler_(std::move(sampler)),
+      alpha_type_(alpha_type),
+      coeffs_(coeffs),
+      global_alpha_(global_alpha) {}
+
+std::string WGSLAtlasFragment::GetShaderName() const {
+  std::string name = "AtlasFragmentWGSL";
+
+  if (filter_ != nullptr) {
+    name += "_" + filter_->GetShaderName();
+  }
+
+  return name;
+}
+
+std::string WGSLAtlasFragment::GenSourceWGSL() const {
+  std::string wgsl_code = R"(
+    struct AtlasInfo {
+        coeffs          : vec4<f32>,
+        modulate        : f32,
+        global_alpha    : f32,
+        alpha_type      : i32,
+    };
+
+    @group(1) @binding(0) var<uniform>  atlas_info  : AtlasInfo;
+    @group(1) @binding(1) var           uSampler    : sampler;
+    @group(1) @binding(2) var           uTexture    : texture_2d<f32>;
+  )";
+
+  if (filter_ != nullptr) {
+    wgsl_code += filter_->GenSourceWGSL();
+  }
+
+  wgsl_code += R"(
+    struct AtlasFSInput {
+        @location(0) v_uv    : vec2<f32>,
+        @location(1) v_color : vec4<f32>
+    };
+
+    @fragment
+    fn fs_main(input: AtlasFSInput) -> @location(0) vec4<f32> {
+      var pixel: vec4<f32> = textureSample(uTexture, uSampler, input.v_uv);
+
+      if atlas_info.alpha_type == 3 {
+        pixel = vec4<f32>(pixel.xyz * pixel.w, pixel.w);
+      }
+
+      var c: vec4<f32> = input.v_color;
+      var k: vec4<f32> = atlas_info.coeffs;
+
+      var color: vec4<f32> = c * (k.x + k.y * pixel.w) +
+                             pixel * (k.z + k.w * c.w) +
+                             atlas_info.modulate * c * pixel;
+
+      color = clamp(color, vec4<f32>(0.0), vec4<f32>(1.0));
+      color *= atlas_info.global_alpha;
+  )";
+
+  if (filter_ != nullptr) {
+    wgsl_code += R"(
+      color = filter_color(color);
+    )";
+  }
+
+  wgsl_code += R"(
+      return color;
+    }
+  )";
+
+  return wgsl_code;
+}
+
+void WGSLAtlasFragment::PrepareCMD(Command* cmd, HWDrawContext* context) {
+  SKITY_TRACE_EVENT(WGSLAtlasFragment_PrepareCMD);
+
+  if (cmd->pipeline == nullptr) {
+    return;
+  }
+
+  auto group = cmd->pipeline->GetBindingGroup(1);
+  if (group == nullptr) {
+    return;
+  }
+
+  // AtlasInfo
+  {
+    auto entry = group->GetEntry(0);
+
+    if (entry == nullptr || entry->type_definition->name != "AtlasInfo") {
+      return;
+    }
+
+    auto info_struct =
+        static_cast<wgx::StructDefinition*>(entry->type_definition.get());
+
+    int32_t alpha_type = alpha_type_;
+
+    info_struct->GetMember("coeffs")->type->SetData(&coeffs_.k, sizeof(Vec4));
+    info_struct->GetMember("modulate")->type->SetData(&coeffs_.m,
+                                                      sizeof(float));
+    info_struct->GetMember("global_alpha")
+        ->type->SetData(&global_alpha_, sizeof(float));
+    info_struct->GetMember("alpha_type")
+        ->type->SetData(&alpha_type, sizeof(int32_t));
+
+    UploadBindGroup(group->group, entry, cmd, context);
+  }
+
+  auto sampler_binding = group->GetEntry(1);
+  auto texture_binding = group->GetEntry(2);
+
+  if (sampler_binding == nullptr ||
+      sampler_binding->type != wgx::BindingType::kSampler ||
+      texture_binding == nullptr ||
+      texture_binding->type != wgx::BindingType::kTexture) {
+    return;
+  }
+
+  UploadBindGroup(group->group, sampler_binding, cmd, sampler_);
+  UploadBindGroup(group->group, texture_binding, cmd, texture_);
+
+  if (filter_ != nullptr) {
+    filter_->SetupBindGroup(cmd, context);
+  }
+}
+
+}  // namespace skity
@@ -0,0 +1,69 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_FRAGMENT_WGSL_ATLAS_FRAGMENT_HPP
+#define SRC_RENDER_HW_DRAW_FRAGMENT_WGSL_ATLAS_FRAGMENT_HPP
+
+#include <skity/geometry/vector.hpp>
+#include <skity/graphic/alpha_type.hpp>
+#include <skity/graphic/blend_mode.hpp>
+
+#include "src/gpu/gpu_sampler.hpp"
+#include "src/gpu/gpu_texture.hpp"
+#include "src/render/hw/draw/hw_wgsl_fragment.hpp"
+
+namespace skity {
+
+/**
+ * Fragment of WGSLAtlasGeometry. Samples the atlas and blends the sprite
+ * color (the source) with the sampled pixel (the destination).
+ *
+ * The blend is evaluated as
+ *
+ *    c * (k.x + k.y * i.a) + i * (k.z + k.w * c.a) + m * c * i
+ *
+ * where c is the sprite color and i the sampled pixel, which covers all the
+ * coefficient modes up to BlendMode::kLastCoeffMode with one shader.
+ */
+class WGSLAtlasFragment : public HWWGSLFragment {
+ public:
+  struct BlendCoeffs {
+    Vec4 k;
+    float m;
+  };
+
+  /**
+   * @return false if the blend mode can not be expressed with BlendCoeffs
+   */
+  static bool ComputeBlendCoeffs(BlendMode mode, BlendCoeffs* coeffs);
+
+  WGSLAtlasFragment(std::shared_ptr<GPUTexture> texture,
+                    std::shared_ptr<GPUSampler> sampler, AlphaType alpha_type,
+                    const BlendCoeffs& coeffs, float global_alpha);
+
+  ~WGSLAtlasFragment() override = default;
+
+  std::string GetShaderName() const override;
+
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kAtlas);
+  }
+
+  uint32_t NextBindingIndex() const override { return 3; }
+
+  std::string GenSourceWGSL() const override;
+
+  void PrepareCMD(Command* cmd, HWDrawContext* context) override;
+
+ private:
+  std::shared_ptr<GPUTexture> texture_;
+  std::shared_ptr<GPUSampler> sampler_;
+  AlphaType alpha_type_;
+  BlendCoeffs coeffs_;
+  float global_alpha_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_FRAGMENT_WGSL_ATLAS_FRAGMENT_HPP
@@ -21,6 +21,10 @@ class WGSLBlurFilter : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kBlurFilter);
+  }
+
   std::string GenSourceWGSL() const override;
 
   uint32_t NextBindingIndex() const override;
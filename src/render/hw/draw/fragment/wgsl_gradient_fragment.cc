@@ -155,6 +155,11 @@ std::string WGSLGradientFragment::GetShaderName() const {
   return gradient_fragment_.GetShaderName();
 }
 
+uint32_t WGSLGradientFragment::GetShaderKey() const {
+  return MakeHWShaderKey(HWFragmentVariant::kGradient,
+                         gradient_fragment_.GetShaderKeyOptions());
+}
+
 uint32_t WGSLGradientFragment::NextBindingIndex() const { return 2; }
 
 void WGSLGradientFragment::PrepareCMD(Command* cmd, HWDrawContext* context) {
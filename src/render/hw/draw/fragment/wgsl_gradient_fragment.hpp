@@ -23,6 +23,8 @@ class WGSLGradientFragment : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override;
+
   void PrepareCMD(Command* cmd, HWDrawContext* context) override;
 
   void WriteFSFunctionsAndStructs(std::stringstream& ss) const override;
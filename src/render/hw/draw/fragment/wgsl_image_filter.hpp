@@ -22,6 +22,10 @@ class WGSLImageFilter : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kImageFilter);
+  }
+
   std::string GenSourceWGSL() const override;
 
   uint32_t NextBindingIndex() const override;
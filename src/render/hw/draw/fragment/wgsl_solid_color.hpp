@@ -21,6 +21,10 @@ class WGSLSolidColor : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kSolidColor);
+  }
+
   void WriteFSUniforms(std::stringstream& ss) const override;
 
   void WriteFSMain(std::stringstream& ss) const override;
@@ -22,6 +22,10 @@ class WGSLSolidVertexColor : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kSolidVertexColor);
+  }
+
   std::optional<std::vector<std::string>> GetVarings() const override;
 
   void WriteVSAssgnShadingVarings(std::stringstream& ss) const override;
@@ -15,6 +15,10 @@ class WGSLStencilFragment : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kStencil);
+  }
+
   std::string GenSourceWGSL() const override;
 
   uint32_t NextBindingIndex() const override { return 0; }
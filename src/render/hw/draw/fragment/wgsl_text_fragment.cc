@@ -166,6 +166,10 @@ std::string WGSLColorEmojiFragment::GetShaderName() const {
   return name;
 }
 
+uint32_t WGSLColorEmojiFragment::GetShaderKey() const {
+  return MakeHWShaderKey(HWFragmentVariant::kColorEmoji, swizzle_rb_ ? 1 : 0);
+}
+
 uint32_t WGSLColorEmojiFragment::NextBindingIndex() const { return 6; }
 
 void WGSLColorEmojiFragment::PrepareCMD(Command* cmd, HWDrawContext* context) {
@@ -254,6 +258,11 @@ std::string WGSLGradientTextFragment::GetShaderName() const {
   return name;
 }
 
+uint32_t WGSLGradientTextFragment::GetShaderKey() const {
+  return MakeHWShaderKey(HWFragmentVariant::kGradientText,
+                         gradient_fragment_.GetShaderKeyOptions());
+}
+
 std::string WGSLGradientTextFragment::GenSourceWGSL() const {
   std::string wgsl_code = kCommonTextFragment;
 
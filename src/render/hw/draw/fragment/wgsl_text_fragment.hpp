@@ -80,6 +80,10 @@ class WGSLColorTextFragment : public WGSLTextFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kColorText);
+  }
+
   uint32_t NextBindingIndex() const override;
 
   std::string GenSourceWGSL() const override;
@@ -102,6 +106,8 @@ class WGSLColorEmojiFragment : public WGSLTextFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override;
+
   uint32_t NextBindingIndex() const override;
 
   bool CanMerge(const HWWGSLFragment* other) const override;
@@ -133,6 +139,8 @@ class WGSLGradientTextFragment : public WGSLTextFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override;
+
   std::string GenSourceWGSL() const override;
 
   bool CanMerge(const HWWGSLFragment* other) const override;
@@ -157,6 +165,10 @@ class WGSLSdfColorTextFragment : public WGSLTextFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kSdfColorText);
+  }
+
   uint32_t NextBindingIndex() const override;
 
   std::string GenSourceWGSL() const override;
@@ -28,6 +28,10 @@ class WGSLTextureFragment : public HWWGSLFragment {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWFragmentVariant::kTexture);
+  }
+
   void PrepareCMD(Command* cmd, HWDrawContext* context) override;
 
   void WriteFSFunctionsAndStructs(std::stringstream& ss) const override;
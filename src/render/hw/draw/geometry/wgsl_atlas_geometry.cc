@@ -0,0 +1,136 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/geometry/wgsl_atlas_geometry.hpp"
+
+#include "src/render/hw/draw/wgx_utils.hpp"
+#include "src/render/hw/hw_draw.hpp"
+#include "src/render/hw/hw_stage_buffer.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+const std::vector<GPUVertexBufferLayout>& WGSLAtlasGeometry::GetBufferLayout()
+    const {
+  static const std::vector<GPUVertexBufferLayout> layout = {
+      // the unit quad shared with the text geometry
+      GPUVertexBufferLayout{
+          4 * sizeof(float),
+          GPUVertexStepMode::kVertex,
+          {
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  0,
+                  0,
+              },
+          },
+      },
+      GPUVertexBufferLayout{
+          sizeof(AtlasSprite),
+          GPUVertexStepMode::kInstance,
+          {
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  0,
+                  1,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  4 * sizeof(float),
+                  2,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  8 * sizeof(float),
+                  3,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  12 * sizeof(float),
+                  4,
+              },
+          },
+      },
+  };
+
+  return layout;
+}
+
+std::string WGSLAtlasGeometry::GenSourceWGSL() const {
+  std::string wgsl_code = CommonVertexWGSL();
+
+  wgsl_code += R"(
+    struct AtlasVSInput {
+        @location(0) a_offset : vec4<f32>,
+        @location(1) a_axes   : vec4<f32>,
+        @location(2) a_origin : vec4<f32>,
+        @location(3) a_uv     : vec4<f32>,
+        @location(4) a_color  : vec4<f32>
+    };
+
+    struct AtlasVSOutput {
+        @builtin(position)  pos     : vec4<f32>,
+        @location(0)        v_uv    : vec2<f32>,
+        @location(1)        v_color : vec4<f32>
+    };
+
+    @group(0) @binding(0) var<uniform> common_slot: CommonSlot;
+
+    @vertex
+    fn vs_main(atlas_in: AtlasVSInput) -> AtlasVSOutput {
+        var output: AtlasVSOutput;
+        // the corner of the unit quad
+        var t: vec2<f32> = atlas_in.a_offset.zw;
+        var pos: vec2<f32> = atlas_in.a_origin.xy +
+                             t.x * atlas_in.a_axes.xy +
+                             t.y * atlas_in.a_axes.zw;
+
+        output.pos      = get_vertex_position(pos, common_slot);
+        output.v_uv     = mix(atlas_in.a_uv.xy, atlas_in.a_uv.zw, t);
+        output.v_color  = atlas_in.a_color;
+        return output;
+    }
+  )";
+
+  return wgsl_code;
+}
+
+void WGSLAtlasGeometry::PrepareCMD(Command* cmd, HWDrawContext* context,
+                                   const Matrix& transform, float clip_depth,
+                                   Command* stencil_cmd) {
+  SKITY_TRACE_EVENT(WGSLAtlasGeometry_PrepareCMD);
+
+  if (cmd->pipeline == nullptr) {
+    return;
+  }
+
+  cmd->vertex_buffer = context->static_buffer->GetTextVertexBufferView();
+  cmd->index_buffer = context->static_buffer->GetTextIndexBufferView();
+  cmd->index_count = cmd->index_buffer.range / sizeof(uint32_t);
+
+  context->stageBuffer->BeginWritingInstance(
+      sprites_.size() * sizeof(AtlasSprite), alignof(AtlasSprite));
+  for (const auto& sprite : sprites_) {
+    context->stageBuffer->AppendInstance<AtlasSprite>(sprite);
+  }
+  auto instance_buffer_view = context->stageBuffer->EndWritingInstance();
+  cmd->instance_count = instance_buffer_view.range / sizeof(AtlasSprite);
+  cmd->instance_buffer = instance_buffer_view;
+
+  auto group = cmd->pipeline->GetBindingGroup(0);
+  if (group == nullptr) {
+    return;
+  }
+
+  // bind CommonSlot
+  auto common_slot = group->GetEntry(0);
+
+  if (!SetupCommonInfo(common_slot, context->mvp, transform, clip_depth)) {
+    return;
+  }
+
+  UploadBindGroup(group->group, common_slot, cmd, context);
+}
+
+}  // namespace skity
@@ -0,0 +1,64 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_ATLAS_GEOMETRY_HPP
+#define SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_ATLAS_GEOMETRY_HPP
+
+#include <skity/geometry/vector.hpp>
+#include <vector>
+
+#include "src/render/hw/draw/hw_wgsl_geometry.hpp"
+
+namespace skity {
+
+/**
+ * One sprite of a DrawAtlas call, already mapped into the space of the draw
+ * transform. A corner (u, v) of the unit square lands on
+ * `origin + u * axis_x + v * axis_y`.
+ */
+struct AtlasSprite {
+  // axis_x.xy, axis_y.xy
+  Vec4 axes;
+  // origin.xy, unused
+  Vec4 origin;
+  // normalized texture coordinate of the sprite, left, top, right, bottom
+  Vec4 uv;
+  // premultiplied sprite color
+  Vec4 color;
+};
+
+static_assert(sizeof(AtlasSprite) == 64);
+
+/**
+ * Draws all the sprites of one or more DrawAtlas calls with a single instanced
+ * draw, reusing the unit quad of the text geometry. Every instance carries its
+ * own placement, texture coordinate and color.
+ */
+class WGSLAtlasGeometry : public HWWGSLGeometry {
+ public:
+  explicit WGSLAtlasGeometry(std::vector<AtlasSprite> sprites)
+      : sprites_(std::move(sprites)) {}
+
+  ~WGSLAtlasGeometry() override = default;
+
+  const std::vector<GPUVertexBufferLayout>& GetBufferLayout() const override;
+
+  std::string GetShaderName() const override { return "AtlasVertexWGSL"; }
+
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kAtlas);
+  }
+
+  std::string GenSourceWGSL() const override;
+
+  void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
+                  float clip_depth, Command* stencil_cmd) override;
+
+ private:
+  std::vector<AtlasSprite> sprites_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_ATLAS_GEOMETRY_HPP
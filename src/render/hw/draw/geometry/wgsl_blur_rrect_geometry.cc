@@ -0,0 +1,246 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/geometry/wgsl_blur_rrect_geometry.hpp"
+
+#include "src/render/hw/draw/wgx_utils.hpp"
+#include "src/render/hw/hw_draw.hpp"
+#include "src/render/hw/hw_stage_buffer.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+namespace {
+
+struct Instance {
+  Vec4 rect;
+  // corner radius, sigma
+  Vec2 blur;
+  Vec4 transform0;
+  Vec2 transform1;
+  Vec4 color;
+};
+
+static_assert(sizeof(Instance) == 64);
+
+}  // namespace
+
+WGSLBlurRRectGeometry::WGSLBlurRRectGeometry(
+    const std::vector<BatchGroup<AnalyticBlurRRect>>& batch_group)
+    : HWWGSLGeometry(Flags::kSnippet | Flags::kAffectsFragment),
+      batch_group_(batch_group) {}
+
+const std::vector<GPUVertexBufferLayout>&
+WGSLBlurRRectGeometry::GetBufferLayout() const {
+  static const std::vector<GPUVertexBufferLayout> layout = {
+      // the unit quad shared with the text geometry
+      GPUVertexBufferLayout{
+          4 * sizeof(float),
+          GPUVertexStepMode::kVertex,
+          {
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  0,
+                  0,
+              },
+          },
+      },
+      GPUVertexBufferLayout{
+          sizeof(Instance),
+          GPUVertexStepMode::kInstance,
+          {
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  0,
+                  1,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x2,
+                  4 * sizeof(float),
+                  2,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  6 * sizeof(float),
+                  3,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x2,
+                  10 * sizeof(float),
+                  4,
+              },
+              GPUVertexAttribute{
+                  GPUVertexFormat::kFloat32x4,
+                  12 * sizeof(float),
+                  5,
+              },
+          },
+      },
+  };
+
+  return layout;
+}
+
+std::string WGSLBlurRRectGeometry::GetShaderName() const { return "BlurRRect"; }
+
+void WGSLBlurRRectGeometry::WriteVSFunctionsAndStructs(
+    std::stringstream& ss) const {
+  ss << CommonVertexWGSL();
+}
+
+void WGSLBlurRRectGeometry::WriteVSUniforms(std::stringstream& ss) const {
+  ss << "@group(0) @binding(0) var<uniform> common_slot  : CommonSlot;\n";
+}
+
+void WGSLBlurRRectGeometry::WriteVSInput(std::stringstream& ss) const {
+  ss << R"(
+struct VSInput {
+  @location(0)  packed        :   vec4<f32>,
+  @location(1)  rect          :   vec4<f32>,
+  @location(2)  blur          :   vec2<f32>,
+  @location(3)  transform0    :   vec4<f32>,
+  @location(4)  transform1    :   vec2<f32>,
+  @location(5)  color         :   vec4<f32>,
+};
+)";
+}
+
+void WGSLBlurRRectGeometry::WriteVSMain(std::stringstream& ss) const {
+  ss << R"(
+  // the corner of the unit quad, stretched over the rect outset by 3 sigma
+  var t: vec2<f32> = input.packed.zw;
+  var outset: f32 = 3.0 * input.blur.y;
+  var bounds: vec4<f32> = input.rect +
+                          vec4<f32>(-outset, -outset, outset, outset);
+  var pos: vec2<f32> = mix(bounds.xy, bounds.zw, t);
+
+  local_pos = pos;
+  var transform: mat4x4<f32> = mat4x4<f32>(
+    input.transform0.x, input.transform0.y, 0.0, 0.0,
+    input.transform0.z, input.transform0.w, 0.0, 0.0,
+                   0.0,                0.0, 1.0, 0.0,
+    input.transform1.x, input.transform1.y, 0.0, 1.0
+  );
+  var common_slot_clone: CommonSlot = common_slot;
+  common_slot_clone.userTransform = transform;
+  output.pos = get_vertex_position(pos, common_slot_clone);
+  output.v_blur_pos = pos;
+  output.v_rect = input.rect;
+  output.v_blur = input.blur;
+)";
+}
+
+std::optional<std::vector<std::string>> WGSLBlurRRectGeometry::GetVarings()
+    const {
+  return std::vector<std::string>{"v_blur_pos: vec2<f32>",  //
+                                  "v_rect: vec4<f32>",      //
+                                  "v_blur: vec2<f32>"};
+}
+
+void WGSLBlurRRectGeometry::WriteFSFunctionsAndStructs(
+    std::stringstream& ss) const {
+  ss << R"(
+fn blur_erf(x: vec2<f32>) -> vec2<f32> {
+  let s: vec2<f32> = sign(x);
+  let a: vec2<f32> = abs(x);
+  var t: vec2<f32> = 1.0 + (0.278393 + (0.230389 + 0.078108 * (a * a)) * a) * a;
+  t = t * t;
+  return s - s / (t * t);
+}
+
+// the Gaussian integrated over [lo, hi], seen from x
+fn blur_interval(x: f32, lo: f32, hi: f32, sigma: f32) -> f32 {
+  let e: vec2<f32> = blur_erf(vec2<f32>(x - lo, x - hi) * (0.70710678 / sigma));
+  return 0.5 * (e.x - e.y);
+}
+
+fn blur_gaussian(x: f32, sigma: f32) -> f32 {
+  return exp(-(x * x) / (2.0 * sigma * sigma)) / (2.50662827 * sigma);
+}
+
+fn blur_rrect_coverage(p: vec2<f32>, rect: vec4<f32>, corner: f32,
+                       sigma: f32) -> f32 {
+  if (corner <= 0.0) {
+    return clamp(blur_interval(p.x, rect.x, rect.z, sigma) *
+                 blur_interval(p.y, rect.y, rect.w, sigma), 0.0, 1.0);
+  }
+
+  let half_size: vec2<f32> = (rect.zw - rect.xy) * 0.5;
+  let q: vec2<f32> = p - (rect.xy + rect.zw) * 0.5;
+
+  // integrates the blurred rows of the rrect over the kernel along y
+  let start: f32 = clamp(-3.0 * sigma, q.y - half_size.y, q.y + half_size.y);
+  let end: f32 = clamp(3.0 * sigma, q.y - half_size.y, q.y + half_size.y);
+  let step: f32 = (end - start) * 0.25;
+  var offset: f32 = start + step * 0.5;
+  var value: f32 = 0.0;
+  for (var i: i32 = 0; i < 4; i = i + 1) {
+    let dy: f32 = min(half_size.y - corner - abs(q.y - offset), 0.0);
+    let curved: f32 = half_size.x - corner +
+                      sqrt(max(0.0, corner * corner - dy * dy));
+    value = value + blur_interval(q.x, -curved, curved, sigma) *
+                    blur_gaussian(offset, sigma) * step;
+    offset = offset + step;
+  }
+
+  return clamp(value, 0.0, 1.0);
+}
+)";
+}
+
+void WGSLBlurRRectGeometry::WriteFSAlphaMask(std::stringstream& ss) const {
+  ss << R"(
+  mask_alpha = blur_rrect_coverage(input.v_blur_pos, input.v_rect,
+                                   input.v_blur.x, input.v_blur.y);
+)";
+}
+
+void WGSLBlurRRectGeometry::PrepareCMD(Command* cmd, HWDrawContext* context,
+                                       const Matrix& transform,
+                                       float clip_depth, Command* stencil_cmd) {
+  SKITY_TRACE_EVENT(WGSLBlurRRectGeometry_PrepareCMD);
+
+  if (cmd->pipeline == nullptr) {
+    return;
+  }
+
+  cmd->vertex_buffer = context->static_buffer->GetTextVertexBufferView();
+  cmd->index_buffer = context->static_buffer->GetTextIndexBufferView();
+  cmd->index_count = cmd->index_buffer.range / sizeof(uint32_t);
+
+  context->stageBuffer->BeginWritingInstance(
+      batch_group_.size() * sizeof(Instance), alignof(Instance));
+  for (const auto& element : batch_group_) {
+    const AnalyticBlurRRect& blur = element.item;
+    const Rect& rect = blur.GetRect();
+    const Matrix& m = element.transform;
+
+    Instance instance = {
+        Vec4{rect.Left(), rect.Top(), rect.Right(), rect.Bottom()},
+        Vec2{blur.GetCornerRadius(), blur.GetSigma()},
+        Vec4{m.GetScaleX(), m.GetSkewY(), m.GetSkewX(), m.GetScaleY()},
+        Vec2{m.GetTranslateX(), m.GetTranslateY()},
+        Vec4{element.paint.GetColor4f()}};
+    context->stageBuffer->AppendInstance<Instance>(instance);
+  }
+  auto instance_buffer_view = context->stageBuffer->EndWritingInstance();
+  cmd->instance_count = instance_buffer_view.range / sizeof(Instance);
+  cmd->instance_buffer = instance_buffer_view;
+
+  auto group = cmd->pipeline->GetBindingGroup(0);
+  if (group == nullptr) {
+    return;
+  }
+
+  // bind CommonSlot
+  auto common_slot = group->GetEntry(0);
+
+  if (!SetupCommonInfo(common_slot, context->mvp, transform, clip_depth)) {
+    return;
+  }
+
+  UploadBindGroup(group->group, common_slot, cmd, context);
+}
+
+}  // namespace skity
@@ -0,0 +1,59 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_BLUR_RRECT_GEOMETRY_HPP
+#define SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_BLUR_RRECT_GEOMETRY_HPP
+
+#include <vector>
+
+#include "src/effect/analytic_blur.hpp"
+#include "src/render/hw/draw/hw_wgsl_geometry.hpp"
+#include "src/utils/batch_group.hpp"
+
+namespace skity {
+
+/**
+ * Instanced quads covering blurred rects and rrects. The fragment stage
+ * evaluates the analytic blurred coverage, so no offscreen target nor blur
+ * pass is needed.
+ */
+class WGSLBlurRRectGeometry : public HWWGSLGeometry {
+ public:
+  explicit WGSLBlurRRectGeometry(
+      const std::vector<BatchGroup<AnalyticBlurRRect>>& batch_group);
+
+  ~WGSLBlurRRectGeometry() override = default;
+
+  const std::vector<GPUVertexBufferLayout>& GetBufferLayout() const override;
+
+  std::string GetShaderName() const override;
+
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kBlurRRect);
+  }
+
+  void WriteVSFunctionsAndStructs(std::stringstream& ss) const override;
+
+  void WriteVSUniforms(std::stringstream& ss) const override;
+
+  void WriteVSInput(std::stringstream& ss) const override;
+
+  void WriteVSMain(std::stringstream& ss) const override;
+
+  std::optional<std::vector<std::string>> GetVarings() const override;
+
+  void WriteFSFunctionsAndStructs(std::stringstream& ss) const override;
+
+  void WriteFSAlphaMask(std::stringstream& ss) const override;
+
+  void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
+                  float clip_depth, Command* stencil_cmd) override;
+
+ private:
+  const std::vector<BatchGroup<AnalyticBlurRRect>>& batch_group_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_BLUR_RRECT_GEOMETRY_HPP
@@ -24,6 +24,10 @@ class WGSLFilterGeometry : public HWWGSLGeometry {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kFilter);
+  }
+
   std::string GenSourceWGSL() const override;
 
   void PrepareCMD(Command *cmd, HWDrawContext *context, const Matrix &transform,
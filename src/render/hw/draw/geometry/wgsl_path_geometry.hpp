@@ -22,6 +22,10 @@ class WGSLPathGeometry : public HWWGSLGeometry {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kPath);
+  }
+
   void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
                   float clip_depth, Command* stencil_cmd) override;
 
@@ -50,6 +54,10 @@ class WGSLPathAAGeometry : public HWWGSLGeometry {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kPathAA);
+  }
+
   void WriteVSFunctionsAndStructs(std::stringstream& ss) const override;
 
   void WriteVSUniforms(std::stringstream& ss) const override;
@@ -24,6 +24,10 @@ class WGSLRRectGeometry : public HWWGSLGeometry {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kRRect);
+  }
+
   void WriteVSFunctionsAndStructs(std::stringstream& ss) const override;
 
   void WriteVSUniforms(std::stringstream& ss) const override;
@@ -24,6 +24,10 @@ class WGSLTessPathFillGeometry : public HWWGSLGeometry {
 
   std::string GetShaderName() const override;
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kTessPathFill);
+  }
+
   void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
                   float clip_depth, Command* stencil_cmd) override;
 
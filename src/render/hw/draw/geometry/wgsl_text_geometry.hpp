@@ -91,6 +91,10 @@ class WGSLTextSolidColorGeometry : public WGSLTextGeometry {
   std::string GetShaderName() const override {
     return "TextSolidColorVertexWGSL";
   }
+
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kTextSolidColor);
+  }
 };
 
 class WGSLTextGradientGeometry : public WGSLTextGeometry {
@@ -115,6 +119,10 @@ class WGSLTextGradientGeometry : public WGSLTextGeometry {
     return "TextGradientVertexWGSL";
   }
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWGeometryVariant::kTextGradient);
+  }
+
   bool CanMerge(const HWWGSLGeometry* other) const override;
 
   void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
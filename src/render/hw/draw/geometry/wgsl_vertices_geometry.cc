@@ -0,0 +1,238 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/geometry/wgsl_vertices_geometry.hpp"
+
+#include <iomanip>
+
+#include "src/render/hw/draw/wgx_utils.hpp"
+#include "src/render/hw/hw_draw.hpp"
+#include "src/render/hw/hw_stage_buffer.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+namespace {
+
+std::vector<GPUVertexBufferLayout> InitVertexBufferLayout(bool use_texs,
+                                                          bool use_colors) {
+  GPUVertexBufferLayout layout{
+      2 * sizeof(float),
+      GPUVertexStepMode::kVertex,
+      {
+          GPUVertexAttribute{
+              GPUVertexFormat::kFloat32x2,
+              0,
+              0,
+          },
+      },
+  };
+
+  int32_t location = 1;
+  if (use_texs) {
+    layout.attributes.emplace_back(GPUVertexAttribute{
+        GPUVertexFormat::kFloat32x2,
+        layout.array_stride,
+        location++,
+    });
+    layout.array_stride += 2 * sizeof(float);
+  }
+
+  if (use_colors) {
+    layout.attributes.emplace_back(GPUVertexAttribute{
+        GPUVertexFormat::kFloat32x4,
+        layout.array_stride,
+        location++,
+    });
+    layout.array_stride += 4 * sizeof(float);
+  }
+
+  return {layout};
+}
+
+}  // namespace
+
+WGSLVerticesGeometry::WGSLVerticesGeometry(const Vertices& vertices,
+                                           bool use_texs, bool use_colors,
+                                           float color_alpha,
+                                           std::optional<BlendMode> blend)
+    : HWWGSLGeometry(blend.has_value()
+                         ? Flags::kSnippet | Flags::kAffectsFragment
+                         : Flags::kSnippet),
+      vertices_(vertices),
+      use_texs_(use_texs),
+      use_colors_(use_colors || blend.has_value()),
+      color_alpha_(color_alpha),
+      blend_(blend),
+      layout_(InitVertexBufferLayout(use_texs_, use_colors_)) {
+  if (blend_.has_value()) {
+    WGSLAtlasFragment::ComputeBlendCoeffs(*blend_, &coeffs_);
+  }
+}
+
+const std::vector<GPUVertexBufferLayout>&
+WGSLVerticesGeometry::GetBufferLayout() const {
+  return layout_;
+}
+
+std::string WGSLVerticesGeometry::GetShaderName() const {
+  std::string name = "Vertices";
+  if (use_texs_) {
+    name += "Tex";
+  }
+  if (use_colors_) {
+    name += "Color";
+  }
+  return name;
+}
+
+uint32_t WGSLVerticesGeometry::GetShaderKey() const {
+  // 1 bit texs, 1 bit colors, 1 bit blend, 5 bits blend mode
+  uint32_t options = (use_texs_ ? 1 : 0) | (use_colors_ ? 2 : 0);
+  if (blend_.has_value()) {
+    options |= 4 | static_cast<uint32_t>(*blend_) << 3;
+  }
+  return MakeHWShaderKey(HWGeometryVariant::kVertices, options);
+}
+
+void WGSLVerticesGeometry::WriteVSFunctionsAndStructs(
+    std::stringstream& ss) const {
+  ss << CommonVertexWGSL();
+}
+
+void WGSLVerticesGeometry::WriteVSUniforms(std::stringstream& ss) const {
+  ss << "@group(0) @binding(0) var<uniform> common_slot  : CommonSlot;\n";
+}
+
+void WGSLVerticesGeometry::WriteVSInput(std::stringstream& ss) const {
+  int32_t location = 1;
+  ss << R"(
+struct VSInput {
+  @location(0)  a_pos: vec2<f32>,
+)";
+  if (use_texs_) {
+    ss << "  @location(" << location++ << ")  a_uv: vec2<f32>,\n";
+  }
+  if (use_colors_) {
+    ss << "  @location(" << location++ << ")  color: vec4<f32>,\n";
+  }
+  ss << R"(
+};
+)";
+}
+
+void WGSLVerticesGeometry::WriteVSMain(std::stringstream& ss) const {
+  if (use_texs_) {
+    ss << R"(
+  local_pos = input.a_uv;
+)";
+  } else {
+    ss << R"(
+  local_pos = input.a_pos;
+)";
+  }
+
+  ss << R"(
+  output.pos = get_vertex_position(input.a_pos, common_slot);
+)";
+
+  if (blend_.has_value()) {
+    ss << R"(
+  output.v_color = input.color;
+)";
+  }
+}
+
+std::optional<std::vector<std::string>> WGSLVerticesGeometry::GetVarings()
+    const {
+  if (!blend_.has_value()) {
+    return std::nullopt;
+  }
+  return std::vector<std::string>{"v_color: vec4<f32>"};
+}
+
+std::string WGSLVerticesGeometry::GetFSNameSuffix() const {
+  return "VerticesBlend" +
+         std::to_string(static_cast<uint32_t>(blend_.value_or(BlendMode{})));
+}
+
+void WGSLVerticesGeometry::WriteFSModifyColor(std::stringstream& ss) const {
+  if (!blend_.has_value()) {
+    return;
+  }
+
+  // color is the shader output, the source of the blend
+  ss << std::fixed << std::setprecision(1);
+  ss << R"(
+  var dst_color: vec4<f32> = vec4<f32>(input.v_color.rgb * input.v_color.a,
+                                       input.v_color.a);
+  var blend_k: vec4<f32> = vec4<f32>()"
+     << coeffs_.k.x << ", " << coeffs_.k.y << ", " << coeffs_.k.z << ", "
+     << coeffs_.k.w << R"();
+  color = color * (blend_k.x + blend_k.y * dst_color.a) +
+          dst_color * (blend_k.z + blend_k.w * color.a) +
+          )"
+     << coeffs_.m << R"( * color * dst_color;
+  color = clamp(color, vec4<f32>(0.0), vec4<f32>(1.0));
+)";
+}
+
+void WGSLVerticesGeometry::PrepareCMD(Command* cmd, HWDrawContext* context,
+                                      const Matrix& transform,
+                                      float clip_depth, Command* stencil_cmd) {
+  SKITY_TRACE_EVENT(WGSLVerticesGeometry_PrepareCMD);
+
+  if (cmd->pipeline == nullptr || vertices_.IndexCount() == 0) {
+    return;
+  }
+
+  const Vec2* positions = vertices_.Positions();
+  const Vec2* texs = vertices_.Texs();
+  const Color* colors = vertices_.Colors();
+
+  std::vector<float> vertex_data;
+  vertex_data.reserve(vertices_.VertexCount() * layout_.front().array_stride /
+                      sizeof(float));
+
+  for (uint32_t i = 0; i < vertices_.VertexCount(); i++) {
+    vertex_data.push_back(positions[i].x);
+    vertex_data.push_back(positions[i].y);
+
+    if (use_texs_) {
+      vertex_data.push_back(texs[i].x);
+      vertex_data.push_back(texs[i].y);
+    }
+
+    if (use_colors_) {
+      Color4f color = Color4fFromColor(colors[i]);
+      vertex_data.push_back(color.r);
+      vertex_data.push_back(color.g);
+      vertex_data.push_back(color.b);
+      vertex_data.push_back(color.a * color_alpha_);
+    }
+  }
+
+  cmd->vertex_buffer = context->stageBuffer->Push(
+      vertex_data.data(), vertex_data.size() * sizeof(float));
+  cmd->index_buffer = context->stageBuffer->PushIndex(
+      const_cast<uint32_t*>(vertices_.Indices()),
+      vertices_.IndexCount() * sizeof(uint32_t));
+  cmd->index_count = vertices_.IndexCount();
+
+  auto group = cmd->pipeline->GetBindingGroup(0);
+  if (group == nullptr) {
+    return;
+  }
+
+  // bind CommonSlot
+  auto common_slot = group->GetEntry(0);
+
+  if (!SetupCommonInfo(common_slot, context->mvp, transform, clip_depth)) {
+    return;
+  }
+
+  UploadBindGroup(group->group, common_slot, cmd, context);
+}
+
+}  // namespace skity
@@ -0,0 +1,71 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_VERTICES_GEOMETRY_HPP
+#define SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_VERTICES_GEOMETRY_HPP
+
+#include <optional>
+#include <skity/graphic/blend_mode.hpp>
+#include <skity/graphic/vertices.hpp>
+
+#include "src/render/hw/draw/fragment/wgsl_atlas_fragment.hpp"
+#include "src/render/hw/draw/hw_wgsl_geometry.hpp"
+
+namespace skity {
+
+/**
+ * Uploads the triangles of a Vertices as they are.
+ *
+ * The local position passed to the shading fragment is the texture coordinate
+ * of the vertex if `use_texs` is set. The unpremultiplied vertex color, with
+ * its alpha multiplied by `color_alpha`, is exposed to the fragment as
+ * `input.color` if `use_colors` is set.
+ *
+ * If a blend is given the vertex color is instead blended with the output of
+ * the shading fragment, see WGSLAtlasFragment for the blend equation.
+ */
+class WGSLVerticesGeometry : public HWWGSLGeometry {
+ public:
+  WGSLVerticesGeometry(const Vertices& vertices, bool use_texs,
+                       bool use_colors, float color_alpha,
+                       std::optional<BlendMode> blend = std::nullopt);
+
+  ~WGSLVerticesGeometry() override = default;
+
+  const std::vector<GPUVertexBufferLayout>& GetBufferLayout() const override;
+
+  std::string GetShaderName() const override;
+
+  uint32_t GetShaderKey() const override;
+
+  void WriteVSFunctionsAndStructs(std::stringstream& ss) const override;
+
+  void WriteVSUniforms(std::stringstream& ss) const override;
+
+  void WriteVSInput(std::stringstream& ss) const override;
+
+  void WriteVSMain(std::stringstream& ss) const override;
+
+  std::optional<std::vector<std::string>> GetVarings() const override;
+
+  std::string GetFSNameSuffix() const override;
+
+  void WriteFSModifyColor(std::stringstream& ss) const override;
+
+  void PrepareCMD(Command* cmd, HWDrawContext* context, const Matrix& transform,
+                  float clip_depth, Command* stencil_cmd) override;
+
+ private:
+  const Vertices& vertices_;
+  bool use_texs_;
+  bool use_colors_;
+  float color_alpha_;
+  std::optional<BlendMode> blend_;
+  WGSLAtlasFragment::BlendCoeffs coeffs_ = {};
+  std::vector<GPUVertexBufferLayout> layout_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_GEOMETRY_WGSL_VERTICES_GEOMETRY_HPP
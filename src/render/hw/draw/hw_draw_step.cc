@@ -4,6 +4,9 @@
 
 #include "src/render/hw/draw/hw_draw_step.hpp"
 
+#include <array>
+
+#include "src/render/hw/draw/wgx_utils.hpp"
 #include "src/render/hw/hw_pipeline_lib.hpp"
 #include "src/tracing.hpp"
 
@@ -21,6 +24,9 @@ void HWDrawStep::GenerateCommand(const HWDrawStepContext& ctx, Command* cmd,
 
   cmd->scissor_rect = rect;
 
+  // a clip failing PrepareAnalyticClip() was dropped by the draw already
+  SetAnalyticClip(ctx.analytic_clip);
+
   cmd->pipeline = GetPipeline(ctx.context, ctx.state, ctx.color_format,
                               ctx.sample_count, ctx.blend_mode);
 
@@ -31,6 +37,87 @@ void HWDrawStep::GenerateCommand(const HWDrawStepContext& ctx, Command* cmd,
                               stencil_cmd);
   }
   fragment_->PrepareCMD(cmd, ctx.context);
+  if (cmd->pipeline != nullptr && analytic_clip_ != nullptr) {
+    SetupAnalyticClip(cmd, ctx.context);
+  }
+}
+
+bool HWDrawStep::PrepareAnalyticClip(const HWDrawStepContext& ctx) {
+  SetAnalyticClip(ctx.analytic_clip);
+
+  if (analytic_clip_ == nullptr) {
+    return true;
+  }
+
+  auto pipeline = GetPipeline(ctx.context, ctx.state, ctx.color_format,
+                              ctx.sample_count, ctx.blend_mode);
+
+  return pipeline == nullptr || CanSetupAnalyticClip(pipeline, ctx.context);
+}
+
+void HWDrawStep::SetAnalyticClip(const HWAnalyticClip* clip) {
+  // stencil and clip steps write no color, clipping them changes nothing
+  if (!RequireColorWrite()) {
+    clip = nullptr;
+  }
+
+  // draws with full shaders are clipped by the stencil fallback instead, see
+  // HWDraw::SupportsAnalyticClip()
+  DEBUG_CHECK(clip == nullptr ||
+              (geometry_->IsSnippet() && fragment_->IsSnippet()));
+
+  analytic_clip_ = clip;
+  shader_writer_.SetAnalyticClip(clip ? clip->GetShapeCount() : 0,
+                                 fragment_->EndBindingIndex());
+}
+
+bool HWDrawStep::CanSetupAnalyticClip(GPURenderPipeline* pipeline,
+                                      HWDrawContext* context) const {
+  // the shader writer declares a ClipShape per shape after the bindings of
+  // the fragment, anything else is a bug in the generated shader
+  auto group = pipeline->GetBindingGroup(1);
+  bool declared = group != nullptr;
+  uint32_t binding = fragment_->EndBindingIndex();
+  for (uint32_t i = 0; declared && i < analytic_clip_->GetShapeCount(); i++) {
+    auto entry = group->GetEntry(binding + i);
+    declared = entry != nullptr && entry->type_definition != nullptr &&
+               entry->type_definition->name == "ClipShape";
+  }
+
+  // the shader evaluates the shapes at normalized device coordinates
+  Matrix ndc_to_layer;
+  bool valid = declared && context->mvp.Invert(&ndc_to_layer);
+  DEBUG_CHECK(valid);
+
+  return valid;
+}
+
+void HWDrawStep::SetupAnalyticClip(Command* cmd, HWDrawContext* context) const {
+  auto group = cmd->pipeline->GetBindingGroup(1);
+
+  Matrix ndc_to_layer;
+  context->mvp.Invert(&ndc_to_layer);
+
+  uint32_t binding = fragment_->EndBindingIndex();
+  for (uint32_t i = 0; i < analytic_clip_->GetShapeCount(); i++) {
+    auto entry = group->GetEntry(binding + i);
+
+    const HWAnalyticClip::Shape& shape = analytic_clip_->GetShape(i);
+    Matrix m = shape.inverse * ndc_to_layer;
+
+    auto clip_shape =
+        static_cast<wgx::StructDefinition*>(entry->type_definition.get());
+    clip_shape->GetMember("matrix")->type->SetData(std::array<float, 4>{
+        m.GetScaleX(), m.GetSkewY(), m.GetSkewX(), m.GetScaleY()});
+    clip_shape->GetMember("info")->type->SetData(std::array<float, 4>{
+        m.GetTranslateX(), m.GetTranslateY(), shape.corner_radius,
+        shape.coverage_scale});
+    clip_shape->GetMember("rect")->type->SetData(std::array<float, 4>{
+        shape.rect.Left(), shape.rect.Top(), shape.rect.Right(),
+        shape.rect.Bottom()});
+
+    UploadBindGroup(group->group, entry, cmd, context);
+  }
 }
 
 GPURenderPipeline* HWDrawStep::GetPipeline(HWDrawContext* context,
@@ -80,6 +167,12 @@ GPURenderPipeline* HWDrawStep::GetPipeline(HWDrawContext* context,
 
   pipeline.shader_generator = this;
 
+  uint64_t key = GetPipelineKey();
+
+  if (key != kHWPipelineKeyInvalid) {
+    return context->pipelineLib->GetPipeline(key, pipeline);
+  }
+
   return context->pipelineLib->GetPipeline(
       {
           GetVertexName(),
@@ -88,4 +181,17 @@ GPURenderPipeline* HWDrawStep::GetPipeline(HWDrawContext* context,
       pipeline);
 }
 
+uint64_t HWDrawStep::GetPipelineKey() const {
+  auto filter = fragment_->GetFilter();
+
+  uint32_t filter_key = filter ? filter->GetShaderKey()
+                               : MakeHWShaderKey(HWColorFilterVariant::kNone);
+
+  static_assert(HWAnalyticClip::kMaxShapeCount < 16);
+
+  return MakeHWPipelineKey(
+      geometry_->GetShaderKey(), fragment_->GetShaderKey(), filter_key,
+      analytic_clip_ ? analytic_clip_->GetShapeCount() : 0);
+}
+
 }  // namespace skity
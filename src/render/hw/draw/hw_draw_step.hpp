@@ -12,6 +12,7 @@
 #include "src/render/hw/draw/hw_wgsl_fragment.hpp"
 #include "src/render/hw/draw/hw_wgsl_geometry.hpp"
 #include "src/render/hw/draw/hw_wgsl_shader_writer.hpp"
+#include "src/render/hw/hw_analytic_clip.hpp"
 #include "src/render/hw/hw_draw.hpp"
 #include "src/render/hw/hw_shader_generator.hpp"
 
@@ -27,6 +28,7 @@ struct HWDrawStepContext {
   uint32_t sample_count = 1;
   BlendMode blend_mode = BlendMode::kDefault;
   Vec2 scale = {1.f, 1.f};
+  const HWAnalyticClip* analytic_clip = nullptr;
 };
 
 class HWDrawStep : public HWShaderGenerator {
@@ -45,6 +47,14 @@ class HWDrawStep : public HWShaderGenerator {
 
   bool RequireDepth() const { return require_depth_; }
 
+  /**
+   * Picks the pipeline of this step with the analytic clip of `ctx`.
+   *
+   * @return false if the pipeline can not evaluate the clip, the draw then
+   *         has to be clipped by the stencil fallback instead
+   */
+  bool PrepareAnalyticClip(const HWDrawStepContext& ctx);
+
   void GenerateCommand(const HWDrawStepContext& ctx, Command* cmd,
                        Command* stencil_cmd);
 
@@ -100,12 +110,37 @@ class HWDrawStep : public HWShaderGenerator {
                                  GPUTextureFormat target_format,
                                  uint32_t sample_count, BlendMode blend_mode);
 
+  /**
+   * The compact key of the shaders of this step, or kHWPipelineKeyInvalid if
+   * the geometry, fragment or color filter has no shader key.
+   */
+  uint64_t GetPipelineKey() const;
+
+  void SetAnalyticClip(const HWAnalyticClip* clip);
+
+  /**
+   * Checks that the pipeline declares a ClipShape uniform for every shape of
+   * the analytic clip, and that the shapes can be mapped from the normalized
+   * device coordinates.
+   *
+   * @return false if the clip has to be dropped
+   */
+  bool CanSetupAnalyticClip(GPURenderPipeline* pipeline,
+                            HWDrawContext* context) const;
+
+  /**
+   * Uploads the shapes of the analytic clip, after PrepareAnalyticClip()
+   * passed.
+   */
+  void SetupAnalyticClip(Command* cmd, HWDrawContext* context) const;
+
  private:
   HWWGSLGeometry* geometry_;
   HWWGSLFragment* fragment_;
   bool require_stencil_ = false;
   bool require_depth_ = false;
   HWWGSLShaderWriter shader_writer_;
+  const HWAnalyticClip* analytic_clip_ = nullptr;
 };
 
 }  // namespace skity
@@ -0,0 +1,70 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/hw_dynamic_atlas_draw.hpp"
+
+#include "src/render/hw/draw/step/color_step.hpp"
+#include "src/render/hw/draw/wgx_filter.hpp"
+#include "src/render/hw/draw/wgx_utils.hpp"
+
+namespace skity {
+
+HWDynamicAtlasDraw::HWDynamicAtlasDraw(
+    const Matrix& transform, BlendMode blend_mode, std::shared_ptr<Image> atlas,
+    const SamplingOptions& sampling,
+    const WGSLAtlasFragment::BlendCoeffs& coeffs, float global_alpha,
+    std::shared_ptr<ColorFilter> color_filter, std::vector<AtlasSprite> sprites)
+    : HWDynamicDraw(transform, blend_mode),
+      atlas_(std::move(atlas)),
+      sampling_(sampling),
+      coeffs_(coeffs),
+      global_alpha_(global_alpha),
+      color_filter_(std::move(color_filter)),
+      sprites_(std::move(sprites)) {}
+
+bool HWDynamicAtlasDraw::OnMergeIfPossible(HWDraw* draw) {
+  if (!HWDynamicDraw::OnMergeIfPossible(draw)) {
+    return false;
+  }
+
+  auto other = static_cast<HWDynamicAtlasDraw*>(draw);
+
+  if (atlas_ != other->atlas_ || GetTransform() != other->GetTransform() ||
+      !SamplingOptions::Equal{}(sampling_, other->sampling_) ||
+      coeffs_.k != other->coeffs_.k || coeffs_.m != other->coeffs_.m ||
+      global_alpha_ != other->global_alpha_ ||
+      color_filter_ != other->color_filter_) {
+    return false;
+  }
+
+  sprites_.insert(sprites_.end(), other->sprites_.begin(),
+                  other->sprites_.end());
+
+  return true;
+}
+
+void HWDynamicAtlasDraw::OnGenerateDrawStep(ArrayList<HWDrawStep*, 2>& steps,
+                                            HWDrawContext* context) {
+  auto texture = GetImageGPUTexture(context, atlas_);
+
+  if (texture == nullptr || sprites_.empty()) {
+    return;
+  }
+
+  auto arena_allocator = context->arena_allocator;
+
+  auto geometry = arena_allocator->Make<WGSLAtlasGeometry>(std::move(sprites_));
+  auto fragment = arena_allocator->Make<WGSLAtlasFragment>(
+      std::move(texture), CreateSampler(context, sampling_),
+      atlas_->GetAlphaType(), coeffs_, global_alpha_);
+
+  if (color_filter_) {
+    fragment->SetFilter(WGXFilterFragment::Make(color_filter_.get()));
+  }
+
+  steps.emplace_back(arena_allocator->Make<ColorStep>(geometry, fragment,
+                                                      CoverageType::kNone));
+}
+
+}  // namespace skity
@@ -0,0 +1,54 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_HW_DYNAMIC_ATLAS_DRAW_HPP
+#define SRC_RENDER_HW_DRAW_HW_DYNAMIC_ATLAS_DRAW_HPP
+
+#include <skity/effect/color_filter.hpp>
+#include <skity/graphic/image.hpp>
+#include <skity/graphic/sampling_options.hpp>
+#include <vector>
+
+#include "src/render/hw/draw/fragment/wgsl_atlas_fragment.hpp"
+#include "src/render/hw/draw/geometry/wgsl_atlas_geometry.hpp"
+#include "src/render/hw/draw/hw_dynamic_draw.hpp"
+
+namespace skity {
+
+/**
+ * All the sprites of a DrawAtlas call. Following calls on the same atlas with
+ * the same state are merged into it, so they end up in one instanced draw.
+ */
+class HWDynamicAtlasDraw : public HWDynamicDraw {
+ public:
+  HWDynamicAtlasDraw(const Matrix& transform, BlendMode blend_mode,
+                     std::shared_ptr<Image> atlas,
+                     const SamplingOptions& sampling,
+                     const WGSLAtlasFragment::BlendCoeffs& coeffs,
+                     float global_alpha,
+                     std::shared_ptr<ColorFilter> color_filter,
+                     std::vector<AtlasSprite> sprites);
+
+  ~HWDynamicAtlasDraw() override = default;
+
+  HWDrawType GetDrawType() const override { return HWDrawType::kAtlas; }
+
+  bool OnMergeIfPossible(HWDraw* draw) override;
+
+ protected:
+  void OnGenerateDrawStep(ArrayList<HWDrawStep*, 2>& steps,
+                          HWDrawContext* context) override;
+
+ private:
+  std::shared_ptr<Image> atlas_;
+  SamplingOptions sampling_;
+  WGSLAtlasFragment::BlendCoeffs coeffs_;
+  float global_alpha_;
+  std::shared_ptr<ColorFilter> color_filter_;
+  std::vector<AtlasSprite> sprites_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_HW_DYNAMIC_ATLAS_DRAW_HPP
@@ -0,0 +1,49 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/hw_dynamic_blur_rrect_draw.hpp"
+
+#include "src/render/hw/draw/fragment/wgsl_solid_vertex_color.hpp"
+#include "src/render/hw/draw/geometry/wgsl_blur_rrect_geometry.hpp"
+#include "src/render/hw/draw/step/color_step.hpp"
+
+namespace skity {
+
+HWDynamicBlurRRectDraw::HWDynamicBlurRRectDraw(Matrix transform,
+                                               AnalyticBlurRRect blur,
+                                               Paint paint)
+    : HWDynamicDraw(transform, paint.GetBlendMode()) {
+  batch_group_.emplace_back(BatchGroup<AnalyticBlurRRect>{
+      std::move(blur),
+      std::move(paint),
+      std::move(transform),
+  });
+}
+
+bool HWDynamicBlurRRectDraw::OnMergeIfPossible(HWDraw* draw) {
+  if (!HWDynamicDraw::OnMergeIfPossible(draw)) {
+    return false;
+  }
+
+  // AnalyticBlurRRect only accepts solid colors without color filter, every
+  // blurred rrect can share the draw
+  auto& other_group = static_cast<HWDynamicBlurRRectDraw*>(draw)->batch_group_;
+  for (auto& element : other_group) {
+    batch_group_.emplace_back(std::move(element));
+  }
+
+  return true;
+}
+
+void HWDynamicBlurRRectDraw::OnGenerateDrawStep(
+    ArrayList<HWDrawStep*, 2>& steps, HWDrawContext* context) {
+  auto arena_allocator = context->arena_allocator;
+  auto geom = arena_allocator->Make<WGSLBlurRRectGeometry>(batch_group_);
+  auto frag = arena_allocator->Make<WGSLSolidVertexColor>();
+
+  steps.emplace_back(
+      arena_allocator->Make<ColorStep>(geom, frag, CoverageType::kNone));
+}
+
+}  // namespace skity
@@ -0,0 +1,44 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_HW_DYNAMIC_BLUR_RRECT_DRAW_HPP
+#define SRC_RENDER_HW_DRAW_HW_DYNAMIC_BLUR_RRECT_DRAW_HPP
+
+#include <skity/graphic/paint.hpp>
+#include <vector>
+
+#include "src/effect/analytic_blur.hpp"
+#include "src/render/hw/draw/hw_dynamic_draw.hpp"
+#include "src/utils/batch_group.hpp"
+
+namespace skity {
+
+/**
+ * Draws rects and rrects blurred by a normal style mask filter in a single
+ * pass, see AnalyticBlurRRect.
+ */
+class HWDynamicBlurRRectDraw : public HWDynamicDraw {
+ public:
+  HWDynamicBlurRRectDraw(Matrix transform, AnalyticBlurRRect blur,
+                         Paint paint);
+
+  ~HWDynamicBlurRRectDraw() override = default;
+
+  HWDrawType GetDrawType() const override { return HWDrawType::kBlur; }
+
+  bool SupportsAnalyticClip() const override { return true; }
+
+  bool OnMergeIfPossible(HWDraw* draw) override;
+
+ protected:
+  void OnGenerateDrawStep(ArrayList<HWDrawStep*, 2>& steps,
+                          HWDrawContext* context) override;
+
+ private:
+  std::vector<BatchGroup<AnalyticBlurRRect>> batch_group_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_HW_DYNAMIC_BLUR_RRECT_DRAW_HPP
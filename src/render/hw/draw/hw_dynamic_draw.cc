@@ -33,11 +33,7 @@ void HWDynamicDraw::OnGenerateCommand(HWDrawContext* context,
                                       HWDrawState state) {
   SKITY_TRACE_EVENT(HWDynamicDraw_OnGenerateCommand);
 
-  HWDrawStepContext ctx{
-      context,          state,           GetTransform(),
-      GetClipValue(),   GetScissorBox(), GetColorFormat(),
-      GetSampleCount(), blend_mode_,     context->scale,
-  };
+  HWDrawStepContext ctx = MakeStepContext(context, state);
 
   for (auto& step : steps_) {
     auto stencil_cmd = commands_.empty() ? nullptr : commands_.front();
@@ -50,6 +46,34 @@ void HWDynamicDraw::OnGenerateCommand(HWDrawContext* context,
   }
 }
 
+bool HWDynamicDraw::PrepareAnalyticClip(HWDrawContext* context,
+                                        HWDrawState state) {
+  if (GetAnalyticClip() == nullptr) {
+    return true;
+  }
+
+  HWDrawStepContext ctx = MakeStepContext(context, state);
+
+  for (auto& step : steps_) {
+    if (!step->PrepareAnalyticClip(ctx)) {
+      SetAnalyticClip(nullptr);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+HWDrawStepContext HWDynamicDraw::MakeStepContext(HWDrawContext* context,
+                                                 HWDrawState state) const {
+  return HWDrawStepContext{
+      context,          state,           GetTransform(),
+      GetClipValue(),   GetScissorBox(), GetColorFormat(),
+      GetSampleCount(), blend_mode_,     context->scale,
+      GetAnalyticClip(),
+  };
+}
+
 bool HWDynamicDraw::OnMergeIfPossible(HWDraw* draw) {
   if (blend_mode_ != static_cast<HWDynamicDraw*>(draw)->blend_mode_) {
     return false;
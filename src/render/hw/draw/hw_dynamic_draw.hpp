@@ -28,6 +28,8 @@ class HWDynamicDraw : public HWDraw {
 
   bool OnMergeIfPossible(HWDraw* draw) override;
 
+  bool PrepareAnalyticClip(HWDrawContext* context, HWDrawState state) override;
+
  protected:
   HWDrawState OnPrepare(HWDrawContext* context) override;
 
@@ -37,6 +39,9 @@ class HWDynamicDraw : public HWDraw {
                                   HWDrawContext* context) = 0;
 
  private:
+  HWDrawStepContext MakeStepContext(HWDrawContext* context,
+                                    HWDrawState state) const;
+
   BlendMode blend_mode_;
   ArrayList<HWDrawStep*, 2> steps_;
   ArrayList<Command*, 32> commands_;
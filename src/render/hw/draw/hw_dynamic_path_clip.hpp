@@ -19,6 +19,8 @@ class HWDynamicPathClip : public HWDynamicDraw {
 
   ~HWDynamicPathClip() override = default;
 
+  HWDrawType GetDrawType() const override { return HWDrawType::kClip; }
+
  protected:
   void OnGenerateDrawStep(ArrayList<HWDrawStep *, 2> &steps,
                           HWDrawContext *context) override;
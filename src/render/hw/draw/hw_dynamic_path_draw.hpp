@@ -22,6 +22,8 @@ class HWDynamicPathDraw : public HWDynamicDraw {
 
   ~HWDynamicPathDraw() override = default;
 
+  bool SupportsAnalyticClip() const override { return true; }
+
  protected:
   void OnGenerateDrawStep(ArrayList<HWDrawStep *, 2> &steps,
                           HWDrawContext *context) override;
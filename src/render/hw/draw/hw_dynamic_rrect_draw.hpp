@@ -23,6 +23,8 @@ class HWDynamicRRectDraw : public HWDynamicDraw {
 
   HWDrawType GetDrawType() const override { return HWDrawType::kRRect; }
 
+  bool SupportsAnalyticClip() const override { return true; }
+
   bool OnMergeIfPossible(HWDraw* draw) override;
 
  protected:
@@ -0,0 +1,70 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/draw/hw_dynamic_vertices_draw.hpp"
+
+#include "src/render/hw/draw/geometry/wgsl_vertices_geometry.hpp"
+#include "src/render/hw/draw/step/color_step.hpp"
+#include "src/render/hw/draw/wgx_filter.hpp"
+#include "src/render/hw/draw/wgx_utils.hpp"
+
+namespace skity {
+
+bool HWDynamicVerticesDraw::CanDraw(const Vertices& vertices, BlendMode mode,
+                                    const Paint& paint) {
+  if (vertices.Colors() == nullptr || paint.GetShader() == nullptr ||
+      mode == BlendMode::kSrc || mode == BlendMode::kDst) {
+    return true;
+  }
+
+  WGSLAtlasFragment::BlendCoeffs coeffs{};
+  return WGSLAtlasFragment::ComputeBlendCoeffs(mode, &coeffs);
+}
+
+HWDynamicVerticesDraw::HWDynamicVerticesDraw(const Matrix& transform,
+                                             std::shared_ptr<Vertices> vertices,
+                                             BlendMode mode, const Paint& paint)
+    : HWDynamicDraw(transform, paint.GetBlendMode()),
+      vertices_(std::move(vertices)),
+      mode_(mode),
+      paint_(paint) {}
+
+void HWDynamicVerticesDraw::OnGenerateDrawStep(ArrayList<HWDrawStep*, 2>& steps,
+                                               HWDrawContext* context) {
+  auto arena_allocator = context->arena_allocator;
+
+  bool has_colors = vertices_->Colors() != nullptr;
+  bool has_shader = paint_.GetShader() != nullptr;
+  bool use_texs = has_shader && vertices_->Texs() != nullptr;
+
+  HWWGSLGeometry* geometry = nullptr;
+  HWWGSLFragment* fragment = nullptr;
+
+  if (!has_colors || (has_shader && mode_ == BlendMode::kSrc)) {
+    // the paint alone
+    geometry = arena_allocator->Make<WGSLVerticesGeometry>(*vertices_, use_texs,
+                                                           false, 1.f);
+    fragment = GenShadingFragment(context, paint_, false);
+  } else if (!has_shader || mode_ == BlendMode::kDst) {
+    // the vertex colors alone
+    geometry = arena_allocator->Make<WGSLVerticesGeometry>(
+        *vertices_, false, true, paint_.GetAlphaF());
+    fragment = GenShadingFragment(context, Paint{}, false, false);
+  } else {
+    // the paint alpha is already applied to the shader output when it is
+    // blended with the vertex colors
+    geometry = arena_allocator->Make<WGSLVerticesGeometry>(
+        *vertices_, use_texs, true, 1.f, mode_);
+    fragment = GenShadingFragment(context, paint_, false);
+  }
+
+  if (paint_.GetColorFilter()) {
+    fragment->SetFilter(WGXFilterFragment::Make(paint_.GetColorFilter().get()));
+  }
+
+  steps.emplace_back(arena_allocator->Make<ColorStep>(geometry, fragment,
+                                                      CoverageType::kNone));
+}
+
+}  // namespace skity
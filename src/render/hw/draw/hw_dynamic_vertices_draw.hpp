@@ -0,0 +1,55 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_DRAW_HW_DYNAMIC_VERTICES_DRAW_HPP
+#define SRC_RENDER_HW_DRAW_HW_DYNAMIC_VERTICES_DRAW_HPP
+
+#include <memory>
+#include <skity/graphic/paint.hpp>
+#include <skity/graphic/vertices.hpp>
+
+#include "src/render/hw/draw/hw_dynamic_draw.hpp"
+
+namespace skity {
+
+/**
+ * A DrawVertices call. The paint shader or color is sampled at the texture
+ * coordinates of the mesh and combined with the vertex colors by `mode`, the
+ * caller makes sure the combination is supported, see
+ * HWDynamicVerticesDraw::CanDraw().
+ */
+class HWDynamicVerticesDraw : public HWDynamicDraw {
+ public:
+  /**
+   * @return true if the vertices can be drawn with `mode` and `paint` without
+   *         falling back to Canvas::OnDrawVertices
+   */
+  static bool CanDraw(const Vertices& vertices, BlendMode mode,
+                      const Paint& paint);
+
+  HWDynamicVerticesDraw(const Matrix& transform,
+                        std::shared_ptr<Vertices> vertices, BlendMode mode,
+                        const Paint& paint);
+
+  ~HWDynamicVerticesDraw() override = default;
+
+  HWDrawType GetDrawType() const override { return HWDrawType::kVertices; }
+
+  bool SupportsAnalyticClip() const override { return true; }
+
+ protected:
+  void OnGenerateDrawStep(ArrayList<HWDrawStep*, 2>& steps,
+                          HWDrawContext* context) override;
+
+  bool OnMergeIfPossible(HWDraw* draw) override { return false; }
+
+ private:
+  std::shared_ptr<Vertices> vertices_;
+  BlendMode mode_;
+  Paint paint_;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_DRAW_HW_DYNAMIC_VERTICES_DRAW_HPP
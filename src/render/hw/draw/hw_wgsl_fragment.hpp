@@ -9,6 +9,7 @@
 
 #include "src/gpu/gpu_render_pass.hpp"
 #include "src/render/hw/draw/wgx_filter.hpp"
+#include "src/render/hw/hw_pipeline_key.hpp"
 
 namespace skity {
 
@@ -54,6 +55,13 @@ class HWWGSLFragment {
    */
   virtual std::string GetShaderName() const = 0;
 
+  /**
+   * Compact replacement of the shader name used to look up pipelines without
+   * building strings, see MakeHWShaderKey(). The color filter is not part of
+   * this key.
+   */
+  virtual uint32_t GetShaderKey() const { return kHWShaderKeyUnknown; }
+
   virtual const char* GetEntryPoint() const { return "fs_main"; }
 
   virtual uint32_t NextBindingIndex() const = 0;
@@ -150,11 +158,19 @@ class HWWGSLFragment {
 
   void SetFilter(std::unique_ptr<WGXFilterFragment> filter) {
     filter_ = std::move(filter);
-    filter_->InitBinding(NextBindingIndex());
+    end_binding_ = filter_->InitBinding(NextBindingIndex());
   }
 
   WGXFilterFragment* GetFilter() const { return filter_.get(); }
 
+  /**
+   * The first free binding of group 1 after the uniforms of this fragment and
+   * its color filter.
+   */
+  uint32_t EndBindingIndex() const {
+    return filter_ ? end_binding_ : NextBindingIndex();
+  }
+
   constexpr bool IsSnippet() const { return (flags_ & Flags::kSnippet) > 0; }
 
   constexpr bool AffectsVertex() const {
@@ -166,6 +182,7 @@ class HWWGSLFragment {
 
  private:
   uint32_t flags_;
+  uint32_t end_binding_ = 0;
 };
 
 }  // namespace skity
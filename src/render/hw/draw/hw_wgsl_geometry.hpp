@@ -10,6 +10,7 @@
 
 #include "src/gpu/gpu_render_pass.hpp"
 #include "src/logging.hpp"
+#include "src/render/hw/hw_pipeline_key.hpp"
 
 namespace skity {
 
@@ -56,6 +57,12 @@ class HWWGSLGeometry {
    */
   virtual std::string GetShaderName() const = 0;
 
+  /**
+   * Compact replacement of the shader name used to look up pipelines without
+   * building strings, see MakeHWShaderKey().
+   */
+  virtual uint32_t GetShaderKey() const { return kHWShaderKeyUnknown; }
+
   /*
    * Generates the complete vertex shader. This method is called only when
    * 'Flags::kNone' is set. When 'Flags::kSnippet' is specified, vertex shader
@@ -117,6 +124,13 @@ class HWWGSLGeometry {
    */
   virtual void WriteFSAlphaMask(std::stringstream& ss) const {}
 
+  /**
+   * Supplies code changing the color written by the fragment, before the color
+   * filter is applied. This method is called only when
+   * 'Flags::kAffectsFragment' is specified.
+   */
+  virtual void WriteFSModifyColor(std::stringstream& ss) const {}
+
   virtual const char* GetEntryPoint() const { return "vs_main"; }
   /**
    * Check if this geometry can be merged with other geometry.
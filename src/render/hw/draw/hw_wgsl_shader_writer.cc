@@ -71,6 +71,13 @@ fn vs_main(input: VSInput) -> VSOutput {
 )";
   geometry_->WriteVSMain(ss);
   WriteVSAssgnShadingVarings(ss);
+  if (analytic_clip_count_ > 0) {
+    // the clip space position, divided per fragment so the normalized device
+    // coordinates are exact under perspective
+    ss << R"(
+  output.v_clip_pos = output.pos.xyw;
+)";
+  }
   ss << R"(
   return output;
 };
@@ -94,11 +101,37 @@ void HWWGSLShaderWriter::WriteFSFunctionsAndStructs(
   if (fragment_->GetFilter()) {
     ss << fragment_->GetFilter()->GenSourceWGSL();
   }
+  if (analytic_clip_count_ > 0) {
+    // keep in sync with HWAnalyticClip::Shape::Coverage()
+    ss << R"(
+struct ClipShape {
+  matrix  : vec4<f32>,
+  info    : vec4<f32>,
+  rect    : vec4<f32>,
+};
+
+fn clip_shape_coverage(ndc: vec2<f32>, shape: ClipShape) -> f32 {
+  let pos: vec2<f32> = vec2<f32>(
+      shape.matrix.x * ndc.x + shape.matrix.z * ndc.y,
+      shape.matrix.y * ndc.x + shape.matrix.w * ndc.y) + shape.info.xy;
+  let radius: f32 = shape.info.z;
+  let q: vec2<f32> = abs(pos - (shape.rect.xy + shape.rect.zw) * 0.5) -
+                     (shape.rect.zw - shape.rect.xy) * 0.5 + radius;
+  let dist: f32 = length(max(q, vec2<f32>(0.0))) +
+                  min(max(q.x, q.y), 0.0) - radius;
+  return clamp(0.5 - dist * shape.info.w, 0.0, 1.0);
+}
+)";
+  }
 }
 
 void HWWGSLShaderWriter::WriteFSUniforms(std::stringstream& ss) const {
   DEBUG_CHECK(fragment_);
   fragment_->WriteFSUniforms(ss);
+  for (uint32_t i = 0; i < analytic_clip_count_; i++) {
+    ss << "@group(1) @binding(" << analytic_clip_binding_ + i
+       << ") var<uniform> clip_shape_" << i << " : ClipShape;\n";
+  }
 }
 
 void HWWGSLShaderWriter::WriteFSInput(std::stringstream& ss) const {
@@ -132,6 +165,9 @@ fn fs_main() -> @location(0) vec4<f32> {
   }
 
   fragment_->WriteFSMain(ss);
+  if (geometry_ && geometry_->AffectsFragment()) {
+    geometry_->WriteFSModifyColor(ss);
+  }
   if (fragment_->GetFilter()) {
     ss << R"(
   color = filter_color(color);
@@ -148,6 +184,16 @@ fn fs_main() -> @location(0) vec4<f32> {
 )";
   }
 
+  if (analytic_clip_count_ > 0) {
+    ss << R"(
+  let clip_pos: vec2<f32> = input.v_clip_pos.xy / input.v_clip_pos.z;
+)";
+    for (uint32_t i = 0; i < analytic_clip_count_; i++) {
+      ss << "  color = color * clip_shape_coverage(clip_pos, clip_shape_" << i
+         << ");\n";
+    }
+  }
+
   ss << R"(
   return color;
 }
@@ -174,6 +220,9 @@ void HWWGSLShaderWriter::WriteVaryings(std::stringstream& ss) const {
       i++;
     }
   }
+  if (analytic_clip_count_ > 0) {
+    ss << "  @location(" << i << ") v_clip_pos: vec3<f32>,\n";
+  }
 }
 
 bool HWWGSLShaderWriter::HasVarings() const {
@@ -185,7 +234,7 @@ bool HWWGSLShaderWriter::HasVarings() const {
   if (fragment_ && fragment_->GetVarings().has_value()) {
     varyings_count += fragment_->GetVarings().value().size();
   }
-  return varyings_count > 0;
+  return varyings_count > 0 || analytic_clip_count_ > 0;
 }
 
 std::string HWWGSLShaderWriter::GetVSShaderName() const {
@@ -195,6 +244,9 @@ std::string HWWGSLShaderWriter::GetVSShaderName() const {
     DEBUG_CHECK(fragment_->GetVSNameSuffix().size() > 0);
     name += +"_" + fragment_->GetVSNameSuffix();
   }
+  if (analytic_clip_count_ > 0) {
+    name += "_Clip";
+  }
   return name;
 }
 
@@ -208,6 +260,9 @@ std::string HWWGSLShaderWriter::GetFSShaderName() const {
   if (fragment_->GetFilter()) {
     name += "_" + fragment_->GetFilter()->GetShaderName();
   }
+  if (analytic_clip_count_ > 0) {
+    name += "_Clip" + std::to_string(analytic_clip_count_);
+  }
   return name;
 }
 
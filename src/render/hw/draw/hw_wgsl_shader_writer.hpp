@@ -25,6 +25,16 @@ class HWWGSLShaderWriter {
   std::string GetVSShaderName() const;
   std::string GetFSShaderName() const;
 
+  /**
+   * Multiplies the color by the coverage of `shape_count` analytic clip
+   * shapes, see HWAnalyticClip. The shapes are bound to group 1 from
+   * `binding`, each one as a ClipShape uniform.
+   */
+  void SetAnalyticClip(uint32_t shape_count, uint32_t binding) {
+    analytic_clip_count_ = shape_count;
+    analytic_clip_binding_ = binding;
+  }
+
  private:
   void WriteVSFunctionsAndStructs(std::stringstream& ss) const;
   void WriteVSUniforms(std::stringstream& ss) const;
@@ -44,6 +54,8 @@ class HWWGSLShaderWriter {
  private:
   const HWWGSLGeometry* geometry_ = nullptr;
   const HWWGSLFragment* fragment_ = nullptr;
+  uint32_t analytic_clip_count_ = 0;
+  uint32_t analytic_clip_binding_ = 0;
 };
 
 }  // namespace skity
@@ -76,6 +76,11 @@ class WGXBlendFilter : public WGXFilterFragment {
     }
   }
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWColorFilterVariant::kBlend,
+                           static_cast<uint32_t>(mode_));
+  }
+
   std::string GenSourceWGSL() const override {
     std::string wgsl_source = "";
 
@@ -237,6 +242,10 @@ class WGXMatrixFilter : public WGXFilterFragment {
 
   std::string GetShaderName() const override { return "MatrixFilter"; }
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWColorFilterVariant::kMatrix);
+  }
+
   uint32_t InitBinding(uint32_t binding) override {
     binding_ = binding;
     return binding + 1;
@@ -350,6 +359,11 @@ class WGXGammaFilter : public WGXFilterFragment {
     }
   }
 
+  uint32_t GetShaderKey() const override {
+    return MakeHWShaderKey(HWColorFilterVariant::kGamma,
+                           static_cast<uint32_t>(type_));
+  }
+
   std::string GenSourceWGSL() const override {
     std::string wgsl_source = GenFunctionSignature();
 
@@ -9,6 +9,8 @@
 #include <skity/effect/color_filter.hpp>
 #include <string>
 
+#include "src/render/hw/hw_pipeline_key.hpp"
+
 namespace skity {
 
 struct Command;
@@ -34,6 +36,8 @@ class WGXFilterFragment {
 
   virtual std::string GetShaderName() const = 0;
 
+  virtual uint32_t GetShaderKey() const { return kHWShaderKeyUnknown; }
+
   virtual void SetupBindGroup(Command* cmd, HWDrawContext* context) = 0;
 
   static std::unique_ptr<WGXFilterFragment> Make(ColorFilter* filter,
@@ -368,6 +368,21 @@ std::string WGXGradientFragment::GetShaderName() const {
   return name;
 }
 
+uint32_t WGXGradientFragment::GetShaderKeyOptions() const {
+  // max_color_count_ is at most 64
+  uint32_t options = static_cast<uint32_t>(type_) & 0x7;
+  options |= (max_color_count_ & 0x7F) << 3;
+  if (info_.color_offsets.empty()) {
+    options |= 1 << 10;
+  }
+
+  if (CanUseLerpColorFast()) {
+    options |= 1 << 11;
+  }
+
+  return options;
+}
+
 namespace {
 Color4f Premul(const Color4f& color) {
   return Color4f{color.r * color.a, color.g * color.a, color.b * color.a,
@@ -681,6 +696,42 @@ bool WGXGradientFragment::SetupSweepInfo(
   return true;
 }
 
+std::shared_ptr<GPUTexture> GetImageGPUTexture(
+    HWDrawContext* context, const std::shared_ptr<Image>& image) {
+  if (image->GetTexture()) {
+    const auto& texture_image = *(image->GetTexture());
+    return texture_image->GetGPUTexture();
+  }
+
+  if (image->GetPixmap()) {
+    const auto& pixmap_image = *(image->GetPixmap());
+    auto texture_handler =
+        context->gpuContext->GetTextureManager()->FindOrCreateTexture(
+            Texture::FormatFromColorType(pixmap_image->GetColorType()),
+            pixmap_image->Width(), pixmap_image->Height(),
+            pixmap_image->GetAlphaType(), pixmap_image);
+    texture_handler->UploadImage(pixmap_image);
+    return texture_handler->GetGPUTexture();
+  }
+
+  auto texture_handler = image->GetTextureByContext(context->gpuContext);
+
+  if (texture_handler) {
+    return texture_handler->GetGPUTexture();
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<GPUSampler> CreateSampler(HWDrawContext* context,
+                                          const SamplingOptions& sampling) {
+  GPUSamplerDescriptor descriptor;
+  descriptor.mag_filter = ToGPUFilterMode(sampling.filter);
+  descriptor.min_filter = ToGPUFilterMode(sampling.filter);
+  descriptor.mipmap_filter = ToGPUMipmapMode(sampling.mipmap);
+  return context->gpuContext->GetGPUDevice()->CreateSampler(descriptor);
+}
+
 HWWGSLFragment* GenShadingFragment(HWDrawContext* context, const Paint& paint,
                                    bool is_stroke, bool has_color) {
   auto arena_allocator = context->arena_allocator;
@@ -694,37 +745,11 @@ HWWGSLFragment* GenShadingFragment(HWDrawContext* context, const Paint& paint,
 
       const std::shared_ptr<Image>& image = *(pixmap_shader->AsImage());
 
-      std::shared_ptr<GPUTexture> texture;
-      if (image->GetTexture()) {
-        const auto& texture_image = *(image->GetTexture());
-        texture = texture_image->GetGPUTexture();
-      } else if (image->GetPixmap()) {
-        const auto& pixmap_image = *(image->GetPixmap());
-        auto texture_handler =
-            context->gpuContext->GetTextureManager()->FindOrCreateTexture(
-                Texture::FormatFromColorType(pixmap_image->GetColorType()),
-                pixmap_image->Width(), pixmap_image->Height(),
-                pixmap_image->GetAlphaType(), pixmap_image);
-        texture_handler->UploadImage(pixmap_image);
-        texture = texture_handler->GetGPUTexture();
-      } else {
-        auto texture_handler = image->GetTextureByContext(context->gpuContext);
-
-        if (texture_handler) {
-          texture = texture_handler->GetGPUTexture();
-        }
-      }
+      auto texture = GetImageGPUTexture(context, image);
 
       if (texture != nullptr) {
-        GPUSamplerDescriptor descriptor;
-        descriptor.mag_filter =
-            ToGPUFilterMode(pixmap_shader->GetSamplingOptions()->filter);
-        descriptor.min_filter =
-            ToGPUFilterMode(pixmap_shader->GetSamplingOptions()->filter);
-        descriptor.mipmap_filter =
-            ToGPUMipmapMode(pixmap_shader->GetSamplingOptions()->mipmap);
         auto sampler =
-            context->gpuContext->GetGPUDevice()->CreateSampler(descriptor);
+            CreateSampler(context, *pixmap_shader->GetSamplingOptions());
 
         Matrix inv_local_matrix{};
         pixmap_shader->GetLocalMatrix().Invert(&inv_local_matrix);
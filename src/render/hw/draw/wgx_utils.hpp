@@ -18,6 +18,7 @@ namespace skity {
 struct Command;
 struct HWDrawContext;
 class HWWGSLFragment;
+class Image;
 class Paint;
 
 void UploadBindGroup(uint32_t group, const wgx::BindGroupEntry* entry,
@@ -61,6 +62,18 @@ bool SetupImageBoundsInfo(const wgx::BindGroupEntry* image_bounds_entry,
                           const Matrix& local_matrix, float width,
                           float height);
 
+/**
+ * Find or upload the GPU texture holding the pixels of an image.
+ *
+ * @return nullptr if the image can not be turned into a texture with this
+ *         context
+ */
+std::shared_ptr<GPUTexture> GetImageGPUTexture(
+    HWDrawContext* context, const std::shared_ptr<Image>& image);
+
+std::shared_ptr<GPUSampler> CreateSampler(HWDrawContext* context,
+                                          const SamplingOptions& sampling);
+
 HWWGSLFragment* GenShadingFragment(HWDrawContext* context, const Paint& paint,
                                    bool is_stroke, bool has_color = true);
 /**
@@ -108,6 +121,12 @@ class WGXGradientFragment {
 
   std::string GetShaderName() const;
 
+  /**
+   * The options GetShaderName() encodes, packed in 12 bits to be used in a
+   * shader key.
+   */
+  uint32_t GetShaderKeyOptions() const;
+
   bool SetupCommonInfo(const wgx::BindGroupEntry* info_entry,
                        float global_alpha) const;
 
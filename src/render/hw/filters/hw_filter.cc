@@ -28,8 +28,9 @@ std::shared_ptr<GPUTexture> HWFilter::CreateOutputTexture(
   texture_desc.width = glm::ceil(output_texture_size.x);
   texture_desc.height = glm::ceil(output_texture_size.y);
   texture_desc.storage_mode = GPUTextureStorageMode::kPrivate;
-  auto output_texture = context.device->CreateTexture(texture_desc);
-  return output_texture;
+  return context.gpu_context->GetRenderTargetCache()
+      ->ObtainResource(texture_desc, context.draw_context->pool)
+      ->GetValue();
 }
 
 GPURenderPassDescriptor HWFilter::CreateRenderPassDesc(
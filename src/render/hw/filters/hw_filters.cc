@@ -19,14 +19,6 @@ namespace skity {
 
 namespace {
 
-float radial_to_sigma(float radius) {
-  return radius > 0.f ? radius * 0.57735f + 0.5f : 0.f;
-}
-
-float sigma_to_radius(float sigma) {
-  return sigma > 0.5f ? (sigma - 0.5f) / 0.57735f : 0.0f;
-}
-
 int scale_blur_radius(float radius, float scalar) {
   return static_cast<int>(std::round(radius * scalar));
 }
@@ -57,7 +49,7 @@ float calculate_blur_scale(float sigma) {
   // for the blur.
   if (rounded < 0.125f) {
     float rounded_plus = powf(2.0f, exponent + 1);
-    float blur_radius = sigma_to_radius(sigma);
+    float blur_radius = ConvertSigmaToRadius(sigma);
     int kernel_size_plus =
         (scale_blur_radius(blur_radius, rounded_plus) * 2) + 1;
     // This constant was picked by looking at the results to make sure no
@@ -175,7 +167,7 @@ std::shared_ptr<HWFilter> HWFilters::Blur(float radius_x, float radius_y,
    */
   auto down_sampler = [max_scaled_radius, &radius_x,
                        &radius_y](std::shared_ptr<HWFilter> input) {
-    auto scale = calculate_blur_scale(radial_to_sigma(max_scaled_radius));
+    auto scale = calculate_blur_scale(ConvertRadiusToSigma(max_scaled_radius));
 
     if (scale != 1.f) {
       input = std::make_shared<HWDownSamplerFilter>(input, scale);
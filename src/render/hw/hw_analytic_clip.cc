@@ -0,0 +1,97 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_analytic_clip.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace skity {
+
+float HWAnalyticClip::Shape::Coverage(const Vec2& pos) const {
+  Vec2 local;
+  inverse.MapPoints(&local, &pos, 1);
+
+  // signed distance to the rrect, negative inside
+  float qx = std::abs(local.x - rect.CenterX()) - rect.Width() * 0.5f +
+             corner_radius;
+  float qy = std::abs(local.y - rect.CenterY()) - rect.Height() * 0.5f +
+             corner_radius;
+  float outside = std::sqrt(std::max(qx, 0.f) * std::max(qx, 0.f) +
+                            std::max(qy, 0.f) * std::max(qy, 0.f));
+  float inside = std::min(std::max(qx, qy), 0.f);
+  float distance = outside + inside - corner_radius;
+
+  return std::clamp(0.5f - distance * coverage_scale, 0.f, 1.f);
+}
+
+HWAnalyticClip* HWAnalyticClip::Make(ArenaAllocator* arena_allocator,
+                                     const HWAnalyticClip* parent,
+                                     const RRect& rrect, const Matrix& matrix,
+                                     const Matrix& physical_matrix,
+                                     Canvas::ClipOp op) {
+  if (parent != nullptr && parent->GetShapeCount() >= kMaxShapeCount) {
+    return nullptr;
+  }
+
+  if (rrect.IsEmpty() || matrix.HasPersp() || physical_matrix.HasPersp()) {
+    return nullptr;
+  }
+
+  if (!rrect.IsRect() && !rrect.IsOval() && !rrect.IsSimple()) {
+    return nullptr;
+  }
+
+  Shape shape;
+  shape.rect = rrect.GetRect();
+
+  // scales y so the corners become circular
+  Matrix local;
+  Vec2 radii = rrect.GetSimpleRadii();
+  if (!rrect.IsRect() && radii.x > 0.f && radii.y > 0.f) {
+    if (radii.x != radii.y) {
+      float sy = radii.y / radii.x;
+      local = Matrix::Scale(1.f, sy);
+      shape.rect = Rect::MakeLTRB(shape.rect.Left(), shape.rect.Top() / sy,
+                                  shape.rect.Right(), shape.rect.Bottom() / sy);
+    }
+    shape.corner_radius = radii.x;
+  }
+
+  if (!(matrix * local).Invert(&shape.inverse)) {
+    return nullptr;
+  }
+
+  Matrix to_physical = physical_matrix * local;
+  float scale = std::sqrt(std::abs(
+      to_physical.GetScaleX() * to_physical.GetScaleY() -
+      to_physical.GetSkewX() * to_physical.GetSkewY()));
+  if (!(scale > 0.f) || !std::isfinite(scale) || !shape.rect.IsFinite()) {
+    return nullptr;
+  }
+
+  shape.coverage_scale = op == Canvas::ClipOp::kDifference ? -scale : scale;
+
+  return arena_allocator->Make<HWAnalyticClip>(parent, shape);
+}
+
+HWAnalyticClip::HWAnalyticClip(const HWAnalyticClip* parent,
+                               const Shape& shape) {
+  if (parent != nullptr) {
+    shapes_ = parent->shapes_;
+    shape_count_ = parent->shape_count_;
+  }
+
+  shapes_[shape_count_++] = shape;
+}
+
+float HWAnalyticClip::Coverage(const Vec2& pos) const {
+  float coverage = 1.f;
+  for (uint32_t i = 0; i < shape_count_; i++) {
+    coverage *= shapes_[i].Coverage(pos);
+  }
+  return coverage;
+}
+
+}  // namespace skity
@@ -0,0 +1,87 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_HW_ANALYTIC_CLIP_HPP
+#define SRC_RENDER_HW_HW_ANALYTIC_CLIP_HPP
+
+#include <array>
+#include <cstdint>
+#include <skity/geometry/matrix.hpp>
+#include <skity/geometry/rrect.hpp>
+#include <skity/render/canvas.hpp>
+
+#include "src/utils/arena_allocator.hpp"
+
+namespace skity {
+
+/**
+ * The clip shapes of a save level whose coverage is evaluated in the fragment
+ * stage of the clipped draws, instead of being written into the stencil
+ * buffer by a HWDynamicPathClip.
+ *
+ * A shape is a rect, a rrect with the same radii at every corner or an oval,
+ * under an affine transform. Elliptic corners are made circular by scaling
+ * the local space of the shape.
+ *
+ * Instances are immutable, a clip holds the shapes of the save levels below
+ * it followed by its own shape.
+ */
+class HWAnalyticClip {
+ public:
+  /**
+   * Each shape costs a uniform binding and a few instructions per fragment,
+   * deeper clip stacks fall back to the stencil clip.
+   */
+  static constexpr uint32_t kMaxShapeCount = 4;
+
+  struct Shape {
+    // the shape in its local space
+    Rect rect = {};
+    float corner_radius = 0.f;
+    // from the layer space to the local space of the shape
+    Matrix inverse = {};
+    // device pixels per local unit, negative for difference clips
+    float coverage_scale = 1.f;
+
+    /**
+     * Coverage in [0, 1] at a position of the layer space. Keep in sync with
+     * the shader generated by HWWGSLShaderWriter.
+     */
+    float Coverage(const Vec2& pos) const;
+  };
+
+  /**
+   * @param parent           the clip of the save levels below, may be null
+   * @param matrix           from the local space of rrect to the layer space
+   * @param physical_matrix  from the local space of rrect to the physical
+   *                         pixels of the layer
+   * @return                 nullptr if the shape can not be evaluated
+   *                         analytically or the parent is full
+   */
+  static HWAnalyticClip* Make(ArenaAllocator* arena_allocator,
+                              const HWAnalyticClip* parent, const RRect& rrect,
+                              const Matrix& matrix,
+                              const Matrix& physical_matrix,
+                              Canvas::ClipOp op);
+
+  HWAnalyticClip(const HWAnalyticClip* parent, const Shape& shape);
+
+  uint32_t GetShapeCount() const { return shape_count_; }
+
+  const Shape& GetShape(uint32_t index) const { return shapes_[index]; }
+
+  /**
+   * The product of the coverage of all shapes at a position of the layer
+   * space.
+   */
+  float Coverage(const Vec2& pos) const;
+
+ private:
+  std::array<Shape, kMaxShapeCount> shapes_ = {};
+  uint32_t shape_count_ = 0;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_HW_ANALYTIC_CLIP_HPP
@@ -12,13 +12,20 @@
 #include <skity/text/text_blob.hpp>
 
 #include "skity/geometry/rrect.hpp"
+#include "src/effect/analytic_blur.hpp"
+#include "src/effect/dash_path_effect.hpp"
 #include "src/effect/image_filter_base.hpp"
 #include "src/gpu/gpu_surface_impl.hpp"
 #include "src/render/canvas_state.hpp"
+#include "src/render/hw/draw/hw_dynamic_atlas_draw.hpp"
+#include "src/render/hw/draw/hw_dynamic_blur_rrect_draw.hpp"
 #include "src/render/hw/draw/hw_dynamic_path_clip.hpp"
 #include "src/render/hw/draw/hw_dynamic_path_draw.hpp"
 #include "src/render/hw/draw/hw_dynamic_rrect_draw.hpp"
+#include "src/render/hw/draw/hw_dynamic_vertices_draw.hpp"
 #include "src/render/hw/filters/hw_filters.hpp"
+#include "src/render/hw/hw_analytic_clip.hpp"
+#include "src/render/hw/hw_draw_occlusion.hpp"
 #include "src/render/hw/layer/hw_filter_layer.hpp"
 #include "src/render/shape.hpp"
 #include "src/render/text/glyph_run.hpp"
@@ -76,17 +83,50 @@ void HWCanvas::OnClipRect(const Rect& rect, ClipOp op) {
     return;
   }
 
-  if (op == ClipOp::kDifference || !CurrentMatrix().OnlyScaleAndTranslate()) {
-    Canvas::OnClipRect(rect, op);
+  if (op == ClipOp::kIntersect && CurrentMatrix().OnlyScaleAndTranslate()) {
+    CurrentLayer()->AddRectClip(rect, CurrentMatrix());
     return;
   }
 
-  CurrentLayer()->AddRectClip(rect, CurrentMatrix());
+  Path path;
+  path.AddRect(rect);
+  path.SetConvexityType(Path::ConvexityType::kConvex);
+
+  RRect rrect = RRect::MakeRect(rect);
+  AddClip(path, op, &rrect);
+}
+
+void HWCanvas::OnClipRRect(const RRect& rrect, ClipOp op) {
+  SKITY_TRACE_EVENT(HWCanvas_OnClipRRect);
+
+  if (rrect.IsRect()) {
+    OnClipRect(rrect.GetRect(), op);
+    return;
+  }
+
+  Path path;
+  path.AddRRect(rrect);
+
+  AddClip(path, op, &rrect);
 }
 
 void HWCanvas::OnClipPath(const Path& path, ClipOp op) {
   SKITY_TRACE_EVENT(HWCanvas_OnClipPath);
 
+  // circles and rrects built as paths are clipped analytically as well
+  Rect oval;
+  RRect rrect;
+  if (path.IsOval(&oval)) {
+    rrect.SetOval(oval);
+    AddClip(path, op, &rrect);
+  } else if (path.IsRRect(&rrect)) {
+    AddClip(path, op, &rrect);
+  } else {
+    AddClip(path, op, nullptr);
+  }
+}
+
+void HWCanvas::AddClip(const Path& path, ClipOp op, const RRect* rrect) {
   auto layer = CurrentLayer();
 
   if (layer == nullptr) {
@@ -107,6 +147,19 @@ void HWCanvas::OnClipPath(const Path& path, ClipOp op) {
     CurrentLayer()->AddRectClip(path.GetBounds(), CurrentMatrix());
   }
 
+  // rects and rrects are clipped in the fragment stage of the draws, the
+  // stencil clip is only drawn for the draws which can not do so
+  if (rrect != nullptr) {
+    auto analytic_clip = HWAnalyticClip::Make(
+        arena_allocator_, layer->GetState()->CurrentAnalyticClip(), *rrect,
+        CurrentMatrix(), layer->GetLayerPhysicalMatrix(CurrentMatrix()), op);
+
+    if (analytic_clip != nullptr) {
+      layer->AddAnalyticClip(analytic_clip, clip);
+      return;
+    }
+  }
+
   layer->AddClip(clip);
 }
 
@@ -161,6 +214,10 @@ void HWCanvas::DrawShape(const Shape& shape, const Paint& paint) {
   Matrix current_matrix = CurrentMatrix();
   Paint working_paint{paint};
 
+  if (paint.GetMaskFilter() && DrawBlurRRect(shape, paint, current_matrix)) {
+    return;
+  }
+
   if (NeesOffScreenLayer(paint)) {
     Paint restore_paint{working_paint};
     restore_paint.SetAlphaF(1.0);
@@ -390,6 +447,9 @@ void HWCanvas::DrawPathInternal(const Path& path, const Paint& paint,
     auto bounds = use_stroke ? paint.ComputeFastBounds(path.GetBounds())
                              : path.GetBounds();
     SetupLayerSpaceBoundsForDraw(draw, bounds);
+    if (!use_stroke && paint.GetStyle() == Paint::kFill_Style) {
+      SetupOpaqueBoundsForDraw(draw, path, paint);
+    }
     CurrentLayer()->AddDraw(draw);
   };
 
@@ -416,6 +476,14 @@ void HWCanvas::DrawPathInternal(const Path& path, const Paint& paint,
     Path outline;
     const Path* dst = &path;
 
+    if (work_paint.IsAntiAlias() &&
+        StrokeDashedPath(path, work_paint, &outline)) {
+      // the dashes were stroked as they were generated, without a dashed path
+      work_paint.SetFillColor(work_paint.GetStrokeColor());
+      draw_op_handler(outline, work_paint, false);
+      return;
+    }
+
     if (paint.GetPathEffect() && paint.GetPathEffect()->FilterPath(
                                      &effect_path, path, true, work_paint)) {
       dst = &effect_path;
@@ -436,6 +504,31 @@ void HWCanvas::DrawPathInternal(const Path& path, const Paint& paint,
   }
 }
 
+void HWCanvas::SetupOpaqueBoundsForDraw(HWDraw* draw, const Path& path,
+                                        const Paint& paint) {
+  Rect rect;
+  if (!CurrentMatrix().RectStaysRect() || !path.IsRect(&rect) ||
+      !IsOpaqueFill(paint, rect)) {
+    return;
+  }
+
+  Rect bounds =
+      CurrentLayer()->CalculateLayerSpaceBounds(rect, CurrentMatrix());
+  bounds.Sort();
+  // the edge pixels of an image may be filtered with the transparent pixels
+  // around it
+  if (paint.GetShader()) {
+    bounds.Inset(1.f, 1.f);
+  }
+  // only the pixels fully inside the rect are replaced, the others are
+  // blended with their anti-aliased coverage
+  bounds.RoundIn();
+
+  if (!bounds.IsEmpty()) {
+    draw->SetOpaqueBounds(bounds);
+  }
+}
+
 bool HWCanvas::NeedsFallbackToPathDraw(const RRect& rrect, const Paint& paint,
                                        const Matrix& transform) const {
   if (!surface_->GetGPUContext()->IsEnableSimpleShapePipeline()) {
@@ -561,6 +654,114 @@ void HWCanvas::OnDrawImageRect(std::shared_ptr<Image> image, const Rect& src,
   OnDrawRRect(RRect::MakeRect(dst), work_paint);
 }
 
+void HWCanvas::OnDrawAtlas(const std::shared_ptr<Image>& atlas,
+                           const RSXform xform[], const Rect tex[],
+                           const Color colors[], int count, BlendMode mode,
+                           const SamplingOptions& sampling,
+                           const Rect* cull_rect, const Paint* paint) {
+  SKITY_TRACE_EVENT(HWCanvas_OnDrawAtlas);
+
+  if (atlas->IsTextureBackend() && !atlas->IsLazy() &&
+      atlas->GetTexture() == nullptr) {
+    return;
+  }
+
+  if (CurrentLayer() == nullptr) {
+    return;
+  }
+
+  Paint work_paint = (paint == nullptr) ? Paint() : *paint;
+
+  // without colors the sprites are the atlas pixels whatever the mode is
+  WGSLAtlasFragment::BlendCoeffs coeffs{};
+  if (!WGSLAtlasFragment::ComputeBlendCoeffs(colors ? mode : BlendMode::kDst,
+                                             &coeffs) ||
+      NeesOffScreenLayer(work_paint) || atlas->Width() == 0 ||
+      atlas->Height() == 0) {
+    Canvas::OnDrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                        cull_rect, paint);
+    return;
+  }
+
+  float inv_width = 1.f / static_cast<float>(atlas->Width());
+  float inv_height = 1.f / static_cast<float>(atlas->Height());
+
+  std::vector<AtlasSprite> sprites;
+  sprites.reserve(count);
+
+  Rect bounds = Rect::MakeEmpty();
+  for (int i = 0; i < count; i++) {
+    const RSXform& x = xform[i];
+    const Rect& src = tex[i];
+
+    Vec4 color{1.f, 1.f, 1.f, 1.f};
+    if (colors) {
+      Color4f c = Color4fFromColor(colors[i]);
+      color = Vec4{c.r * c.a, c.g * c.a, c.b * c.a, c.a};
+    }
+
+    sprites.emplace_back(AtlasSprite{
+        Vec4{x.scos * src.Width(), x.ssin * src.Width(),
+             -x.ssin * src.Height(), x.scos * src.Height()},
+        Vec4{x.tx, x.ty, 0.f, 0.f},
+        Vec4{src.Left() * inv_width, src.Top() * inv_height,
+             src.Right() * inv_width, src.Bottom() * inv_height},
+        color,
+    });
+
+    if (cull_rect == nullptr) {
+      bounds.Join(x.ToMatrix().MapRect(Rect::MakeWH(src.Width(),
+                                                    src.Height())));
+    }
+  }
+
+  if (cull_rect != nullptr) {
+    bounds = *cull_rect;
+  }
+
+  HWDraw* draw = arena_allocator_->Make<HWDynamicAtlasDraw>(
+      CurrentMatrix(), work_paint.GetBlendMode(), atlas, sampling, coeffs,
+      work_paint.GetAlphaF(), work_paint.GetColorFilter(), std::move(sprites));
+
+  draw->SetSampleCount(GetCanvasSampleCount());
+  SetupLayerSpaceBoundsForDraw(draw, bounds);
+  CurrentLayer()->AddDraw(draw);
+}
+
+void HWCanvas::OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                              BlendMode mode, const Paint& paint) {
+  SKITY_TRACE_EVENT(HWCanvas_OnDrawVertices);
+
+  if (CurrentLayer() == nullptr) {
+    return;
+  }
+
+  if (const auto* image_ptr =
+          paint.GetShader() ? paint.GetShader()->AsImage() : nullptr;
+      image_ptr && (*image_ptr)->IsTextureBackend() &&
+      !(*image_ptr)->IsLazy() && (*image_ptr)->GetTexture() == nullptr) {
+    return;
+  }
+
+  if (!HWDynamicVerticesDraw::CanDraw(*vertices, mode, paint)) {
+    Canvas::OnDrawVertices(vertices, mode, paint);
+    return;
+  }
+
+  Paint work_paint{paint};
+  work_paint.SetStyle(Paint::kFill_Style);
+  work_paint.SetPathEffect(nullptr);
+  work_paint.SetMaskFilter(nullptr);
+  work_paint.SetImageFilter(nullptr);
+
+  HWDraw* draw = arena_allocator_->Make<HWDynamicVerticesDraw>(
+      CurrentMatrix(), vertices, mode, work_paint);
+
+  draw->SetSampleCount(GetCanvasSampleCount());
+  SetupLayerSpaceBoundsForDraw(draw, vertices->Bounds());
+  CurrentLayer()->AddDraw(draw);
+}
+
 void HWCanvas::OnRestore() {
   SKITY_TRACE_EVENT(HWCanvas_OnRestore);
 
@@ -635,6 +836,10 @@ void HWCanvas::OnFlush() {
   layer_stack_.clear();
 }
 
+void HWCanvas::OnFrameStatsCollected(const FrameStats& stats) {
+  surface_->GetGPUContext()->SetFrameStats(stats);
+}
+
 uint32_t HWCanvas::GetCanvasSampleCount() {
   if (!enable_msaa_) {
     return 1;
@@ -649,6 +854,48 @@ void HWCanvas::UploadMesh() {
   static_buffer_->Flush();
 }
 
+bool HWCanvas::DrawBlurRRect(const Shape& shape, const Paint& paint,
+                             const Matrix& transform) {
+  RRect rrect;
+  if (shape.IsRRect()) {
+    rrect = *shape.GetRRect();
+  } else {
+    Rect rect;
+    if (!shape.GetPath()->IsRect(&rect)) {
+      return false;
+    }
+    rrect.SetRect(rect);
+  }
+
+  // the layer blurs in device space, which is the local blur scaled only if
+  // the scale is uniform
+  Matrix world_matrix = GetCanvasState()->GetTotalMatrix();
+  if (!world_matrix.IsSimilarity()) {
+    return false;
+  }
+
+  float scale =
+      Vec2{world_matrix.GetScaleX(), world_matrix.GetSkewY()}.Length() *
+      ctx_scale_;
+  auto blur = AnalyticBlurRRect::Make(rrect, paint, scale);
+  if (!blur) {
+    return false;
+  }
+
+  SKITY_TRACE_EVENT(HWCanvas_DrawBlurRRect);
+
+  HWDraw* draw =
+      arena_allocator_->Make<HWDynamicBlurRRectDraw>(transform, *blur, paint);
+  if (draw == nullptr) {
+    return true;
+  }
+
+  draw->SetSampleCount(GetCanvasSampleCount());
+  SetupLayerSpaceBoundsForDraw(draw, blur->GetBounds());
+  CurrentLayer()->AddDraw(draw);
+  return true;
+}
+
 HWLayer* HWCanvas::CurrentLayer() {
   if (layer_stack_.empty()) {
     return nullptr;
@@ -47,6 +47,8 @@ class HWCanvas : public Canvas {
 
   void OnClipRect(const Rect& rect, ClipOp op) override;
 
+  void OnClipRRect(const RRect& rrect, ClipOp op) override;
+
   void OnClipPath(const Path& path, ClipOp op) override;
 
   void OnDrawPath(const Path& path, const Paint& paint) override;
@@ -62,6 +64,14 @@ class HWCanvas : public Canvas {
                        const Rect& dst, const SamplingOptions& sampling,
                        Paint const* paint) override;
 
+  void OnDrawAtlas(const std::shared_ptr<Image>& atlas, const RSXform xform[],
+                   const Rect tex[], const Color colors[], int count,
+                   BlendMode mode, const SamplingOptions& sampling,
+                   const Rect* cull_rect, const Paint* paint) override;
+
+  void OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                      BlendMode mode, const Paint& paint) override;
+
   void OnDrawGlyphs(uint32_t count, const GlyphID* glyphs,
                     const float* position_x, const float* position_y,
                     const Font& font, const Paint& paint) override;
@@ -74,6 +84,8 @@ class HWCanvas : public Canvas {
 
   void OnFlush() override;
 
+  void OnFrameStatsCollected(const FrameStats& stats) override;
+
   uint32_t OnGetWidth() const override;
 
   uint32_t OnGetHeight() const override;
@@ -99,12 +111,28 @@ class HWCanvas : public Canvas {
 
   void DrawShape(const Shape& shape, const Paint& paint);
 
+  /**
+   * Clips the current layer with a stencil clip of path, or with an analytic
+   * clip when `rrect` is the same shape as path and can be evaluated in the
+   * fragment stage.
+   */
+  void AddClip(const Path& path, ClipOp op, const RRect* rrect);
+
   void DrawPathInternal(const Path& path, const Paint& paint,
                         const Matrix& transform);
 
   void DrawRRectInternal(const RRect& rrect, const Paint& paint,
                          const Matrix& transform);
 
+  /**
+   * Draws a rect or rrect blurred by the mask filter of the paint with its
+   * analytic coverage, without offscreen layer and blur passes.
+   *
+   * @return false if the draw needs the offscreen layer
+   */
+  bool DrawBlurRRect(const Shape& shape, const Paint& paint,
+                     const Matrix& transform);
+
   const Matrix& CurrentMatrix() const {
     return GetCanvasState()->CurrentLayerMatrix();
   }
@@ -116,6 +144,13 @@ class HWCanvas : public Canvas {
         CurrentLayer()->CalculateLayerSpaceBounds(bounds, transform));
   }
 
+  /**
+   * Marks a fill of a rect with an opaque paint as hiding the draws below it,
+   * so HWLayer can drop them.
+   */
+  void SetupOpaqueBoundsForDraw(HWDraw* draw, const Path& path,
+                                const Paint& paint);
+
   bool NeesOffScreenLayer(const Paint& paint) const;
 
   bool NeedsFallbackToPathDraw(const RRect& rrect, const Paint& paint,
@@ -18,6 +18,7 @@
 
 namespace skity {
 
+class HWAnalyticClip;
 class HWStageBuffer;
 class GPURenderPass;
 class HWPipelineLib;
@@ -28,6 +29,8 @@ enum class HWDrawType {
   kPath,
   kRRect,
   kText,
+  kAtlas,
+  kVertices,
   kBlur,
   kStencil,
   kLayer,
@@ -105,6 +108,27 @@ class HWDraw {
 
   const HWDraw* GetClipDraw() const { return clip_draw_; }
 
+  /**
+   * Whether every step of this draw writing colors is generated by the
+   * HWWGSLShaderWriter, which evaluates the analytic clip. Other draws are
+   * clipped by the stencil fallback of the analytic clip instead.
+   */
+  virtual bool SupportsAnalyticClip() const { return false; }
+
+  void SetAnalyticClip(const HWAnalyticClip* clip) { analytic_clip_ = clip; }
+
+  const HWAnalyticClip* GetAnalyticClip() const { return analytic_clip_; }
+
+  /**
+   * Called by the layer once this draw is prepared and the `state` of the
+   * layer is known. Drops the analytic clip and returns false if a step can
+   * not evaluate it, the layer then draws the stencil fallback of the clip
+   * before this draw.
+   */
+  virtual bool PrepareAnalyticClip(HWDrawContext* context, HWDrawState state) {
+    return true;
+  }
+
   uint32_t GetClipDepth() const { return clip_depth_; }
 
   float GetClipValue() const { return clip_value_; }
@@ -115,6 +139,17 @@ class HWDraw {
     layer_space_bounds_ = layer_space_bounds;
   }
 
+  /**
+   * The rect of the layer space whose pixels are all replaced by opaque colors
+   * of this draw, the draws below it inside this rect are not visible. Empty
+   * if unknown.
+   */
+  const Rect& GetOpaqueBounds() const { return opaque_bounds_; }
+
+  void SetOpaqueBounds(const Rect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
   bool MergeIfPossible(HWDraw* draw) {
     if (GetDrawType() != draw->GetDrawType() ||
         GetDrawType() == HWDrawType::kUnknow) {
@@ -122,6 +157,7 @@ class HWDraw {
     }
 
     if (GetClipDraw() != draw->GetClipDraw() ||
+        GetAnalyticClip() != draw->GetAnalyticClip() ||
         GetScissorBox() != draw->GetScissorBox()) {
       return false;
     }
@@ -158,7 +194,9 @@ class HWDraw {
   HWDrawState draw_state_ = HWDrawState::kDrawStateNone;
   Rect scissor_rect_ = {};
   Rect layer_space_bounds_ = Rect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
+  Rect opaque_bounds_ = {};
   HWDraw* clip_draw_;
+  const HWAnalyticClip* analytic_clip_ = nullptr;
 };
 
 }  // namespace skity
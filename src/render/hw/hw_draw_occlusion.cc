@@ -0,0 +1,141 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_draw_occlusion.hpp"
+
+#include <array>
+#include <skity/graphic/image.hpp>
+
+#include "src/effect/pixmap_shader.hpp"
+#include "src/tracing.hpp"
+
+namespace skity {
+
+namespace {
+
+constexpr size_t kMaxOccluderCount = 4;
+
+float Area(const Rect& rect) { return rect.Width() * rect.Height(); }
+
+class Occluders {
+ public:
+  bool Hides(const Rect& bounds) const {
+    for (size_t i = 0; i < count_; i++) {
+      if (rects_[i].Contains(bounds)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Add(const Rect& rect) {
+    if (Hides(rect)) {
+      return;
+    }
+
+    // replaces the rects inside the new one first, then the smallest one
+    size_t index = count_;
+    for (size_t i = 0; i < count_; i++) {
+      if (rect.Contains(rects_[i])) {
+        index = i;
+        break;
+      }
+    }
+
+    if (index == kMaxOccluderCount) {
+      index = 0;
+      for (size_t i = 1; i < count_; i++) {
+        if (Area(rects_[i]) < Area(rects_[index])) {
+          index = i;
+        }
+      }
+
+      if (Area(rects_[index]) >= Area(rect)) {
+        return;
+      }
+    }
+
+    rects_[index] = rect;
+    if (index == count_) {
+      count_++;
+    }
+  }
+
+ private:
+  std::array<Rect, kMaxOccluderCount> rects_ = {};
+  size_t count_ = 0;
+};
+
+}  // namespace
+
+size_t CullOccludedDraws(std::vector<HWDraw*>* draws) {
+  SKITY_TRACE_EVENT(CullOccludedDraws);
+
+  Occluders occluders;
+  // the kept draws are compacted towards the end while walking from the top
+  size_t first_kept = draws->size();
+
+  for (size_t i = draws->size(); i > 0; i--) {
+    HWDraw* draw = (*draws)[i - 1];
+
+    if (draw->GetDrawType() != HWDrawType::kClip) {
+      Rect bounds = draw->GetLayerSpaceBounds();
+      if (bounds.Intersect(draw->GetScissorBox()) && occluders.Hides(bounds)) {
+        continue;
+      }
+
+      if (!draw->GetOpaqueBounds().IsEmpty()) {
+        occluders.Add(draw->GetOpaqueBounds());
+      }
+    }
+
+    (*draws)[--first_kept] = draw;
+  }
+
+  draws->erase(draws->begin(), draws->begin() + first_kept);
+
+  return first_kept;
+}
+
+bool IsOpaqueFill(const Paint& paint, const Rect& rect) {
+  if (paint.GetBlendMode() != BlendMode::kSrcOver &&
+      paint.GetBlendMode() != BlendMode::kSrc) {
+    return false;
+  }
+
+  if (paint.GetColorFilter() || paint.GetMaskFilter() ||
+      paint.GetImageFilter() || paint.GetAlphaF() < 1.f) {
+    return false;
+  }
+
+  auto shader = paint.GetShader();
+  if (shader == nullptr || shader->IsOpaque()) {
+    return true;
+  }
+
+  const auto* image = shader->AsImage();
+  if (image == nullptr || *image == nullptr ||
+      (*image)->GetAlphaType() != AlphaType::kOpaque_AlphaType) {
+    return false;
+  }
+
+  const auto* pixmap_shader = static_cast<const PixmapShader*>(shader.get());
+  if (pixmap_shader->GetXTileMode() != TileMode::kDecal &&
+      pixmap_shader->GetYTileMode() != TileMode::kDecal) {
+    return true;
+  }
+
+  const Matrix& local_matrix = pixmap_shader->GetLocalMatrix();
+  if (!local_matrix.RectStaysRect()) {
+    return false;
+  }
+
+  Rect image_bounds = Rect::MakeWH(static_cast<float>((*image)->Width()),
+                                   static_cast<float>((*image)->Height()));
+  image_bounds = local_matrix.MapRect(image_bounds);
+  image_bounds.Sort();
+  return image_bounds.Contains(rect);
+}
+
+}  // namespace skity
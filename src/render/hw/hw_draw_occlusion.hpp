@@ -0,0 +1,44 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_HW_DRAW_OCCLUSION_HPP
+#define SRC_RENDER_HW_HW_DRAW_OCCLUSION_HPP
+
+#include <cstddef>
+#include <skity/geometry/rect.hpp>
+#include <skity/graphic/paint.hpp>
+#include <vector>
+
+#include "src/render/hw/hw_draw.hpp"
+
+namespace skity {
+
+/**
+ * Removes the draws of a layer which are fully hidden by the opaque bounds of
+ * the draws after them. Clip draws are always kept, they write the depth
+ * tested by the draws after them.
+ *
+ * Only the largest few opaque rects are tracked while walking the draws from
+ * the top, so a draw hidden by the union of several rects may be kept.
+ *
+ * @param draws  draws of a layer in painting order
+ * @return       the number of removed draws
+ */
+size_t CullOccludedDraws(std::vector<HWDraw*>* draws);
+
+/**
+ * Checks whether filling the rect with the paint replaces every pixel it fully
+ * covers with an opaque color.
+ *
+ * An image shader of an opaque image only counts when it tiles on both axes,
+ * or when the image mapped by its local matrix contains the rect. A decal
+ * image is transparent outside of its bounds.
+ *
+ * @param rect  the filled rect in the local space of the shader
+ */
+bool IsOpaqueFill(const Paint& paint, const Rect& rect);
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_HW_DRAW_OCCLUSION_HPP
@@ -6,10 +6,13 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <skity/effect/shader.hpp>
+#include <unordered_set>
 
 #include "src/geometry/glm_helper.hpp"
 #include "src/gpu/gpu_context_impl.hpp"
+#include "src/render/hw/hw_draw_occlusion.hpp"
 #include "src/tracing.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -52,11 +55,21 @@ void HWLayer::Draw(GPURenderPass* render_pass) {
   OnPostDraw(render_pass, cmd.get());
 
   draw_ops_.clear();
+  fallback_clips_.clear();
 }
 
 HWLayerState* HWLayer::GetState() { return &state_; }
 
 void HWLayer::AddDraw(HWDraw* draw) {
+  if (draw->SupportsAnalyticClip()) {
+    draw->SetAnalyticClip(state_.CurrentAnalyticClip());
+    if (draw->GetAnalyticClip() != nullptr) {
+      state_.GetFallbackClips(&fallback_clips_[draw]);
+    }
+  } else {
+    state_.TakeFallbackClips(&pending_clip_);
+  }
+
   FlushPendingClip();
 
   draw->SetColorFormat(GetColorFormat());
@@ -73,6 +86,16 @@ void HWLayer::AddDraw(HWDraw* draw) {
   }
   draw->SetLayerSpaceBounds(rect);
 
+  // a draw clipped by more than the scissor box may not cover its opaque
+  // bounds
+  Rect opaque_bounds = draw->GetOpaqueBounds();
+  if (draw->GetClipDraw() != nullptr || draw->GetAnalyticClip() != nullptr ||
+      !opaque_bounds.Intersect(clip_bounds)) {
+    opaque_bounds.SetEmpty();
+  }
+  opaque_bounds.RoundIn();
+  draw->SetOpaqueBounds(opaque_bounds);
+
   if (enable_merging_draw_call_) {
     bool merged = TryMerge(draw);
     if (merged) {
@@ -112,6 +135,12 @@ void HWLayer::AddClip(HWDraw* draw) {
   state_.SaveClipOp(draw);
 }
 
+void HWLayer::AddAnalyticClip(const HWAnalyticClip* clip, HWDraw* fallback) {
+  fallback->SetScissorBox(state_.CurrentClipBounds());
+  fallback->SetColorFormat(GetColorFormat());
+  state_.SaveAnalyticClip(clip, fallback);
+}
+
 void HWLayer::AddRectClip(const skity::Rect& local_rect, const Matrix& matrix) {
   Rect transformed_rect;
   GetLayerPhysicalMatrix(matrix).MapRect(&transformed_rect, local_rect);
@@ -139,6 +168,8 @@ void HWLayer::FlushPendingClip() {
 HWDrawState HWLayer::OnPrepare(HWDrawContext* context) {
   state_.FlushClipDepth();
 
+  AddRenderCounter(RenderCounter::kDrawCulled, CullOccludedDraws(&draw_ops_));
+
   gpu_device_ = context->gpuContext->GetGPUDevice();
 
   HWRenderTargetCache::Pool pool(context->gpuContext->GetRenderTargetCache());
@@ -163,10 +194,48 @@ HWDrawState HWLayer::OnPrepare(HWDrawContext* context) {
     layer_state_ |= draw->Prepare(&sub_context);
   }
 
+  PrepareAnalyticClips(&sub_context);
+
   // abstract layer no need stencil test and depth for itself
   return HWDrawState::kDrawStateNone;
 }
 
+void HWLayer::PrepareAnalyticClips(HWDrawContext* context) {
+  std::unordered_set<HWDraw*> fallback_draws;
+  for (auto draw : draw_ops_) {
+    if (fallback_clips_.count(draw) != 0 &&
+        !draw->PrepareAnalyticClip(context, layer_state_)) {
+      fallback_draws.insert(draw);
+    }
+  }
+
+  if (fallback_draws.empty()) {
+    return;
+  }
+
+  // a stencil clip stays valid for all the draws of its save level which
+  // follow it, so each one is drawn once, in front of its first user
+  std::vector<HWDraw*> draw_ops;
+  std::unordered_set<HWDraw*> added;
+
+  for (auto draw : draw_ops_) {
+    if (fallback_draws.count(draw) != 0) {
+      for (auto clip : fallback_clips_[draw]) {
+        if (added.insert(clip).second) {
+          layer_state_ |= clip->Prepare(context);
+          draw_ops.emplace_back(clip);
+        }
+      }
+    }
+
+    if (added.insert(draw).second) {
+      draw_ops.emplace_back(draw);
+    }
+  }
+
+  draw_ops_.swap(draw_ops);
+}
+
 void HWLayer::OnGenerateCommand(HWDrawContext* context, HWDrawState state) {
   HWRenderTargetCache::Pool pool(context->gpuContext->GetRenderTargetCache());
 
@@ -204,6 +273,16 @@ Rect HWLayer::CalculateLayerSpaceBounds(const Rect& local_rect,
 std::shared_ptr<Shader> HWLayer::CreateDrawLayerShader(
     GPUContext* gpu_context, std::shared_ptr<GPUTexture> gpu_texture,
     const Rect& bounds) const {
+  Vec2 content_size{static_cast<float>(gpu_texture->GetDescriptor().width),
+                    static_cast<float>(gpu_texture->GetDescriptor().height)};
+
+  return CreateDrawLayerShader(gpu_context, std::move(gpu_texture), bounds,
+                               content_size);
+}
+
+std::shared_ptr<Shader> HWLayer::CreateDrawLayerShader(
+    GPUContext* gpu_context, std::shared_ptr<GPUTexture> gpu_texture,
+    const Rect& bounds, const Vec2& content_size) const {
   auto texture = std::make_shared<InternalTexture>(
       gpu_texture, AlphaType::kPremul_AlphaType);
 
@@ -211,17 +290,19 @@ std::shared_ptr<Shader> HWLayer::CreateDrawLayerShader(
 
   Matrix local_matrix;
   // FIXME: GL/GLES fbo texture need to flip the Y coordinate when drawing
-  // back to screen
+  // back to screen. The viewport is placed at the top of the fbo, so the
+  // content ends at the last row of a larger texture.
   if (gpu_context->GetBackendType() == GPUBackendType::kOpenGL ||
       gpu_context->GetBackendType() == GPUBackendType::kWebGL2) {
+    float flipped_height = bounds.Height() * texture->Height() / content_size.y;
     local_matrix =
-        Matrix::Translate(bounds.Left(), bounds.Height() + bounds.Top()) *
-        Matrix::Scale(bounds.Width() / texture->Width(),
-                      -(bounds.Height() / texture->Height()));
+        Matrix::Translate(bounds.Left(), bounds.Top() + flipped_height) *
+        Matrix::Scale(bounds.Width() / content_size.x,
+                      -(bounds.Height() / content_size.y));
   } else {
     local_matrix = Matrix::Translate(bounds.Left(), bounds.Top()) *
-                   Matrix::Scale(bounds.Width() / texture->Width(),
-                                 bounds.Height() / texture->Height());
+                   Matrix::Scale(bounds.Width() / content_size.x,
+                                 bounds.Height() / content_size.y);
   }
 
   return Shader::MakeShader(image, SamplingOptions{}, TileMode::kClamp,
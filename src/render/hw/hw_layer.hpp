@@ -7,6 +7,7 @@
 
 #include <skity/geometry/rect.hpp>
 #include <skity/graphic/paint.hpp>
+#include <unordered_map>
 #include <vector>
 
 #include "src/gpu/gpu_command_buffer.hpp"
@@ -48,6 +49,16 @@ class HWLayer : public HWDraw {
 
   void AddRectClip(const Rect& local_rect, const Matrix& matrix);
 
+  /**
+   * Clips the following draws with shapes evaluated in their fragment stage.
+   *
+   * @param clip      the analytic clip of the current save level, including
+   *                  the shapes of the levels below
+   * @param fallback  stencil clip of the new shape, only drawn before the
+   *                  first draw which does not support analytic clips
+   */
+  void AddAnalyticClip(const HWAnalyticClip* clip, HWDraw* fallback);
+
   void Restore();
 
   void RestoreToCount(int32_t count);
@@ -109,11 +120,23 @@ class HWLayer : public HWDraw {
       GPUContext* gpu_context, std::shared_ptr<GPUTexture> texture,
       const Rect& bounds) const;
 
+  // the layer content only covers the top left `content_size` pixels of the
+  // texture, which may be larger when it comes from an approximate fit
+  std::shared_ptr<Shader> CreateDrawLayerShader(
+      GPUContext* gpu_context, std::shared_ptr<GPUTexture> texture,
+      const Rect& bounds, const Vec2& content_size) const;
+
  private:
   void FlushPendingClip();
 
   bool TryMerge(HWDraw* draw);
 
+  /**
+   * Draws the stencil fallbacks of the analytic clip before every draw whose
+   * steps can not evaluate the clip, see HWDraw::PrepareAnalyticClip().
+   */
+  void PrepareAnalyticClips(HWDrawContext* context);
+
  private:
   HWLayerState state_;
   // logical bounds used when layer rendered backend to parent
@@ -129,6 +152,8 @@ class HWLayer : public HWDraw {
   Matrix world_matrix_ = {};
   std::vector<HWDraw*> draw_ops_ = {};
   std::vector<HWDraw*> pending_clip_ = {};
+  // the stencil fallbacks pending when a draw got its analytic clip
+  std::unordered_map<HWDraw*, std::vector<HWDraw*>> fallback_clips_ = {};
   GPUDevice* gpu_device_ = {};
   Matrix bounds_to_physical_matrix_ = {};
   bool enable_merging_draw_call_ = {};
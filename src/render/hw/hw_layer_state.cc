@@ -51,31 +51,65 @@ HWDraw *HWLayerState::LastClipDraw() const {
   return nullptr;
 }
 
+void HWLayerState::SaveAnalyticClip(const HWAnalyticClip *clip,
+                                    HWDraw *fallback) {
+  clip_stack_.back().analytic_clip = clip;
+  clip_stack_.back().fallback_clips.emplace_back(fallback);
+}
+
+const HWAnalyticClip *HWLayerState::CurrentAnalyticClip() const {
+  return clip_stack_.back().analytic_clip;
+}
+
+void HWLayerState::TakeFallbackClips(std::vector<HWDraw *> *clips) {
+  for (auto &value : clip_stack_) {
+    for (auto fallback : value.fallback_clips) {
+      value.clip_draws.emplace_back(fallback);
+      clips->emplace_back(fallback);
+    }
+    value.fallback_clips.clear();
+  }
+}
+
+void HWLayerState::GetFallbackClips(std::vector<HWDraw *> *clips) const {
+  for (const auto &value : clip_stack_) {
+    clips->insert(clips->end(), value.fallback_clips.begin(),
+                  value.fallback_clips.end());
+  }
+}
+
 uint32_t HWLayerState::GetNextDrawDepth() { return ++draw_depth_; }
 
 void HWLayerState::FlushClipDepth() {
   for (auto it = clip_stack_.rbegin(); it != clip_stack_.rend(); it++) {
-    for (auto draw_it = it->clip_draws.rbegin();
-         draw_it != it->clip_draws.rend(); draw_it++) {
-      (*draw_it)->SetClipDepth(GetNextDrawDepth());
-    }
+    SetClipDepth(*it);
   }
 }
 
 void HWLayerState::PushClipStack() {
   auto bounds = clip_stack_.back().clip_bounds;
+  auto analytic_clip = clip_stack_.back().analytic_clip;
   clip_stack_.emplace_back();
   clip_stack_.back().clip_bounds = bounds;
+  clip_stack_.back().analytic_clip = analytic_clip;
 }
 
 void HWLayerState::PopClipStack() {
-  auto &clip_draws = clip_stack_.back().clip_draws;
+  SetClipDepth(clip_stack_.back());
 
-  for (auto it = clip_draws.rbegin(); it != clip_draws.rend(); it++) {
+  clip_stack_.pop_back();
+}
+
+void HWLayerState::SetClipDepth(const ClipStackValue &value) {
+  for (auto it = value.clip_draws.rbegin(); it != value.clip_draws.rend();
+       it++) {
     (*it)->SetClipDepth(GetNextDrawDepth());
   }
 
-  clip_stack_.pop_back();
+  for (auto it = value.fallback_clips.rbegin();
+       it != value.fallback_clips.rend(); it++) {
+    (*it)->SetClipDepth(GetNextDrawDepth());
+  }
 }
 
 }  // namespace skity
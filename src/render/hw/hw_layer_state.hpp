@@ -10,6 +10,7 @@
 #include <skity/graphic/path.hpp>
 #include <vector>
 
+#include "src/render/hw/hw_analytic_clip.hpp"
 #include "src/render/hw/hw_draw.hpp"
 
 namespace skity {
@@ -21,6 +22,12 @@ class HWLayerState {
     // clip bounds in physical pixel size in this layer
     // only applied with intersect clip
     Rect clip_bounds = {};
+    // the analytic clip of this save level and the levels below it
+    const HWAnalyticClip* analytic_clip = nullptr;
+    // stencil clips of the analytic shapes of this save level, they are moved
+    // into clip_draws once a draw can not evaluate the analytic clip. They get
+    // a clip depth either way, so a draw can still fall back to them late.
+    std::vector<HWDraw*> fallback_clips;
   };
 
   explicit HWLayerState(int32_t depth);
@@ -39,6 +46,22 @@ class HWLayerState {
 
   HWDraw* LastClipDraw() const;
 
+  void SaveAnalyticClip(const HWAnalyticClip* clip, HWDraw* fallback);
+
+  const HWAnalyticClip* CurrentAnalyticClip() const;
+
+  /**
+   * Moves the pending stencil fallbacks of all save levels into their clip
+   * draws and appends them to `clips`, from the bottom save level up.
+   */
+  void TakeFallbackClips(std::vector<HWDraw*>* clips);
+
+  /**
+   * Appends the pending stencil fallbacks of all save levels to `clips`, from
+   * the bottom save level up, without taking them.
+   */
+  void GetFallbackClips(std::vector<HWDraw*>* clips) const;
+
   int32_t GetCurrentDepth() const {
     return start_depth + clip_stack_.size() - 1;
   }
@@ -57,6 +80,8 @@ class HWLayerState {
   void PushClipStack();
   void PopClipStack();
 
+  void SetClipDepth(const ClipStackValue& value);
+
  private:
   int32_t start_depth = 1;
   std::vector<ClipStackValue> clip_stack_ = {};
@@ -0,0 +1,211 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_RENDER_HW_HW_PIPELINE_KEY_HPP
+#define SRC_RENDER_HW_HW_PIPELINE_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace skity {
+
+/**
+ * Compact keys identifying the shaders generated by a HWDrawStep.
+ *
+ * Every geometry, fragment and color filter reports a shader key made of its
+ * variant in the high bits and the options changing its generated WGSL in the
+ * low bits. Two objects with the same key must generate the same shader.
+ *
+ * kHWShaderKeyUnknown means the object can not be described by a compact key,
+ * pipelines are then looked up by their shader names instead.
+ */
+constexpr uint32_t kHWShaderKeyUnknown = 0;
+
+enum class HWGeometryVariant : uint32_t {
+  kPath = 1,
+  kPathAA,
+  kRRect,
+  kTessPathFill,
+  kTessPathStroke,
+  kFilter,
+  kTextSolidColor,
+  kTextGradient,
+  kAtlas,
+  kVertices,
+  kBlurRRect,
+};
+
+enum class HWFragmentVariant : uint32_t {
+  kSolidColor = 1,
+  kSolidVertexColor,
+  kStencil,
+  kGradient,
+  kTexture,
+  kBlurFilter,
+  kImageFilter,
+  kColorText,
+  kColorEmoji,
+  kGradientText,
+  kSdfColorText,
+  kAtlas,
+};
+
+enum class HWColorFilterVariant : uint32_t {
+  // the fragment has no color filter
+  kNone = 1,
+  kBlend,
+  kMatrix,
+  kGamma,
+};
+
+// geometry: 8 bits variant, 8 bits options
+constexpr uint32_t kHWGeometryOptionBits = 8;
+// fragment and color filter: 8 bits variant, 16 bits options
+constexpr uint32_t kHWFragmentOptionBits = 16;
+constexpr uint32_t kHWColorFilterOptionBits = 16;
+
+constexpr uint32_t MakeHWShaderKey(HWGeometryVariant variant,
+                                   uint32_t options = 0) {
+  return static_cast<uint32_t>(variant) << kHWGeometryOptionBits | options;
+}
+
+constexpr uint32_t MakeHWShaderKey(HWFragmentVariant variant,
+                                   uint32_t options = 0) {
+  return static_cast<uint32_t>(variant) << kHWFragmentOptionBits | options;
+}
+
+constexpr uint32_t MakeHWShaderKey(HWColorFilterVariant variant,
+                                   uint32_t options = 0) {
+  return static_cast<uint32_t>(variant) << kHWColorFilterOptionBits | options;
+}
+
+// the color filter keeps 20 bits of the pipeline key
+static_assert(MakeHWShaderKey(HWColorFilterVariant::kGamma, 0xFFFF) <= 0xFFFFF);
+
+/**
+ * 0 is never a valid pipeline key.
+ */
+constexpr uint64_t kHWPipelineKeyInvalid = 0;
+
+/**
+ * Pack the shader keys of a draw step into a 64 bits pipeline key:
+ *
+ *   bits 48 - 63: geometry
+ *   bits 24 - 47: fragment
+ *   bits 20 - 23: analytic clip shape count
+ *   bits  0 - 19: color filter
+ *
+ * @return kHWPipelineKeyInvalid if any of the keys is unknown
+ */
+constexpr uint64_t MakeHWPipelineKey(uint32_t geometry_key,
+                                     uint32_t fragment_key,
+                                     uint32_t filter_key,
+                                     uint32_t analytic_clip_count = 0) {
+  if (geometry_key == kHWShaderKeyUnknown ||
+      fragment_key == kHWShaderKeyUnknown ||
+      filter_key == kHWShaderKeyUnknown) {
+    return kHWPipelineKeyInvalid;
+  }
+
+  return static_cast<uint64_t>(geometry_key & 0xFFFF) << 48 |
+         static_cast<uint64_t>(fragment_key & 0xFFFFFF) << 24 |
+         static_cast<uint64_t>(analytic_clip_count & 0xF) << 20 |
+         static_cast<uint64_t>(filter_key & 0xFFFFF);
+}
+
+/**
+ * Open addressing hash map from pipeline keys to objects it does not own.
+ * Lookups only probe a flat array of slots, no allocation is involved.
+ */
+template <typename T>
+class HWPipelineKeyMap {
+ public:
+  T* Find(uint64_t key) const {
+    if (slots_.empty() || key == kHWPipelineKeyInvalid) {
+      return nullptr;
+    }
+
+    size_t mask = slots_.size() - 1;
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+      const Slot& slot = slots_[i];
+      if (slot.key == key) {
+        return slot.value;
+      }
+      if (slot.key == kHWPipelineKeyInvalid) {
+        return nullptr;
+      }
+    }
+  }
+
+  /**
+   * Insert or replace the value of `key`.
+   */
+  void Insert(uint64_t key, T* value) {
+    if (key == kHWPipelineKeyInvalid) {
+      return;
+    }
+
+    // keep the load factor under 1/2 so probe sequences stay short
+    if ((size_ + 1) * 2 > slots_.size()) {
+      Grow();
+    }
+
+    if (InsertNoGrow(key, value)) {
+      size_++;
+    }
+  }
+
+  size_t Size() const { return size_; }
+
+ private:
+  struct Slot {
+    uint64_t key = kHWPipelineKeyInvalid;
+    T* value = nullptr;
+  };
+
+  static size_t Hash(uint64_t key) {
+    // finalizer of MurmurHash3, spreads the packed bit fields
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ull;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+  }
+
+  bool InsertNoGrow(uint64_t key, T* value) {
+    size_t mask = slots_.size() - 1;
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+      Slot& slot = slots_[i];
+      if (slot.key == key) {
+        slot.value = value;
+        return false;
+      }
+      if (slot.key == kHWPipelineKeyInvalid) {
+        slot.key = key;
+        slot.value = value;
+        return true;
+      }
+    }
+  }
+
+  void Grow() {
+    std::vector<Slot> old_slots = std::move(slots_);
+    slots_ = std::vector<Slot>(old_slots.empty() ? 64 : old_slots.size() * 2);
+
+    for (const Slot& slot : old_slots) {
+      if (slot.key != kHWPipelineKeyInvalid) {
+        InsertNoGrow(slot.key, slot.value);
+      }
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+};
+
+}  // namespace skity
+
+#endif  // SRC_RENDER_HW_HW_PIPELINE_KEY_HPP
@@ -8,6 +8,7 @@
 #include "src/gpu/gpu_shader_module.hpp"
 #include "src/logging.hpp"
 #include "src/render/hw/hw_shader_generator.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -82,6 +83,7 @@ GPURenderPipeline *HWPipeline::GetPipeline(const HWPipelineDescriptor &desc) {
     return nullptr;
   }
 
+  AddRenderCounter(RenderCounter::kPipelineCreated, 1);
   gpu_pipelines_.emplace_back(std::move(variant_pipeline));
 
   return gpu_pipelines_.back().get();
@@ -106,10 +108,47 @@ bool HWPipeline::PipelineMatch(GPURenderPipeline *pipeline,
 
 GPURenderPipeline *HWPipelineLib::GetPipeline(
     const HWPipelineKey &key, const HWPipelineDescriptor &desc) {
+  auto pipeline = FindOrCreatePipeline(key, desc);
+
+  if (!pipeline) {
+    return nullptr;
+  }
+
+  return pipeline->GetPipeline(desc);
+}
+
+GPURenderPipeline *HWPipelineLib::GetPipeline(
+    uint64_t key, const HWPipelineDescriptor &desc) {
+  auto pipeline = pipeline_key_map_.Find(key);
+
+  if (pipeline == nullptr) {
+    if (desc.shader_generator == nullptr) {
+      return nullptr;
+    }
+
+    pipeline = FindOrCreatePipeline(
+        {
+            desc.shader_generator->GetVertexName(),
+            desc.shader_generator->GetFragmentName(),
+        },
+        desc);
+
+    if (!pipeline) {
+      return nullptr;
+    }
+
+    pipeline_key_map_.Insert(key, pipeline);
+  }
+
+  return pipeline->GetPipeline(desc);
+}
+
+HWPipeline *HWPipelineLib::FindOrCreatePipeline(
+    const HWPipelineKey &key, const HWPipelineDescriptor &desc) {
   auto it = pipelines_.find(key);
 
   if (it != pipelines_.end()) {
-    return it->second->GetPipeline(desc);
+    return it->second.get();
   }
 
   auto pipeline = CreatePipeline(key, desc);
@@ -118,7 +157,7 @@ GPURenderPipeline *HWPipelineLib::GetPipeline(
     return nullptr;
   }
 
-  auto ret = pipeline->GetPipeline(desc);
+  auto ret = pipeline.get();
 
   pipelines_.insert({HWPipelineKey(key), std::move(pipeline)});
 
@@ -153,6 +192,8 @@ std::unique_ptr<HWPipeline> HWPipelineLib::CreatePipeline(
     return std::unique_ptr<HWPipeline>();
   }
 
+  AddRenderCounter(RenderCounter::kPipelineCreated, 1);
+
   return std::make_unique<HWPipeline>(gpu_device_, std::move(gpu_pipeline));
 }
 
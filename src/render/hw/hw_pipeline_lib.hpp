@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "src/gpu/gpu_render_pipeline.hpp"
+#include "src/render/hw/hw_pipeline_key.hpp"
 
 namespace skity {
 
@@ -102,7 +103,17 @@ class HWPipelineLib final {
   GPURenderPipeline* GetPipeline(const HWPipelineKey& key,
                                  const HWPipelineDescriptor& desc);
 
+  /**
+   * Same as above, with a key built by MakeHWPipelineKey(). Shader names are
+   * only queried from `desc.shader_generator` the first time a key is seen.
+   */
+  GPURenderPipeline* GetPipeline(uint64_t key,
+                                 const HWPipelineDescriptor& desc);
+
  private:
+  HWPipeline* FindOrCreatePipeline(const HWPipelineKey& key,
+                                   const HWPipelineDescriptor& desc);
+
   std::unique_ptr<HWPipeline> CreatePipeline(const HWPipelineKey& key,
                                              const HWPipelineDescriptor& desc);
 
@@ -121,6 +132,8 @@ class HWPipelineLib final {
   GPUBackendType backend_;
   GPUDevice* gpu_device_;
   PipelineMap pipelines_ = {};
+  // pipelines already created in `pipelines_`, by compact key
+  HWPipelineKeyMap<HWPipeline> pipeline_key_map_ = {};
   ShaderFunctionCache shader_functions_ = {};
 };
 
@@ -5,11 +5,14 @@
 #ifndef SRC_RENDER_HW_HW_RENDER_TARGET_CACHE_HPP
 #define SRC_RENDER_HW_HW_RENDER_TARGET_CACHE_HPP
 
+#include <algorithm>
 #include <memory>
 
+#include "src/geometry/math.hpp"
 #include "src/gpu/gpu_device.hpp"
 #include "src/gpu/gpu_texture.hpp"
 #include "src/render/hw/hw_resource_cache.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -72,6 +75,7 @@ class HWRenderTargetAllocator
   std::shared_ptr<HWResource<GPUTextureDescriptor, std::shared_ptr<GPUTexture>>>
   AllocateResource(const GPUTextureDescriptor& key) override {
     auto texture = device_->CreateTexture(key);
+    AddRenderCounter(RenderCounter::kRenderTargetAllocated, 1);
     return std::make_shared<HWRenderTarget>(texture);
   }
 
@@ -86,14 +90,61 @@ class HWRenderTargetCache
   HWRenderTargetCache(std::unique_ptr<HWResourceAllocator<
                           GPUTextureDescriptor, std::shared_ptr<GPUTexture>>>
                           allocator,
-                      size_t max_bytes = kDefaultMaxBytes)
+                      size_t max_bytes = kDefaultMaxBytes,
+                      uint32_t max_texture_size = 0)
       : HWResourceCache<GPUTextureDescriptor, std::shared_ptr<GPUTexture>,
-                        HWTextureCompare>(std::move(allocator), max_bytes) {}
+                        HWTextureCompare>(std::move(allocator), max_bytes),
+        max_texture_size_(max_texture_size) {}
 
   static std::unique_ptr<HWRenderTargetCache> Create(GPUDevice* device) {
     auto allocator = std::make_unique<HWRenderTargetAllocator>(device);
-    return std::make_unique<HWRenderTargetCache>(std::move(allocator));
+    return std::make_unique<HWRenderTargetCache>(
+        std::move(allocator), kDefaultMaxBytes, device->GetMaxTextureSize());
   }
+
+  /**
+   * Obtain a render target at least as large as `desc`, which may be larger.
+   * New targets are allocated with the size rounded up to a bucket, so
+   * targets whose size changes a little from frame to frame, like layers with
+   * animated bounds, keep reusing the same texture.
+   *
+   * Callers must only render to and sample from the top left `desc.width` x
+   * `desc.height` region of the returned texture.
+   */
+  std::shared_ptr<HWResource<GPUTextureDescriptor, std::shared_ptr<GPUTexture>>>
+  ObtainApproxRenderTarget(const GPUTextureDescriptor& desc,
+                           Pool* pool = nullptr) {
+    GPUTextureDescriptor approx_desc = desc;
+    auto approx_size = MakeApprox(glm::uvec2{desc.width, desc.height});
+    approx_desc.width = ClampSize(approx_size.x, desc.width);
+    approx_desc.height = ClampSize(approx_size.y, desc.height);
+
+    // a small target does not hold on to a much bigger texture which a
+    // larger one may need in the same frame
+    auto fits = [&desc, &approx_desc](const GPUTextureDescriptor& key) {
+      return key.width >= desc.width && key.height >= desc.height &&
+             key.width <= approx_desc.width * 2 &&
+             key.height <= approx_desc.height * 2 &&
+             key.mip_level_count == desc.mip_level_count &&
+             key.sample_count == desc.sample_count &&
+             key.format == desc.format && key.usage == desc.usage &&
+             key.storage_mode == desc.storage_mode;
+    };
+
+    return ObtainApproxResource(approx_desc, fits, pool);
+  }
+
+ private:
+  uint32_t ClampSize(uint32_t approx, uint32_t exact) const {
+    if (max_texture_size_ == 0 || approx <= max_texture_size_) {
+      return approx;
+    }
+
+    return std::max(exact, max_texture_size_);
+  }
+
+ private:
+  uint32_t max_texture_size_;
 };
 
 }  // namespace skity
@@ -28,7 +28,8 @@ class HWResourceAllocator {
   virtual std::shared_ptr<HWResource<K, V>> AllocateResource(const K& key) = 0;
 };
 
-const size_t kDefaultMaxBytes = 0;
+// bytes of idle resources kept alive across frames
+const size_t kDefaultMaxBytes = 64 * 1024 * 1024;
 
 template <typename K, typename V, typename Compare>
 class HWResourceCache {
@@ -59,24 +60,38 @@ class HWResourceCache {
                                                    Pool* pool = nullptr) {
     auto range = purgeable_map_.equal_range(key);
     if (range.first != range.second) {
-      auto list_it = range.first->second;
-      auto resource = *list_it;
-      purgeable_list_.erase(list_it);
-      purgeable_map_.erase(range.first);
-      purgeable_bytes_ -= resource->GetBytes();
-      if (pool) {
-        pool->PutResource(resource);
+      return TakePurgeable(range.first, pool);
+    }
+
+    return Allocate(key, pool);
+  }
+
+  /**
+   * Like ObtainResource(), but any purgeable resource accepted by `fits` can
+   * be reused for `key`. The smallest accepted one is taken, a new resource
+   * is only allocated for `key` if there is none.
+   */
+  template <typename Fits>
+  std::shared_ptr<HWResource<K, V>> ObtainApproxResource(
+      const K& key, Fits&& fits, Pool* pool = nullptr) {
+    auto best = purgeable_map_.end();
+    for (auto it = purgeable_map_.begin(); it != purgeable_map_.end(); it++) {
+      const auto& resource = *(it->second);
+      if (!fits(resource->GetKey())) {
+        continue;
+      }
+
+      if (best == purgeable_map_.end() ||
+          resource->GetBytes() < (*best->second)->GetBytes()) {
+        best = it;
       }
-      return resource;
     }
 
-    std::shared_ptr<HWResource<K, V>> resource =
-        allocator_->AllocateResource(key);
-    total_resource_bytes_ += resource->GetBytes();
-    if (pool) {
-      pool->PutResource(resource);
+    if (best != purgeable_map_.end()) {
+      return TakePurgeable(best, pool);
     }
-    return resource;
+
+    return Allocate(key, pool);
   }
 
   void StoreResource(std::shared_ptr<HWResource<K, V>> resource) {
@@ -112,14 +127,42 @@ class HWResourceCache {
   size_t GetPurgableBytes() const { return purgeable_bytes_; }
   size_t GetMaxbytes() const { return max_bytes_; }
 
+ private:
+  using ResourceList = std::list<std::shared_ptr<HWResource<K, V>>>;
+  using ResourceMap =
+      std::multimap<K, typename ResourceList::iterator, Compare>;
+
+  std::shared_ptr<HWResource<K, V>> TakePurgeable(
+      typename ResourceMap::iterator map_it, Pool* pool) {
+    auto list_it = map_it->second;
+    auto resource = *list_it;
+    purgeable_list_.erase(list_it);
+    purgeable_map_.erase(map_it);
+    purgeable_bytes_ -= resource->GetBytes();
+    if (pool) {
+      pool->PutResource(resource);
+    }
+    return resource;
+  }
+
+  std::shared_ptr<HWResource<K, V>> Allocate(const K& key, Pool* pool) {
+    std::shared_ptr<HWResource<K, V>> resource =
+        allocator_->AllocateResource(key);
+    total_resource_bytes_ += resource->GetBytes();
+    if (pool) {
+      pool->PutResource(resource);
+    }
+    return resource;
+  }
+
  private:
   size_t total_resource_bytes_ = 0;
   size_t purgeable_bytes_ = 0;
   std::unique_ptr<HWResourceAllocator<K, V>> allocator_;
   size_t max_bytes_;
 
-  std::list<std::shared_ptr<HWResource<K, V>>> purgeable_list_;
-  std::multimap<K, decltype(purgeable_list_.begin()), Compare> purgeable_map_;
+  ResourceList purgeable_list_;
+  ResourceMap purgeable_map_;
 };
 
 }  // namespace skity
@@ -11,6 +11,7 @@
 #include "src/gpu/gpu_buffer.hpp"
 #include "src/gpu/gpu_device.hpp"
 #include "src/logging.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -130,6 +131,9 @@ void HWStageBuffer::Flush() {
   blit_pass->End();
   cmd_buffer->Submit();
 
+  AddRenderCounter(RenderCounter::kStageVertexBytes, stage_pos_);
+  AddRenderCounter(RenderCounter::kStageIndexBytes, stage_index_pos_);
+
   stage_pos_ = 0;
   stage_index_pos_ = 0;
 }
@@ -17,7 +17,10 @@ HWFilterLayer::HWFilterLayer(Matrix matrix, int32_t depth, Rect bounds,
 HWDrawState HWFilterLayer::OnPrepare(HWDrawContext* context) {
   auto desc = GetColorTextureDesc();
   auto device = context->gpuContext->GetGPUDevice();
-  auto input_texture = device->CreateTexture(desc);
+  // filters sample their input as a whole, so it needs an exact fit
+  auto input_texture = context->gpuContext->GetRenderTargetCache()
+                           ->ObtainResource(desc, context->pool)
+                           ->GetValue();
   auto command_buffer =
       std::make_shared<GPUCommandBufferProxy>(device->CreateCommandBuffer());
 
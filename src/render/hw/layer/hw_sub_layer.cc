@@ -25,7 +25,8 @@ HWDrawState HWSubLayer::OnPrepare(HWDrawContext* context) {
     paint.SetAlphaF(alpha_);
     paint.SetStyle(Paint::kFill_Style);
     paint.SetShader(CreateDrawLayerShader(context->gpuContext,
-                                          layer_back_draw_texture_, bounds));
+                                          layer_back_draw_texture_, bounds,
+                                          GetLayerBackDrawContentSize()));
 
     layer_back_draw_ = context->arena_allocator->Make<HWDynamicPathDraw>(
         GetTransform(), std::move(path), std::move(paint), false, false);
@@ -35,6 +36,7 @@ HWDrawState HWSubLayer::OnPrepare(HWDrawContext* context) {
   layer_back_draw_->SetSampleCount(GetSampleCount());
   layer_back_draw_->SetColorFormat(GetColorFormat());
   layer_back_draw_->SetScissorBox(GetScissorBox());
+  layer_back_draw_->SetAnalyticClip(GetAnalyticClip());
 
   auto state = layer_back_draw_->Prepare(context);
 
@@ -47,6 +49,16 @@ HWDrawState HWSubLayer::OnPrepare(HWDrawContext* context) {
   return state;
 }
 
+bool HWSubLayer::PrepareAnalyticClip(HWDrawContext* context,
+                                     HWDrawState state) {
+  if (layer_back_draw_->PrepareAnalyticClip(context, state)) {
+    return true;
+  }
+
+  SetAnalyticClip(nullptr);
+  return false;
+}
+
 void HWSubLayer::OnGenerateCommand(HWDrawContext* context, HWDrawState state) {
   HWLayer::OnGenerateCommand(context, state);
 
@@ -68,12 +80,26 @@ void HWSubLayer::InitTexture(GPUContextImpl* gpu_context,
     return;
   }
 
-  auto render_target = gpu_context->GetRenderTargetCache()->ObtainResource(
-      GetColorTextureDesc(), pool);
+  // layers move and resize from frame to frame, any large enough texture does
+  auto render_target =
+      gpu_context->GetRenderTargetCache()->ObtainApproxRenderTarget(
+          GetColorTextureDesc(), pool);
   color_texture_ = render_target->GetValue();
   layer_back_draw_texture_ = color_texture_;
 }
 
+Vec2 HWSubLayer::GetLayerBackDrawContentSize() const {
+  // the color texture may be larger than the layer, while filters output
+  // textures of exactly the filtered size
+  if (layer_back_draw_texture_ == color_texture_) {
+    return Vec2{static_cast<float>(texture_size_.x),
+                static_cast<float>(texture_size_.y)};
+  }
+
+  const auto& desc = layer_back_draw_texture_->GetDescriptor();
+  return Vec2{static_cast<float>(desc.width), static_cast<float>(desc.height)};
+}
+
 void HWSubLayer::PrepareRenderPassDesc(HWDrawContext* context) {
   HWRenderPassBuilder builder(context, color_texture_);
 
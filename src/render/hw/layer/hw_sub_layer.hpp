@@ -19,6 +19,11 @@ class HWSubLayer : public HWLayer {
 
   ~HWSubLayer() override = default;
 
+  // the layer is drawn back by a HWDynamicPathDraw
+  bool SupportsAnalyticClip() const override { return true; }
+
+  bool PrepareAnalyticClip(HWDrawContext* context, HWDrawState state) override;
+
   void SetAlpha(float alpha) { alpha_ = alpha; }
 
   void SetBlendMode(BlendMode blend_mode) { blend_mode_ = blend_mode; }
@@ -69,6 +74,8 @@ class HWSubLayer : public HWLayer {
   void InitTexture(GPUContextImpl* gpu_context,
                    HWRenderTargetCache::Pool* pool);
 
+  Vec2 GetLayerBackDrawContentSize() const;
+
   void PrepareRenderPassDesc(HWDrawContext* context);
 
  private:
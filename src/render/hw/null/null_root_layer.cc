@@ -0,0 +1,37 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/null/null_root_layer.hpp"
+
+#include "src/render/hw/hw_render_pass_builder.hpp"
+
+namespace skity {
+
+NullRootLayer::NullRootLayer(std::shared_ptr<GPUTexture> color_attachment,
+                             const Rect &bounds)
+    : HWRootLayer(color_attachment->GetDescriptor().width,
+                  color_attachment->GetDescriptor().height, bounds,
+                  color_attachment->GetDescriptor().format),
+      color_attachment_(std::move(color_attachment)) {}
+
+HWDrawState NullRootLayer::OnPrepare(HWDrawContext *context) {
+  auto ret = HWRootLayer::OnPrepare(context);
+
+  HWRenderPassBuilder builder(context, color_attachment_);
+
+  builder.SetSampleCount(GetSampleCount())
+      .SetDrawState(GetLayerDrawState())
+      .SetLoadOp(NeedClearSurface() ? GPULoadOp::kClear : GPULoadOp::kLoad)
+      .SetStoreOp(GPUStoreOp::kStore)
+      .Build(render_pass_desc_);
+
+  return ret;
+}
+
+std::shared_ptr<GPURenderPass> NullRootLayer::OnBeginRenderPass(
+    GPUCommandBuffer *cmd) {
+  return cmd->BeginRenderPass(render_pass_desc_);
+}
+
+}  // namespace skity
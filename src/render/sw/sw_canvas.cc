@@ -14,9 +14,12 @@
 #include <skity/text/text_blob.hpp>
 #include <skity/text/text_run.hpp>
 
+#include "src/effect/color_filter_base.hpp"
+#include "src/effect/dash_path_effect.hpp"
 #include "src/effect/image_filter_base.hpp"
 #include "src/effect/mask_filter_priv.hpp"
 #include "src/effect/pixmap_shader.hpp"
+#include "src/geometry/geometry.hpp"
 #include "src/render/sw/sw_raster.hpp"
 #include "src/render/sw/sw_span_brush.hpp"
 #include "src/render/sw/sw_stack_blur.hpp"
@@ -130,6 +133,96 @@ static std::vector<Span> spans_subtraction(std::vector<Span> const& subtrahend,
   return ret;
 }
 
+// Spans covering an axis aligned device rect, the partially covered pixels on
+// its borders get their exact coverage.
+static void RectToSpans(const Rect& rect, const Rect& clip_bounds,
+                        std::vector<Span>* spans) {
+  Rect bounds = rect;
+  if (!bounds.Intersect(clip_bounds)) {
+    return;
+  }
+
+  int32_t left = static_cast<int32_t>(std::floor(bounds.Left()));
+  int32_t top = static_cast<int32_t>(std::floor(bounds.Top()));
+  int32_t right = static_cast<int32_t>(std::ceil(bounds.Right()));
+  int32_t bottom = static_cast<int32_t>(std::ceil(bounds.Bottom()));
+
+  float left_cover = std::min(bounds.Right(), left + 1.f) - bounds.Left();
+  float right_cover = bounds.Right() - (right - 1.f);
+
+  for (int32_t y = top; y < bottom; y++) {
+    float row_cover = std::min(bounds.Bottom(), y + 1.f) -
+                      std::max(bounds.Top(), static_cast<float>(y));
+
+    auto emit = [&](int32_t x, int32_t len, float cover) {
+      auto alpha = static_cast<Alpha>(cover * row_cover * 255.f + 0.5f);
+      if (len > 0 && alpha > 0) {
+        spans->emplace_back(Span{x, y, len, alpha});
+      }
+    };
+
+    emit(left, 1, left_cover);
+    if (right - left > 1) {
+      emit(left + 1, right - left - 2, 1.f);
+      emit(right - 1, 1, right_cover);
+    }
+  }
+}
+
+// Spans of the pixels whose center is inside a device space triangle, without
+// anti-aliasing. Edges are half open on their bottom and right side, so the
+// pixels on an edge shared by two triangles are drawn exactly once.
+static void TriangleToSpans(const Vec2 p[3], const Rect& clip_bounds,
+                            std::vector<Span>* spans) {
+  float area = CrossProduct(p[1] - p[0], p[2] - p[0]);
+  if (area == 0.f || !std::isfinite(area)) {
+    return;
+  }
+
+  float min_y = std::max(std::min({p[0].y, p[1].y, p[2].y}), clip_bounds.Top());
+  float max_y =
+      std::min(std::max({p[0].y, p[1].y, p[2].y}), clip_bounds.Bottom());
+
+  auto top = static_cast<int32_t>(std::ceil(min_y - 0.5f));
+  auto bottom = static_cast<int32_t>(std::ceil(max_y - 0.5f));
+
+  for (int32_t y = top; y < bottom; y++) {
+    float center_y = y + 0.5f;
+
+    float xs[2];
+    int32_t count = 0;
+    for (int32_t i = 0; i < 3 && count < 2; i++) {
+      // always walk the edge downwards so both triangles sharing it compute
+      // the same intersections
+      Vec2 a = p[i];
+      Vec2 b = p[(i + 1) % 3];
+      if (a.y > b.y) {
+        std::swap(a, b);
+      }
+
+      if (center_y < a.y || center_y >= b.y) {
+        continue;
+      }
+
+      xs[count++] = a.x + (center_y - a.y) * (b.x - a.x) / (b.y - a.y);
+    }
+
+    if (count != 2) {
+      continue;
+    }
+
+    float left_x = std::max(std::min(xs[0], xs[1]), clip_bounds.Left());
+    float right_x = std::min(std::max(xs[0], xs[1]), clip_bounds.Right());
+
+    auto left = static_cast<int32_t>(std::ceil(left_x - 0.5f));
+    auto right = static_cast<int32_t>(std::ceil(right_x - 0.5f));
+
+    if (right > left) {
+      spans->emplace_back(Span{left, y, right - left, 255});
+    }
+  }
+}
+
 static Rect ComputeBoundsIfStroke(Rect bounds, const Paint& paint) {
   if (paint.GetStyle() != Paint::kFill_Style) {
     float stroke_width = paint.GetStrokeWidth();
@@ -384,16 +477,19 @@ void SWCanvas::OnDrawPath(const Path& path, const Paint& paint) {
   if (need_stroke) {
     Stroke stroke(paint);
 
-    Path temp;
-    Path quad;
     Path outline;
-    if (paint.GetPathEffect() &&
-        paint.GetPathEffect()->FilterPath(&temp, path, true, paint)) {
-      stroke.QuadPath(temp, &quad);
-      stroke.StrokePath(quad, &outline);
-    } else {
-      stroke.QuadPath(path, &quad);
-      stroke.StrokePath(quad, &outline);
+    // dashes are stroked as they are generated, without a dashed path
+    if (!StrokeDashedPath(path, paint, &outline)) {
+      Path temp;
+      Path quad;
+      if (paint.GetPathEffect() &&
+          paint.GetPathEffect()->FilterPath(&temp, path, true, paint)) {
+        stroke.QuadPath(temp, &quad);
+        stroke.StrokePath(quad, &outline);
+      } else {
+        stroke.QuadPath(path, &quad);
+        stroke.StrokePath(quad, &outline);
+      }
     }
 
     SWRaster raster;
@@ -652,6 +748,195 @@ void SWCanvas::OnDrawImageRect(std::shared_ptr<Image> image, const Rect& src,
   this->OnDrawPath(path, work_paint);
 }
 
+void SWCanvas::OnDrawAtlas(const std::shared_ptr<Image>& atlas,
+                           const RSXform xform[], const Rect tex[],
+                           const Color colors[], int count, BlendMode mode,
+                           const SamplingOptions& sampling,
+                           const Rect* cull_rect, const Paint* paint) {
+  SKITY_TRACE_EVENT(SWCanvas_OnDrawAtlas);
+
+  if (PeekLayerStack()) {
+    PeekLayerStack()->canvas->DrawAtlas(atlas, xform, tex, colors, count, mode,
+                                        sampling, cull_rect, paint);
+    return;
+  }
+
+  Paint work_paint = (paint == nullptr) ? Paint() : *paint;
+  auto pixmap = atlas->GetPixmap();
+
+  // the sprite color and the paint color filter would need a compose filter
+  if (pixmap == nullptr || IsDrawingLayer() || work_paint.GetMaskFilter() ||
+      work_paint.GetImageFilter() ||
+      (colors != nullptr && work_paint.GetColorFilter())) {
+    Canvas::OnDrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                        cull_rect, paint);
+    return;
+  }
+
+  Matrix transform = CurrentTransform();
+  Rect clip_bounds = GetScanClipBounds();
+  Matrix texel_to_unit =
+      Matrix::Scale(1.f / (*pixmap)->Width(), 1.f / (*pixmap)->Height());
+
+  std::vector<Span> spans;
+  for (int i = 0; i < count; i++) {
+    const Rect& src = tex[i];
+    if (src.Width() <= 0 || src.Height() <= 0) {
+      continue;
+    }
+
+    Matrix sprite_to_device = transform * xform[i].ToMatrix();
+    Matrix device_to_sprite;
+    if (!sprite_to_device.Invert(&device_to_sprite)) {
+      continue;
+    }
+
+    Rect sprite = Rect::MakeWH(src.Width(), src.Height());
+    spans.clear();
+    if (sprite_to_device.OnlyScaleAndTranslate()) {
+      // most sprites are not rotated, skip the rasterizer
+      RectToSpans(sprite_to_device.MapRect(sprite), clip_bounds, &spans);
+    } else {
+      Path path;
+      path.AddRect(sprite);
+      SWRaster raster;
+      raster.RastePath(path, sprite_to_device, clip_bounds);
+      spans = raster.CurrentSpans();
+    }
+
+    if (state_stack_.back().HasClip() && !spans.empty()) {
+      spans = state_stack_.back().PerformClip(spans);
+    }
+
+    if (spans.empty()) {
+      continue;
+    }
+
+    BlendColorFilter color_blend(colors ? colors[i] : Color_WHITE, mode);
+    ColorFilter* color_filter = colors != nullptr
+                                    ? &color_blend
+                                    : work_paint.GetColorFilter().get();
+
+    PixmapBrush brush(spans, bitmap_, color_filter, work_paint.GetBlendMode(),
+                      work_paint.GetAlphaF(), *pixmap,
+                      texel_to_unit *
+                          Matrix::Translate(src.Left(), src.Top()) *
+                          device_to_sprite,
+                      sampling.filter, TileMode::kClamp, TileMode::kClamp);
+    brush.Brush();
+  }
+}
+
+void SWCanvas::OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                              BlendMode mode, const Paint& paint) {
+  SKITY_TRACE_EVENT(SWCanvas_OnDrawVertices);
+
+  if (PeekLayerStack()) {
+    PeekLayerStack()->canvas->DrawVertices(vertices, mode, paint);
+    return;
+  }
+
+  const Color* colors = vertices->Colors();
+  bool use_shader = paint.GetShader() && (!colors || mode != BlendMode::kDst);
+  bool use_colors = colors && (!use_shader || mode != BlendMode::kSrc);
+  bool use_texs = use_shader && vertices->Texs() != nullptr;
+
+  // PorterDuffBlend only knows the coefficient modes
+  if (IsDrawingLayer() ||
+      (use_shader && use_colors && mode > BlendMode::kScreen)) {
+    Canvas::OnDrawVertices(vertices, mode, paint);
+    return;
+  }
+
+  Paint work_paint = paint;
+  work_paint.SetStyle(Paint::kFill_Style);
+  if (!use_shader) {
+    work_paint.SetShader(nullptr);
+  }
+
+  Matrix transform = CurrentTransform();
+  Rect clip_bounds = GetScanClipBounds();
+  if (!clip_bounds.Intersect(Rect::MakeWH(bitmap_->Width(),
+                                          bitmap_->Height()))) {
+    return;
+  }
+
+  const Vec2* positions = vertices->Positions();
+  const Vec2* texs = vertices->Texs();
+  const uint32_t* indices = vertices->Indices();
+  uint32_t triangle_count = vertices->TriangleCount();
+
+  std::vector<Span> spans;
+
+  if (!use_colors && !use_texs) {
+    // the paint does not depend on the triangle, one brush fills them all
+    for (uint32_t t = 0; t < triangle_count; t++) {
+      const uint32_t* index = indices + t * 3;
+      Vec2 device[3] = {positions[index[0]], positions[index[1]],
+                        positions[index[2]]};
+      transform.MapPoints(device, device, 3);
+      TriangleToSpans(device, clip_bounds, &spans);
+    }
+
+    if (state_stack_.back().HasClip() && !spans.empty()) {
+      spans = state_stack_.back().PerformClip(spans);
+    }
+
+    if (!spans.empty()) {
+      GenerateBrush(spans, work_paint, false, vertices->Bounds())->Brush();
+    }
+    return;
+  }
+
+  for (uint32_t t = 0; t < triangle_count; t++) {
+    const uint32_t* index = indices + t * 3;
+    Vec2 pos[3] = {positions[index[0]], positions[index[1]],
+                   positions[index[2]]};
+    Vec2 device[3];
+    transform.MapPoints(device, pos, 3);
+
+    spans.clear();
+    TriangleToSpans(device, clip_bounds, &spans);
+
+    if (state_stack_.back().HasClip() && !spans.empty()) {
+      spans = state_stack_.back().PerformClip(spans);
+    }
+
+    if (spans.empty()) {
+      continue;
+    }
+
+    std::unique_ptr<SWSpanBrush> shader_brush;
+    if (use_shader) {
+      Matrix local_to_device = transform;
+      if (use_texs) {
+        Vec2 tex[3] = {texs[index[0]], texs[index[1]], texs[index[2]]};
+        Matrix tex_to_pos;
+        if (!TriangleToTriangle(tex, pos, &tex_to_pos)) {
+          continue;
+        }
+        local_to_device = transform * tex_to_pos;
+      }
+
+      shader_brush = GenerateBrush(spans, work_paint, false,
+                                   vertices->Bounds(), local_to_device);
+    }
+
+    if (!use_colors) {
+      shader_brush->Brush();
+      continue;
+    }
+
+    Color triangle_colors[3] = {colors[index[0]], colors[index[1]],
+                                colors[index[2]]};
+
+    VertexColorBrush brush(spans, bitmap_, work_paint.GetColorFilter().get(),
+                           work_paint.GetBlendMode(), work_paint.GetAlphaF(),
+                           device, triangle_colors, shader_brush.get(), mode);
+    brush.Brush();
+  }
+}
+
 void SWCanvas::OnSave() {
   if (PeekLayerStack()) {
     PeekLayerStack()->canvas->Save();
@@ -704,7 +989,7 @@ void SWCanvas::OnUpdateViewport(uint32_t, uint32_t) {}
 
 std::unique_ptr<SWSpanBrush> SWCanvas::GenerateBrush(
     std::vector<Span> const& spans, skity::Paint const& paint, bool stroke,
-    Rect const& bounds) {
+    Rect const& bounds, Matrix const& transform) {
   auto shader = paint.GetShader();
   if (shader) {
     const auto* image_ptr = paint.GetShader()->AsImage();
@@ -723,7 +1008,7 @@ std::unique_ptr<SWSpanBrush> SWCanvas::GenerateBrush(
             Matrix::Translate(-bounds.Left(), -bounds.Top());
       } else {
         Matrix layer_to_local;
-        CurrentTransform().Invert(&layer_to_local);
+        transform.Invert(&layer_to_local);
         device_to_local = device_to_local * layer_to_local;
       }
 
@@ -753,7 +1038,7 @@ std::unique_ptr<SWSpanBrush> SWCanvas::GenerateBrush(
                  Matrix::Translate(-bounds.Left(), -bounds.Top());
       } else {
         Matrix layer_to_local;
-        CurrentTransform().Invert(&layer_to_local);
+        transform.Invert(&layer_to_local);
         matrix = matrix * layer_to_local;
       }
 
@@ -91,6 +91,14 @@ class SWCanvas : public Canvas {
                        const Rect& dst, const SamplingOptions& sampling,
                        Paint const* paint) override;
 
+  void OnDrawAtlas(const std::shared_ptr<Image>& atlas, const RSXform xform[],
+                   const Rect tex[], const Color colors[], int count,
+                   BlendMode mode, const SamplingOptions& sampling,
+                   const Rect* cull_rect, const Paint* paint) override;
+
+  void OnDrawVertices(const std::shared_ptr<Vertices>& vertices,
+                      BlendMode mode, const Paint& paint) override;
+
   void OnSave() override;
 
   void OnRestore() override;
@@ -115,7 +123,18 @@ class SWCanvas : public Canvas {
  private:
   std::unique_ptr<SWSpanBrush> GenerateBrush(std::vector<Span> const& spans,
                                              skity::Paint const& paint,
-                                             bool stroke, Rect const& bounds);
+                                             bool stroke, Rect const& bounds) {
+    return GenerateBrush(spans, paint, stroke, bounds, CurrentTransform());
+  }
+
+  /**
+   * @param transform  maps the local space the paint shader is defined in to
+   *                   the space of the spans, unused when drawing a layer
+   */
+  std::unique_ptr<SWSpanBrush> GenerateBrush(std::vector<Span> const& spans,
+                                             skity::Paint const& paint,
+                                             bool stroke, Rect const& bounds,
+                                             Matrix const& transform);
 
   State* CurrentState() { return &state_stack_.back(); }
 
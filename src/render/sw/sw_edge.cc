@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <utility>
 
+#include "src/geometry/conic.hpp"
 #include "src/geometry/geometry.hpp"
 #include "src/geometry/math.hpp"
 #include "src/graphic/path_priv.hpp"
@@ -87,6 +88,23 @@ bool SWEdge::CanBeIgnored(const Rect& scan_bounds, SWFixed y0,
   return false;
 }
 
+bool SWEdge::ClipTop(SWFixed start_y) {
+  if (lower_y <= start_y) {
+    return false;
+  }
+
+  if (upper_y < start_y) {
+    // GoY() computes x from the upper point the same way, so moving the upper
+    // point along the line does not change the rest of the walk
+    upper_x += SWFixedMul(dx, start_y - upper_y);
+    upper_y = start_y;
+  }
+
+  x = upper_x;
+  y = upper_y;
+  return true;
+}
+
 /*  We store 1<<shift in a (signed) byte, so its maximum value is 1<<6 == 64.
     Note that this limits the number of lines we use to approximate a curve.
     If we need to increase this, we need to store fCurveCount in something
@@ -296,24 +314,279 @@ void SWQuadEdge::KeepContinuous() {
   snapped_y = y;
 }
 
-int SWEdgeBuilder::BuildEdges(const Path& path, const Rect& scan_bounds) {
+bool SWQuadEdge::ClipTop(SWFixed start_y) {
+  // Unlike the walk, do not call KeepContinuous() here. The segments start at
+  // the exact points UpdateQuad() computed, no error was accumulated yet.
+  while (lower_y <= start_y) {
+    if (curve_count <= 0 || !UpdateQuad()) {
+      return false;
+    }
+  }
+
+  return SWEdge::ClipTop(start_y);
+}
+
+// The error of approximating a curve by n lines is at most max|P''| / (8n^2).
+// For a quad this is the distance SWQuadEdge::SetQuad() feeds diff_to_shift().
+// The second derivative of a cubic is linear, so its maximum is at one of the
+// ends, which gives the distance with the same error per subdivision.
+static inline SWFDot6 cubic_flatness(SWFDot6 x0, SWFDot6 y0, SWFDot6 x1,
+                                     SWFDot6 y1, SWFDot6 x2, SWFDot6 y2,
+                                     SWFDot6 x3, SWFDot6 y3) {
+  SWFDot6 start = cheap_distance(x0 - x1 - x1 + x2, y0 - y1 - y1 + y2);
+  SWFDot6 end = cheap_distance(x1 - x2 - x2 + x3, y1 - y2 - y2 + y3);
+
+  return std::max(start, end) * 3 / 4;
+}
+
+bool SWCubicEdge::SetCubic(const Point pts[4]) {
+  SWFDot6 x0, y0, x1, y1, x2, y2, x3, y3;
+
+  float scale = static_cast<float>(1 << (kDefaultAccuracy + 6));
+  x0 = static_cast<int>(pts[0].x * scale);
+  y0 = static_cast<int>(pts[0].y * scale);
+  x1 = static_cast<int>(pts[1].x * scale);
+  y1 = static_cast<int>(pts[1].y * scale);
+  x2 = static_cast<int>(pts[2].x * scale);
+  y2 = static_cast<int>(pts[2].y * scale);
+  x3 = static_cast<int>(pts[3].x * scale);
+  y3 = static_cast<int>(pts[3].y * scale);
+
+  int w = 1;
+  if (y0 > y3) {
+    std::swap(x0, x3);
+    std::swap(x1, x2);
+    std::swap(y0, y3);
+    std::swap(y1, y2);
+    w = -1;
+  }
+
+  int top = SWFDot6Round(y0);
+  int bottom = SWFDot6Round(y3);
+  if (top == bottom) {
+    return false;
+  }
+
+  int shift = diff_to_shift(
+      cubic_flatness(x0, y0, x1, y1, x2, y2, x3, y3), 0, kDefaultAccuracy);
+  // need at least 1 subdivision for our bias trick
+  if (shift == 0) {
+    shift = 1;
+  } else if (shift > MAX_COEFF_SHIFT) {
+    shift = MAX_COEFF_SHIFT;
+  }
+
+  // Since our in coefficient limit is 6 and we need 3 bits to subdivide the
+  // cubic 3 times, we have 6 bits left for the position
+  int up_shift = 6;  // largest safe value
+  int down_shift = shift + up_shift - 10;
+  if (down_shift < 0) {
+    down_shift = 0;
+    up_shift = 10 - shift;
+  }
+
+  winding = w;
+  curve_count = static_cast<int8_t>(-(1 << shift));
+  curve_shift = static_cast<uint8_t>(shift);
+  cubic_dshift = static_cast<uint8_t>(down_shift);
+
+  /*
+   *  p0 (1 - t)^3 + 3 p1 t(1 - t)^2 + 3 p2 t^2(1 - t) + p3 t^3
+   *    ==> Dt^3 + Ct^2 + Bt + A
+   *
+   *  B = 3(p1 - p0)
+   *  C = 3(p0 - 2p1 + p2)
+   *  D = p3 + 3(p1 - p2) - p0
+   *
+   *  The differences are forward-differenced with 1 / 2^shift steps, the
+   *  first one is kept up shifted to keep the precision of the small steps.
+   */
+  SWFixed B = SWLeftShift(3 * (x1 - x0), up_shift);
+  SWFixed C = SWLeftShift(3 * (x0 - x1 - x1 + x2), up_shift);
+  SWFixed D = SWLeftShift(x3 + 3 * (x1 - x2) - x0, up_shift);
+
+  cx = SWFDot6ToFixed(x0);
+  cdx = B + (C >> shift) + (D >> 2 * shift);  // biased by shift
+  cddx = 2 * C + (3 * D >> (shift - 1));      // biased by 2*shift
+  cdddx = 3 * D >> (shift - 1);               // biased by 2*shift
+
+  B = SWLeftShift(3 * (y1 - y0), up_shift);
+  C = SWLeftShift(3 * (y0 - y1 - y1 + y2), up_shift);
+  D = SWLeftShift(y3 + 3 * (y1 - y2) - y0, up_shift);
+
+  cy = SWFDot6ToFixed(y0);
+  cdy = B + (C >> shift) + (D >> 2 * shift);  // biased by shift
+  cddy = 2 * C + (3 * D >> (shift - 1));      // biased by 2*shift
+  cdddy = 3 * D >> (shift - 1);               // biased by 2*shift
+
+  c_last_x = SWFDot6ToFixed(x3);
+  c_last_y = SWFDot6ToFixed(y3);
+
+  cx >>= kDefaultAccuracy;
+  cy >>= kDefaultAccuracy;
+  cdx >>= kDefaultAccuracy;
+  cdy >>= kDefaultAccuracy;
+  cddx >>= kDefaultAccuracy;
+  cddy >>= kDefaultAccuracy;
+  cdddx >>= kDefaultAccuracy;
+  cdddy >>= kDefaultAccuracy;
+  c_last_x >>= kDefaultAccuracy;
+  c_last_y >>= kDefaultAccuracy;
+  cy = SnapY(cy);
+  c_last_y = SnapY(c_last_y);
+  c_first_y = cy;
+
+  snapped_x = cx;
+  snapped_y = cy;
+
+  return UpdateCubic();
+}
+
+bool SWCubicEdge::UpdateCubic() {
+  bool success = false;
+  int count = curve_count;
+  SWFixed oldy = cy;
+  SWFixed newx, newy, new_snapped_x, new_snapped_y;
+  const int ddshift = curve_shift;
+  const int dshift = cubic_dshift;
+
+  do {
+    SWFixed slope;
+    if (++count < 0) {
+      newx = cx + (cdx >> dshift);
+      cdx += cddx >> ddshift;
+      cddx += cdddx;
+
+      newy = oldy + (cdy >> dshift);
+      cdy += cddy >> ddshift;
+      cddy += cdddy;
+
+      // the cubic is monotonic in y, but the finite fixed point precision
+      // does not always keep it that way, so pin it here
+      if (newy < oldy) {
+        newy = oldy;
+      }
+
+      // same as SWQuadEdge::UpdateQuad()
+      if (newy - oldy >= SW_Fixed1 * 2) {  // only snap when dy is large enough
+        SWFDot6 diffY = SkFixedToFDot6(newy - snapped_y);
+        slope = diffY ? SWFDot6Div(SkFixedToFDot6(newx - snapped_x), diffY)
+                      : SW_MaxS32;
+        // The precision of new_snapped_y is 1 pixel
+        new_snapped_y = std::min<SWFixed>(c_last_y, SWFixedRoundToFixed(newy));
+        new_snapped_x = newx - SWFixedMul(slope, newy - new_snapped_y);
+      } else {
+        // The precision of new_snapped_y is 1/4 pixel
+        new_snapped_y = std::min(c_last_y, SnapY(newy));
+        new_snapped_x = newx;
+        SWFDot6 diffY = SkFixedToFDot6(new_snapped_y - snapped_y);
+        slope = diffY ? SWFDot6Div(SkFixedToFDot6(newx - snapped_x), diffY)
+                      : SW_MaxS32;
+      }
+    } else {  // last segment
+      newx = c_last_x;
+      newy = c_last_y;
+      new_snapped_y = newy;
+      new_snapped_x = newx;
+      SWFDot6 diffY = SkFixedToFDot6(newy - snapped_y);
+      slope = diffY ? SWFDot6Div(SkFixedToFDot6(newx - snapped_x), diffY)
+                    : SW_MaxS32;
+    }
+
+    if (slope < SW_MaxS32) {
+      success = this->UpdateLine(snapped_x, snapped_y, new_snapped_x,
+                                 new_snapped_y, slope);
+    }
+    cx = newx;
+    oldy = newy;
+    snapped_x = new_snapped_x;
+    snapped_y = new_snapped_y;
+  } while (count < 0 && !success);
+
+  cy = newy;
+  curve_count = static_cast<int8_t>(count);
+  return success;
+}
+
+void SWCubicEdge::KeepContinuous() {
+  snapped_x = x;
+  snapped_y = y;
+}
+
+bool SWCubicEdge::ClipTop(SWFixed start_y) {
+  while (lower_y <= start_y) {
+    if (curve_count >= 0 || !UpdateCubic()) {
+      return false;
+    }
+  }
+
+  return SWEdge::ClipTop(start_y);
+}
+
+int SWEdgeBuilder::BuildEdges(const Path& path, const Matrix& transform,
+                              const Rect& scan_bounds) {
+  bool identity = transform.IsIdentity();
+  Point pts[4];
+
   PathEdgeIter iter(path);
   while (auto e = iter.next()) {
+    int count = 0;
+    switch (e.edge) {
+      case skity::PathEdgeIter::Edge::kLine:
+        count = 2;
+        break;
+      case skity::PathEdgeIter::Edge::kQuad:
+      case skity::PathEdgeIter::Edge::kConic:
+        count = 3;
+        break;
+      case skity::PathEdgeIter::Edge::kCubic:
+        count = 4;
+        break;
+    }
+    if (identity) {
+      std::copy(e.points, e.points + count, pts);
+    } else {
+      transform.MapPoints(pts, e.points, count);
+    }
+
     switch (e.edge) {
       case skity::PathEdgeIter::Edge::kLine: {
-        AddLine(e.points, scan_bounds);
+        AddLine(pts, scan_bounds);
         break;
       }
       case skity::PathEdgeIter::Edge::kQuad: {
-        Point mono_x[5];
-        int n = ChopQuadAtYExtrema(e.points, mono_x);
+        Point mono_y[5];
+        int n = ChopQuadAtYExtrema(pts, mono_y);
         for (int i = 0; i <= n; i++) {
-          this->AddQuad(&mono_x[i * 2], scan_bounds);
+          this->AddQuad(&mono_y[i * 2], scan_bounds);
         }
         break;
       }
-      default:
+      case skity::PathEdgeIter::Edge::kConic: {
+        // An affine transform maps a conic to the conic of the mapped points
+        // with the same weight. Two quads per conic, as Stroke::QuadPath
+        // does.
+        constexpr uint32_t kPow2 = 1;
+        Point quads[1 + 2 * (1 << kPow2)];
+        Conic conic(pts, iter.conicWeight());
+        conic.ChopIntoQuadsPOW2(quads, kPow2);
+        for (uint32_t q = 0; q < (1 << kPow2); q++) {
+          Point mono_y[5];
+          int n = ChopQuadAtYExtrema(&quads[q * 2], mono_y);
+          for (int i = 0; i <= n; i++) {
+            this->AddQuad(&mono_y[i * 2], scan_bounds);
+          }
+        }
         break;
+      }
+      case skity::PathEdgeIter::Edge::kCubic: {
+        Point mono_y[10];
+        int n = ChopCubicAtYExtrema(pts, mono_y);
+        for (int i = 0; i <= n; i++) {
+          this->AddCubic(&mono_y[i * 3], scan_bounds);
+        }
+        break;
+      }
     }
   }
   return edges_.size();
@@ -335,4 +608,12 @@ void SWEdgeBuilder::AddQuad(const Point pts[], const Rect& scan_bounds) {
   }
 }
 
+void SWEdgeBuilder::AddCubic(const Point pts[], const Rect& scan_bounds) {
+  auto edge = std::make_unique<SWCubicEdge>();
+  if (edge->SetCubic(pts) &&
+      !edge->CanBeIgnored(scan_bounds, edge->c_first_y, edge->c_last_y)) {
+    edges_.push_back(std::move(edge));
+  }
+}
+
 }  // namespace skity
@@ -7,6 +7,7 @@
 #define SRC_RENDER_SW_SW_EDGE_HPP
 
 #include <memory>
+#include <skity/geometry/matrix.hpp>
 #include <skity/graphic/color.hpp>
 #include <skity/graphic/path.hpp>
 #include <vector>
@@ -60,6 +61,10 @@ struct SWEdge {
   bool SetLine(const Point& p0, const Point& p1);
   bool UpdateLine(SWFixed x0, SWFixed y0, SWFixed x1, SWFixed y1, SWFixed slop);
   bool CanBeIgnored(const Rect& scan_bounds, SWFixed y0, SWFixed y1) const;
+
+  // Move the top of the edge down to start_y, as if it had been walked there.
+  // Returns false if the edge ends at or above start_y.
+  bool ClipTop(SWFixed start_y);
 };
 
 struct SWQuadEdge : public SWEdge {
@@ -78,16 +83,50 @@ struct SWQuadEdge : public SWEdge {
   bool UpdateQuad();
 
   void KeepContinuous();
+
+  // Skip the line segments above start_y, then clip the one crossing it.
+  bool ClipTop(SWFixed start_y);
+};
+
+// Cubic edges are the ones with a negative curve_count, which counts up to 0
+// as the line segments are generated.
+struct SWCubicEdge : public SWEdge {
+  SWFixed cx, cy;
+  SWFixed cdx, cdy;
+  SWFixed cddx, cddy;
+  SWFixed cdddx, cdddy;
+  SWFixed c_first_y;
+  SWFixed c_last_x, c_last_y;
+  uint8_t cubic_dshift;
+
+  // snap y to integer points in the middle of the curve to accelerate AAA
+  // path filling, like SWQuadEdge
+  SWFixed snapped_x, snapped_y;
+
+  bool SetCubic(const Point pts[4]);
+
+  bool UpdateCubic();
+
+  void KeepContinuous();
+
+  // Skip the line segments above start_y, then clip the one crossing it.
+  bool ClipTop(SWFixed start_y);
 };
 
 class SWEdgeBuilder {
  public:
-  int BuildEdges(const Path& path, const Rect& scan_bounds);
+  /**
+   * Build the edges of the path mapped by transform. The points are mapped
+   * while the edges are built, so no transformed copy of the path is made.
+   */
+  int BuildEdges(const Path& path, const Matrix& transform,
+                 const Rect& scan_bounds);
   std::vector<std::unique_ptr<SWEdge>>& GetEdges() { return edges_; }
 
  private:
   void AddLine(const Point pts[], const Rect& scan_bounds);
   void AddQuad(const Point pts[], const Rect& scan_bounds);
+  void AddCubic(const Point pts[], const Rect& scan_bounds);
 
   std::vector<std::unique_ptr<SWEdge>> edges_;
 };
@@ -9,10 +9,12 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <skity/geometry/stroke.hpp>
 
 #include "src/logging.hpp"
 #include "src/tracing.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -632,6 +634,12 @@ void WalkEdges(SWEdge* prev_head, SWEdge* next_tail,
           if (!quadEdge->UpdateQuad()) {
             break;
           }
+        } else if (curr_edge->curve_count < 0) {
+          SWCubicEdge* cubicEdge = static_cast<SWCubicEdge*>(curr_edge);
+          cubicEdge->KeepContinuous();
+          if (!cubicEdge->UpdateCubic()) {
+            break;
+          }
         } else {
           break;
         }
@@ -703,6 +711,64 @@ static void SortEdges(std::vector<std::unique_ptr<SWEdge>>& edges) {
   }
 }
 
+// Move all edges down to start_y and drop the ones ending above it, so the
+// walk begins at the first visible row instead of the top of the path.
+static void ClipEdgesTop(std::vector<std::unique_ptr<SWEdge>>& edges,
+                         SWFixed start_y) {
+  auto it = std::remove_if(
+      edges.begin(), edges.end(), [start_y](std::unique_ptr<SWEdge>& edge) {
+        if (edge->upper_y >= start_y) {
+          return false;
+        }
+        if (edge->curve_count > 0) {
+          return !static_cast<SWQuadEdge*>(edge.get())->ClipTop(start_y);
+        }
+        if (edge->curve_count < 0) {
+          return !static_cast<SWCubicEdge*>(edge.get())->ClipTop(start_y);
+        }
+        return !edge->ClipTop(start_y);
+      });
+  edges.erase(it, edges.end());
+}
+
+// Bounds of the control points of the path mapped by transform, which contain
+// the mapped path, without making a transformed copy of it.
+static Rect MapPathBounds(const Path& path, const Matrix& transform) {
+  if (transform.IsIdentity()) {
+    return path.GetBounds();
+  }
+
+  if (transform.RectStaysRect()) {
+    return transform.MapRect(path.GetBounds());
+  }
+
+  const Point* pts = path.Points();
+  size_t count = path.CountPoints();
+  if (count == 0) {
+    return Rect::MakeEmpty();
+  }
+
+  // map the points in batches, one MapPoints call per batch
+  constexpr size_t kBatchSize = 64;
+  Point mapped[kBatchSize];
+
+  float left = std::numeric_limits<float>::max();
+  float top = std::numeric_limits<float>::max();
+  float right = std::numeric_limits<float>::lowest();
+  float bottom = std::numeric_limits<float>::lowest();
+  for (size_t start = 0; start < count; start += kBatchSize) {
+    size_t n = std::min(kBatchSize, count - start);
+    transform.MapPoints(mapped, pts + start, static_cast<int>(n));
+    for (size_t i = 0; i < n; i++) {
+      left = std::min(left, mapped[i].x);
+      top = std::min(top, mapped[i].y);
+      right = std::max(right, mapped[i].x);
+      bottom = std::max(bottom, mapped[i].y);
+    }
+  }
+  return Rect::MakeLTRB(left, top, right, bottom);
+}
+
 static void ProcessEdges(std::vector<std::unique_ptr<SWEdge>>& edges,
                          SWEdge& head, SWEdge& tail) {
   SortEdges(edges);
@@ -733,12 +799,7 @@ void SWRaster::RastePath(Path const& path, Matrix const& transform,
                          SpanBuilderDelegate* span_builder_delegate) {
   SKITY_TRACE_EVENT(SWRaster_RastePath);
 
-  Paint paint;
-  Stroke stroke(paint);
-  Path quad;
-  stroke.QuadPath(path, &quad);
-  Path transformed_path = quad.CopyWithMatrix(Matrix(transform));
-  Rect scan_bounds = transformed_path.GetBounds();
+  Rect scan_bounds = MapPathBounds(path, transform);
   bounds_ = Rect::MakeLTRB(
       std::floor(scan_bounds.Left()), std::floor(scan_bounds.Top()),
       std::ceil(scan_bounds.Right()), std::ceil(scan_bounds.Bottom()));
@@ -754,35 +815,38 @@ void SWRaster::RastePath(Path const& path, Matrix const& transform,
   }
 
   SWEdgeBuilder builder;
-  int count = builder.BuildEdges(transformed_path, scan_bounds);
+  int count = builder.BuildEdges(path, transform, scan_bounds);
   auto& edges = builder.GetEdges();
   if (count == 0) {
     return;
   }
+
+  int start_y = scan_bounds.Top();
+  int stop_y = scan_bounds.Bottom();
+  SWFixed left_bound = static_cast<uint32_t>(scan_bounds.Left()) << 16;
+  SWFixed right_bound = static_cast<uint32_t>(scan_bounds.Right()) << 16;
+
+  // the edges are sorted by their top, clip them first so the ones crossing
+  // start_y are ordered by their x there
+  if (start_y > bounds_.Top()) {
+    ClipEdgesTop(edges, SWIntToFixed(start_y));
+    if (edges.empty()) {
+      return;
+    }
+  }
+
   SWEdge head;
   SWEdge tail;
   ProcessEdges(edges, head, tail);
 
-  int start_y;
-  int stop_y;
-  SWFixed left_bound;
-  SWFixed right_bound;
   SpanBuilder span_builder(bounds_.Left(), bounds_.Width(), scan_bounds,
                            span_builder_delegate);
 
-  // It makes more sense to start scanning from scan_bounds.Top(), but currently
-  // WalkEdges does not support it. If we start from scan_bounds.Top(), the
-  // order of edges needs to be rearranged, and the logic of updating quad
-  // also needs to be modified.
-  start_y = bounds_.Top();
-  stop_y = scan_bounds.Bottom();
-  left_bound = static_cast<uint32_t>(scan_bounds.Left()) << 16;
-  right_bound = static_cast<uint32_t>(scan_bounds.Right()) << 16;
-
   WalkEdges(&head, &tail, path.GetFillType(), &span_builder, start_y, stop_y,
             left_bound, right_bound);
   span_builder.Flush();
   spans_ = span_builder.TakeSpans();
+  AddRenderCounter(RenderCounter::kRasterSpan, spans_.size());
 }
 
 }  // namespace skity
@@ -7,7 +7,9 @@
 #include <skity/effect/color_filter.hpp>
 #include <skity/graphic/bitmap.hpp>
 
+#include "src/effect/color_filter_base.hpp"
 #include "src/geometry/geometry.hpp"
+#include "src/graphic/blend_mode_priv.hpp"
 #include "src/graphic/color_priv.hpp"
 #include "src/tracing.hpp"
 
@@ -105,6 +107,12 @@ void SWSpanBrush::Brush() {
   OnPostBrush();
 }
 
+void SWSpanBrush::FilterColors(PMColor* colors, int32_t count) const {
+  if (color_filter_ && count > 0) {
+    As_CFB(color_filter_)->OnFilterColors(colors, static_cast<size_t>(count));
+  }
+}
+
 void SWSpanBrush::BrushH(int32_t x, int32_t y, int32_t length, int32_t alpha) {
   if (length == 1 || PureColor()) {
     PMColor color = CalculateColor(x, y);
@@ -126,13 +134,11 @@ void SWSpanBrush::BrushH(int32_t x, int32_t y, int32_t length, int32_t alpha) {
         color = AlphaMulQ(color, alpha);
       }
 
-      if (color_filter_) {
-        color = color_filter_->FilterColor(color);
-      }
-
       pm_colors[l] = color;
     }
 
+    FilterColors(pm_colors.data(), length);
+
     render_target_.BlendPixelH(x, y, pm_colors.data(), length, blend_);
   }
 }
@@ -696,6 +702,7 @@ void PixmapBrush::BrushH(int32_t x, int32_t y, int32_t length, int32_t alpha) {
       std::swap(src.val[0], src.val[2]);  // RGBA -> BGRA
     }
     vst4_u8(reinterpret_cast<uint8_t*>(colors.data()), src);
+    FilterColors(colors.data(), N);
 
     GetRenderTarget().BlendPixelH(x + l, y, colors.data(), N, GetBlendMode());
   }
@@ -708,4 +715,44 @@ void PixmapBrush::BrushH(int32_t x, int32_t y, int32_t length, int32_t alpha) {
 #endif
 }
 
+VertexColorBrush::VertexColorBrush(std::vector<Span> const& spans,
+                                   Bitmap* bitmap, ColorFilter* color_filter,
+                                   BlendMode blend, float global_alpha,
+                                   const Vec2 device_pos[3],
+                                   const Color colors[3],
+                                   SWSpanBrush* shader_brush,
+                                   BlendMode shader_mode)
+    : SWSpanBrush(spans, bitmap, color_filter, blend, global_alpha),
+      origin_(device_pos[0]),
+      colors_({Color4fFromColor(colors[0]), Color4fFromColor(colors[1]),
+               Color4fFromColor(colors[2])}),
+      shader_brush_(shader_brush),
+      shader_mode_(shader_mode) {
+  Vec2 e1 = device_pos[1] - device_pos[0];
+  Vec2 e2 = device_pos[2] - device_pos[0];
+  float det = CrossProduct(e1, e2);
+  float inv_det = det != 0.f ? 1.f / det : 0.f;
+
+  weight_1_ = Vec2{e2.y, -e2.x} * inv_det;
+  weight_2_ = Vec2{-e1.y, e1.x} * inv_det;
+}
+
+Color VertexColorBrush::CalculateColor(int32_t x, int32_t y) {
+  Vec2 offset = Vec2{x + 0.5f, y + 0.5f} - origin_;
+
+  float w1 = std::clamp(Vec2::Dot(offset, weight_1_), 0.f, 1.f);
+  float w2 = std::clamp(Vec2::Dot(offset, weight_2_), 0.f, 1.f - w1);
+  float w0 = 1.f - w1 - w2;
+
+  Color4f color = colors_[0] * w0 + colors_[1] * w1 + colors_[2] * w2;
+  PMColor vertex_color = ColorToPMColor(Color4fToColor(color));
+
+  if (shader_brush_ == nullptr) {
+    return vertex_color;
+  }
+
+  return PorterDuffBlend(shader_brush_->ColorAt(x, y), vertex_color,
+                         shader_mode_);
+}
+
 }  // namespace skity
@@ -39,6 +39,12 @@ class SWSpanBrush {
 
   void Brush();
 
+  /**
+   * The premultiplied color of the pixel before coverage, color filter and
+   * blending are applied.
+   */
+  Color ColorAt(int32_t x, int32_t y) { return CalculateColor(x, y); }
+
  protected:
   // premultiplied color
   virtual Color CalculateColor(int32_t x, int32_t y) = 0;
@@ -55,6 +61,11 @@ class SWSpanBrush {
 
   SWRenderTarget& GetRenderTarget() { return render_target_; }
 
+  /**
+   * Applies the color filter, if any, to a span of premultiplied colors.
+   */
+  void FilterColors(PMColor* colors, int32_t count) const;
+
   virtual void BrushH(int32_t x, int32_t y, int32_t length, int32_t alpha);
 
   virtual void OnPreBrush() {}
@@ -132,6 +143,38 @@ class PixmapBrush : public SWSpanBrush {
   BitmapSampler bitmap_sampler_;
 };
 
+/**
+ * Fills one triangle of a DrawVertices call with its unpremultiplied vertex
+ * colors interpolated at the pixel centers.
+ *
+ * If a shader brush is given its color is combined with the interpolated one
+ * by `shader_mode`, the shader being the source. Only the modes up to
+ * BlendMode::kScreen are supported.
+ */
+class VertexColorBrush : public SWSpanBrush {
+ public:
+  VertexColorBrush(std::vector<Span> const& spans, Bitmap* bitmap,
+                   ColorFilter* color_filter, BlendMode blend,
+                   float global_alpha, const Vec2 device_pos[3],
+                   const Color colors[3], SWSpanBrush* shader_brush,
+                   BlendMode shader_mode);
+
+  ~VertexColorBrush() override = default;
+
+ protected:
+  Color CalculateColor(int32_t x, int32_t y) override;
+
+ private:
+  Vec2 origin_;
+  // dot products with the offset from origin_ give the weights of the second
+  // and the third vertex
+  Vec2 weight_1_;
+  Vec2 weight_2_;
+  std::array<Color4f, 3> colors_;
+  SWSpanBrush* shader_brush_;
+  BlendMode shader_mode_;
+};
+
 }  // namespace skity
 
 #endif  // SRC_RENDER_SW_SW_SPAN_BRUSH_HPP
@@ -12,6 +12,7 @@
 #include "src/render/text/sdf_gen.hpp"
 #include "src/render/text/text_render_control.hpp"
 #include "src/tracing.hpp"
+#include "src/utils/render_counters.hpp"
 
 namespace skity {
 
@@ -118,11 +119,13 @@ GlyphRegion Atlas::GetGlyphRegion(const Font& font, GlyphID glyph_id,
       AtlasBitmap* memory_atlas = atlas_bitmap_[index].get();
       auto region = memory_atlas->GetGlyphRegion(key);
       if (region != INVALID_LOC) {
+        AddRenderCounter(RenderCounter::kGlyphCacheHit, 1);
         return GlyphRegion{index, region, sdf_scale};
       }
     }
   }
 
+  AddRenderCounter(RenderCounter::kGlyphCacheMiss, 1);
   GlyphRegion gen_region = GenerateGlyphRegion(font, key, paint, load_sdf);
   return GlyphRegion{gen_region.index_in_group, gen_region.loc, sdf_scale};
 }
@@ -291,6 +294,10 @@ void Atlas::UploadAtlas(uint32_t group_index) {
             atlas_config_.max_bitmap_size, dirty_rect->w - dirty_rect->y,
             mem_data + atlas_config_.max_bitmap_size * dirty_rect->y *
                            bytes_per_pixel_);
+        AddRenderCounter(RenderCounter::kAtlasUploadBytes,
+                         atlas_config_.max_bitmap_size *
+                             (dirty_rect->w - dirty_rect->y) *
+                             bytes_per_pixel_);
         atlas_bitmap_[index]->SetAllClean();
       }
     }
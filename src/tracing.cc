@@ -52,6 +52,12 @@ ScopedTraceEvent::~ScopedTraceEvent() {
   }
 }
 
+void TraceCounter(const char* name, uint64_t value) {
+  if (g_trace_handler.counter) {
+    g_trace_handler.counter(SKITY_TRACE_CATEGORY, name, value, false);
+  }
+}
+
 #endif
 
 }  // namespace skity
@@ -23,6 +23,9 @@ class ScopedTraceEvent {
 
 #define SKITY_TRACE_EVENT(name) ScopedTraceEvent name(#name, -1)
 
+// report the absolute value of a counter to the injected trace handler
+void TraceCounter(const char* name, uint64_t value);
+
 #else
 
 #define SKITY_TRACE_EVENT(...)
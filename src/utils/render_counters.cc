@@ -0,0 +1,73 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/utils/render_counters.hpp"
+
+#include "src/tracing.hpp"
+
+namespace skity {
+
+thread_local FrameStats g_thread_render_counters;
+
+float FrameStats::GlyphCacheHitRate() const {
+  uint64_t hit = Get(RenderCounter::kGlyphCacheHit);
+  uint64_t total = hit + Get(RenderCounter::kGlyphCacheMiss);
+
+  if (total == 0) {
+    return 0.f;
+  }
+
+  return static_cast<float>(hit) / static_cast<float>(total);
+}
+
+FrameStats& FrameStats::operator+=(const FrameStats& other) {
+  for (size_t i = 0; i < kRenderCounterCount; i++) {
+    counters[i] += other.counters[i];
+  }
+
+  return *this;
+}
+
+const char* FrameStats::GetCounterName(RenderCounter counter) {
+  switch (counter) {
+    case RenderCounter::kGlyphCacheHit:
+      return "GlyphCacheHit";
+    case RenderCounter::kGlyphCacheMiss:
+      return "GlyphCacheMiss";
+    case RenderCounter::kAtlasUploadBytes:
+      return "AtlasUploadBytes";
+    case RenderCounter::kStageVertexBytes:
+      return "StageVertexBytes";
+    case RenderCounter::kStageIndexBytes:
+      return "StageIndexBytes";
+    case RenderCounter::kPipelineCreated:
+      return "PipelineCreated";
+    case RenderCounter::kRenderTargetAllocated:
+      return "RenderTargetAllocated";
+    case RenderCounter::kRasterSpan:
+      return "RasterSpan";
+    case RenderCounter::kDrawCulled:
+      return "DrawCulled";
+    case RenderCounter::kCount:
+      break;
+  }
+
+  return "";
+}
+
+FrameStats CollectRenderCounters() {
+  FrameStats stats = g_thread_render_counters;
+  g_thread_render_counters = FrameStats{};
+
+#ifdef SKITY_ENABLE_TRACING
+  for (size_t i = 0; i < kRenderCounterCount; i++) {
+    TraceCounter(FrameStats::GetCounterName(static_cast<RenderCounter>(i)),
+                 stats.counters[i]);
+  }
+#endif
+
+  return stats;
+}
+
+}  // namespace skity
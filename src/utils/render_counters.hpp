@@ -0,0 +1,30 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SRC_UTILS_RENDER_COUNTERS_HPP
+#define SRC_UTILS_RENDER_COUNTERS_HPP
+
+#include <skity/render/frame_stats.hpp>
+
+namespace skity {
+
+/**
+ * Counters of the calling thread since they were last collected. Each thread
+ * owns its counters, so hot paths update them without any synchronization.
+ */
+extern thread_local FrameStats g_thread_render_counters;
+
+inline void AddRenderCounter(RenderCounter counter, uint64_t value) {
+  g_thread_render_counters.counters[static_cast<size_t>(counter)] += value;
+}
+
+/**
+ * Take and reset the counters of the calling thread. The values are also
+ * reported to the trace counter hook when tracing is enabled.
+ */
+FrameStats CollectRenderCounters();
+
+}  // namespace skity
+
+#endif  // SRC_UTILS_RENDER_COUNTERS_HPP
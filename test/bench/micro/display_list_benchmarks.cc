@@ -0,0 +1,51 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <benchmark/benchmark.h>
+
+#include <skity/recorder/picture_recorder.hpp>
+#include <skity/skity.hpp>
+
+static std::unique_ptr<skity::DisplayList> RecordRectGrid(bool build_rtree) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 4000, 4000),
+                          build_rtree);
+  auto canvas = recorder.GetRecordingCanvas();
+  skity::Paint paint;
+  for (int32_t i = 0; i < 100; i++) {
+    for (int32_t j = 0; j < 100; j++) {
+      paint.SetColor(skity::ColorSetARGB(0xFF, i * 2, j * 2, 0x80));
+      canvas->Save();
+      canvas->Translate(i * 40, j * 40);
+      canvas->DrawRect(skity::Rect::MakeXYWH(4, 4, 32, 32), paint);
+      canvas->Restore();
+    }
+  }
+  return recorder.FinishRecording();
+}
+
+// Replay a 256x256 tile out of a 4000x4000 recording.
+static void DrawTile(benchmark::State& state, bool build_rtree) {
+  auto display_list = RecordRectGrid(build_rtree);
+  skity::Bitmap bitmap(256, 256, skity::AlphaType::kPremul_AlphaType);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+
+  for (auto _ : state) {
+    canvas->Save();
+    canvas->ClipRect(skity::Rect::MakeWH(256, 256));
+    canvas->Translate(-1800, -1800);
+    display_list->Draw(canvas.get());
+    canvas->Restore();
+  }
+}
+
+static void BM_DisplayListDrawTile(benchmark::State& state) {
+  DrawTile(state, false);
+}
+BENCHMARK(BM_DisplayListDrawTile)->Unit(benchmark::kMicrosecond);
+
+static void BM_DisplayListDrawTileWithRTree(benchmark::State& state) {
+  DrawTile(state, true);
+}
+BENCHMARK(BM_DisplayListDrawTileWithRTree)->Unit(benchmark::kMicrosecond);
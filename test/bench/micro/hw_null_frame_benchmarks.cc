@@ -0,0 +1,314 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <skity/skity.hpp>
+#include <vector>
+
+#include "src/gpu/null/gpu_context_impl_null.hpp"
+#include "test/bench/case/draw_circle.hpp"
+
+#ifdef SKITY_MICRO_BENCH_SKP
+#include "test/bench/case/draw_skp.hpp"
+#endif
+
+// Measure the CPU cost of preparing a whole frame in the HW renderer, from
+// recording the canvas calls to encoding the render passes. The null backend
+// stands in for the GPU, so the numbers do not depend on a driver and the
+// recorded draw calls and uploaded bytes are reported as counters.
+
+namespace {
+
+enum Scene : int64_t {
+  kFillCircles = 0,
+  kStrokeCircles,
+  kLayers,
+  kMeshVertices,
+  kMeshPaths,
+  kBlurRRects,
+  kBlurPaths,
+  kTiger1000,
+  kTiger2000,
+};
+
+enum AAType : int64_t {
+  kNoAA = 0,
+  kMSAA,
+  kContourAA,
+};
+
+// Nested translucent layers, each one needs its own render pass and is drawn
+// back into its parent.
+class DrawLayersBenchmark : public skity::Benchmark {
+ public:
+  Size GetSize() override { return {1024, 1024}; }
+
+  std::string GetName() override { return "Layers"; }
+
+ protected:
+  void OnDraw(skity::Canvas* canvas, int index) override {
+    canvas->Clear(0xFFFFFFFF);
+
+    skity::Paint paint;
+    paint.SetAntiAlias(true);
+
+    for (int32_t i = 0; i < 16; i++) {
+      float x = static_cast<float>(i % 4) * 256.f;
+      float y = static_cast<float>(i / 4) * 256.f;
+
+      skity::Paint layer_paint;
+      layer_paint.SetAlphaF(0.5f);
+      canvas->SaveLayer(skity::Rect::MakeXYWH(x, y, 256.f, 256.f),
+                        layer_paint);
+
+      for (int32_t j = 0; j < 64; j++) {
+        paint.SetColor(skity::ColorSetARGB(0xFF, j * 4, i * 16, 0x80));
+        canvas->DrawRRect(
+            skity::RRect::MakeRectXY(
+                skity::Rect::MakeXYWH(x + (j % 8) * 32.f, y + (j / 8) * 32.f,
+                                      28.f, 28.f),
+                6.f, 6.f),
+            paint);
+      }
+
+      canvas->Restore();
+    }
+  }
+};
+
+// A 64x64 grid of colored quads, either as one DrawVertices call or as one
+// path per triangle.
+class DrawMeshBenchmark : public skity::Benchmark {
+ public:
+  explicit DrawMeshBenchmark(bool as_paths) : as_paths_(as_paths) {
+    constexpr uint32_t kCells = 64;
+    std::vector<skity::Vec2> positions;
+    std::vector<skity::Color> colors;
+    for (uint32_t y = 0; y <= kCells; y++) {
+      for (uint32_t x = 0; x <= kCells; x++) {
+        positions.push_back(skity::Vec2{x * 16.f, y * 16.f});
+        colors.push_back(skity::ColorSetARGB(0xFF, x * 4, y * 4, 0x80));
+      }
+    }
+
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < kCells; y++) {
+      for (uint32_t x = 0; x < kCells; x++) {
+        uint32_t i = y * (kCells + 1) + x;
+        uint32_t quad[] = {i, i + 1, i + kCells + 1, i + 1, i + kCells + 2,
+                           i + kCells + 1};
+        indices.insert(indices.end(), quad, quad + 6);
+      }
+    }
+
+    mesh_ = skity::Vertices::MakeCopy(
+        skity::Vertices::VertexMode::kTriangles,
+        static_cast<uint32_t>(positions.size()), positions.data(), nullptr,
+        colors.data(), static_cast<uint32_t>(indices.size()), indices.data());
+  }
+
+  Size GetSize() override { return {1024, 1024}; }
+
+  std::string GetName() override {
+    return as_paths_ ? "MeshPaths" : "MeshVertices";
+  }
+
+ protected:
+  void OnDraw(skity::Canvas* canvas, int index) override {
+    canvas->Clear(0xFFFFFFFF);
+
+    if (!as_paths_) {
+      canvas->DrawVertices(mesh_, skity::BlendMode::kModulate, skity::Paint{});
+      return;
+    }
+
+    const skity::Vec2* p = mesh_->Positions();
+    for (uint32_t t = 0; t < mesh_->TriangleCount(); t++) {
+      const uint32_t* i = mesh_->Indices() + t * 3;
+      skity::Path path;
+      path.MoveTo(p[i[0]].x, p[i[0]].y);
+      path.LineTo(p[i[1]].x, p[i[1]].y);
+      path.LineTo(p[i[2]].x, p[i[2]].y);
+      path.Close();
+
+      skity::Paint paint;
+      paint.SetColor(mesh_->Colors()[i[0]]);
+      canvas->DrawPath(path, paint);
+    }
+  }
+
+ private:
+  bool as_paths_;
+  std::shared_ptr<skity::Vertices> mesh_;
+};
+
+// An 8x8 grid of card shadows, rects and rrects blurred by a mask filter.
+// Drawn as rrects they all take the analytic blur. Drawn as paths, the rrects
+// are rendered offscreen and blurred, the rect paths are still recognized.
+class DrawBlurBenchmark : public skity::Benchmark {
+ public:
+  explicit DrawBlurBenchmark(bool as_paths) : as_paths_(as_paths) {}
+
+  Size GetSize() override { return {1024, 1024}; }
+
+  std::string GetName() override {
+    return as_paths_ ? "BlurPaths" : "BlurRRects";
+  }
+
+ protected:
+  void OnDraw(skity::Canvas* canvas, int index) override {
+    canvas->Clear(0xFFFFFFFF);
+
+    skity::Paint paint;
+    paint.SetAntiAlias(true);
+    paint.SetColor(skity::ColorSetARGB(0x60, 0, 0, 0));
+    paint.SetMaskFilter(
+        skity::MaskFilter::MakeBlur(skity::BlurStyle::kNormal, 8.f));
+
+    for (int32_t i = 0; i < 64; i++) {
+      auto rect = skity::Rect::MakeXYWH((i % 8) * 128.f + 16.f,
+                                        (i / 8) * 128.f + 16.f, 96.f, 72.f);
+      float radius = i % 2 == 0 ? 0.f : 12.f;
+      auto rrect = skity::RRect::MakeRectXY(rect, radius, radius);
+
+      if (as_paths_) {
+        skity::Path path;
+        path.AddRRect(rrect);
+        canvas->DrawPath(path, paint);
+      } else {
+        canvas->DrawRRect(rrect, paint);
+      }
+    }
+  }
+
+ private:
+  bool as_paths_;
+};
+
+std::shared_ptr<skity::Benchmark> MakeScene(Scene scene) {
+  switch (scene) {
+    case kFillCircles:
+      return std::make_shared<skity::DrawCircleBenchmark>(1000, 32, false);
+    case kStrokeCircles: {
+      auto benchmark =
+          std::make_shared<skity::DrawCircleBenchmark>(1000, 32, false);
+      benchmark->SetStroke(true);
+      benchmark->SetStrokeWidth(10);
+      return benchmark;
+    }
+    case kLayers:
+      return std::make_shared<DrawLayersBenchmark>();
+    case kMeshVertices:
+      return std::make_shared<DrawMeshBenchmark>(false);
+    case kMeshPaths:
+      return std::make_shared<DrawMeshBenchmark>(true);
+    case kBlurRRects:
+      return std::make_shared<DrawBlurBenchmark>(false);
+    case kBlurPaths:
+      return std::make_shared<DrawBlurBenchmark>(true);
+#ifdef SKITY_MICRO_BENCH_SKP
+    case kTiger1000:
+      return std::make_shared<skity::DrawSKPBenchmark>(
+          "Tiger_1000", RESOURCES_DIR "/skp/tiger.skp", 1000, 1000,
+          skity::Matrix::Translate(-130, 20));
+    case kTiger2000:
+      return std::make_shared<skity::DrawSKPBenchmark>(
+          "Tiger_2000", RESOURCES_DIR "/skp/tiger.skp", 2000, 2000,
+          skity::Matrix::Scale(2, 2) * skity::Matrix::Translate(-130, 20));
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const char* GetAALabel(AAType aa) {
+  switch (aa) {
+    case kNoAA:
+      return "NoAA";
+    case kMSAA:
+      return "MSAA";
+    case kContourAA:
+      return "ContourAA";
+  }
+  return "";
+}
+
+void DrawFrame(skity::GPUSurface* surface, skity::Benchmark* scene) {
+  auto canvas = surface->LockCanvas();
+  scene->Draw(canvas, 0);
+  canvas->Flush();
+  surface->Flush();
+}
+
+}  // namespace
+
+static void BM_HWNullFrame(benchmark::State& state) {
+  auto scene = MakeScene(static_cast<Scene>(state.range(0)));
+  auto aa = static_cast<AAType>(state.range(1));
+
+  if (scene == nullptr) {
+    state.SkipWithError("Scene not available in this build");
+    return;
+  }
+
+  auto context = skity::NullContextCreate();
+  if (context == nullptr) {
+    state.SkipWithError("Create null GPUContext failed");
+    return;
+  }
+
+  context->SetEnableContourAA(aa == kContourAA);
+
+  skity::GPUSurfaceDescriptor desc{};
+  desc.backend = skity::GPUBackendType::kNone;
+  desc.width = scene->GetSize().width;
+  desc.height = scene->GetSize().height;
+  desc.sample_count = aa == kMSAA ? 4 : 1;
+  desc.content_scale = 1.f;
+
+  auto surface = context->CreateSurface(&desc);
+  if (surface == nullptr) {
+    state.SkipWithError("Create null GPUSurface failed");
+    return;
+  }
+
+  state.SetLabel(scene->GetName() + "_" + GetAALabel(aa));
+
+  // the first frame creates the pipelines and fills the caches, only the
+  // steady state is measured
+  DrawFrame(surface.get(), scene.get());
+  context->ResetStats();
+
+  for (auto _ : state) {
+    DrawFrame(surface.get(), scene.get());
+  }
+
+  const auto& stats = context->GetStats();
+
+  auto average = [&](double value) {
+    return benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+  };
+
+  state.counters["draws"] = average(stats.draw_call_count);
+  state.counters["passes"] = average(stats.render_pass_count);
+  state.counters["pipeline_switches"] = average(stats.pipeline_switch_count);
+  state.counters["buffer_bytes"] = average(stats.buffer_upload_bytes);
+  state.counters["texture_bytes"] = average(stats.texture_upload_bytes);
+  state.counters["new_pipelines"] = average(stats.pipeline_count);
+}
+
+BENCHMARK(BM_HWNullFrame)
+    ->ArgsProduct({
+        {kFillCircles, kStrokeCircles, kLayers, kMeshVertices, kMeshPaths,
+         kBlurRRects, kBlurPaths,
+#ifdef SKITY_MICRO_BENCH_SKP
+         kTiger1000, kTiger2000,
+#endif
+        },
+        {kNoAA, kMSAA, kContourAA},
+    })
+    ->ArgNames({"scene", "aa"})
+    ->Unit(benchmark::kMicrosecond);
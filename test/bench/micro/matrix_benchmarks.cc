@@ -5,6 +5,7 @@
 #include <benchmark/benchmark.h>
 
 #include <random>
+#include <vector>
 #include <skity/skity.hpp>
 
 static void BM_MatrixMultiply(benchmark::State& state) {
@@ -152,3 +153,132 @@ static void BM_MatrixMapPoints2(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_MatrixMapPoints2)->Unit(benchmark::kMicrosecond);
+
+namespace {
+
+enum MatrixClass : int64_t {
+  kIdentity = 0,
+  kTranslate,
+  kScaleTranslate,
+  kAffine,
+  kPerspective,
+};
+
+skity::Matrix MakeMatrix(MatrixClass type) {
+  switch (type) {
+    case kIdentity:
+      return skity::Matrix();
+    case kTranslate:
+      return skity::Matrix::Translate(13.f, -7.f);
+    case kScaleTranslate:
+      return skity::Matrix::Translate(13.f, -7.f) *
+             skity::Matrix::Scale(1.5f, 0.75f);
+    case kAffine:
+      return skity::Matrix::RotateDeg(30.f, skity::Vec2{100.f, 100.f});
+    case kPerspective: {
+      skity::Matrix m = skity::Matrix::Translate(13.f, -7.f);
+      m.SetPersp0(0.0001f);
+      m.SetPersp1(-0.0002f);
+      return m;
+    }
+  }
+  return skity::Matrix();
+}
+
+const char* GetMatrixClassLabel(MatrixClass type) {
+  switch (type) {
+    case kIdentity:
+      return "Identity";
+    case kTranslate:
+      return "Translate";
+    case kScaleTranslate:
+      return "ScaleTranslate";
+    case kAffine:
+      return "Affine";
+    case kPerspective:
+      return "Perspective";
+  }
+  return "";
+}
+
+}  // namespace
+
+// Map a batch of 1000 points with one matrix of each transform class, the
+// way Path::CopyWithMatrix and the software rasterizer use it.
+static void BM_MatrixMapPointsByType(benchmark::State& state) {
+  auto type = static_cast<MatrixClass>(state.range(0));
+  skity::Matrix m = MakeMatrix(type);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+  std::vector<skity::Point> src(1000);
+  std::vector<skity::Point> dst(1000);
+  for (auto& p : src) {
+    p = skity::Point(dist(rng), dist(rng), 0.f, 1.f);
+  }
+
+  state.SetLabel(GetMatrixClassLabel(type));
+
+  for (auto _ : state) {
+    m.MapPoints(dst.data(), src.data(), static_cast<int>(src.size()));
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_MatrixMapPointsByType)
+    ->DenseRange(kIdentity, kPerspective)
+    ->ArgName("type");
+
+static void BM_MatrixMapVec2ByType(benchmark::State& state) {
+  auto type = static_cast<MatrixClass>(state.range(0));
+  skity::Matrix m = MakeMatrix(type);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+  std::vector<skity::Vec2> src(1000);
+  std::vector<skity::Vec2> dst(1000);
+  for (auto& p : src) {
+    p = skity::Vec2(dist(rng), dist(rng));
+  }
+
+  state.SetLabel(GetMatrixClassLabel(type));
+
+  for (auto _ : state) {
+    m.MapPoints(dst.data(), src.data(), static_cast<int>(src.size()));
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_MatrixMapVec2ByType)
+    ->DenseRange(kIdentity, kPerspective)
+    ->ArgName("type");
+
+static void BM_MatrixMapRectByType(benchmark::State& state) {
+  auto type = static_cast<MatrixClass>(state.range(0));
+  skity::Matrix m = MakeMatrix(type);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(.0f, 1000.0f);
+  skity::Rect src[1000];
+  skity::Rect dst[1000];
+  for (auto& r : src) {
+    r = skity::Rect::MakeXYWH(dist(rng), dist(rng), dist(rng), dist(rng));
+  }
+
+  state.SetLabel(GetMatrixClassLabel(type));
+
+  for (auto _ : state) {
+    for (int32_t i = 0; i < 1000; i++) {
+      m.MapRect(&dst[i], src[i]);
+    }
+    benchmark::DoNotOptimize(dst);
+  }
+}
+BENCHMARK(BM_MatrixMapRectByType)
+    ->DenseRange(kIdentity, kPerspective)
+    ->ArgName("type")
+    ->Unit(benchmark::kMicrosecond);
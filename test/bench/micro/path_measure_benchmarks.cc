@@ -0,0 +1,79 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <benchmark/benchmark.h>
+
+#include <skity/skity.hpp>
+#include <vector>
+
+// A wavy path of the given number of cubics, like a motion path.
+static skity::Path MakeMotionPath(int64_t curves) {
+  skity::Path path;
+  path.MoveTo(0, 0);
+  for (int64_t i = 0; i < curves; i++) {
+    float x = i * 30.f;
+    path.CubicTo(x + 10, (i % 2) ? -40 : 40, x + 20, (i % 3) ? 30 : -30,
+                 x + 30, 0);
+  }
+  return path;
+}
+
+// Samples 64 points of the path per frame, measuring it every frame the way
+// a fresh PathMeasure does.
+static void BM_PathMeasureRemeasure(benchmark::State& state) {
+  skity::Path path = MakeMotionPath(state.range(0));
+
+  skity::Point position;
+  skity::Vector tangent;
+  for (auto _ : state) {
+    skity::PathMeasure meas{path, false};
+    float step = meas.GetLength() / 64;
+    for (int32_t i = 0; i < 64; i++) {
+      meas.GetPosTan(i * step, &position, &tangent);
+    }
+    benchmark::DoNotOptimize(position);
+  }
+}
+BENCHMARK(BM_PathMeasureRemeasure)
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
+
+// The lookup of a path measured with the cache in an earlier frame.
+static void BM_MeasuredPathCacheHit(benchmark::State& state) {
+  skity::Path path = MakeMotionPath(state.range(0));
+  skity::MeasuredPath::Make(path, false, 1.f, true);
+
+  for (auto _ : state) {
+    auto measured = skity::MeasuredPath::Make(path, false, 1.f, true);
+    benchmark::DoNotOptimize(measured.get());
+  }
+}
+BENCHMARK(BM_MeasuredPathCacheHit)
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
+
+// The same samples from the measure of the first frame.
+static void BM_MeasuredPathSample(benchmark::State& state) {
+  skity::Path path = MakeMotionPath(state.range(0));
+  auto measured = skity::MeasuredPath::Make(path, false);
+
+  std::vector<float> distances(64);
+  for (size_t i = 0; i < distances.size(); i++) {
+    distances[i] = i * measured->GetLength() / distances.size();
+  }
+
+  std::vector<skity::Point> positions(distances.size());
+  std::vector<skity::Vector> tangents(distances.size());
+  for (auto _ : state) {
+    measured->GetPosTans(distances.data(), distances.size(), positions.data(),
+                         tangents.data());
+    benchmark::DoNotOptimize(positions.data());
+  }
+}
+BENCHMARK(BM_MeasuredPathSample)
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
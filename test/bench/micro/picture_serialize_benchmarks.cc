@@ -0,0 +1,98 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <benchmark/benchmark.h>
+
+#include <skity/io/picture.hpp>
+#include <skity/recorder/picture_recorder.hpp>
+#include <skity/skity.hpp>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// Counts the serialized bytes without keeping them, so the memory measured is
+// the one used by the serializer itself.
+class NullWriteStream : public skity::WriteStream {
+ public:
+  bool Write(void const* buffer, size_t size) override {
+    bytes_written_ += size;
+    return true;
+  }
+
+  bool Flush() override { return true; }
+
+  size_t BytesWritten() const override { return bytes_written_; }
+
+ private:
+  size_t bytes_written_ = 0;
+};
+
+// A recording with `count` distinct paths and paints, the shape of a large
+// vector document.
+std::unique_ptr<skity::Picture> RecordLargePicture(int32_t count) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeWH(4000, 4000));
+  auto canvas = recorder.GetRecordingCanvas();
+  skity::Paint paint;
+  paint.SetAntiAlias(true);
+  for (int32_t i = 0; i < count; i++) {
+    float x = static_cast<float>(i % 100) * 40.f;
+    float y = static_cast<float>(i / 100 % 100) * 40.f;
+    skity::Path path;
+    path.MoveTo(x, y);
+    for (int32_t j = 0; j < 16; j++) {
+      path.QuadTo(x + j * 2.f, y + 20.f + (i + j) % 7, x + j * 2.f + 1.f,
+                  y + j);
+    }
+    path.Close();
+    paint.SetColor(skity::ColorSetARGB(0xFF, i & 0xFF, (i >> 8) & 0xFF, 0x80));
+    canvas->DrawPath(path, paint);
+  }
+  auto display_list = recorder.FinishRecording();
+  return skity::Picture::MakeFromDisplayList(display_list.get());
+}
+
+int64_t PeakRSSKiloBytes() {
+#if !defined(_WIN32)
+  rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+// Peak RSS is per process, run with --benchmark_filter to get a value that
+// belongs to a single size.
+static void BM_PictureSerialize(benchmark::State& state) {
+  auto picture = RecordLargePicture(static_cast<int32_t>(state.range(0)));
+  int64_t rss_before = PeakRSSKiloBytes();
+  size_t bytes = 0;
+
+  for (auto _ : state) {
+    NullWriteStream stream;
+    picture->Serialize(stream, nullptr);
+    bytes = stream.BytesWritten();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  state.counters["skp_kb"] = static_cast<double>(bytes / 1024);
+  state.counters["peak_rss_kb"] = static_cast<double>(PeakRSSKiloBytes());
+  state.counters["peak_rss_growth_kb"] =
+      static_cast<double>(PeakRSSKiloBytes() - rss_before);
+}
+BENCHMARK(BM_PictureSerialize)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
@@ -86,6 +86,96 @@ static void BM_SWRasterStar(benchmark::State& state) {
 }
 BENCHMARK(BM_SWRasterStar)->Unit(benchmark::kMicrosecond);
 
+// A tall path mostly scrolled out of a 1000x800 viewport, only the visible
+// rows should cost anything.
+static void BM_SWRasterClippedTallPath(benchmark::State& state) {
+  float height = static_cast<float>(state.range(0));
+  skity::Path path;
+  path.AddRRect(skity::RRect::MakeRectXY(
+      skity::Rect::MakeLTRB(20, 800 - height, 980, 780), 40, 40));
+
+  for (auto _ : state) {
+    skity::SWRaster raster;
+    raster.RastePath(path, skity::Matrix{},
+                     skity::Rect::MakeLTRB(0, 0, 1000, 800));
+    benchmark::DoNotOptimize(raster.CurrentSpans().data());
+  }
+}
+BENCHMARK(BM_SWRasterClippedTallPath)
+    ->Arg(800)
+    ->Arg(2000)
+    ->Arg(6000)
+    ->Unit(benchmark::kMicrosecond);
+
+// An icon sized shape made of cubics, like glyph outlines and SVG icons,
+// drawn scaled and rotated.
+static void BM_SWRasterCubicIcon(benchmark::State& state) {
+  skity::Path path;
+  path.MoveTo(12, 2);
+  path.CubicTo(17.5f, 2, 22, 6.5f, 22, 12);
+  path.CubicTo(22, 17.5f, 17.5f, 22, 12, 22);
+  path.CubicTo(6.5f, 22, 2, 17.5f, 2, 12);
+  path.CubicTo(2, 6.5f, 6.5f, 2, 12, 2);
+  path.Close();
+  path.MoveTo(8, 9);
+  path.CubicTo(8, 4, 16, 4, 16, 9);
+  path.CubicTo(16, 13, 12, 13, 12, 16);
+  path.CubicTo(10, 13, 8, 13, 8, 9);
+  path.Close();
+  path.SetFillType(skity::Path::PathFillType::kEvenOdd);
+
+  skity::Matrix transform = skity::Matrix::Translate(40, 20) *
+                            skity::Matrix::RotateDeg(15) *
+                            skity::Matrix::Scale(state.range(0) / 24.f,
+                                                 state.range(0) / 24.f);
+
+  for (auto _ : state) {
+    skity::SWRaster raster;
+    raster.RastePath(path, transform);
+    benchmark::DoNotOptimize(raster.CurrentSpans().data());
+  }
+}
+BENCHMARK(BM_SWRasterCubicIcon)
+    ->Arg(24)
+    ->Arg(96)
+    ->Arg(512)
+    ->Unit(benchmark::kMicrosecond);
+
+// Dashed grid lines and a dashed circle, like chart axes and selection
+// outlines, with the given number of lines in each direction.
+static void BM_SWDrawDashedStroke(benchmark::State& state) {
+  skity::Bitmap bitmap(1000, 800, skity::AlphaType::kPremul_AlphaType);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+
+  float intervals[] = {6.f, 4.f};
+  skity::Paint paint;
+  paint.SetStyle(skity::Paint::kStroke_Style);
+  paint.SetStrokeWidth(2.f);
+  paint.SetColor(skity::Color_BLACK);
+  paint.SetPathEffect(
+      skity::PathEffect::MakeDashPathEffect(intervals, 2, 0.f));
+
+  int64_t count = state.range(0);
+  skity::Path path;
+  for (int64_t i = 0; i < count; i++) {
+    float x = 20.f + 960.f * i / count;
+    float y = 20.f + 760.f * i / count;
+    path.MoveTo(x, 20);
+    path.LineTo(x, 780);
+    path.MoveTo(20, y);
+    path.LineTo(980, y);
+  }
+  path.AddCircle(500, 400, 300);
+
+  for (auto _ : state) {
+    canvas->DrawPath(path, paint);
+  }
+}
+BENCHMARK(BM_SWDrawDashedStroke)
+    ->Arg(8)
+    ->Arg(64)
+    ->Unit(benchmark::kMicrosecond);
+
 static void BM_SWDrawBigImage(benchmark::State& state) {
   skity::Bitmap bitmap1(1000, 800, skity::AlphaType::kPremul_AlphaType);
   auto canvas1 = skity::Canvas::MakeSoftwareCanvas(&bitmap1);
@@ -153,6 +243,90 @@ static void BM_SWDrawBigImageWithBlur(benchmark::State& state) {
 }
 BENCHMARK(BM_SWDrawBigImageWithBlur)->Unit(benchmark::kMicrosecond);
 
+// Arg 0 is a grayscale matrix, arg 1 the grayscale matrix composed with a
+// brightness matrix, which are folded into one, and arg 2 the grayscale
+// matrix composed with the sRGB gamma.
+static std::shared_ptr<skity::ColorFilter> MakeBenchColorFilter(int64_t kind) {
+  const float grayscale[20] = {
+      0.21f, 0.72f, 0.07f, 0.f, 0.f,  //
+      0.21f, 0.72f, 0.07f, 0.f, 0.f,  //
+      0.21f, 0.72f, 0.07f, 0.f, 0.f,  //
+      0.f,   0.f,   0.f,   1.f, 0.f,  //
+  };
+  const float brightness[20] = {
+      1.f, 0.f, 0.f, 0.f, 0.1f,  //
+      0.f, 1.f, 0.f, 0.f, 0.1f,  //
+      0.f, 0.f, 1.f, 0.f, 0.1f,  //
+      0.f, 0.f, 0.f, 1.f, 0.f,   //
+  };
+
+  auto filter = skity::ColorFilters::Matrix(grayscale);
+  if (kind == 1) {
+    return skity::ColorFilters::Compose(
+        skity::ColorFilters::Matrix(brightness), filter);
+  } else if (kind == 2) {
+    return skity::ColorFilters::Compose(
+        skity::ColorFilters::LinearToSRGBGamma(), filter);
+  }
+  return filter;
+}
+
+static void BM_SWDrawFilteredImage(benchmark::State& state) {
+  skity::Bitmap bitmap1(1000, 800, skity::AlphaType::kPremul_AlphaType);
+  auto canvas1 = skity::Canvas::MakeSoftwareCanvas(&bitmap1);
+
+  skity::Paint paint;
+  paint.SetColor(skity::Color_WHITE);
+  canvas1->DrawPaint(paint);
+  skity::example::basic::draw_canvas(canvas1.get());
+
+  skity::Bitmap bitmap2(1000, 800, skity::AlphaType::kPremul_AlphaType);
+  auto canvas2 = skity::Canvas::MakeSoftwareCanvas(&bitmap2);
+  std::shared_ptr<skity::Image> image =
+      skity::Image::MakeImage(bitmap1.GetPixmap());
+  paint.SetColorFilter(MakeBenchColorFilter(state.range(0)));
+
+  for (auto _ : state) {
+    canvas2->DrawImage(
+        image, skity::Rect::MakeWH(image->Width(), image->Height()), &paint);
+  }
+}
+BENCHMARK(BM_SWDrawFilteredImage)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_SWDrawFilteredGradient(benchmark::State& state) {
+  skity::Bitmap bitmap(1000, 800, skity::AlphaType::kPremul_AlphaType);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+
+  skity::Vec4 colors[] = {
+      skity::Vec4{1.f, 0.f, 0.f, 1.f},
+      skity::Vec4{0.f, 0.f, 1.f, 0.5f},
+      skity::Vec4{0.f, 1.f, 0.f, 1.f},
+  };
+  float positions[] = {0.f, 0.5f, 1.f};
+  skity::Point pts[] = {
+      skity::Point{0.f, 0.f, 0.f, 1.f},
+      skity::Point{1000.f, 800.f, 0.f, 1.f},
+  };
+
+  skity::Paint paint;
+  paint.SetShader(skity::Shader::MakeLinear(pts, colors, positions, 3,
+                                            skity::TileMode::kClamp));
+  paint.SetColorFilter(MakeBenchColorFilter(state.range(0)));
+
+  for (auto _ : state) {
+    canvas->DrawRect(skity::Rect::MakeWH(1000, 800), paint);
+  }
+}
+BENCHMARK(BM_SWDrawFilteredGradient)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+
 class GradientSpanTest : public skity::GradientColorBrush {
  public:
   GradientSpanTest(skity::Shader::GradientInfo info,
@@ -198,3 +372,99 @@ static void BM_SWGradientSpanBrush(benchmark::State& state) {
 }
 
 BENCHMARK(BM_SWGradientSpanBrush)->Unit(benchmark::kMicrosecond);
+
+// A grid mesh of 2 * cells^2 triangles on a 1000x800 canvas.
+static std::shared_ptr<skity::Vertices> MakeGridMesh(int32_t cells,
+                                                     bool with_colors) {
+  std::vector<skity::Vec2> positions;
+  std::vector<skity::Color> colors;
+  for (int32_t y = 0; y <= cells; y++) {
+    for (int32_t x = 0; x <= cells; x++) {
+      positions.push_back(skity::Vec2{1000.f * x / cells, 800.f * y / cells});
+      colors.push_back(skity::ColorSetARGB(0xFF, x * 255 / cells,
+                                           y * 255 / cells, 0x80));
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (int32_t y = 0; y < cells; y++) {
+    for (int32_t x = 0; x < cells; x++) {
+      uint32_t i = y * (cells + 1) + x;
+      uint32_t quad[] = {i, i + 1, i + cells + 1, i + 1, i + cells + 2,
+                         i + cells + 1};
+      indices.insert(indices.end(), quad, quad + 6);
+    }
+  }
+
+  return skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangles,
+      static_cast<uint32_t>(positions.size()), positions.data(), nullptr,
+      with_colors ? colors.data() : nullptr,
+      static_cast<uint32_t>(indices.size()), indices.data());
+}
+
+static void BM_SWDrawMeshVertices(benchmark::State& state) {
+  skity::Bitmap bitmap(1000, 800);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  auto mesh = MakeGridMesh(static_cast<int32_t>(state.range(0)), false);
+  skity::Paint paint;
+  paint.SetColor(skity::Color_RED);
+
+  for (auto _ : state) {
+    canvas->DrawVertices(mesh, skity::BlendMode::kModulate, paint);
+  }
+}
+BENCHMARK(BM_SWDrawMeshVertices)
+    ->Arg(8)
+    ->Arg(64)
+    ->ArgName("cells")
+    ->Unit(benchmark::kMicrosecond);
+
+// The same mesh as one path per triangle, what callers did before
+// DrawVertices.
+static void BM_SWDrawMeshPaths(benchmark::State& state) {
+  skity::Bitmap bitmap(1000, 800);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  auto mesh = MakeGridMesh(static_cast<int32_t>(state.range(0)), false);
+  skity::Paint paint;
+  paint.SetColor(skity::Color_RED);
+  paint.SetAntiAlias(false);
+
+  std::vector<skity::Path> paths;
+  for (uint32_t t = 0; t < mesh->TriangleCount(); t++) {
+    const uint32_t* index = mesh->Indices() + t * 3;
+    const skity::Vec2* p = mesh->Positions();
+    skity::Path path;
+    path.MoveTo(p[index[0]].x, p[index[0]].y);
+    path.LineTo(p[index[1]].x, p[index[1]].y);
+    path.LineTo(p[index[2]].x, p[index[2]].y);
+    path.Close();
+    paths.emplace_back(std::move(path));
+  }
+
+  for (auto _ : state) {
+    for (const auto& path : paths) {
+      canvas->DrawPath(path, paint);
+    }
+  }
+}
+BENCHMARK(BM_SWDrawMeshPaths)
+    ->Arg(8)
+    ->Arg(64)
+    ->ArgName("cells")
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_SWDrawMeshVertexColors(benchmark::State& state) {
+  skity::Bitmap bitmap(1000, 800);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  auto mesh = MakeGridMesh(static_cast<int32_t>(state.range(0)), true);
+
+  for (auto _ : state) {
+    canvas->DrawVertices(mesh, skity::BlendMode::kModulate, skity::Paint{});
+  }
+}
+BENCHMARK(BM_SWDrawMeshVertexColors)
+    ->Arg(8)
+    ->Arg(64)
+    ->ArgName("cells")
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,380 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <benchmark/benchmark.h>
+#include <wgsl_cross.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <skity/skity.hpp>
+#include <string>
+#include <vector>
+
+#include "src/effect/pixmap_shader.hpp"
+#include "src/render/hw/draw/fragment/wgsl_gradient_fragment.hpp"
+#include "src/render/hw/draw/fragment/wgsl_solid_color.hpp"
+#include "src/render/hw/draw/fragment/wgsl_solid_vertex_color.hpp"
+#include "src/render/hw/draw/fragment/wgsl_stencil_fragment.hpp"
+#include "src/render/hw/draw/fragment/wgsl_texture_fragment.hpp"
+#include "src/render/hw/draw/geometry/wgsl_path_geometry.hpp"
+#include "src/render/hw/draw/geometry/wgsl_rrect_geometry.hpp"
+#include "src/render/hw/draw/geometry/wgsl_tess_path_fill_geometry.hpp"
+#include "src/render/hw/draw/geometry/wgsl_tess_path_stroke_geometry.hpp"
+#include "src/render/hw/draw/hw_wgsl_shader_writer.hpp"
+#include "src/render/hw/draw/wgx_filter.hpp"
+
+// Count heap allocations so the benchmarks can report allocations per
+// translation. This replaces the global operators of the whole binary, which
+// is why these benchmarks are built as skity_wgx_bench, apart from
+// skity_micro_bench.
+static std::atomic<size_t> g_allocation_count{0};
+
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+enum ShaderVariant : int64_t {
+  kPathSolidColor = 0,
+  kPathAASolidColor,
+  kTessPathFillSolidColor,
+  kTessPathStrokeSolidColor,
+  kPathStencil,
+  kPathLinearGradient,
+  kPathAALinearGradient,
+  kPathRadialGradient,
+  kPathLinearGradientSlow,
+  kPathTexture,
+  kPathAATexture,
+  kPathAAMatrixFilter,
+  kPathBlendFilter,
+  kRRectSolidVertexColor,
+  kRRectLinearGradient,
+  kRRectTexture,
+  kShaderVariantCount,
+};
+
+struct ShaderSource {
+  std::string name;
+  std::string vs;
+  std::string fs;
+  std::string vs_entry_point;
+  std::string fs_entry_point;
+};
+
+skity::Path MakePath() {
+  skity::Path path;
+  path.MoveTo(100, 100);
+  path.LineTo(200, 200);
+  path.LineTo(100, 200);
+  path.Close();
+  return path;
+}
+
+std::shared_ptr<skity::Shader> MakeLinearGradient(int count) {
+  std::vector<skity::Vec4> colors;
+  std::vector<float> pos;
+  for (int i = 0; i < count; i++) {
+    colors.emplace_back(i % 2 ? 1.f : 0.f, 0.f, i % 2 ? 0.f : 1.f, 1.f);
+    // uneven stops disable the fast offset path
+    pos.emplace_back(static_cast<float>(i * i) / ((count - 1) * (count - 1)));
+  }
+
+  skity::Point pts[] = {
+      skity::Point{0.f, 0.f, 0.f, 1.f},
+      skity::Point{256.f, 0.f, 0.f, 1.f},
+  };
+
+  return skity::Shader::MakeLinear(pts, colors.data(),
+                                   count > 2 ? pos.data() : nullptr, count);
+}
+
+std::shared_ptr<skity::Shader> MakeRadialGradient() {
+  skity::Vec4 colors[] = {
+      skity::Vec4{0.f, 0.f, 1.f, 1.f},
+      skity::Vec4{1.f, 0.f, 0.f, 1.f},
+  };
+
+  return skity::Shader::MakeRadial(skity::Point{128.f, 128.f, 0.f, 1.f}, 128.f,
+                                   colors, nullptr, 2);
+}
+
+std::unique_ptr<skity::HWWGSLFragment> MakeGradientFragment(
+    const std::shared_ptr<skity::Shader>& shader) {
+  skity::Shader::GradientInfo info;
+  auto type = shader->AsGradient(&info);
+
+  return std::make_unique<skity::WGSLGradientFragment>(info, type, 1.f,
+                                                       skity::Matrix{});
+}
+
+std::unique_ptr<skity::HWWGSLFragment> MakeTextureFragment() {
+  auto pixmap = std::make_shared<skity::Pixmap>(
+      64, 64, skity::AlphaType::kUnpremul_AlphaType, skity::ColorType::kRGBA);
+  auto shader = std::make_shared<skity::PixmapShader>(
+      skity::Image::MakeImage(pixmap), skity::SamplingOptions{},
+      skity::TileMode::kClamp, skity::TileMode::kClamp, skity::Matrix{});
+
+  return std::make_unique<skity::WGSLTextureFragment>(
+      shader, nullptr, nullptr, 1.f, skity::Matrix{}, 64.f, 64.f);
+}
+
+std::unique_ptr<skity::HWWGSLFragment> MakeSolidColor() {
+  return std::make_unique<skity::WGSLSolidColor>(
+      skity::Color4fFromColor(skity::Color_GREEN));
+}
+
+ShaderSource GenerateShader(ShaderVariant variant) {
+  auto path = MakePath();
+  skity::Paint paint;
+
+  std::vector<skity::BatchGroup<skity::RRect>> rrects;
+  rrects.push_back(
+      {skity::RRect::MakeRectXY(skity::Rect::MakeLTRB(0, 0, 100, 100), 10, 10),
+       paint});
+
+  std::unique_ptr<skity::HWWGSLGeometry> geometry;
+  std::unique_ptr<skity::HWWGSLFragment> fragment;
+  std::string name;
+
+  switch (variant) {
+    case kPathSolidColor:
+      name = "Path_SolidColor";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeSolidColor();
+      break;
+    case kPathAASolidColor:
+      name = "PathAA_SolidColor";
+      geometry = std::make_unique<skity::WGSLPathAAGeometry>(path, paint);
+      fragment = MakeSolidColor();
+      break;
+    case kTessPathFillSolidColor:
+      name = "TessPathFill_SolidColor";
+      geometry = std::make_unique<skity::WGSLTessPathFillGeometry>(path, paint);
+      fragment = MakeSolidColor();
+      break;
+    case kTessPathStrokeSolidColor:
+      name = "TessPathStroke_SolidColor";
+      geometry =
+          std::make_unique<skity::WGSLTessPathStrokeGeometry>(path, paint);
+      fragment = MakeSolidColor();
+      break;
+    case kPathStencil:
+      name = "Path_Stencil";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = std::make_unique<skity::WGSLStencilFragment>();
+      break;
+    case kPathLinearGradient:
+      name = "Path_LinearGradient";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeGradientFragment(MakeLinearGradient(2));
+      break;
+    case kPathAALinearGradient:
+      name = "PathAA_LinearGradient";
+      geometry = std::make_unique<skity::WGSLPathAAGeometry>(path, paint);
+      fragment = MakeGradientFragment(MakeLinearGradient(2));
+      break;
+    case kPathRadialGradient:
+      name = "Path_RadialGradient";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeGradientFragment(MakeRadialGradient());
+      break;
+    case kPathLinearGradientSlow:
+      name = "Path_LinearGradient8Stops";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeGradientFragment(MakeLinearGradient(8));
+      break;
+    case kPathTexture:
+      name = "Path_Texture";
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeTextureFragment();
+      break;
+    case kPathAATexture:
+      name = "PathAA_Texture";
+      geometry = std::make_unique<skity::WGSLPathAAGeometry>(path, paint);
+      fragment = MakeTextureFragment();
+      break;
+    case kPathAAMatrixFilter: {
+      name = "PathAA_SolidColor_MatrixFilter";
+      float matrix[20] = {0, 1, 0, 0, 0,  //
+                          0, 0, 1, 0, 0,  //
+                          1, 0, 0, 0, 0,  //
+                          0, 0, 0, 1, 0};
+      auto filter = skity::ColorFilters::Matrix(matrix);
+      geometry = std::make_unique<skity::WGSLPathAAGeometry>(path, paint);
+      fragment = MakeSolidColor();
+      fragment->SetFilter(skity::WGXFilterFragment::Make(filter.get()));
+    } break;
+    case kPathBlendFilter: {
+      name = "Path_SolidColor_BlendFilter";
+      auto filter = skity::ColorFilters::Blend(skity::Color_RED,
+                                               skity::BlendMode::kSrcOver);
+      geometry = std::make_unique<skity::WGSLPathGeometry>(path, paint, false);
+      fragment = MakeSolidColor();
+      fragment->SetFilter(skity::WGXFilterFragment::Make(filter.get()));
+    } break;
+    case kRRectSolidVertexColor:
+      name = "RRect_SolidVertexColor";
+      geometry = std::make_unique<skity::WGSLRRectGeometry>(rrects);
+      fragment = std::make_unique<skity::WGSLSolidVertexColor>();
+      break;
+    case kRRectLinearGradient:
+      name = "RRect_LinearGradient";
+      geometry = std::make_unique<skity::WGSLRRectGeometry>(rrects);
+      fragment = MakeGradientFragment(MakeLinearGradient(2));
+      break;
+    case kRRectTexture:
+      name = "RRect_Texture";
+      geometry = std::make_unique<skity::WGSLRRectGeometry>(rrects);
+      fragment = MakeTextureFragment();
+      break;
+    default:
+      return {};
+  }
+
+  skity::HWWGSLShaderWriter writer{geometry.get(), fragment.get()};
+
+  return {
+      name,
+      writer.GenVSSourceWGSL(),
+      writer.GenFSSourceWGSL(),
+      geometry->GetEntryPoint(),
+      fragment->GetEntryPoint(),
+  };
+}
+
+const ShaderSource& GetShader(int64_t variant) {
+  static std::vector<ShaderSource> shaders = [] {
+    std::vector<ShaderSource> result;
+    for (int64_t i = 0; i < kShaderVariantCount; i++) {
+      result.emplace_back(GenerateShader(static_cast<ShaderVariant>(i)));
+    }
+    return result;
+  }();
+
+  return shaders[variant];
+}
+
+template <typename Translate>
+void RunTranslateBenchmark(benchmark::State& state, Translate translate) {
+  const auto& shader = GetShader(state.range(0));
+  state.SetLabel(shader.name);
+
+  size_t allocations = 0;
+  for (auto _ : state) {
+    size_t start = g_allocation_count.load(std::memory_order_relaxed);
+
+    auto vs_program = wgx::Program::Parse(shader.vs);
+    auto fs_program = wgx::Program::Parse(shader.fs);
+
+    if (vs_program->GetDiagnosis() || fs_program->GetDiagnosis()) {
+      state.SkipWithError("WGSL parse error");
+      return;
+    }
+
+    // the fragment shader continues the binding slots of the vertex shader,
+    // the same way HWPipelineLib chains them
+    auto vs_result =
+        translate(*vs_program, shader.vs_entry_point, wgx::CompilerContext{});
+    auto fs_result =
+        translate(*fs_program, shader.fs_entry_point, vs_result.context);
+
+    if (!vs_result.success || !fs_result.success) {
+      state.SkipWithError("WGX translate error");
+      return;
+    }
+
+    benchmark::DoNotOptimize(fs_result.content.data());
+
+    allocations += g_allocation_count.load(std::memory_order_relaxed) - start;
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          (shader.vs.size() + shader.fs.size()));
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+static void BM_WGX_Parse(benchmark::State& state) {
+  const auto& shader = GetShader(state.range(0));
+  state.SetLabel(shader.name);
+
+  size_t allocations = 0;
+  for (auto _ : state) {
+    size_t start = g_allocation_count.load(std::memory_order_relaxed);
+
+    auto vs_program = wgx::Program::Parse(shader.vs);
+    auto fs_program = wgx::Program::Parse(shader.fs);
+
+    if (vs_program->GetDiagnosis() || fs_program->GetDiagnosis()) {
+      state.SkipWithError("WGSL parse error");
+      return;
+    }
+
+    benchmark::DoNotOptimize(vs_program.get());
+    benchmark::DoNotOptimize(fs_program.get());
+
+    allocations += g_allocation_count.load(std::memory_order_relaxed) - start;
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          (shader.vs.size() + shader.fs.size()));
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_WGX_Parse)
+    ->DenseRange(0, kShaderVariantCount - 1)
+    ->ArgNames({"variant"})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_WGX_TranslateGlsl(benchmark::State& state) {
+  wgx::GlslOptions options{};
+  options.standard = wgx::GlslOptions::Standard::kES;
+  options.major_version = 3;
+  options.minor_version = 0;
+
+  RunTranslateBenchmark(state, [&](const wgx::Program& program,
+                                   const std::string& entry_point,
+                                   const wgx::CompilerContext& ctx) {
+    return program.WriteToGlsl(entry_point.c_str(), options, ctx);
+  });
+}
+
+BENCHMARK(BM_WGX_TranslateGlsl)
+    ->DenseRange(0, kShaderVariantCount - 1)
+    ->ArgNames({"variant"})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_WGX_TranslateMsl(benchmark::State& state) {
+  wgx::MslOptions options{};
+  options.msl_version_major = 2;
+  options.msl_version_minor = 0;
+
+  RunTranslateBenchmark(state, [&](const wgx::Program& program,
+                                   const std::string& entry_point,
+                                   const wgx::CompilerContext& ctx) {
+    return program.WriteToMsl(entry_point.c_str(), options, ctx);
+  });
+}
+
+BENCHMARK(BM_WGX_TranslateMsl)
+    ->DenseRange(0, kShaderVariantCount - 1)
+    ->ArgNames({"variant"})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,279 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <skity/codec/animated_image_player.hpp>
+#include <skity/io/pixmap.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int32_t kFrameCount = 16;
+
+// Frame i sets pixel i to i + 1 on top of the previous frame, so a composed
+// frame tells which frames were replayed to build it.
+class CountingDecoder : public skity::MultiFrameDecoder {
+ public:
+  CountingDecoder() {
+    for (int32_t i = 0; i < kFrameCount; i++) {
+      skity::CodecFrameInfo info;
+      info.required_frame =
+          i == 0 ? skity::CodecFrameInfo::kNoFrameRequired : i - 1;
+      info.duration = 10 * (i + 1);
+      info.rect = {i, 0, i + 1, 1};
+      frames_.emplace_back(i, info);
+    }
+  }
+
+  int32_t GetWidth() const override { return kFrameCount; }
+  int32_t GetHeight() const override { return 1; }
+  int32_t GetFrameCount() const override { return kFrameCount; }
+
+  const skity::CodecFrame* GetFrameInfo(int32_t frame_id) const override {
+    if (frame_id < 0 || frame_id >= kFrameCount) {
+      return nullptr;
+    }
+    return &frames_[frame_id];
+  }
+
+  std::shared_ptr<skity::Pixmap> DecodeFrame(
+      const skity::CodecFrame* frame,
+      std::shared_ptr<skity::Pixmap> prev_pixmap) override {
+    decode_count++;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads_.insert(std::this_thread::get_id());
+    }
+
+    auto pixmap = prev_pixmap;
+    if (!pixmap) {
+      pixmap = std::make_shared<skity::Pixmap>(kFrameCount, 1);
+      std::memset(pixmap->WritableAddr(), 0, pixmap->RowBytes());
+    }
+
+    int32_t id = frame->GetFrameID();
+    *reinterpret_cast<uint32_t*>(pixmap->WritableAddr8(id, 0)) = id + 1;
+
+    return pixmap;
+  }
+
+  void SetDisposal(int32_t frame_id, skity::CodecDisposalMethod method) {
+    frames_[frame_id].SetDisposalMethod(method);
+  }
+
+  std::set<std::thread::id> GetThreads() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_;
+  }
+
+  std::atomic<int32_t> decode_count{0};
+
+ private:
+  std::vector<skity::CodecFrame> frames_;
+  std::mutex mutex_;
+  std::set<std::thread::id> threads_;
+};
+
+uint32_t PixelAt(const std::shared_ptr<skity::Pixmap>& pixmap, int32_t x) {
+  return *reinterpret_cast<const uint32_t*>(pixmap->Addr8(x, 0));
+}
+
+size_t FrameBytes() { return kFrameCount * 4; }
+
+skity::AnimatedImagePlayer::Options NoDecodeAhead() {
+  skity::AnimatedImagePlayer::Options options;
+  options.decode_ahead = 0;
+  options.keyframe_interval = 4;
+  return options;
+}
+
+// Restores the process wide budget when a test is done with it.
+class ScopedCacheBudget {
+ public:
+  explicit ScopedCacheBudget(size_t bytes)
+      : saved_(skity::AnimatedImagePlayer::GetCacheBudget()) {
+    skity::AnimatedImagePlayer::SetCacheBudget(bytes);
+  }
+
+  ~ScopedCacheBudget() { skity::AnimatedImagePlayer::SetCacheBudget(saved_); }
+
+ private:
+  size_t saved_;
+};
+
+void WaitForCachedFrames(const skity::AnimatedImagePlayer& player,
+                         size_t count) {
+  for (int32_t i = 0; i < 1000 && player.GetStats().cached_frame_count < count;
+       i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+}  // namespace
+
+TEST(AnimatedImagePlayerTest, ComposesFrames) {
+  auto decoder = std::make_shared<CountingDecoder>();
+  decoder->SetDisposal(2, skity::CodecDisposalMethod::RestoreBGColor);
+
+  auto player = skity::AnimatedImagePlayer::Make(decoder, NoDecodeAhead());
+  ASSERT_TRUE(player != nullptr);
+
+  for (int32_t i = 0; i < kFrameCount; i++) {
+    auto pixmap = player->GetFrame(i);
+    ASSERT_TRUE(pixmap != nullptr);
+
+    for (int32_t x = 0; x < kFrameCount; x++) {
+      bool disposed = x == 2 && i > 2;
+      uint32_t expected = x <= i && !disposed ? x + 1 : 0;
+      EXPECT_EQ(PixelAt(pixmap, x), expected) << "frame " << i << " x " << x;
+    }
+  }
+
+  // every frame was decoded exactly once
+  EXPECT_EQ(decoder->decode_count.load(), kFrameCount);
+  EXPECT_TRUE(player->GetFrame(kFrameCount) == nullptr);
+}
+
+TEST(AnimatedImagePlayerTest, SeekStartsFromKeyframe) {
+  auto decoder = std::make_shared<CountingDecoder>();
+  auto player = skity::AnimatedImagePlayer::Make(decoder, NoDecodeAhead());
+
+  // the first seek replays the whole chain and keeps frames 0, 4, 8 and 12
+  ASSERT_TRUE(player->GetFrame(kFrameCount - 1) != nullptr);
+  EXPECT_EQ(decoder->decode_count.load(), kFrameCount);
+  EXPECT_EQ(player->GetStats().cached_keyframe_count, 4u);
+
+  decoder->decode_count = 0;
+  auto pixmap = player->GetFrame(10);
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(decoder->decode_count.load(), 2);
+  EXPECT_EQ(PixelAt(pixmap, 10), 11u);
+  EXPECT_EQ(PixelAt(pixmap, 11), 0u);
+
+  decoder->decode_count = 0;
+  ASSERT_TRUE(player->GetFrame(10) != nullptr);
+  EXPECT_EQ(decoder->decode_count.load(), 0);
+  EXPECT_EQ(player->GetStats().hit_count, 1u);
+}
+
+TEST(AnimatedImagePlayerTest, StaysWithinBudget) {
+  ScopedCacheBudget budget(FrameBytes() * 3);
+
+  auto decoder = std::make_shared<CountingDecoder>();
+  auto player = skity::AnimatedImagePlayer::Make(decoder, NoDecodeAhead());
+
+  for (int32_t loop = 0; loop < 2; loop++) {
+    for (int32_t i = 0; i < kFrameCount; i++) {
+      ASSERT_TRUE(player->GetFrame(i) != nullptr);
+      EXPECT_LE(player->GetStats().cached_bytes, FrameBytes() * 3);
+    }
+  }
+
+  // the budget is fully used and keyframes survive plain frames
+  auto stats = player->GetStats();
+  EXPECT_EQ(stats.cached_bytes, FrameBytes() * 3);
+  EXPECT_GE(stats.cached_keyframe_count, 2u);
+
+  player->Purge();
+  EXPECT_EQ(player->GetStats().cached_bytes, 0u);
+}
+
+TEST(AnimatedImagePlayerTest, DecodesAhead) {
+  auto decoder = std::make_shared<CountingDecoder>();
+
+  skity::AnimatedImagePlayer::Options options;
+  options.decode_ahead = 2;
+  auto player = skity::AnimatedImagePlayer::Make(decoder, options);
+
+  ASSERT_TRUE(player->GetFrame(0) != nullptr);
+
+  WaitForCachedFrames(*player, 3);
+  EXPECT_EQ(player->GetStats().cached_frame_count, 3u);
+  EXPECT_EQ(decoder->decode_count.load(), 3);
+
+  auto pixmap = player->GetFrame(2);
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(PixelAt(pixmap, 2), 3u);
+  EXPECT_EQ(player->GetStats().hit_count, 1u);
+}
+
+TEST(AnimatedImagePlayerTest, SharesBudgetBetweenPlayers) {
+  ScopedCacheBudget budget(FrameBytes() * 4);
+
+  auto first = skity::AnimatedImagePlayer::Make(
+      std::make_shared<CountingDecoder>(), NoDecodeAhead());
+  auto second = skity::AnimatedImagePlayer::Make(
+      std::make_shared<CountingDecoder>(), NoDecodeAhead());
+
+  for (int32_t i = 0; i < kFrameCount; i++) {
+    ASSERT_TRUE(first->GetFrame(i) != nullptr);
+    ASSERT_TRUE(second->GetFrame(i) != nullptr);
+    EXPECT_LE(first->GetStats().cached_bytes + second->GetStats().cached_bytes,
+              FrameBytes() * 4);
+  }
+
+  // both players keep frames, none of them takes the whole budget
+  EXPECT_GT(first->GetStats().cached_bytes, 0u);
+  EXPECT_GT(second->GetStats().cached_bytes, 0u);
+
+  // frames of a destroyed player no longer take up the budget, so a new
+  // player caches its first frame without evicting any of the others
+  size_t second_bytes = second->GetStats().cached_bytes;
+  first.reset();
+
+  auto third = skity::AnimatedImagePlayer::Make(
+      std::make_shared<CountingDecoder>(), NoDecodeAhead());
+  ASSERT_TRUE(third->GetFrame(0) != nullptr);
+  EXPECT_EQ(third->GetStats().cached_bytes, FrameBytes());
+  EXPECT_EQ(second->GetStats().cached_bytes, second_bytes);
+}
+
+TEST(AnimatedImagePlayerTest, SharesDecodeAheadThread) {
+  std::vector<std::shared_ptr<CountingDecoder>> decoders;
+  std::vector<std::unique_ptr<skity::AnimatedImagePlayer>> players;
+  for (int32_t i = 0; i < 4; i++) {
+    decoders.emplace_back(std::make_shared<CountingDecoder>());
+    players.emplace_back(skity::AnimatedImagePlayer::Make(decoders.back(), {}));
+    ASSERT_TRUE(players.back()->GetFrame(0) != nullptr);
+  }
+
+  std::set<std::thread::id> threads;
+  for (size_t i = 0; i < players.size(); i++) {
+    WaitForCachedFrames(*players[i], 3);
+    EXPECT_EQ(players[i]->GetStats().cached_frame_count, 3u);
+
+    auto decoder_threads = decoders[i]->GetThreads();
+    threads.insert(decoder_threads.begin(), decoder_threads.end());
+  }
+
+  // the calling thread and one worker for all players
+  threads.erase(std::this_thread::get_id());
+  EXPECT_EQ(threads.size(), 1u);
+
+  // a player destroyed while its frames are decoded ahead is released safely
+  players[0]->GetFrame(8);
+  players[0].reset();
+}
+
+TEST(AnimatedImagePlayerTest, FrameAtTime) {
+  auto player = skity::AnimatedImagePlayer::Make(
+      std::make_shared<CountingDecoder>(), NoDecodeAhead());
+
+  // durations are 10, 20, 30, ...
+  EXPECT_EQ(player->GetTotalDuration(),
+            10 * kFrameCount * (kFrameCount + 1) / 2);
+  EXPECT_EQ(player->GetFrameIDAtTime(0), 0);
+  EXPECT_EQ(player->GetFrameIDAtTime(9), 0);
+  EXPECT_EQ(player->GetFrameIDAtTime(10), 1);
+  EXPECT_EQ(player->GetFrameIDAtTime(29), 1);
+  EXPECT_EQ(player->GetFrameIDAtTime(30), 2);
+  EXPECT_EQ(player->GetFrameIDAtTime(player->GetTotalDuration() + 10), 1);
+}
@@ -4,12 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <skity/codec/codec.hpp>
 #include <skity/graphic/bitmap.hpp>
 #include <skity/graphic/color.hpp>
+#include <skity/graphic/decoded_image_cache.hpp>
+#include <skity/graphic/image.hpp>
 #include <skity/io/data.hpp>
 #include <skity/io/pixmap.hpp>
 #include <skity/render/canvas.hpp>
+#include <vector>
 
 TEST(JPEGCodecTest, RecognizeFileType) {
   auto png_data = skity::Data::MakeFromFileName(SKITY_TEST_PNG_FILE);
@@ -44,6 +48,104 @@ TEST(JPEGCodecTest, Decode) {
       reinterpret_cast<const char*>(empty_jpeg), sizeof(empty_jpeg)));
 }
 
+TEST(JPEGCodecTest, DecodeToSize) {
+  auto jpeg_data = skity::Data::MakeFromFileName(SKITY_TEST_JPEG_FILE);
+
+  auto codec = skity::Codec::MakeJPEGCodec();
+
+  codec->SetData(jpeg_data);
+
+  // 133 x 100 decoded at 1/4
+  auto pixmap = codec->DecodeToSize(30, 20);
+
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(pixmap->Width(), 34);
+  EXPECT_EQ(pixmap->Height(), 25);
+  EXPECT_EQ(pixmap->RowBytes(), 34u * 4u);
+  EXPECT_EQ(pixmap->GetColorType(), skity::ColorType::kRGBA);
+
+  // 1/8 would be too small
+  pixmap = codec->DecodeToSize(17, 14);
+
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(pixmap->Width(), 34);
+  EXPECT_EQ(pixmap->Height(), 25);
+
+  // never upscaled
+  pixmap = codec->DecodeToSize(400, 300);
+
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(pixmap->Width(), 133);
+  EXPECT_EQ(pixmap->Height(), 100);
+}
+
+TEST(JPEGCodecTest, DecodeKeepsFullSize) {
+  auto jpeg_data = skity::Data::MakeFromFileName(SKITY_TEST_JPEG_FILE);
+
+  auto codec = skity::Codec::MakeJPEGCodec();
+
+  codec->SetData(jpeg_data);
+
+  auto pixmap = codec->Decode();
+
+  ASSERT_TRUE(pixmap != nullptr);
+  EXPECT_EQ(pixmap->Width(), 133);
+  EXPECT_EQ(pixmap->Height(), 100);
+
+  // an empty target is not scaled either
+  auto empty_target = codec->DecodeToSize(0, 0);
+
+  ASSERT_TRUE(empty_target != nullptr);
+  EXPECT_EQ(empty_target->Width(), 133);
+  EXPECT_EQ(empty_target->Height(), 100);
+
+  auto full_target = codec->DecodeToSize(133, 100);
+
+  ASSERT_TRUE(full_target != nullptr);
+  ASSERT_EQ(full_target->Width(), 133);
+  ASSERT_EQ(full_target->Height(), 100);
+  EXPECT_EQ(std::memcmp(full_target->Addr(), pixmap->Addr(),
+                        pixmap->RowBytes() * pixmap->Height()),
+            0);
+}
+
+TEST(JPEGCodecTest, MakeLazyImage) {
+  skity::DecodedImageCache::Purge();
+
+  auto jpeg_data = skity::Data::MakeFromFileName(SKITY_TEST_JPEG_FILE);
+
+  auto image = skity::Codec::MakeLazyImage(jpeg_data);
+
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_EQ(image->Width(), 133u);
+  EXPECT_EQ(image->Height(), 100u);
+
+  auto codec = skity::Codec::MakeJPEGCodec();
+  codec->SetData(jpeg_data);
+  auto pixmap = codec->Decode();
+  ASSERT_TRUE(pixmap != nullptr);
+
+  skity::Bitmap bitmap(133, 100);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_TRANSPARENT);
+  canvas->DrawImage(image, 0.f, 0.f);
+
+  // drawn at its size the image is decoded at full size
+  EXPECT_EQ(skity::DecodedImageCache::GetStats().resident_bytes,
+            133u * 100u * 4u);
+
+  skity::Bitmap decoded(pixmap, true);
+  int32_t mismatch_count = 0;
+  for (uint32_t y = 0; y < 100; y++) {
+    for (uint32_t x = 0; x < 133; x++) {
+      if (bitmap.GetPixel(x, y) != decoded.GetPixel(x, y)) {
+        mismatch_count++;
+      }
+    }
+  }
+  EXPECT_EQ(mismatch_count, 0);
+}
+
 TEST(JPEGCodecTest, Encode) {
   skity::Bitmap bitmap(128, 128, skity::AlphaType::kUnpremul_AlphaType,
                        skity::ColorType::kRGBA);
@@ -105,3 +207,38 @@ TEST(JPEGCodecTest, EncodeBGRA) {
 
   EXPECT_EQ(*decode_addr, skity::ColorSetARGB(255, 0, 0, 128));
 }
+
+TEST(JPEGCodecTest, DecodeScanlines) {
+  auto data = skity::Data::MakeFromFileName(SKITY_TEST_JPEG_FILE);
+  auto codec = skity::Codec::MakeJPEGCodec();
+  codec->SetData(data);
+
+  auto pixmap = codec->Decode();
+  ASSERT_TRUE(pixmap != nullptr);
+
+  auto decoder = codec->DecodeScanlines();
+  ASSERT_TRUE(decoder != nullptr);
+  EXPECT_EQ(decoder->GetWidth(), pixmap->Width());
+  EXPECT_EQ(decoder->GetHeight(), pixmap->Height());
+
+  // bands of 7 rows, the last one is partial
+  size_t row_bytes = pixmap->Width() * 4;
+  std::vector<uint8_t> band(row_bytes * 7);
+  int32_t y = 0;
+  while (y < decoder->GetHeight()) {
+    int32_t rows = decoder->DecodeRows(band.data(), row_bytes, 7);
+    ASSERT_GT(rows, 0);
+
+    for (int32_t i = 0; i < rows; i++) {
+      EXPECT_EQ(std::memcmp(band.data() + i * row_bytes,
+                            pixmap->WritableAddr8(0, y + i), row_bytes),
+                0);
+    }
+
+    y += rows;
+    EXPECT_EQ(decoder->GetNextRow(), y);
+  }
+
+  EXPECT_EQ(y, pixmap->Height());
+  EXPECT_EQ(decoder->DecodeRows(band.data(), row_bytes, 7), 0);
+}
@@ -4,11 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <skity/codec/codec.hpp>
 #include <skity/graphic/bitmap.hpp>
 #include <skity/io/data.hpp>
 #include <skity/io/pixmap.hpp>
 #include <skity/render/canvas.hpp>
+#include <vector>
 
 TEST(PNGCodecTest, Create) {
   // create directly
@@ -184,3 +186,38 @@ TEST(PNGCodecTest, EncodeBGRA) {
   auto decode_color = reinterpret_cast<const uint32_t*>(decode_pixmap->Addr());
   EXPECT_EQ(*decode_color, skity::ColorSetARGB(128, 0, 0, 255));
 }
+
+TEST(PNGCodecTest, DecodeScanlines) {
+  auto data = skity::Data::MakeFromFileName(SKITY_TEST_PNG_FILE);
+  auto codec = skity::Codec::MakePngCodec();
+  codec->SetData(data);
+
+  auto pixmap = codec->Decode();
+  ASSERT_TRUE(pixmap != nullptr);
+
+  auto decoder = codec->DecodeScanlines();
+  ASSERT_TRUE(decoder != nullptr);
+  EXPECT_EQ(decoder->GetWidth(), pixmap->Width());
+  EXPECT_EQ(decoder->GetHeight(), pixmap->Height());
+
+  // bands of 7 rows, the last one is partial
+  size_t row_bytes = pixmap->Width() * 4;
+  std::vector<uint8_t> band(row_bytes * 7);
+  int32_t y = 0;
+  while (y < decoder->GetHeight()) {
+    int32_t rows = decoder->DecodeRows(band.data(), row_bytes, 7);
+    ASSERT_GT(rows, 0);
+
+    for (int32_t i = 0; i < rows; i++) {
+      EXPECT_EQ(std::memcmp(band.data() + i * row_bytes,
+                            pixmap->WritableAddr8(0, y + i), row_bytes),
+                0);
+    }
+
+    y += rows;
+    EXPECT_EQ(decoder->GetNextRow(), y);
+  }
+
+  EXPECT_EQ(y, pixmap->Height());
+  EXPECT_EQ(decoder->DecodeRows(band.data(), row_bytes, 7), 0);
+}
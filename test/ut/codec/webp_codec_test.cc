@@ -4,11 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <skity/codec/codec.hpp>
 #include <skity/graphic/bitmap.hpp>
 #include <skity/graphic/color.hpp>
 #include <skity/io/data.hpp>
 #include <skity/io/pixmap.hpp>
+#include <vector>
 
 TEST(WebPCodecTest, Create) {
   auto data = skity::Data::MakeFromFileName(SKITY_TEST_WEBP_FILE);
@@ -78,4 +80,53 @@ TEST(WebPCodecTest, Decode) {
 
     EXPECT_EQ(color, skity::ColorSetARGB(255, 0, 0, 255));
   }
-}
\ No newline at end of file
+}
+
+TEST(WebPCodecTest, DecodeScanlinesAnimated) {
+  auto data = skity::Data::MakeFromFileName(SKITY_TEST_WEBP_FILE);
+  auto codec = skity::Codec::MakeWebpCodec();
+  codec->SetData(data);
+
+  // frames of an animation can not be produced row by row
+  EXPECT_TRUE(codec->DecodeScanlines() == nullptr);
+}
+
+TEST(WebPCodecTest, DecodeScanlines) {
+  auto data = skity::Data::MakeFromFileName(SKITY_TEST_SF_WEBP_FILE);
+  auto codec = skity::Codec::MakeWebpCodec();
+  codec->SetData(data);
+
+  auto pixmap = codec->Decode();
+  ASSERT_TRUE(pixmap != nullptr);
+
+  auto decoder = codec->DecodeScanlines();
+  ASSERT_TRUE(decoder != nullptr);
+  EXPECT_EQ(decoder->GetWidth(), pixmap->Width());
+  EXPECT_EQ(decoder->GetHeight(), pixmap->Height());
+
+  // bands of 5 rows, every other band starts at an odd row and the last one
+  // has an odd number of rows
+  ASSERT_EQ(pixmap->Height() % 5, 3u);
+
+  size_t row_bytes = pixmap->Width() * 4;
+  std::vector<uint8_t> band(row_bytes * 5);
+  int32_t y = 0;
+  int32_t rows = 0;
+  while (y < decoder->GetHeight()) {
+    rows = decoder->DecodeRows(band.data(), row_bytes, 5);
+    ASSERT_GT(rows, 0);
+
+    for (int32_t i = 0; i < rows; i++) {
+      EXPECT_EQ(std::memcmp(band.data() + i * row_bytes,
+                            pixmap->WritableAddr8(0, y + i), row_bytes),
+                0);
+    }
+
+    y += rows;
+    EXPECT_EQ(decoder->GetNextRow(), y);
+  }
+
+  EXPECT_EQ(rows, 3);
+  EXPECT_EQ(y, pixmap->Height());
+  EXPECT_EQ(decoder->DecodeRows(band.data(), row_bytes, 5), 0);
+}
@@ -0,0 +1,70 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/effect/analytic_blur.hpp"
+
+#include <gtest/gtest.h>
+
+#include <skity/skity.hpp>
+
+namespace {
+
+skity::Paint BlurPaint(skity::BlurStyle style, float radius) {
+  skity::Paint paint;
+  paint.SetColor(skity::Color_BLACK);
+  paint.SetMaskFilter(skity::MaskFilter::MakeBlur(style, radius));
+  return paint;
+}
+
+}  // namespace
+
+TEST(AnalyticBlur, AcceptsNormalBlurredFill) {
+  auto paint = BlurPaint(skity::BlurStyle::kNormal, 10.f);
+
+  auto rect = skity::AnalyticBlurRRect::Make(
+      skity::Rect::MakeLTRB(10, 10, 50, 30), paint);
+  ASSERT_TRUE(rect.has_value());
+  EXPECT_FLOAT_EQ(rect->GetCornerRadius(), 0.f);
+  // the sigma of the blur filters, 10 * 0.57735 + 0.5
+  EXPECT_NEAR(rect->GetSigma(), 6.2735f, 1e-4f);
+
+  auto rrect = skity::AnalyticBlurRRect::Make(
+      skity::RRect::MakeRectXY(skity::Rect::MakeLTRB(10, 10, 50, 30), 4, 4),
+      paint);
+  ASSERT_TRUE(rrect.has_value());
+  EXPECT_FLOAT_EQ(rrect->GetCornerRadius(), 4.f);
+
+  // the radius is converted to a sigma in device pixels
+  auto scaled = skity::AnalyticBlurRRect::Make(
+      skity::Rect::MakeLTRB(10, 10, 50, 30), paint, 2.f);
+  ASSERT_TRUE(scaled.has_value());
+  EXPECT_NEAR(scaled->GetSigma(), (20.f * 0.57735f + 0.5f) / 2.f, 1e-4f);
+}
+
+TEST(AnalyticBlur, RejectsOtherDraws) {
+  auto rect = skity::Rect::MakeLTRB(10, 10, 50, 30);
+
+  EXPECT_FALSE(
+      skity::AnalyticBlurRRect::Make(rect, skity::Paint{}).has_value());
+
+  for (auto style : {skity::BlurStyle::kSolid, skity::BlurStyle::kOuter,
+                     skity::BlurStyle::kInner}) {
+    EXPECT_FALSE(
+        skity::AnalyticBlurRRect::Make(rect, BlurPaint(style, 4.f))
+            .has_value());
+  }
+
+  // elliptic corners
+  auto paint = BlurPaint(skity::BlurStyle::kNormal, 4.f);
+  EXPECT_FALSE(skity::AnalyticBlurRRect::Make(
+                   skity::RRect::MakeRectXY(rect, 6, 3), paint)
+                   .has_value());
+
+  paint.SetStyle(skity::Paint::kStroke_Style);
+  EXPECT_FALSE(skity::AnalyticBlurRRect::Make(rect, paint).has_value());
+
+  paint.SetStyle(skity::Paint::kFill_Style);
+  paint.SetBlendMode(skity::BlendMode::kMultiply);
+  EXPECT_FALSE(skity::AnalyticBlurRRect::Make(rect, paint).has_value());
+}
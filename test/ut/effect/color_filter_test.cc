@@ -4,11 +4,43 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <skity/effect/color_filter.hpp>
+#include <vector>
 
 #include "src/effect/color_filter_base.hpp"
 #include "src/graphic/color_priv.hpp"
 
+namespace {
+
+// Applies the row major 4x5 matrix to the unpremultiplied color, one channel
+// after another, and rounds half up.
+skity::PMColor FilterWithMatrix(const float matrix[20], skity::PMColor src) {
+  float a = ColorGetA(src);
+  float in[4] = {0.f, 0.f, 0.f, a / 255.f};
+  if (a > 0.f) {
+    in[0] = ColorGetR(src) / a;
+    in[1] = ColorGetG(src) / a;
+    in[2] = ColorGetB(src) / a;
+  }
+
+  float out[4];
+  for (int32_t row = 0; row < 4; row++) {
+    float value = matrix[row * 5 + 4];
+    for (int32_t col = 0; col < 4; col++) {
+      value += matrix[row * 5 + col] * in[col];
+    }
+    out[row] = std::clamp(value, 0.f, 1.f);
+  }
+
+  float out_a = out[3] * 255.f;
+  auto round = [](float v) { return static_cast<uint8_t>(v + 0.5f); };
+  return skity::ColorSetARGB(round(out_a), round(out[0] * out_a),
+                             round(out[1] * out_a), round(out[2] * out_a));
+}
+
+}  // namespace
+
 TEST(BlendFilterTest, Creation) {
   auto filter =
       skity::ColorFilters::Blend(skity::Color_WHITE, skity::BlendMode::kDst);
@@ -186,3 +218,159 @@ TEST(ComposeFilterTest, Creation) {
   EXPECT_EQ(filters[0], filter2.get());
   EXPECT_EQ(filters[1], filter1.get());
 }
+
+TEST(MatrixFilterTest, ApplyToTranslucentColors) {
+  // halves the alpha and keeps the unpremultiplied color
+  constexpr float half_alpha[20] = {
+      1, 0, 0, 0,   0,  //
+      0, 1, 0, 0,   0,  //
+      0, 0, 1, 0,   0,  //
+      0, 0, 0, 0.5, 0,  //
+  };
+  auto filter = skity::ColorFilters::Matrix(half_alpha);
+
+  auto src = skity::ColorToPMColor(skity::ColorSetARGB(200, 255, 100, 0));
+  auto dst = skity::PMColorToColor(filter->FilterColor(src));
+
+  EXPECT_EQ(ColorGetA(dst), 100u);
+  EXPECT_NEAR(static_cast<int>(ColorGetR(dst)), 255, 1);
+  EXPECT_NEAR(static_cast<int>(ColorGetG(dst)), 100, 1);
+  EXPECT_EQ(ColorGetB(dst), 0u);
+
+  // the translation applies to transparent colors too
+  constexpr float fill_alpha[20] = {
+      1, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 1,  //
+  };
+  filter = skity::ColorFilters::Matrix(fill_alpha);
+  EXPECT_EQ(filter->FilterColor(skity::Color_TRANSPARENT), skity::Color_BLACK);
+}
+
+TEST(ColorFilterTest, FilterSpanMatchesFilterColor) {
+  constexpr float color_matrix[20] = {
+      0.3f, 0.6f, 0.1f, 0.f, 0.1f,  //
+      0.3f, 0.6f, 0.1f, 0.f, 0.f,   //
+      0.3f, 0.6f, 0.1f, 0.f, 0.f,   //
+      0.f,  0.f,  0.f,  0.8f, 0.f,  //
+  };
+
+  std::vector<std::shared_ptr<skity::ColorFilter>> filters = {
+      skity::ColorFilters::Matrix(color_matrix),
+      skity::ColorFilters::LinearToSRGBGamma(),
+      skity::ColorFilters::Blend(skity::ColorSetARGB(128, 0, 0, 255),
+                                 skity::BlendMode::kSrcOver),
+      skity::ColorFilters::Compose(skity::ColorFilters::SRGBToLinearGamma(),
+                                   skity::ColorFilters::Matrix(color_matrix)),
+  };
+
+  std::vector<skity::PMColor> colors;
+  for (uint32_t i = 0; i < 64; i++) {
+    colors.push_back(skity::ColorToPMColor(
+        skity::ColorSetARGB(i * 4, i * 3, 255 - i * 2, i * 4)));
+  }
+  // repeated colors are cached by the matrix filter
+  colors.push_back(colors.back());
+  colors.push_back(skity::Color_TRANSPARENT);
+
+  for (const auto& filter : filters) {
+    auto span = colors;
+    static_cast<skity::ColorFilterBase*>(filter.get())
+        ->OnFilterColors(span.data(), span.size());
+
+    for (size_t i = 0; i < colors.size(); i++) {
+      EXPECT_EQ(span[i], filter->FilterColor(colors[i]));
+    }
+  }
+
+  // the matrix filter filters single colors through its span as well, so
+  // compare with a plain implementation
+  auto span = colors;
+  static_cast<skity::ColorFilterBase*>(filters[0].get())
+      ->OnFilterColors(span.data(), span.size());
+  for (size_t i = 0; i < colors.size(); i++) {
+    EXPECT_EQ(span[i], FilterWithMatrix(color_matrix, colors[i]))
+        << "color " << i;
+  }
+}
+
+TEST(ColorFilterTest, MatrixRoundsHalfUp) {
+  // every channel ends up at exactly 2.5
+  constexpr float half = 2.5f / 255.f;
+  constexpr float color_matrix[20] = {
+      0.f, 0.f, 0.f, 0.f, 1.f,   //
+      0.f, 0.f, 0.f, 0.f, 1.f,   //
+      0.f, 0.f, 0.f, 0.f, 1.f,   //
+      0.f, 0.f, 0.f, 0.f, half,  //
+  };
+  ASSERT_EQ(half * 255.f, 2.5f);
+
+  auto filter = skity::ColorFilters::Matrix(color_matrix);
+  EXPECT_EQ(filter->FilterColor(skity::Color_RED),
+            skity::ColorSetARGB(3, 3, 3, 3));
+  EXPECT_EQ(FilterWithMatrix(color_matrix, skity::Color_RED),
+            skity::ColorSetARGB(3, 3, 3, 3));
+}
+
+TEST(ComposeFilterTest, AppliesInnerThenOuter) {
+  constexpr float swap_rb[20] = {
+      0, 0, 1, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      1, 0, 0, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  auto outer = skity::ColorFilters::Matrix(swap_rb);
+  auto inner = skity::ColorFilters::LinearToSRGBGamma();
+  auto filter = skity::ColorFilters::Compose(outer, inner);
+
+  auto src = skity::ColorSetARGB(255, 127, 0, 10);
+
+  EXPECT_EQ(filter->FilterColor(src),
+            outer->FilterColor(inner->FilterColor(src)));
+  EXPECT_EQ(filter->FilterColor(src), skity::ColorSetARGB(255, 55, 0, 187));
+}
+
+TEST(ComposeFilterTest, FoldsMatrices) {
+  constexpr float scale[20] = {
+      0.5f, 0, 0, 0, 0.1f,  //
+      0, 0.5f, 0, 0, 0,     //
+      0, 0, 0.5f, 0, 0,     //
+      0, 0, 0, 1, 0,        //
+  };
+  constexpr float mix[20] = {
+      0.2f, 0.8f, 0, 0, 0,  //
+      0, 1, 0, 0, 0.2f,     //
+      0.5f, 0, 0.5f, 0, 0,  //
+      0, 0, 0, 0.9f, 0,     //
+  };
+
+  auto outer = skity::ColorFilters::Matrix(mix);
+  auto inner = skity::ColorFilters::Matrix(scale);
+
+  float folded[20];
+  skity::MatrixColorFilter::Concat(
+      folded, *static_cast<skity::MatrixColorFilter*>(outer.get()),
+      *static_cast<skity::MatrixColorFilter*>(inner.get()));
+  // the red output of `mix` reads the red and green outputs of `scale`
+  EXPECT_FLOAT_EQ(folded[0], 0.1f);
+  EXPECT_FLOAT_EQ(folded[1], 0.4f);
+  EXPECT_FLOAT_EQ(folded[4], 0.02f);
+  EXPECT_FLOAT_EQ(folded[9], 0.2f);
+  EXPECT_FLOAT_EQ(folded[18], 0.9f);
+
+  auto filter = skity::ColorFilters::Compose(outer, inner);
+  for (uint32_t i = 0; i < 16; i++) {
+    auto src = skity::ColorToPMColor(
+        skity::ColorSetARGB(255 - i * 8, i * 16, 200 - i * 8, i * 10));
+
+    // the folded matrix skips the rounding of the intermediate color
+    auto expected = outer->FilterColor(inner->FilterColor(src));
+    auto result = filter->FilterColor(src);
+    for (int shift = 0; shift < 32; shift += 8) {
+      int expected_channel = static_cast<int>((expected >> shift) & 0xFF);
+      int result_channel = static_cast<int>((result >> shift) & 0xFF);
+      EXPECT_NEAR(result_channel, expected_channel, 2);
+    }
+  }
+}
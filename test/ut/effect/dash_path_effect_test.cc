@@ -0,0 +1,170 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/effect/dash_path_effect.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <skity/effect/path_effect.hpp>
+#include <skity/geometry/stroke.hpp>
+#include <skity/graphic/paint.hpp>
+#include <utility>
+
+#include "src/render/sw/sw_raster.hpp"
+
+namespace {
+
+using Coverage = std::map<std::pair<int32_t, int32_t>, int32_t>;
+
+Coverage Rasterize(const skity::Path& path) {
+  skity::SWRaster raster;
+  raster.RastePath(path, skity::Matrix{},
+                   skity::Rect::MakeLTRB(0, 0, 256, 256));
+
+  Coverage coverage;
+  for (const auto& span : raster.CurrentSpans()) {
+    for (int32_t i = 0; i < span.len; i++) {
+      coverage[{span.x + i, span.y}] += span.cover;
+    }
+  }
+  return coverage;
+}
+
+int32_t MaxDifference(const Coverage& a, const Coverage& b) {
+  int32_t result = 0;
+  for (const auto* coverage : {&a, &b}) {
+    const auto& other = coverage == &a ? b : a;
+    for (const auto& pair : *coverage) {
+      auto it = other.find(pair.first);
+      int32_t value = it == other.end() ? 0 : it->second;
+      result = std::max(result, std::abs(pair.second - value));
+    }
+  }
+  return result;
+}
+
+int32_t CountContours(const skity::Path& path) {
+  int32_t count = 0;
+  skity::Path::Iter iter(path, false);
+  skity::Point pts[4];
+  skity::Path::Verb verb;
+  while ((verb = iter.Next(pts)) != skity::Path::Verb::kDone) {
+    if (verb == skity::Path::Verb::kMove) {
+      count++;
+    }
+  }
+  return count;
+}
+
+skity::Paint DashPaint(float on, float off, float phase) {
+  float intervals[] = {on, off};
+
+  skity::Paint paint;
+  paint.SetStyle(skity::Paint::kStroke_Style);
+  paint.SetStrokeWidth(6.f);
+  paint.SetPathEffect(
+      skity::PathEffect::MakeDashPathEffect(intervals, 2, phase));
+  return paint;
+}
+
+// The outline the canvas used to build: dashed path, quads, then stroke.
+skity::Path StrokeThroughDashedPath(const skity::Path& src,
+                                    const skity::Paint& paint) {
+  skity::Stroke stroke(paint);
+
+  skity::Path dashed;
+  skity::Path quad;
+  skity::Path outline;
+  paint.GetPathEffect()->FilterPath(&dashed, src, true, paint);
+  stroke.QuadPath(dashed, &quad);
+  stroke.StrokePath(quad, &outline);
+  return outline;
+}
+
+skity::Path Curves() {
+  skity::Path path;
+  path.MoveTo(20, 200);
+  path.QuadTo(60, 20, 120, 120);
+  path.CubicTo(160, 200, 200, 40, 240, 100);
+  return path;
+}
+
+}  // namespace
+
+TEST(DashPathEffect, DashesLines) {
+  auto paint = DashPaint(10.f, 5.f, 0.f);
+
+  skity::Path path;
+  path.MoveTo(0, 10);
+  path.LineTo(100, 10);
+
+  skity::Path dashed;
+  ASSERT_TRUE(paint.GetPathEffect()->FilterPath(&dashed, path, true, paint));
+
+  // 0-10, 15-25, ..., 90-100
+  EXPECT_EQ(CountContours(dashed), 7);
+  EXPECT_EQ(dashed.CountPoints(), 14u);
+  EXPECT_FLOAT_EQ(dashed.GetBounds().Left(), 0.f);
+  EXPECT_FLOAT_EQ(dashed.GetBounds().Right(), 100.f);
+}
+
+TEST(DashPathEffect, JoinsClosedContour) {
+  // a dash starts and ends on the first corner of the rect
+  auto paint = DashPaint(30.f, 10.f, 15.f);
+
+  skity::Path path;
+  path.AddRect(skity::Rect::MakeLTRB(10, 10, 110, 110));
+
+  skity::Path dashed;
+  ASSERT_TRUE(paint.GetPathEffect()->FilterPath(&dashed, path, true, paint));
+
+  // 11 pieces over the 400 long contour, the first and the last are merged
+  EXPECT_EQ(CountContours(dashed), 10);
+
+  // the merged dash goes around the corner without a gap
+  auto coverage = Rasterize(StrokeThroughDashedPath(path, paint));
+  EXPECT_EQ(coverage[std::make_pair(10, 10)], 255);
+}
+
+TEST(DashPathEffect, StrokeMatchesDashedPath) {
+  skity::Path rect;
+  rect.AddRect(skity::Rect::MakeLTRB(20, 20, 220, 140));
+
+  skity::Path lines;
+  for (int32_t i = 0; i < 8; i++) {
+    lines.MoveTo(10 + i * 5, 150 + i * 12);
+    lines.LineTo(240 - i * 20, 160 + i * 10);
+  }
+
+  for (auto cap : {skity::Paint::kButt_Cap, skity::Paint::kSquare_Cap,
+                   skity::Paint::kRound_Cap}) {
+    for (const auto& path : {rect, lines, Curves()}) {
+      auto paint = DashPaint(12.f, 7.f, 3.f);
+      paint.SetStrokeCap(cap);
+
+      skity::Path outline;
+      ASSERT_TRUE(skity::StrokeDashedPath(path, paint, &outline));
+
+      int32_t diff = MaxDifference(Rasterize(outline),
+                                   Rasterize(StrokeThroughDashedPath(path,
+                                                                     paint)));
+      EXPECT_EQ(diff, 0) << "cap " << static_cast<int32_t>(cap);
+    }
+  }
+}
+
+TEST(DashPathEffect, StrokeNeedsDash) {
+  skity::Paint paint;
+  paint.SetStyle(skity::Paint::kStroke_Style);
+
+  skity::Path outline;
+  EXPECT_FALSE(skity::StrokeDashedPath(Curves(), paint, &outline));
+
+  paint.SetPathEffect(skity::PathEffect::MakeDiscretePathEffect(4.f, 2.f));
+  EXPECT_FALSE(skity::StrokeDashedPath(Curves(), paint, &outline));
+  EXPECT_TRUE(outline.IsEmpty());
+}
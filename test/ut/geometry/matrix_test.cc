@@ -2,6 +2,7 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <cmath>
 #include <skity/geometry/matrix.hpp>
 #include <skity/geometry/quaternion.hpp>
@@ -733,6 +734,98 @@ TEST(Matrix, MapRect) {
   EXPECT_EQ(m.MapRect(r), expected);
 }
 
+TEST(Matrix, GetType) {
+  using TypeMask = skity::Matrix::TypeMask;
+
+  EXPECT_EQ(skity::Matrix().GetType(), TypeMask::kIdentity);
+  EXPECT_EQ(skity::Matrix::Translate(1, 0).GetType(), TypeMask::kTranslate);
+  EXPECT_EQ(skity::Matrix::Scale(2, 1).GetType(), TypeMask::kScale);
+  EXPECT_EQ((skity::Matrix::Translate(1, 2) * skity::Matrix::Scale(3, 4))
+                .GetType(),
+            TypeMask::kTranslate | TypeMask::kScale);
+  EXPECT_EQ(skity::Matrix::Skew(1, 0).GetType(), TypeMask::kAffine);
+  EXPECT_EQ(skity::Matrix::RotateDeg(30).GetType(),
+            TypeMask::kScale | TypeMask::kAffine);
+
+  skity::Matrix m = skity::Matrix::Translate(1, 2);
+  m.SetPersp0(0.01f);
+  EXPECT_EQ(m.GetType(), TypeMask::kTranslate | TypeMask::kPerspective);
+
+  // a rotation about the x axis is not a 2D transform
+  m = skity::Matrix::RotateDeg(30, skity::Vec3{1, 0, 0});
+  EXPECT_TRUE(m.GetType() & TypeMask::kPerspective);
+}
+
+TEST(Matrix, MapPointsByType) {
+  skity::Matrix persp = skity::Matrix::Translate(10, 20);
+  persp.SetPersp0(0.001f);
+  persp.SetPersp1(-0.002f);
+
+  skity::Matrix matrices[] = {
+      skity::Matrix(),
+      skity::Matrix::Translate(10, -20),
+      skity::Matrix::Scale(-2, 3),
+      skity::Matrix::Translate(10, -20) * skity::Matrix::Scale(-2, 3),
+      skity::Matrix::RotateDeg(30, skity::Vec2{5, 5}),
+      persp,
+  };
+
+  // odd count, so the vectorized loops also run their tail
+  constexpr int kCount = 7;
+  skity::Vec2 src[kCount];
+  skity::Point src_point[kCount];
+  for (int i = 0; i < kCount; i++) {
+    src[i] = skity::Vec2{i * 3.f - 7.f, 11.f - i * 5.f};
+    src_point[i] = skity::Point{src[i].x, src[i].y, 0.f, i % 2 ? 1.f : 2.f};
+  }
+
+  for (const auto& m : matrices) {
+    skity::Vec2 dst[kCount];
+    skity::Point dst_point[kCount];
+    m.MapPoints(dst, src, kCount);
+    m.MapPoints(dst_point, src_point, kCount);
+
+    for (int i = 0; i < kCount; i++) {
+      skity::Vec4 expected = m * skity::Vec4{src[i].x, src[i].y, 0.f, 1.f};
+      EXPECT_FLOAT_EQ(dst[i].x, expected.x / expected.w);
+      EXPECT_FLOAT_EQ(dst[i].y, expected.y / expected.w);
+
+      skity::Vec4 expected_point = m * src_point[i];
+      EXPECT_FLOAT_EQ(dst_point[i].x, expected_point.x);
+      EXPECT_FLOAT_EQ(dst_point[i].y, expected_point.y);
+      EXPECT_FLOAT_EQ(dst_point[i].z, expected_point.z);
+      EXPECT_FLOAT_EQ(dst_point[i].w, expected_point.w);
+    }
+
+    // mapping in place gives the same result
+    skity::Vec2 in_place[kCount];
+    std::copy(src, src + kCount, in_place);
+    m.MapPoints(in_place, in_place, kCount);
+    for (int i = 0; i < kCount; i++) {
+      EXPECT_EQ(in_place[i], dst[i]);
+    }
+  }
+}
+
+TEST(Matrix, MapRectByType) {
+  skity::Rect r = {10, 20, 30, 40};
+
+  EXPECT_EQ(skity::Matrix().MapRect(r), r);
+
+  // negative scale flips the edges, the result is still sorted
+  skity::Matrix m =
+      skity::Matrix::Translate(100, 0) * skity::Matrix::Scale(-2, 1);
+  skity::Rect expected = {40, 20, 80, 40};
+  EXPECT_EQ(m.MapRect(r), expected);
+  EXPECT_TRUE(m.RectStaysRect());
+
+  m = skity::Matrix::Scale(0, 1);
+  skity::Rect dst;
+  EXPECT_FALSE(m.MapRect(&dst, r));
+  expected = {0, 20, 0, 40};
+  EXPECT_EQ(dst, expected);
+}
+
 TEST(Matrix, Access) {
   skity::Matrix m{
       1,  2,  3,  4,   //
@@ -0,0 +1,177 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/gpu/gpu_shader_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <skity/io/data.hpp>
+#include <string>
+
+namespace {
+
+const char* kShaderSource = R"(
+struct ColorInfo {
+  colors: array<vec4<f32>, 2>,
+  offset: vec3<f32>,
+};
+
+@group(0) @binding(0) var<uniform> info: ColorInfo;
+
+@fragment
+fn fs_main() -> @location(0) vec4<f32> {
+  return info.colors[1] + vec4<f32>(info.offset, 0.0);
+}
+)";
+
+std::string CachePath(const char* name) {
+  return ::testing::TempDir() + name;
+}
+
+}  // namespace
+
+TEST(GPUShaderCacheTest, KeyDependsOnAllInputs) {
+  wgx::CompilerContext ctx{};
+  uint64_t key = skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                                "glsl-3.3", ctx);
+
+  EXPECT_EQ(key, skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                                "glsl-3.3", ctx));
+  EXPECT_NE(key, skity::GPUShaderCache::MakeKey(kShaderSource, "vs_main",
+                                                "glsl-3.3", ctx));
+  EXPECT_NE(key, skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                                "glsl-es-3.0", ctx));
+  EXPECT_NE(key, skity::GPUShaderCache::MakeKey(
+                     std::string(kShaderSource) + " ", "fs_main", "glsl-3.3",
+                     ctx));
+
+  ctx.last_ubo_binding = 1;
+  EXPECT_NE(key, skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                                "glsl-3.3", ctx));
+}
+
+TEST(GPUShaderCacheTest, SaveAndLoad) {
+  auto path = CachePath("skity_shader_cache_test.bin");
+  std::remove(path.c_str());
+
+  auto program = wgx::Program::Parse(kShaderSource);
+  ASSERT_FALSE(program->GetDiagnosis().has_value());
+
+  auto result = program->WriteToGlsl("fs_main", wgx::GlslOptions{});
+  ASSERT_TRUE(result.success);
+
+  uint64_t key = skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                                "glsl-3.3", {});
+
+  {
+    skity::GPUShaderCache cache{path};
+    EXPECT_FALSE(cache.Load());
+    EXPECT_FALSE(cache.Find(key).success);
+
+    cache.Store(key, result);
+    EXPECT_TRUE(cache.Save());
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hit_count, 0u);
+    EXPECT_EQ(stats.miss_count, 1u);
+    EXPECT_EQ(stats.entry_count, 1u);
+  }
+
+  skity::GPUShaderCache cache{path};
+  EXPECT_TRUE(cache.Load());
+
+  auto cached = cache.Find(key);
+  ASSERT_TRUE(cached.success);
+  EXPECT_EQ(cached.content, result.content);
+  EXPECT_EQ(cached.context.last_ubo_binding, result.context.last_ubo_binding);
+
+  ASSERT_EQ(cached.bind_groups.size(), result.bind_groups.size());
+  ASSERT_EQ(cached.bind_groups[0].entries.size(),
+            result.bind_groups[0].entries.size());
+
+  const auto& entry = cached.bind_groups[0].entries[0];
+  const auto& expected = result.bind_groups[0].entries[0];
+  EXPECT_EQ(entry.type, expected.type);
+  EXPECT_EQ(entry.name, expected.name);
+  EXPECT_EQ(entry.index, expected.index);
+  ASSERT_TRUE(entry.type_definition != nullptr);
+  EXPECT_EQ(entry.type_definition->name, expected.type_definition->name);
+  EXPECT_EQ(entry.type_definition->size, expected.type_definition->size);
+  EXPECT_EQ(entry.type_definition->alignment,
+            expected.type_definition->alignment);
+
+  // the element type of an array is stored once, every element gets a copy
+  ASSERT_TRUE(entry.type_definition->IsStruct());
+  auto info =
+      static_cast<wgx::StructDefinition*>(entry.type_definition.get());
+  auto colors = info->GetMember("colors");
+  ASSERT_TRUE(colors != nullptr);
+  ASSERT_TRUE(colors->type->IsArray());
+  auto array = static_cast<wgx::ArrayDefinition*>(colors->type);
+  ASSERT_EQ(array->count, 2u);
+  EXPECT_EQ(array->size, 32u);
+  EXPECT_NE(array->GetElementAt(0), array->GetElementAt(1));
+  EXPECT_EQ(array->GetElementAt(1)->name, array->GetElementAt(0)->name);
+  EXPECT_EQ(array->GetElementAt(1)->size, 16u);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.hit_count, 1u);
+  EXPECT_EQ(stats.miss_count, 0u);
+
+  std::remove(path.c_str());
+}
+
+TEST(GPUShaderCacheTest, RejectOtherVersion) {
+  auto path = CachePath("skity_shader_cache_version_test.bin");
+
+  // magic followed by a version that never existed
+  uint32_t header[4] = {0x43534B53, 0, 0, 0};
+  auto data = skity::Data::MakeWithCopy(header, sizeof(header));
+  ASSERT_TRUE(data->WriteToFile(path.c_str()));
+
+  skity::GPUShaderCache cache{path};
+  EXPECT_FALSE(cache.Load());
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+
+  std::remove(path.c_str());
+}
+
+TEST(GPUShaderCacheTest, RejectOtherTranslator) {
+  auto path = CachePath("skity_shader_cache_translator_test.bin");
+  std::remove(path.c_str());
+
+  auto program = wgx::Program::Parse(kShaderSource);
+  auto result = program->WriteToGlsl("fs_main", wgx::GlslOptions{});
+  ASSERT_TRUE(result.success);
+
+  {
+    skity::GPUShaderCache cache{path};
+    cache.Store(skity::GPUShaderCache::MakeKey(kShaderSource, "fs_main",
+                                               "glsl-3.3", {}),
+                result);
+    ASSERT_TRUE(cache.Save());
+  }
+
+  auto data = skity::Data::MakeFromFileName(path.c_str());
+  ASSERT_TRUE(data != nullptr);
+  std::string content(reinterpret_cast<const char*>(data->RawData()),
+                      data->Size());
+
+  // the hash of the translator follows the magic and the version
+  uint32_t translator = 0;
+  std::memcpy(&translator, content.data() + 8, sizeof(translator));
+  translator++;
+  std::memcpy(content.data() + 8, &translator, sizeof(translator));
+  data = skity::Data::MakeWithCopy(content.data(), content.size());
+  ASSERT_TRUE(data->WriteToFile(path.c_str()));
+
+  skity::GPUShaderCache cache{path};
+  EXPECT_FALSE(cache.Load());
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,153 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <skity/graphic/decoded_image_cache.hpp>
+#include <skity/graphic/image.hpp>
+#include <skity/graphic/image_generator.hpp>
+#include <skity/skity.hpp>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kImageSize = 64;
+
+// A solid red image able to generate any size, like a codec with arbitrary
+// scaled decoding, remembering the sizes it was asked for.
+class SolidGenerator : public skity::ImageGenerator {
+ public:
+  uint32_t Width() const override { return kImageSize; }
+
+  uint32_t Height() const override { return kImageSize; }
+
+  skity::AlphaType GetAlphaType() const override {
+    return skity::AlphaType::kUnpremul_AlphaType;
+  }
+
+  std::shared_ptr<skity::Pixmap> Generate(uint32_t target_width,
+                                          uint32_t target_height) override {
+    requests.emplace_back(target_width, target_height);
+
+    auto pixmap = std::make_shared<skity::Pixmap>(target_width, target_height);
+    auto pixels = reinterpret_cast<uint32_t*>(pixmap->WritableAddr());
+    for (uint32_t i = 0; i < target_width * target_height; i++) {
+      pixels[i] = 0xFF0000FF;  // RGBA red in memory order on little endian
+    }
+    return pixmap;
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> requests;
+};
+
+size_t FullBytes() { return kImageSize * kImageSize * 4; }
+
+class LazyImageTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    skity::DecodedImageCache::Purge();
+    skity::DecodedImageCache::ResetStats();
+    skity::DecodedImageCache::SetBudget(
+        skity::DecodedImageCache::kDefaultBudget);
+  }
+};
+
+}  // namespace
+
+TEST_F(LazyImageTest, GeneratesNothingUntilDrawn) {
+  auto generator = std::make_shared<SolidGenerator>();
+  auto image = skity::Image::MakeLazyImage(generator);
+  ASSERT_TRUE(image != nullptr);
+
+  EXPECT_EQ(image->GetImageType(), skity::ImageType::kLazyGenerated);
+  EXPECT_EQ(image->Width(), kImageSize);
+  EXPECT_EQ(image->Height(), kImageSize);
+  EXPECT_TRUE(generator->requests.empty());
+  EXPECT_EQ(skity::DecodedImageCache::GetStats().resident_bytes, 0u);
+
+  EXPECT_TRUE(skity::Image::MakeLazyImage(nullptr) == nullptr);
+}
+
+TEST_F(LazyImageTest, DecodesAtDrawnSize) {
+  auto generator = std::make_shared<SolidGenerator>();
+  auto image = skity::Image::MakeLazyImage(generator);
+
+  skity::Bitmap bitmap(kImageSize, kImageSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_WHITE);
+
+  // a quarter of the size in both directions through the matrix and the dst
+  canvas->Scale(0.5f, 0.5f);
+  canvas->DrawImage(image, skity::Rect::MakeWH(32.f, 32.f));
+
+  ASSERT_EQ(generator->requests.size(), 1u);
+  EXPECT_EQ(generator->requests[0].first, 16u);
+  EXPECT_EQ(generator->requests[0].second, 16u);
+
+  EXPECT_EQ(bitmap.GetPixel(8, 8), skity::Color_RED);
+  EXPECT_EQ(bitmap.GetPixel(20, 20), skity::Color_WHITE);
+
+  // a smaller draw reuses the cached pixels, a larger one generates again
+  canvas->DrawImage(image, skity::Rect::MakeWH(16.f, 16.f));
+  EXPECT_EQ(generator->requests.size(), 1u);
+
+  canvas->DrawImage(image, skity::Rect::MakeWH(128.f, 128.f));
+  ASSERT_EQ(generator->requests.size(), 2u);
+  EXPECT_EQ(generator->requests[1].first, kImageSize);
+
+  auto stats = skity::DecodedImageCache::GetStats();
+  EXPECT_EQ(stats.hit_count, 1u);
+  EXPECT_EQ(stats.miss_count, 2u);
+  EXPECT_EQ(stats.resident_count, 2u);
+  EXPECT_EQ(stats.resident_bytes, FullBytes() + 16 * 16 * 4);
+}
+
+TEST_F(LazyImageTest, PurgesToBudget) {
+  skity::DecodedImageCache::SetBudget(FullBytes() * 2);
+
+  std::vector<std::shared_ptr<skity::Image>> images;
+  std::vector<std::shared_ptr<SolidGenerator>> generators;
+  for (int32_t i = 0; i < 3; i++) {
+    generators.emplace_back(std::make_shared<SolidGenerator>());
+    images.emplace_back(skity::Image::MakeLazyImage(generators.back()));
+  }
+
+  skity::Bitmap bitmap(kImageSize, kImageSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  for (auto& image : images) {
+    canvas->DrawImage(image, 0.f, 0.f);
+    EXPECT_LE(skity::DecodedImageCache::GetStats().resident_bytes,
+              FullBytes() * 2);
+  }
+
+  // the least recently drawn image was purged and is generated again
+  canvas->DrawImage(images[0], 0.f, 0.f);
+  EXPECT_EQ(generators[0]->requests.size(), 2u);
+  EXPECT_EQ(bitmap.GetPixel(1, 1), skity::Color_RED);
+
+  // destroying an image drops its pixels
+  images.clear();
+  EXPECT_EQ(skity::DecodedImageCache::GetStats().resident_bytes, 0u);
+}
+
+TEST_F(LazyImageTest, RecordingKeepsImageLazy) {
+  auto generator = std::make_shared<SolidGenerator>();
+  auto image = skity::Image::MakeLazyImage(generator);
+
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording();
+  recorder.GetRecordingCanvas()->DrawImage(image,
+                                           skity::Rect::MakeWH(16.f, 16.f));
+  auto display_list = recorder.FinishRecording();
+  EXPECT_TRUE(generator->requests.empty());
+
+  skity::Bitmap bitmap(kImageSize, kImageSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  display_list->Draw(canvas.get());
+
+  ASSERT_EQ(generator->requests.size(), 1u);
+  EXPECT_EQ(generator->requests[0].first, 16u);
+}
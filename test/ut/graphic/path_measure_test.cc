@@ -5,6 +5,7 @@
 #include <array>
 #include <skity/graphic/path.hpp>
 #include <skity/graphic/path_measure.hpp>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "src/geometry/math.hpp"
@@ -189,3 +190,132 @@ TEST(PathMeasure, getLength) {
   test_small_segment1();
   test_small_segment2();
 }
+
+TEST(MeasuredPath, SharedBetweenIdenticalPaths) {
+  skity::MeasuredPath::PurgeCache();
+
+  skity::Path path;
+  path.MoveTo(0, 0);
+  path.CubicTo(10, 40, 60, -20, 80, 30);
+
+  auto measured = skity::MeasuredPath::Make(path, false, 1.f, true);
+  ASSERT_EQ(measured->CountContours(), 1u);
+
+  // a copy is the same path, other parameters or points are not
+  skity::Path copy = path;
+  EXPECT_EQ(skity::MeasuredPath::Make(copy, false, 1.f, true), measured);
+  EXPECT_NE(skity::MeasuredPath::Make(path, true, 1.f, true), measured);
+  EXPECT_NE(skity::MeasuredPath::Make(path, false, 2.f, true), measured);
+
+  copy.LineTo(90, 30);
+  EXPECT_NE(skity::MeasuredPath::Make(copy, false, 1.f, true), measured);
+
+  skity::MeasuredPath::PurgeCache();
+  auto remeasured = skity::MeasuredPath::Make(path, false, 1.f, true);
+  EXPECT_NE(remeasured, measured);
+  EXPECT_FLOAT_EQ(remeasured->GetLength(), measured->GetLength());
+}
+
+TEST(MeasuredPath, CachingIsOptIn) {
+  skity::MeasuredPath::PurgeCache();
+
+  skity::Path path;
+  path.MoveTo(0, 0);
+  path.QuadTo(30, 60, 90, 10);
+
+  // measured without the cache, nothing is shared or inserted
+  auto measured = skity::MeasuredPath::Make(path, false);
+  EXPECT_NE(skity::MeasuredPath::Make(path, false), measured);
+  EXPECT_NE(skity::MeasuredPath::Make(path, false, 1.f, true), measured);
+
+  skity::PathMeasure path_measure{path, false};
+  auto cached = skity::MeasuredPath::Make(path, false, 1.f, true);
+  EXPECT_EQ(skity::MeasuredPath::Make(path, false, 1.f, true), cached);
+  EXPECT_NE(skity::MeasuredPath::Make(path, false), cached);
+  EXPECT_FLOAT_EQ(path_measure.GetLength(), cached->GetLength());
+}
+
+TEST(MeasuredPath, DistancesAlongAllContours) {
+  skity::Path path;
+  path.MoveTo(0, 0);
+  path.LineTo(10, 0);
+  path.MoveTo(0, 10);
+  path.LineTo(0, 30);
+  path.AddCircle(100, 100, 20);
+
+  auto measured = skity::MeasuredPath::Make(path, false);
+  ASSERT_EQ(measured->CountContours(), 3u);
+  EXPECT_FLOAT_EQ(measured->GetContourLength(1), 20.f);
+  EXPECT_FALSE(measured->IsContourClosed(1));
+  EXPECT_TRUE(measured->IsContourClosed(2));
+  EXPECT_FLOAT_EQ(measured->GetLength(),
+                  30.f + measured->GetContourLength(2));
+
+  skity::Point position;
+  skity::Vector tangent;
+  EXPECT_TRUE(measured->GetPosTan(15.f, &position, &tangent));
+  EXPECT_FLOAT_EQ(position.x, 0.f);
+  EXPECT_FLOAT_EQ(position.y, 15.f);
+  EXPECT_FLOAT_EQ(tangent.y, 1.f);
+
+  // the end of a contour belongs to it, not to the next one
+  EXPECT_TRUE(measured->GetPosTan(10.f, &position, nullptr));
+  EXPECT_FLOAT_EQ(position.x, 10.f);
+  EXPECT_FLOAT_EQ(position.y, 0.f);
+
+  // a segment over a contour boundary starts the next contour with a move
+  skity::Path segment;
+  EXPECT_TRUE(measured->GetSegment(5.f, 20.f, &segment, true));
+  EXPECT_EQ(segment.CountVerbs(), 4u);
+  EXPECT_FLOAT_EQ(segment.GetBounds().Bottom(), 20.f);
+
+  EXPECT_FALSE(measured->GetSegment(20.f, 5.f, &segment, true));
+  EXPECT_FALSE(skity::MeasuredPath::Make(skity::Path{}, false)
+                   ->GetPosTan(0.f, &position, &tangent));
+}
+
+TEST(MeasuredPath, BatchedMatchesSingle) {
+  skity::Path path;
+  path.MoveTo(0, 0);
+  for (int32_t i = 0; i < 20; i++) {
+    path.QuadTo(i * 10 + 5, (i % 2) ? -20 : 20, i * 10 + 10, 0);
+  }
+  path.AddCircle(50, 100, 30);
+
+  auto measured = skity::MeasuredPath::Make(path, false);
+
+  // increasing with a jump back, and beyond both ends
+  std::vector<float> distances;
+  for (float d = -10.f; d < measured->GetLength() + 10.f; d += 3.7f) {
+    distances.emplace_back(d);
+  }
+  distances.emplace_back(12.f);
+  distances.emplace_back(measured->GetLength() - 1.f);
+
+  std::vector<skity::Point> positions(distances.size());
+  std::vector<skity::Vector> tangents(distances.size());
+  ASSERT_TRUE(measured->GetPosTans(distances.data(), distances.size(),
+                                   positions.data(), tangents.data()));
+
+  for (size_t i = 0; i < distances.size(); i++) {
+    skity::Point position;
+    skity::Vector tangent;
+    ASSERT_TRUE(measured->GetPosTan(distances[i], &position, &tangent));
+    EXPECT_FLOAT_EQ(positions[i].x, position.x) << "at " << distances[i];
+    EXPECT_FLOAT_EQ(positions[i].y, position.y) << "at " << distances[i];
+    EXPECT_FLOAT_EQ(tangents[i].x, tangent.x) << "at " << distances[i];
+    EXPECT_FLOAT_EQ(tangents[i].y, tangent.y) << "at " << distances[i];
+  }
+
+  // the same as walking the contours with PathMeasure
+  skity::PathMeasure meas{path, false};
+  skity::Point expected;
+  ASSERT_TRUE(meas.NextContour());
+  ASSERT_TRUE(meas.GetPosTan(20.f, &expected, nullptr));
+
+  skity::Point position;
+  ASSERT_TRUE(measured->GetPosTan(measured->GetContourLength(0) + 20.f,
+                                  &position, nullptr));
+  EXPECT_FLOAT_EQ(position.x, expected.x);
+  EXPECT_FLOAT_EQ(position.y, expected.y);
+}
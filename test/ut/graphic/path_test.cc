@@ -785,6 +785,89 @@ TEST(path, IsRect) {
   EXPECT_FALSE(path1.IsRect(nullptr));
 }
 
+TEST(Path, IsOval) {
+  auto bounds = skity::Rect::MakeLTRB(10.3f, 20.7f, 90.1f, 61.9f);
+
+  for (auto dir : {skity::Path::Direction::kCW, skity::Path::Direction::kCCW}) {
+    for (uint32_t start = 0; start < 4; start++) {
+      skity::Path path;
+      path.AddOval(bounds, dir, start);
+
+      skity::Rect oval;
+      EXPECT_TRUE(path.IsOval(&oval));
+      EXPECT_EQ(oval, bounds);
+      EXPECT_FALSE(path.IsRRect(nullptr));
+    }
+  }
+
+  skity::Path circle;
+  circle.AddCircle(50, 50, 20);
+  EXPECT_TRUE(circle.IsOval(nullptr));
+
+  skity::Path rect;
+  rect.AddRect(bounds);
+  EXPECT_FALSE(rect.IsOval(nullptr));
+
+  // fail, two contours
+  skity::Path ovals;
+  ovals.AddOval(bounds);
+  ovals.AddOval(skity::Rect::MakeXYWH(0, 0, 10, 10));
+  EXPECT_FALSE(ovals.IsOval(nullptr));
+
+  // fail, one conic bulges out
+  skity::Path path;
+  path.MoveTo(50.2f, 20.7f);
+  path.ConicTo(90.1f, 20.7f, 90.1f, 41.3f, FloatRoot2Over2);
+  path.ConicTo(90.1f, 61.9f, 50.2f, 61.9f, FloatRoot2Over2);
+  path.ConicTo(10.3f, 61.9f, 10.3f, 41.3f, FloatRoot2Over2);
+  path.ConicTo(10.3f, 20.7f, 50.2f, 20.7f, 0.9f);
+  path.Close();
+  EXPECT_FALSE(path.IsOval(nullptr));
+}
+
+TEST(Path, IsRRect) {
+  auto bounds = skity::Rect::MakeLTRB(10.3f, 20.7f, 90.1f, 61.9f);
+  skity::Vec2 radii[4] = {{4.7f, 4.7f}, {8.f, 3.f}, {0.f, 0.f}, {12.f, 12.f}};
+
+  std::vector<skity::RRect> rrects(2);
+  rrects[0].SetRectXY(bounds, 6.1f, 9.3f);
+  rrects[1].SetRectRadii(bounds, radii);
+
+  for (const auto& expected : rrects) {
+    for (auto dir :
+         {skity::Path::Direction::kCW, skity::Path::Direction::kCCW}) {
+      for (uint32_t start = 0; start < 8; start++) {
+        skity::Path path;
+        path.AddRRect(expected, dir, start);
+
+        skity::RRect rrect;
+        EXPECT_TRUE(path.IsRRect(&rrect));
+        EXPECT_EQ(rrect.GetBounds(), expected.GetBounds());
+        for (int32_t i = 0; i < 4; i++) {
+          auto corner = static_cast<skity::RRect::Corner>(i);
+          EXPECT_NEAR(rrect.Radii(corner).x, expected.Radii(corner).x, 1e-4f);
+          EXPECT_NEAR(rrect.Radii(corner).y, expected.Radii(corner).y, 1e-4f);
+        }
+        EXPECT_FALSE(path.IsOval(nullptr));
+      }
+    }
+  }
+
+  // rects and ovals are not written as rrects
+  skity::Path path;
+  path.AddRRect(skity::RRect::MakeRect(bounds));
+  EXPECT_FALSE(path.IsRRect(nullptr));
+  path.Reset();
+  path.AddRRect(skity::RRect::MakeOval(bounds));
+  EXPECT_FALSE(path.IsRRect(nullptr));
+
+  // fail, a line follows the rrect
+  path.Reset();
+  path.AddRRect(rrects[0]);
+  path.LineTo(0, 0);
+  EXPECT_FALSE(path.IsRRect(nullptr));
+}
+
 TEST(Path, Contains) {
   skity::Path path;
 
@@ -0,0 +1,72 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <skity/graphic/vertices.hpp>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<uint32_t> IndicesOf(const skity::Vertices& vertices) {
+  return std::vector<uint32_t>(vertices.Indices(),
+                               vertices.Indices() + vertices.IndexCount());
+}
+
+const skity::Vec2 kPositions[] = {
+    {0.f, 0.f}, {10.f, 0.f}, {0.f, 10.f}, {10.f, 10.f}, {20.f, 5.f},
+};
+
+}  // namespace
+
+TEST(Vertices, Triangles) {
+  auto vertices = skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangles, 5, kPositions, nullptr, nullptr);
+  ASSERT_NE(vertices, nullptr);
+
+  // the trailing vertices not making a whole triangle are ignored
+  EXPECT_EQ(vertices->TriangleCount(), 1u);
+  EXPECT_EQ(IndicesOf(*vertices), (std::vector<uint32_t>{0, 1, 2}));
+  EXPECT_EQ(vertices->Texs(), nullptr);
+  EXPECT_EQ(vertices->Colors(), nullptr);
+}
+
+TEST(Vertices, StripKeepsWinding) {
+  auto vertices = skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangleStrip, 5, kPositions, nullptr,
+      nullptr);
+  ASSERT_NE(vertices, nullptr);
+
+  EXPECT_EQ(IndicesOf(*vertices),
+            (std::vector<uint32_t>{0, 1, 2, 2, 1, 3, 2, 3, 4}));
+}
+
+TEST(Vertices, FanWithIndices) {
+  uint32_t indices[] = {4, 0, 1, 3};
+  auto vertices = skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangleFan, 5, kPositions, nullptr,
+      nullptr, 4, indices);
+  ASSERT_NE(vertices, nullptr);
+
+  EXPECT_EQ(IndicesOf(*vertices), (std::vector<uint32_t>{4, 0, 1, 4, 1, 3}));
+}
+
+TEST(Vertices, RejectsOutOfRangeIndices) {
+  uint32_t indices[] = {0, 1, 5};
+  EXPECT_EQ(skity::Vertices::MakeCopy(skity::Vertices::VertexMode::kTriangles,
+                                      5, kPositions, nullptr, nullptr, 3,
+                                      indices),
+            nullptr);
+  EXPECT_EQ(skity::Vertices::MakeCopy(skity::Vertices::VertexMode::kTriangles,
+                                      0, kPositions, nullptr, nullptr),
+            nullptr);
+}
+
+TEST(Vertices, Bounds) {
+  auto vertices = skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangles, 5, kPositions, nullptr, nullptr);
+  ASSERT_NE(vertices, nullptr);
+
+  EXPECT_EQ(vertices->Bounds(), skity::Rect::MakeLTRB(0.f, 0.f, 20.f, 10.f));
+}
@@ -0,0 +1,215 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <skity/io/picture.hpp>
+#include <skity/io/stream.hpp>
+#include <skity/skity.hpp>
+#include <vector>
+
+#include "src/picture_priv.hpp"
+#include "src/record/record_playback.hpp"
+
+namespace {
+
+class MemoryWriteStream : public skity::WriteStream {
+ public:
+  bool Write(void const* buffer, size_t size) override {
+    auto bytes = static_cast<const uint8_t*>(buffer);
+    data_.insert(data_.end(), bytes, bytes + size);
+    return true;
+  }
+
+  bool Flush() override { return true; }
+
+  size_t BytesWritten() const override { return data_.size(); }
+
+  const std::vector<uint8_t>& GetData() const { return data_; }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class MemoryReadStream : public skity::ReadStream {
+ public:
+  explicit MemoryReadStream(const std::vector<uint8_t>& data) : data_(data) {}
+
+  size_t Read(void* buffer, size_t size) override {
+    size = Peek(buffer, size);
+    offset_ += size;
+    return size;
+  }
+
+  size_t Peek(void* buffer, size_t size) override {
+    size = std::min(size, data_.size() - offset_);
+    if (buffer != nullptr) {
+      std::memcpy(buffer, data_.data() + offset_, size);
+    }
+    return size;
+  }
+
+  bool IsAtEnd() const override { return offset_ == data_.size(); }
+
+  bool Rewind() override {
+    offset_ = 0;
+    return true;
+  }
+
+ private:
+  const std::vector<uint8_t>& data_;
+  size_t offset_ = 0;
+};
+
+std::shared_ptr<skity::Pixmap> MakePixmap(uint32_t width, uint32_t height,
+                                          uint8_t seed) {
+  auto pixmap = std::make_shared<skity::Pixmap>(width, height);
+  auto pixels = static_cast<uint8_t*>(pixmap->WritableAddr());
+  for (size_t i = 0; i < pixmap->RowBytes() * height; i++) {
+    pixels[i] = static_cast<uint8_t>(i * 7 + seed);
+  }
+  return pixmap;
+}
+
+std::shared_ptr<skity::Image> MakeImage(uint32_t width, uint32_t height,
+                                        uint8_t seed) {
+  return skity::Image::MakeImage(MakePixmap(width, height, seed));
+}
+
+// Paints, paths and two images, one of them drawn twice and used by a shader
+// as well.
+void Record(skity::RecordPlayback& playback) {
+  auto image = MakeImage(16, 8, 1);
+  auto other = MakeImage(4, 4, 2);
+
+  playback.BeginRecording();
+
+  skity::Paint paint;
+  paint.SetColor(skity::Color_RED);
+  playback.DrawRect(skity::Rect::MakeXYWH(10, 10, 50, 30), paint);
+
+  skity::Path path;
+  path.MoveTo(0, 0);
+  path.QuadTo(40, 80, 90, 10);
+  path.Close();
+  paint.SetStyle(skity::Paint::kStroke_Style);
+  paint.SetStrokeWidth(4.f);
+  playback.DrawPath(path, paint);
+
+  playback.Save();
+  playback.ClipRect(skity::Rect::MakeXYWH(0, 0, 64, 64));
+  playback.DrawImageRect(image, skity::Rect::MakeWH(16, 8),
+                         skity::Rect::MakeXYWH(0, 0, 32, 16),
+                         skity::SamplingOptions{}, nullptr);
+  playback.DrawImageRect(other, skity::Rect::MakeWH(4, 4),
+                         skity::Rect::MakeXYWH(40, 0, 8, 8),
+                         skity::SamplingOptions{}, nullptr);
+  playback.DrawImageRect(image, skity::Rect::MakeWH(16, 8),
+                         skity::Rect::MakeXYWH(0, 32, 16, 8),
+                         skity::SamplingOptions{}, nullptr);
+  playback.Restore();
+
+  skity::Paint shader_paint;
+  shader_paint.SetShader(skity::Shader::MakeShader(image));
+  playback.DrawRect(skity::Rect::MakeXYWH(64, 64, 32, 32), shader_paint);
+
+  playback.EndRecording();
+}
+
+}  // namespace
+
+class PictureSerializeTest : public ::testing::Test {
+ protected:
+  // The writer before the data section was streamed: the whole section is
+  // flattened into memory first, then written with its exact size.
+  static std::vector<uint8_t> SerializeBuffered(
+      skity::RecordPlayback& playback, const skity::SerialProc* proc) {
+    // the section tags are built by it
+    using skity::set_four_byte_tag;
+
+    MemoryWriteStream stream;
+
+    auto op_data = playback.writer32_.MakeSnapshot();
+    stream.WriteU32(SK_PICT_READER_TAG);
+    stream.WriteU32(static_cast<uint32_t>(op_data->Size()));
+    stream.Write(op_data->Bytes(), op_data->Size());
+
+    skity::TypefaceSet typeface_set;
+    skity::FactorySet factory_set;
+
+    skity::BinaryWriteBuffer buffer;
+    buffer.SetTypefaceSet(&typeface_set);
+    buffer.SetFactorySet(&factory_set);
+    buffer.SetSerialProc(proc);
+
+    MemoryWriteStream data;
+    playback.FlattenToBuffer(buffer, &data);
+
+    playback.WriteFactories(stream, factory_set);
+    playback.WriteTypefaces(stream, typeface_set);
+
+    stream.WriteU32(SK_PICT_BUFFER_SIZE_TAG);
+    stream.WriteU32(static_cast<uint32_t>(data.BytesWritten()));
+    stream.Write(data.GetData().data(), data.BytesWritten());
+
+    stream.WriteU32(SK_PICT_EOF_TAG);
+
+    return stream.GetData();
+  }
+};
+
+TEST_F(PictureSerializeTest, MatchesBufferedWriter) {
+  skity::RecordPlayback playback{128, 128};
+  Record(playback);
+
+  MemoryWriteStream stream;
+  ASSERT_TRUE(playback.Serialize(stream, nullptr, nullptr));
+
+  EXPECT_EQ(stream.GetData(), SerializeBuffered(playback, nullptr));
+}
+
+TEST_F(PictureSerializeTest, EncodesEachImageOnce) {
+  skity::RecordPlayback playback{128, 128};
+  Record(playback);
+
+  // every call hands out a different pixmap, the two passes still agree as
+  // long as each image is encoded only once
+  int32_t calls = 0;
+  skity::SerialProc proc;
+  proc.image_proc = [&calls](const skity::Image* image) {
+    calls++;
+    return MakePixmap(image->Width() + calls, image->Height(),
+                      static_cast<uint8_t>(calls));
+  };
+
+  MemoryWriteStream stream;
+  EXPECT_TRUE(playback.Serialize(stream, &proc, nullptr));
+  EXPECT_EQ(calls, 2);
+}
+
+TEST_F(PictureSerializeTest, RoundTrip) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeWH(128, 128));
+  auto canvas = recorder.GetRecordingCanvas();
+  skity::Paint paint;
+  paint.SetColor(skity::Color_BLUE);
+  canvas->DrawRect(skity::Rect::MakeXYWH(10, 10, 50, 30), paint);
+  canvas->DrawImageRect(MakeImage(16, 8, 3), skity::Rect::MakeWH(16, 8),
+                        skity::Rect::MakeXYWH(0, 64, 32, 16),
+                        skity::SamplingOptions{}, nullptr);
+  auto display_list = recorder.FinishRecording();
+  auto picture = skity::Picture::MakeFromDisplayList(display_list.get());
+  ASSERT_TRUE(picture != nullptr);
+
+  MemoryWriteStream stream;
+  ASSERT_TRUE(picture->Serialize(stream, nullptr));
+
+  MemoryReadStream read_stream{stream.GetData()};
+  auto restored = skity::Picture::MakeFromStream(read_stream);
+  ASSERT_TRUE(restored != nullptr);
+  EXPECT_TRUE(read_stream.IsAtEnd());
+}
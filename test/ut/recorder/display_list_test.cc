@@ -42,6 +42,19 @@ class MockCanvas : public skity::Canvas {
                skity::Paint const* paint),
               (override));
 
+  MOCK_METHOD(void, OnDrawAtlas,
+              (const std::shared_ptr<skity::Image>& atlas,
+               const skity::RSXform xform[], const skity::Rect tex[],
+               const skity::Color colors[], int count, skity::BlendMode mode,
+               const skity::SamplingOptions& sampling,
+               const skity::Rect* cull_rect, const skity::Paint* paint),
+              (override));
+
+  MOCK_METHOD(void, OnDrawVertices,
+              (const std::shared_ptr<skity::Vertices>& vertices,
+               skity::BlendMode mode, const skity::Paint& paint),
+              (override));
+
   MOCK_METHOD(void, OnDrawGlyphs,
               (uint32_t count, const skity::GlyphID glyphs[],
                const float position_x[], const float position_y[],
@@ -254,3 +267,229 @@ TEST(DisplayList, ClipRect) {
     display_list->Draw(&mock_canvas);
   }
 }
+
+std::unique_ptr<skity::DisplayList> RecordRectGrid(bool build_rtree) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 1000, 1000),
+                          build_rtree);
+  auto canvas = recorder.GetRecordingCanvas();
+  for (int32_t i = 0; i < 10; i++) {
+    for (int32_t j = 0; j < 10; j++) {
+      canvas->DrawRect(
+          skity::Rect::MakeXYWH(i * 100 + 10, j * 100 + 10, 80, 80),
+          skity::Paint{});
+    }
+  }
+  return recorder.FinishRecording();
+}
+
+TEST(DisplayList, RTreeCullsOpsOutsideClip) {
+  {
+    auto display_list = RecordRectGrid(false);
+    EXPECT_FALSE(display_list->HasRTree());
+
+    MockCanvas mock_canvas;
+    mock_canvas.ClipRect(skity::Rect::MakeLTRB(0, 0, 200, 100));
+    EXPECT_CALL(mock_canvas, OnDrawRect(_, _)).Times(100);
+    display_list->Draw(&mock_canvas);
+  }
+  {
+    auto display_list = RecordRectGrid(true);
+    EXPECT_TRUE(display_list->HasRTree());
+
+    MockCanvas mock_canvas;
+    mock_canvas.ClipRect(skity::Rect::MakeLTRB(0, 0, 200, 100));
+    EXPECT_CALL(mock_canvas, OnDrawRect(_, _)).Times(2);
+    display_list->Draw(&mock_canvas);
+  }
+  {
+    auto display_list = RecordRectGrid(true);
+
+    MockCanvas mock_canvas;
+    mock_canvas.ClipRect(skity::Rect::MakeLTRB(0, 0, 200, 100));
+    mock_canvas.Translate(-500, -500);
+    EXPECT_CALL(mock_canvas,
+                OnDrawRect(skity::Rect::MakeXYWH(510, 510, 80, 80), _))
+        .Times(1);
+    EXPECT_CALL(mock_canvas,
+                OnDrawRect(skity::Rect::MakeXYWH(610, 510, 80, 80), _))
+        .Times(1);
+    display_list->Draw(&mock_canvas);
+  }
+  {
+    auto display_list = RecordRectGrid(true);
+
+    MockCanvas mock_canvas;
+    EXPECT_CALL(mock_canvas, OnDrawRect(_, _)).Times(100);
+    display_list->Draw(&mock_canvas);
+  }
+}
+
+TEST(DisplayList, RTreeKeepsSaveLayerBalanced) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 1000, 1000), true);
+  auto canvas = recorder.GetRecordingCanvas();
+  canvas->SaveLayer(skity::Rect::MakeLTRB(0, 0, 100, 100), skity::Paint{});
+  canvas->DrawRect(skity::Rect::MakeLTRB(10, 10, 20, 20), skity::Paint{});
+  canvas->Restore();
+  canvas->DrawRect(skity::Rect::MakeLTRB(500, 500, 600, 600), skity::Paint{});
+  auto display_list = recorder.FinishRecording();
+
+  MockCanvas mock_canvas;
+  mock_canvas.ClipRect(skity::Rect::MakeLTRB(400, 400, 700, 700));
+  EXPECT_CALL(mock_canvas, OnSaveLayer(_, _)).Times(0);
+  EXPECT_CALL(mock_canvas, OnSave()).Times(1);
+  EXPECT_CALL(mock_canvas, OnRestore()).Times(1);
+  EXPECT_CALL(mock_canvas, OnDrawRect(_, _)).Times(1);
+  display_list->Draw(&mock_canvas);
+}
+
+TEST(DisplayList, RTreeExpandsFilteredLayer) {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 1000, 1000), true);
+  auto canvas = recorder.GetRecordingCanvas();
+  skity::Paint layer_paint;
+  layer_paint.SetImageFilter(skity::ImageFilters::Blur(20, 20));
+  canvas->SaveLayer(skity::Rect::MakeLTRB(0, 0, 100, 100), layer_paint);
+  canvas->DrawRect(skity::Rect::MakeLTRB(10, 10, 20, 20), skity::Paint{});
+  canvas->Restore();
+  auto display_list = recorder.FinishRecording();
+
+  MockCanvas mock_canvas;
+  mock_canvas.ClipRect(skity::Rect::MakeLTRB(50, 50, 100, 100));
+  EXPECT_CALL(mock_canvas, OnSaveLayer(_, _)).Times(1);
+  EXPECT_CALL(mock_canvas, OnRestore()).Times(1);
+  EXPECT_CALL(mock_canvas, OnDrawRect(_, _)).Times(1);
+  display_list->Draw(&mock_canvas);
+}
+
+TEST(DisplayList, InternsPaints) {
+  skity::Paint red_paint;
+  red_paint.SetColor(skity::Color_RED);
+  skity::Paint blue_paint;
+  blue_paint.SetColor(skity::Color_BLUE);
+
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording();
+  auto canvas = recorder.GetRecordingCanvas();
+  std::vector<skity::RecordedOpOffset> offsets;
+  for (int32_t i = 0; i < 10; i++) {
+    canvas->DrawRect(skity::Rect::MakeXYWH(i * 10, 0, 10, 10), red_paint);
+    offsets.push_back(canvas->GetLastOpOffset());
+    canvas->DrawRect(skity::Rect::MakeXYWH(i * 10, 10, 10, 10), blue_paint);
+  }
+  auto display_list = recorder.FinishRecording();
+  EXPECT_EQ(display_list->PaintCount(), 2u);
+
+  // Changing one op must not leak into the ops sharing its paint.
+  skity::Paint* paint = display_list->GetOpPaintByOffset(offsets[3]);
+  ASSERT_NE(paint, nullptr);
+  paint->SetColor(skity::Color_YELLOW);
+  EXPECT_EQ(display_list->PaintCount(), 3u);
+  EXPECT_EQ(display_list->GetOpPaintByOffset(offsets[3]), paint);
+  EXPECT_EQ(display_list->PaintCount(), 3u);
+
+  skity::Paint yellow_paint;
+  yellow_paint.SetColor(skity::Color_YELLOW);
+
+  MockCanvas mock_canvas;
+  EXPECT_CALL(mock_canvas, OnDrawRect(_, red_paint)).Times(9);
+  EXPECT_CALL(mock_canvas, OnDrawRect(_, blue_paint)).Times(10);
+  EXPECT_CALL(mock_canvas, OnDrawRect(_, yellow_paint)).Times(1);
+  display_list->Draw(&mock_canvas);
+}
+
+TEST(DisplayList, RecordsAtlasAsOneOp) {
+  auto pixmap = std::make_shared<skity::Pixmap>(
+      16, 16, skity::AlphaType::kPremul_AlphaType, skity::ColorType::kRGBA);
+  auto atlas = skity::Image::MakeImage(pixmap);
+
+  skity::RSXform xform[] = {
+      skity::RSXform::Make(1.f, 0.f, 10.f, 10.f),
+      skity::RSXform::Make(2.f, 0.f, 40.f, 20.f),
+      skity::RSXform::Make(0.f, 1.f, 80.f, 60.f),
+  };
+  skity::Rect tex[] = {
+      skity::Rect::MakeXYWH(0, 0, 8, 8),
+      skity::Rect::MakeXYWH(8, 0, 8, 8),
+      skity::Rect::MakeXYWH(0, 8, 8, 8),
+  };
+
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 100, 100));
+  recorder.GetRecordingCanvas()->DrawAtlas(
+      atlas, xform, tex, nullptr, 3, skity::BlendMode::kModulate,
+      skity::SamplingOptions{}, nullptr);
+  auto display_list = recorder.FinishRecording();
+
+  // the quarter turn puts the last sprite on [72, 80] x [60, 68]
+  EXPECT_EQ(display_list->GetBounds(), skity::Rect::MakeLTRB(10, 10, 80, 68));
+
+  MockCanvas mock_canvas;
+  EXPECT_CALL(mock_canvas, OnDrawAtlas(atlas, _, _, nullptr, 3,
+                                       skity::BlendMode::kModulate, _, nullptr,
+                                       _))
+      .Times(1);
+  EXPECT_CALL(mock_canvas, OnDrawImageRect(_, _, _, _, _)).Times(0);
+  display_list->Draw(&mock_canvas);
+}
+
+TEST(DisplayList, RecordsVerticesAsOneOp) {
+  skity::Vec2 positions[] = {{10, 10}, {60, 20}, {30, 70}};
+  auto vertices = skity::Vertices::MakeCopy(
+      skity::Vertices::VertexMode::kTriangles, 3, positions, nullptr, nullptr);
+
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 100, 100));
+  recorder.GetRecordingCanvas()->DrawVertices(
+      vertices, skity::BlendMode::kModulate, skity::Paint{});
+  auto display_list = recorder.FinishRecording();
+
+  EXPECT_EQ(display_list->GetBounds(), skity::Rect::MakeLTRB(10, 10, 60, 70));
+
+  MockCanvas mock_canvas;
+  EXPECT_CALL(mock_canvas,
+              OnDrawVertices(vertices, skity::BlendMode::kModulate, _))
+      .Times(1);
+  EXPECT_CALL(mock_canvas, OnDrawPath(_, _)).Times(0);
+  display_list->Draw(&mock_canvas);
+}
+
+std::unique_ptr<skity::DisplayList> RecordTextAndPaintUnderTransform() {
+  skity::PictureRecorder recorder;
+  recorder.BeginRecording(skity::Rect::MakeLTRB(0, 0, 1000, 1000), true);
+  auto canvas = recorder.GetRecordingCanvas();
+  canvas->Translate(100, 100);
+  canvas->Scale(2, 2);
+  // device clip of [100, 200] x [100, 200]
+  canvas->ClipRect(skity::Rect::MakeLTRB(0, 0, 50, 50));
+
+  skity::GlyphID glyphs[] = {1, 2};
+  float position_x[] = {10, 20};
+  float position_y[] = {30, 30};
+  canvas->DrawGlyphs(2, glyphs, position_x, position_y, skity::Font{},
+                     skity::Paint{});
+  canvas->DrawPaint(skity::Paint{});
+  return recorder.FinishRecording();
+}
+
+TEST(DisplayList, RTreeKeepsTextAndPaintUnderTransform) {
+  {
+    auto display_list = RecordTextAndPaintUnderTransform();
+
+    MockCanvas mock_canvas;
+    mock_canvas.ClipRect(skity::Rect::MakeLTRB(150, 150, 300, 300));
+    EXPECT_CALL(mock_canvas, OnDrawGlyphs(2, _, _, _, _, _)).Times(1);
+    EXPECT_CALL(mock_canvas, OnDrawPaint(_)).Times(1);
+    display_list->Draw(&mock_canvas);
+  }
+  {
+    auto display_list = RecordTextAndPaintUnderTransform();
+
+    MockCanvas mock_canvas;
+    mock_canvas.ClipRect(skity::Rect::MakeLTRB(0, 0, 90, 90));
+    EXPECT_CALL(mock_canvas, OnDrawGlyphs(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(mock_canvas, OnDrawPaint(_)).Times(0);
+    display_list->Draw(&mock_canvas);
+  }
+}
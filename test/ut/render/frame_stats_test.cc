@@ -0,0 +1,72 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <skity/skity.hpp>
+#include <thread>
+
+#include "src/utils/render_counters.hpp"
+
+TEST(FrameStatsTest, FlushCollectsCounters) {
+  skity::CollectRenderCounters();
+
+  skity::Bitmap bitmap(32, 32);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+
+  skity::Paint paint;
+  paint.SetColor(skity::Color_RED);
+  skity::Path path;
+  path.AddCircle(16.f, 16.f, 10.f);
+  canvas->DrawPath(path, paint);
+  canvas->Flush();
+
+  // at least one span per covered row
+  EXPECT_GE(canvas->GetFrameStats().Get(skity::RenderCounter::kRasterSpan),
+            20u);
+
+  // counters restart from zero for every frame
+  canvas->Flush();
+  EXPECT_EQ(canvas->GetFrameStats().Get(skity::RenderCounter::kRasterSpan),
+            0u);
+}
+
+TEST(FrameStatsTest, CountersArePerThread) {
+  skity::CollectRenderCounters();
+
+  skity::FrameStats other;
+  std::thread thread([&other]() {
+    skity::AddRenderCounter(skity::RenderCounter::kGlyphCacheHit, 3);
+    other = skity::CollectRenderCounters();
+  });
+  thread.join();
+
+  EXPECT_EQ(other.Get(skity::RenderCounter::kGlyphCacheHit), 3u);
+  EXPECT_EQ(skity::CollectRenderCounters().Get(
+                skity::RenderCounter::kGlyphCacheHit),
+            0u);
+}
+
+TEST(FrameStatsTest, Aggregates) {
+  skity::FrameStats stats;
+  EXPECT_EQ(stats.GlyphCacheHitRate(), 0.f);
+
+  skity::FrameStats frame;
+  frame.counters[static_cast<size_t>(skity::RenderCounter::kGlyphCacheHit)] =
+      3;
+  frame.counters[static_cast<size_t>(skity::RenderCounter::kGlyphCacheMiss)] =
+      1;
+
+  stats += frame;
+  stats += frame;
+  EXPECT_EQ(stats.Get(skity::RenderCounter::kGlyphCacheHit), 6u);
+  EXPECT_FLOAT_EQ(stats.GlyphCacheHitRate(), 0.75f);
+
+  for (size_t i = 0; i < skity::kRenderCounterCount; i++) {
+    auto name = skity::FrameStats::GetCounterName(
+        static_cast<skity::RenderCounter>(i));
+    EXPECT_NE(std::strlen(name), 0u);
+  }
+}
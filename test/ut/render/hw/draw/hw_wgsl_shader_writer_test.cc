@@ -19,6 +19,7 @@
 #include "src/render/hw/draw/fragment/wgsl_solid_color.hpp"
 #include "src/render/hw/draw/fragment/wgsl_solid_vertex_color.hpp"
 #include "src/render/hw/draw/fragment/wgsl_texture_fragment.hpp"
+#include "src/render/hw/draw/geometry/wgsl_blur_rrect_geometry.hpp"
 #include "src/render/hw/draw/geometry/wgsl_path_geometry.hpp"
 #include "src/render/hw/draw/geometry/wgsl_rrect_geometry.hpp"
 #include "src/render/hw/draw/geometry/wgsl_tess_path_fill_geometry.hpp"
@@ -1631,6 +1632,84 @@ fn fs_main(input: FSInput) -> @location(0) vec4<f32> {
 )";
 }
 
+std::string GetPathGeometryClipVS() {
+  return R"(
+struct CommonSlot {
+     mvp           : mat4x4<f32>,
+     userTransform : mat4x4<f32>,
+     extraInfo     : vec4<f32>,
+};
+
+fn get_vertex_position(a_pos: vec2<f32>, cs: CommonSlot) -> vec4<f32> {
+  var pos: vec4<f32> = cs.mvp * cs.userTransform * vec4<f32>(a_pos, 0.0, 1.0);
+  return vec4<f32>(pos.x, pos.y, cs.extraInfo[0] * pos.w, pos.w);
+}
+
+@group(0) @binding(0) var<uniform> common_slot  : CommonSlot;
+
+struct VSInput {
+  @location(0)  a_pos: vec2<f32>,
+};
+
+struct VSOutput {
+  @builtin(position) pos: vec4<f32>,
+  @location(0) v_clip_pos: vec3<f32>,
+};
+
+@vertex
+fn vs_main(input: VSInput) -> VSOutput {
+  var output: VSOutput;
+  var local_pos: vec2<f32>;
+
+  local_pos = input.a_pos;
+  output.pos = get_vertex_position(input.a_pos, common_slot);
+  output.v_clip_pos = output.pos.xyw;
+
+  return output;
+};
+)";
+}
+
+std::string GetSolidColorClip2FS() {
+  return R"(
+struct ClipShape {
+  matrix  : vec4<f32>,
+  info    : vec4<f32>,
+  rect    : vec4<f32>,
+};
+
+fn clip_shape_coverage(ndc: vec2<f32>, shape: ClipShape) -> f32 {
+  let pos: vec2<f32> = vec2<f32>(
+      shape.matrix.x * ndc.x + shape.matrix.z * ndc.y,
+      shape.matrix.y * ndc.x + shape.matrix.w * ndc.y) + shape.info.xy;
+  let radius: f32 = shape.info.z;
+  let q: vec2<f32> = abs(pos - (shape.rect.xy + shape.rect.zw) * 0.5) -
+                     (shape.rect.zw - shape.rect.xy) * 0.5 + radius;
+  let dist: f32 = length(max(q, vec2<f32>(0.0))) +
+                  min(max(q.x, q.y), 0.0) - radius;
+  return clamp(0.5 - dist * shape.info.w, 0.0, 1.0);
+}
+
+@group(1) @binding(0) var<uniform> uColor: vec4<f32>;
+@group(1) @binding(1) var<uniform> clip_shape_0 : ClipShape;
+@group(1) @binding(2) var<uniform> clip_shape_1 : ClipShape;
+
+struct FSInput {
+  @location(0) v_clip_pos: vec3<f32>,
+};
+
+@fragment
+fn fs_main(input: FSInput) -> @location(0) vec4<f32> {
+  var color : vec4<f32>;
+  color = vec4<f32>(uColor.rgb * uColor.a, uColor.a);
+  let clip_pos: vec2<f32> = input.v_clip_pos.xy / input.v_clip_pos.z;
+  color = color * clip_shape_coverage(clip_pos, clip_shape_0);
+  color = color * clip_shape_coverage(clip_pos, clip_shape_1);
+  return color;
+}
+)";
+}
+
 skity::Path MakePath() {
   skity::Path path;
   path.MoveTo(100, 100);
@@ -1986,3 +2065,111 @@ TEST(ShaderWriter, RRectWithTexture) {
   ASSERT_TRUE(CompareShader(vs, GetRRectTextureVS()));
   ASSERT_TRUE(CompareShader(fs, GetTextureRRectFS()));
 }
+
+TEST(ShaderWriter, PathWithSolidColorAndAnalyticClip) {
+  auto path = MakePath();
+  skity::Paint paint;
+  paint.SetColor(0xff00ff00);
+  skity::Color4f color = paint.GetColor4f();
+  skity::WGSLPathGeometry geometry{path, paint, false};
+  skity::WGSLSolidColor fragment{color};
+  skity::HWWGSLShaderWriter shader_writer{&geometry, &fragment};
+  shader_writer.SetAnalyticClip(2, fragment.EndBindingIndex());
+  std::string vs = shader_writer.GenVSSourceWGSL();
+  std::string fs = shader_writer.GenFSSourceWGSL();
+  ASSERT_EQ(shader_writer.GetVSShaderName(), "VS_Path_Clip");
+  ASSERT_EQ(shader_writer.GetFSShaderName(), "FS_SolidColor_Clip2");
+  ASSERT_TRUE(CompareShader(vs, GetPathGeometryClipVS()));
+  ASSERT_TRUE(CompareShader(fs, GetSolidColorClip2FS()));
+
+  // HWDrawStep uploads the shapes through the reflection of the pipeline
+  auto program = wgx::Program::Parse(fs);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_FALSE(program->GetDiagnosis().has_value());
+  auto bind_groups = program->GetWGSLBindGroups("fs_main");
+  const wgx::BindGroup* group = nullptr;
+  for (const auto& bind_group : bind_groups) {
+    if (bind_group.group == 1) {
+      group = &bind_group;
+    }
+  }
+  ASSERT_TRUE(group != nullptr);
+  for (uint32_t i = 0; i < 2; i++) {
+    auto entry = group->GetEntry(fragment.EndBindingIndex() + i);
+    ASSERT_TRUE(entry != nullptr);
+    EXPECT_EQ(entry->name, "clip_shape_" + std::to_string(i));
+    ASSERT_TRUE(entry->type_definition != nullptr);
+    EXPECT_EQ(entry->type_definition->name, "ClipShape");
+  }
+}
+
+TEST(ShaderWriter, BlurRRectWithSolidVertexColor) {
+  skity::Paint paint;
+  paint.SetColor(0xff00ff00);
+  paint.SetMaskFilter(
+      skity::MaskFilter::MakeBlur(skity::BlurStyle::kNormal, 8.f));
+  auto blur = skity::AnalyticBlurRRect::Make(
+      skity::RRect::MakeRectXY(skity::Rect::MakeLTRB(0, 0, 100, 60), 10, 10),
+      paint);
+  ASSERT_TRUE(blur.has_value());
+
+  std::vector<skity::BatchGroup<skity::AnalyticBlurRRect>> batch_group;
+  batch_group.push_back({*blur, paint});
+  skity::WGSLBlurRRectGeometry geometry{batch_group};
+  skity::WGSLSolidVertexColor fragment;
+  skity::HWWGSLShaderWriter shader_writer{&geometry, &fragment};
+  std::string vs = shader_writer.GenVSSourceWGSL();
+  std::string fs = shader_writer.GenFSSourceWGSL();
+  ASSERT_EQ(shader_writer.GetVSShaderName(), "VS_BlurRRect_SolidVertexColor");
+  ASSERT_EQ(shader_writer.GetFSShaderName(), "FS_SolidVertexColor_BlurRRect");
+
+  // the pipelines are created from the translated sources
+  std::string glsl[2];
+  for (int32_t i = 0; i < 2; i++) {
+    const std::string& source = i == 0 ? vs : fs;
+    const char* entry_point = i == 0 ? "vs_main" : "fs_main";
+
+    auto program = wgx::Program::Parse(source);
+    ASSERT_TRUE(program != nullptr);
+    ASSERT_FALSE(program->GetDiagnosis().has_value())
+        << program->GetDiagnosis()->message;
+
+    auto result = program->WriteToGlsl(entry_point, wgx::GlslOptions{});
+    ASSERT_TRUE(result.success) << entry_point;
+    glsl[i] = result.content;
+    EXPECT_TRUE(program->WriteToMsl(entry_point, wgx::MslOptions{}).success)
+        << entry_point;
+
+    // PrepareCMD uploads the CommonSlot of group 0 and nothing else
+    if (i == 0) {
+      auto bind_groups = program->GetWGSLBindGroups(entry_point);
+      ASSERT_EQ(bind_groups.size(), 1u);
+      EXPECT_EQ(bind_groups[0].group, 0u);
+      auto entry = bind_groups[0].GetEntry(0);
+      ASSERT_TRUE(entry != nullptr);
+      EXPECT_EQ(entry->name, "common_slot");
+    }
+  }
+
+  // the vertex inputs match the buffer layout of the pipeline
+  for (const auto& buffer : geometry.GetBufferLayout()) {
+    for (const auto& attribute : buffer.attributes) {
+      std::string type =
+          attribute.format == skity::GPUVertexFormat::kFloat32x4 ? "vec4"
+                                                                  : "vec2";
+      EXPECT_NE(glsl[0].find("layout(location =" +
+                             std::to_string(attribute.shader_location) +
+                             ") in " + type + " "),
+                std::string::npos)
+          << attribute.shader_location;
+    }
+  }
+
+  // only the functions reached from the entry point are translated, a helper
+  // of the coverage which is misspelled or never called goes missing
+  for (const char* function :
+       {"vec2 blur_erf(", "float blur_interval(", "float blur_gaussian(",
+        "float blur_rrect_coverage("}) {
+    EXPECT_NE(glsl[1].find(function), std::string::npos) << function;
+  }
+}
@@ -0,0 +1,127 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_analytic_clip.hpp"
+
+#include <gtest/gtest.h>
+
+#include <skity/skity.hpp>
+
+using namespace skity;
+
+namespace {
+
+HWAnalyticClip* MakeClip(ArenaAllocator* arena, const RRect& rrect,
+                         const Matrix& matrix = Matrix{},
+                         const HWAnalyticClip* parent = nullptr,
+                         Canvas::ClipOp op = Canvas::ClipOp::kIntersect) {
+  return HWAnalyticClip::Make(arena, parent, rrect, matrix, matrix, op);
+}
+
+}  // namespace
+
+TEST(HWAnalyticClip, RejectsUnsupportedShapes) {
+  ArenaAllocator arena;
+  auto rect = Rect::MakeLTRB(10, 10, 50, 30);
+
+  EXPECT_EQ(MakeClip(&arena, RRect::MakeRect(Rect::MakeEmpty())), nullptr);
+
+  // different radii at the corners
+  RRect complex;
+  Vec2 radii[4] = {{2, 2}, {4, 4}, {2, 2}, {4, 4}};
+  complex.SetRectRadii(rect, radii);
+  EXPECT_EQ(MakeClip(&arena, complex), nullptr);
+
+  Matrix perspective;
+  perspective.SetPersp0(0.01f);
+  EXPECT_EQ(MakeClip(&arena, RRect::MakeRect(rect), perspective), nullptr);
+
+  EXPECT_EQ(MakeClip(&arena, RRect::MakeRect(rect), Matrix::Scale(0.f, 1.f)),
+            nullptr);
+}
+
+TEST(HWAnalyticClip, RotatedRectCoverage) {
+  ArenaAllocator arena;
+  auto matrix = Matrix::RotateDeg(45.f, Vec2{30, 20});
+  auto clip =
+      MakeClip(&arena, RRect::MakeRect(Rect::MakeLTRB(10, 10, 50, 30)), matrix);
+  ASSERT_NE(clip, nullptr);
+  ASSERT_EQ(clip->GetShapeCount(), 1u);
+
+  // the center and points along the rotated axes
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{30, 20}), 1.f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{30 + 12, 20 + 12}), 1.f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{30 + 16, 20 + 16}), 0.f);
+  // the rect is 20 wide, its rotated edge passes 10 away from the center
+  float d = 10.f * 0.70710678f;
+  EXPECT_NEAR(clip->Coverage(Vec2{30 + d, 20 - d}), 0.5f, 1e-3f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{30 + 2 * d, 20 - 2 * d}), 0.f);
+}
+
+TEST(HWAnalyticClip, RRectAndOvalCoverage) {
+  ArenaAllocator arena;
+
+  auto rrect = RRect::MakeRectXY(Rect::MakeLTRB(0, 0, 40, 40), 10, 10);
+  auto clip = MakeClip(&arena, rrect);
+  ASSERT_NE(clip, nullptr);
+
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{20, 0.f}), 0.5f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{20, 2.f}), 1.f);
+  // the corner is cut along the circle of radius 10 around (10, 10)
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{1, 1}), 0.f);
+  float d = 10.f - 10.f * 0.70710678f;
+  EXPECT_NEAR(clip->Coverage(Vec2{d, d}), 0.5f, 1e-3f);
+
+  // an elliptic oval scales its local space to round the corners
+  auto oval = MakeClip(&arena, RRect::MakeOval(Rect::MakeLTRB(0, 0, 40, 20)));
+  ASSERT_NE(oval, nullptr);
+  EXPECT_FLOAT_EQ(oval->Coverage(Vec2{20, 10}), 1.f);
+  EXPECT_NEAR(oval->Coverage(Vec2{0, 10}), 0.5f, 1e-3f);
+  EXPECT_NEAR(oval->Coverage(Vec2{20, 0}), 0.5f, 1e-3f);
+  EXPECT_FLOAT_EQ(oval->Coverage(Vec2{3, 3}), 0.f);
+}
+
+TEST(HWAnalyticClip, DifferenceAndNestedClips) {
+  ArenaAllocator arena;
+
+  auto outer =
+      MakeClip(&arena, RRect::MakeRect(Rect::MakeLTRB(0, 0, 100, 100)));
+  auto inner =
+      MakeClip(&arena, RRect::MakeOval(Rect::MakeLTRB(40, 40, 60, 60)),
+               Matrix{}, outer, Canvas::ClipOp::kDifference);
+  ASSERT_NE(inner, nullptr);
+  ASSERT_EQ(inner->GetShapeCount(), 2u);
+
+  EXPECT_FLOAT_EQ(inner->Coverage(Vec2{20, 20}), 1.f);
+  EXPECT_FLOAT_EQ(inner->Coverage(Vec2{50, 50}), 0.f);
+  EXPECT_FLOAT_EQ(inner->Coverage(Vec2{120, 50}), 0.f);
+  EXPECT_NEAR(inner->Coverage(Vec2{60, 50}), 0.5f, 1e-3f);
+
+  // the shapes of the parent are kept untouched
+  EXPECT_FLOAT_EQ(outer->Coverage(Vec2{50, 50}), 1.f);
+
+  const HWAnalyticClip* clip = inner;
+  while (clip->GetShapeCount() < HWAnalyticClip::kMaxShapeCount) {
+    clip = MakeClip(&arena, RRect::MakeRect(Rect::MakeLTRB(0, 0, 100, 100)),
+                    Matrix{}, clip);
+    ASSERT_NE(clip, nullptr);
+  }
+  EXPECT_EQ(MakeClip(&arena, RRect::MakeRect(Rect::MakeLTRB(0, 0, 100, 100)),
+                     Matrix{}, clip),
+            nullptr);
+}
+
+TEST(HWAnalyticClip, CoverageScalesWithThePhysicalMatrix) {
+  ArenaAllocator arena;
+  auto rrect = RRect::MakeRect(Rect::MakeLTRB(0, 0, 40, 40));
+
+  // a quarter of a logical pixel is half a physical pixel
+  auto clip = HWAnalyticClip::Make(&arena, nullptr, rrect, Matrix{},
+                                   Matrix::Scale(2.f, 2.f),
+                                   Canvas::ClipOp::kIntersect);
+  ASSERT_NE(clip, nullptr);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{40.25f, 20}), 0.f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{39.75f, 20}), 1.f);
+  EXPECT_FLOAT_EQ(clip->Coverage(Vec2{40.f, 20}), 0.5f);
+}
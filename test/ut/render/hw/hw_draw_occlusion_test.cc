@@ -0,0 +1,134 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_draw_occlusion.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <skity/effect/shader.hpp>
+#include <skity/graphic/image.hpp>
+#include <skity/io/pixmap.hpp>
+#include <vector>
+
+using namespace skity;
+
+namespace {
+
+class FakeDraw : public HWDraw {
+ public:
+  FakeDraw(const Rect& bounds, const Rect& opaque_bounds,
+           HWDrawType type = HWDrawType::kUnknow)
+      : HWDraw(Matrix{}), type_(type) {
+    SetLayerSpaceBounds(bounds);
+    SetOpaqueBounds(opaque_bounds);
+    SetScissorBox(Rect::MakeWH(100, 100));
+  }
+
+  void Draw(GPURenderPass*) override {}
+
+  HWDrawType GetDrawType() const override { return type_; }
+
+ protected:
+  HWDrawState OnPrepare(HWDrawContext*) override {
+    return HWDrawState::kDrawStateNone;
+  }
+
+  void OnGenerateCommand(HWDrawContext*, HWDrawState) override {}
+
+ private:
+  HWDrawType type_;
+};
+
+Paint ImagePaint(TileMode tile_mode, const Matrix& local_matrix) {
+  auto pixmap = std::make_shared<Pixmap>(10, 10, AlphaType::kOpaque_AlphaType);
+  Paint paint;
+  paint.SetShader(Shader::MakeShader(Image::MakeImage(pixmap),
+                                     SamplingOptions{}, tile_mode, tile_mode,
+                                     local_matrix));
+  return paint;
+}
+
+}  // namespace
+
+TEST(HWDrawOcclusion, DropsDrawsHiddenByLaterOpaqueDraws) {
+  FakeDraw hidden(Rect::MakeLTRB(10, 10, 40, 40), Rect{});
+  FakeDraw partial(Rect::MakeLTRB(40, 40, 60, 60), Rect{});
+  FakeDraw background(Rect::MakeWH(50, 50), Rect::MakeWH(50, 50));
+  FakeDraw top(Rect::MakeLTRB(20, 20, 30, 30), Rect{});
+
+  std::vector<HWDraw*> draws = {&hidden, &partial, &background, &top};
+
+  EXPECT_EQ(CullOccludedDraws(&draws), 1u);
+  EXPECT_EQ(draws, (std::vector<HWDraw*>{&partial, &background, &top}));
+}
+
+TEST(HWDrawOcclusion, KeepsClipDraws) {
+  FakeDraw hidden(Rect::MakeLTRB(10, 10, 40, 40), Rect{});
+  FakeDraw clip(Rect::MakeLTRB(10, 10, 40, 40), Rect{}, HWDrawType::kClip);
+  FakeDraw background(Rect::MakeWH(100, 100), Rect::MakeWH(100, 100));
+
+  std::vector<HWDraw*> draws = {&hidden, &clip, &background};
+
+  EXPECT_EQ(CullOccludedDraws(&draws), 1u);
+  EXPECT_EQ(draws, (std::vector<HWDraw*>{&clip, &background}));
+}
+
+TEST(HWDrawOcclusion, UsesTheScissorBoxOfTheHiddenDraw) {
+  // the bounds of the draw are larger than the occluder, but it is only
+  // visible inside its scissor box
+  FakeDraw scissored(Rect::MakeWH(100, 100), Rect{});
+  scissored.SetScissorBox(Rect::MakeLTRB(10, 10, 20, 20));
+  FakeDraw visible(Rect::MakeWH(100, 100), Rect{});
+  FakeDraw occluder(Rect::MakeWH(50, 50), Rect::MakeWH(50, 50));
+
+  std::vector<HWDraw*> draws = {&scissored, &visible, &occluder};
+
+  EXPECT_EQ(CullOccludedDraws(&draws), 1u);
+  EXPECT_EQ(draws, (std::vector<HWDraw*>{&visible, &occluder}));
+}
+
+TEST(HWDrawOcclusion, TracksSeveralOccluders) {
+  FakeDraw left_hidden(Rect::MakeLTRB(5, 5, 15, 15), Rect{});
+  FakeDraw right_hidden(Rect::MakeLTRB(65, 5, 75, 15), Rect{});
+  FakeDraw across(Rect::MakeLTRB(5, 5, 75, 15), Rect{});
+  FakeDraw left(Rect::MakeWH(40, 40), Rect::MakeWH(40, 40));
+  FakeDraw right(Rect::MakeLTRB(60, 0, 100, 40),
+                 Rect::MakeLTRB(60, 0, 100, 40));
+
+  std::vector<HWDraw*> draws = {&left_hidden, &right_hidden, &across, &left,
+                                &right};
+
+  EXPECT_EQ(CullOccludedDraws(&draws), 2u);
+  EXPECT_EQ(draws, (std::vector<HWDraw*>{&across, &left, &right}));
+}
+
+TEST(HWDrawOcclusion, OpaqueImageFillsDependOnTheTileMode) {
+  Rect rect = Rect::MakeWH(50, 50);
+
+  // the image covers 20 x 20 of the rect
+  Matrix local_matrix = Matrix::Scale(2.f, 2.f);
+  EXPECT_FALSE(IsOpaqueFill(ImagePaint(TileMode::kDecal, local_matrix), rect));
+  EXPECT_TRUE(IsOpaqueFill(ImagePaint(TileMode::kClamp, local_matrix), rect));
+  EXPECT_TRUE(IsOpaqueFill(ImagePaint(TileMode::kRepeat, local_matrix), rect));
+
+  // the image stretched over the rect, like DrawImageRect does
+  EXPECT_TRUE(IsOpaqueFill(
+      ImagePaint(TileMode::kDecal, Matrix::Scale(5.f, 5.f)), rect));
+}
+
+TEST(HWDrawOcclusion, KeepsDrawsAroundADecalImage) {
+  Rect rect = Rect::MakeWH(50, 50);
+  Paint paint = ImagePaint(TileMode::kDecal, Matrix::Scale(2.f, 2.f));
+
+  // the draw is only hidden where the image is, the rest of the rect is
+  // transparent
+  FakeDraw below(Rect::MakeLTRB(30, 30, 40, 40), Rect{});
+  FakeDraw image(rect, IsOpaqueFill(paint, rect) ? rect : Rect{});
+
+  std::vector<HWDraw*> draws = {&below, &image};
+
+  EXPECT_EQ(CullOccludedDraws(&draws), 0u);
+  EXPECT_EQ(draws, (std::vector<HWDraw*>{&below, &image}));
+}
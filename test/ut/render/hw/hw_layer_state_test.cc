@@ -0,0 +1,97 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_layer_state.hpp"
+
+#include <gtest/gtest.h>
+
+#include <skity/skity.hpp>
+#include <vector>
+
+#include "src/utils/arena_allocator.hpp"
+
+using namespace skity;
+
+namespace {
+
+class FakeDraw : public HWDraw {
+ public:
+  FakeDraw() : HWDraw(Matrix{}) { SetClipDepth(0); }
+
+  void Draw(GPURenderPass*) override {}
+
+ protected:
+  HWDrawState OnPrepare(HWDrawContext*) override {
+    return HWDrawState::kDrawStateNone;
+  }
+
+  void OnGenerateCommand(HWDrawContext*, HWDrawState) override {}
+};
+
+HWAnalyticClip* MakeClip(ArenaAllocator* arena, const HWAnalyticClip* parent,
+                         const Rect& rect) {
+  return HWAnalyticClip::Make(arena, parent, RRect::MakeRect(rect), Matrix{},
+                              Matrix{}, Canvas::ClipOp::kIntersect);
+}
+
+}  // namespace
+
+TEST(HWLayerState, FallbackClipsStayPending) {
+  ArenaAllocator arena;
+  HWLayerState state{1};
+
+  FakeDraw outer;
+  auto outer_clip = MakeClip(&arena, nullptr, Rect::MakeWH(80, 80));
+  state.SaveAnalyticClip(outer_clip, &outer);
+
+  state.Save();
+  FakeDraw inner;
+  state.SaveAnalyticClip(
+      MakeClip(&arena, outer_clip, Rect::MakeLTRB(10, 10, 50, 50)), &inner);
+
+  std::vector<HWDraw*> clips;
+  state.GetFallbackClips(&clips);
+  EXPECT_EQ(clips, (std::vector<HWDraw*>{&outer, &inner}));
+
+  // only taking them moves them into the clip draws
+  EXPECT_EQ(state.LastClipDraw(), nullptr);
+
+  clips.clear();
+  state.TakeFallbackClips(&clips);
+  EXPECT_EQ(clips, (std::vector<HWDraw*>{&outer, &inner}));
+  EXPECT_EQ(state.LastClipDraw(), &inner);
+
+  clips.clear();
+  state.GetFallbackClips(&clips);
+  EXPECT_TRUE(clips.empty());
+}
+
+TEST(HWLayerState, PendingFallbackClipsGetClipDepth) {
+  ArenaAllocator arena;
+  HWLayerState state{1};
+
+  FakeDraw outer;
+  auto outer_clip = MakeClip(&arena, nullptr, Rect::MakeWH(80, 80));
+  state.SaveAnalyticClip(outer_clip, &outer);
+  uint32_t outer_draw = state.GetNextDrawDepth();
+
+  state.Save();
+  FakeDraw inner;
+  state.SaveAnalyticClip(
+      MakeClip(&arena, outer_clip, Rect::MakeLTRB(10, 10, 50, 50)), &inner);
+  uint32_t inner_draw = state.GetNextDrawDepth();
+  state.Restore();
+
+  // a draw may still fall back to the clips once the layer is prepared, they
+  // have to clip every draw of their save level
+  EXPECT_GT(inner.GetClipDepth(), inner_draw);
+  EXPECT_EQ(outer.GetClipDepth(), 0u);
+
+  uint32_t after_restore = state.GetNextDrawDepth();
+  EXPECT_GT(after_restore, inner.GetClipDepth());
+
+  state.FlushClipDepth();
+  EXPECT_GT(outer.GetClipDepth(), after_restore);
+  EXPECT_GT(outer.GetClipDepth(), outer_draw);
+}
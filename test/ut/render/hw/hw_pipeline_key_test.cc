@@ -0,0 +1,102 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "src/render/hw/hw_pipeline_key.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace skity;
+
+TEST(HWPipelineKeyTest, PackShaderKeys) {
+  uint32_t geometry = MakeHWShaderKey(HWGeometryVariant::kRRect, 3);
+  uint32_t fragment = MakeHWShaderKey(HWFragmentVariant::kGradient, 0x123);
+  uint32_t filter = MakeHWShaderKey(HWColorFilterVariant::kBlend, 5);
+
+  uint64_t key = MakeHWPipelineKey(geometry, fragment, filter);
+
+  EXPECT_NE(key, kHWPipelineKeyInvalid);
+  EXPECT_EQ(key >> 48, geometry);
+  EXPECT_EQ((key >> 24) & 0xFFFFFF, fragment);
+  EXPECT_EQ(key & 0xFFFFFF, filter);
+
+  // different options must produce different keys
+  EXPECT_NE(key, MakeHWPipelineKey(
+                     geometry, fragment,
+                     MakeHWShaderKey(HWColorFilterVariant::kBlend, 6)));
+  EXPECT_NE(key, MakeHWPipelineKey(
+                     MakeHWShaderKey(HWGeometryVariant::kRRect, 0), fragment,
+                     filter));
+}
+
+TEST(HWPipelineKeyTest, AnalyticClipCount) {
+  uint32_t geometry = MakeHWShaderKey(HWGeometryVariant::kPath);
+  uint32_t fragment = MakeHWShaderKey(HWFragmentVariant::kSolidColor);
+  uint32_t filter = MakeHWShaderKey(HWColorFilterVariant::kBlend, 5);
+
+  uint64_t key = MakeHWPipelineKey(geometry, fragment, filter);
+  uint64_t clipped = MakeHWPipelineKey(geometry, fragment, filter, 2);
+
+  EXPECT_NE(key, clipped);
+  EXPECT_EQ((key >> 20) & 0xF, 0u);
+  EXPECT_EQ((clipped >> 20) & 0xF, 2u);
+  EXPECT_EQ(clipped & 0xFFFFF, filter);
+  EXPECT_EQ((clipped >> 24) & 0xFFFFFF, fragment);
+  EXPECT_NE(clipped, MakeHWPipelineKey(geometry, fragment, filter, 3));
+}
+
+TEST(HWPipelineKeyTest, UnknownShaderKey) {
+  uint32_t geometry = MakeHWShaderKey(HWGeometryVariant::kPath);
+  uint32_t fragment = MakeHWShaderKey(HWFragmentVariant::kSolidColor);
+  uint32_t filter = MakeHWShaderKey(HWColorFilterVariant::kNone);
+
+  EXPECT_EQ(MakeHWPipelineKey(kHWShaderKeyUnknown, fragment, filter),
+            kHWPipelineKeyInvalid);
+  EXPECT_EQ(MakeHWPipelineKey(geometry, kHWShaderKeyUnknown, filter),
+            kHWPipelineKeyInvalid);
+  EXPECT_EQ(MakeHWPipelineKey(geometry, fragment, kHWShaderKeyUnknown),
+            kHWPipelineKeyInvalid);
+}
+
+TEST(HWPipelineKeyTest, KeyMapInsertAndFind) {
+  HWPipelineKeyMap<int> map;
+  int a = 1;
+  int b = 2;
+
+  EXPECT_EQ(map.Find(1), nullptr);
+
+  map.Insert(1, &a);
+  map.Insert(2, &b);
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.Find(1), &a);
+  EXPECT_EQ(map.Find(2), &b);
+  EXPECT_EQ(map.Find(3), nullptr);
+
+  // replace the value of an existing key
+  map.Insert(1, &b);
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.Find(1), &b);
+
+  // the invalid key is never stored
+  map.Insert(kHWPipelineKeyInvalid, &a);
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.Find(kHWPipelineKeyInvalid), nullptr);
+}
+
+TEST(HWPipelineKeyTest, KeyMapGrow) {
+  HWPipelineKeyMap<int> map;
+  std::vector<int> values(1000);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int>(i);
+    map.Insert(static_cast<uint64_t>(i + 1) << 24, &values[i]);
+  }
+
+  EXPECT_EQ(map.Size(), values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(map.Find(static_cast<uint64_t>(i + 1) << 24), &values[i]);
+  }
+  EXPECT_EQ(map.Find(static_cast<uint64_t>(values.size() + 1) << 24), nullptr);
+}
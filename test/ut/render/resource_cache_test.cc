@@ -237,3 +237,35 @@ TEST(ResourceCache, PurgeResourcesByOrder) {
   EXPECT_EQ(cache.GetTotalResourceBytes(), static_cast<size_t>(0));
   EXPECT_EQ(cache.GetPurgableBytes(), static_cast<size_t>(0));
 }
+
+TEST(ResourceCache, ObtainApprox) {
+  skity::testing::TestResourceCache cache(
+      std::make_unique<skity::testing::TestResourceAllocator>(), 4000);
+
+  auto fits = [](const skity::testing::TestResourceKey& key) {
+    return key.hint_value >= 150;
+  };
+
+  auto resource1 = cache.ObtainResource({100});
+  auto resource2 = cache.ObtainResource({300});
+  auto resource3 = cache.ObtainResource({200});
+  cache.StoreResource(resource1);
+  cache.StoreResource(resource2);
+  cache.StoreResource(resource3);
+  EXPECT_EQ(cache.GetTotalResourceBytes(), static_cast<size_t>(2400));
+
+  // the smallest resource large enough is reused
+  auto resource = cache.ObtainApproxResource({160}, fits);
+  EXPECT_EQ(resource->GetValue(), 200);
+  EXPECT_EQ(cache.GetPurgableBytes(), static_cast<size_t>(1600));
+
+  resource = cache.ObtainApproxResource({160}, fits);
+  EXPECT_EQ(resource->GetValue(), 300);
+  EXPECT_EQ(cache.GetPurgableBytes(), static_cast<size_t>(400));
+
+  // nothing fits anymore, a resource is allocated for the given key
+  resource = cache.ObtainApproxResource({160}, fits);
+  EXPECT_EQ(resource->GetValue(), 160);
+  EXPECT_EQ(cache.GetTotalResourceBytes(), static_cast<size_t>(3040));
+  EXPECT_EQ(cache.GetPurgableBytes(), static_cast<size_t>(400));
+}
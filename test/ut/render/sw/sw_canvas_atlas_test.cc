@@ -0,0 +1,159 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <skity/skity.hpp>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSize = 64;
+
+// 4 x 4 cells of 8 x 8 pixels, each one with its own color
+std::shared_ptr<skity::Image> MakeAtlasImage() {
+  auto pixmap = std::make_shared<skity::Pixmap>(
+      32, 32, skity::AlphaType::kPremul_AlphaType, skity::ColorType::kRGBA);
+  skity::Bitmap bitmap(pixmap, false);
+  for (uint32_t y = 0; y < 32; y++) {
+    for (uint32_t x = 0; x < 32; x++) {
+      uint32_t cell = (y / 8) * 4 + x / 8;
+      bitmap.SetPixel(x, y,
+                      skity::ColorSetARGB(0xFF, cell * 16, 255 - cell * 16,
+                                          (x % 8) * 32));
+    }
+  }
+  return skity::Image::MakeImage(pixmap);
+}
+
+struct Sprites {
+  std::vector<skity::RSXform> xform;
+  std::vector<skity::Rect> tex;
+  std::vector<skity::Color> colors;
+};
+
+Sprites MakeSprites() {
+  Sprites sprites;
+  for (int32_t i = 0; i < 8; i++) {
+    float x = static_cast<float>(i % 4) * 8.f;
+    float y = static_cast<float>(i / 4) * 8.f;
+    sprites.tex.push_back(skity::Rect::MakeXYWH(x, y, 8.f, 8.f));
+    sprites.colors.push_back(
+        skity::ColorSetARGB(0x80 + i * 16, 0xFF, i * 32, 0x40));
+  }
+
+  // translations, an integer scale and quarter turns keep every pixel center
+  // on a texel center, so the fast path has no reason to differ
+  sprites.xform.push_back(skity::RSXform::Make(1.f, 0.f, 2.f, 3.f));
+  sprites.xform.push_back(skity::RSXform::Make(1.f, 0.f, 20.f, 3.f));
+  sprites.xform.push_back(skity::RSXform::Make(2.f, 0.f, 30.f, 0.f));
+  sprites.xform.push_back(skity::RSXform::Make(0.f, 1.f, 60.f, 20.f));
+  sprites.xform.push_back(skity::RSXform::Make(-1.f, 0.f, 16.f, 40.f));
+  sprites.xform.push_back(skity::RSXform::Make(0.f, -2.f, 20.f, 60.f));
+  sprites.xform.push_back(skity::RSXform::Make(1.f, 0.f, 40.f, 40.f));
+  sprites.xform.push_back(skity::RSXform::Make(1.f, 0.f, 44.f, 44.f));
+  return sprites;
+}
+
+// What DrawAtlas is defined as, one image rect per sprite.
+void DrawReference(skity::Canvas* canvas,
+                   const std::shared_ptr<skity::Image>& image,
+                   const Sprites& sprites, bool use_colors,
+                   skity::BlendMode mode, const skity::Paint& paint) {
+  for (size_t i = 0; i < sprites.xform.size(); i++) {
+    skity::Paint work_paint = paint;
+    if (use_colors) {
+      work_paint.SetColorFilter(
+          skity::ColorFilters::Blend(sprites.colors[i], mode));
+    }
+
+    const skity::Rect& tex = sprites.tex[i];
+    canvas->Save();
+    canvas->Concat(sprites.xform[i].ToMatrix());
+    canvas->DrawImageRect(image, tex,
+                          skity::Rect::MakeWH(tex.Width(), tex.Height()),
+                          skity::SamplingOptions{}, &work_paint);
+    canvas->Restore();
+  }
+}
+
+void ExpectSamePixels(skity::Bitmap* a, skity::Bitmap* b, int32_t tolerance) {
+  for (uint32_t y = 0; y < kSize; y++) {
+    for (uint32_t x = 0; x < kSize; x++) {
+      skity::Color ca = a->GetPixel(x, y);
+      skity::Color cb = b->GetPixel(x, y);
+      for (int32_t shift = 0; shift < 32; shift += 8) {
+        int32_t da = static_cast<int32_t>((ca >> shift) & 0xFF);
+        int32_t db = static_cast<int32_t>((cb >> shift) & 0xFF);
+        ASSERT_LE(std::abs(da - db), tolerance) << "at " << x << ", " << y;
+      }
+    }
+  }
+}
+
+void CompareWithReference(bool use_colors, skity::BlendMode mode,
+                          const skity::Paint& paint) {
+  auto image = MakeAtlasImage();
+  auto sprites = MakeSprites();
+
+  skity::Bitmap atlas_bitmap(kSize, kSize);
+  auto atlas_canvas = skity::Canvas::MakeSoftwareCanvas(&atlas_bitmap);
+  atlas_canvas->Clear(skity::Color_WHITE);
+  atlas_canvas->DrawAtlas(image, sprites.xform.data(), sprites.tex.data(),
+                          use_colors ? sprites.colors.data() : nullptr,
+                          static_cast<int>(sprites.xform.size()), mode,
+                          skity::SamplingOptions{}, nullptr, &paint);
+
+  skity::Bitmap reference_bitmap(kSize, kSize);
+  auto reference_canvas = skity::Canvas::MakeSoftwareCanvas(&reference_bitmap);
+  reference_canvas->Clear(skity::Color_WHITE);
+  DrawReference(reference_canvas.get(), image, sprites, use_colors, mode,
+                paint);
+
+  ExpectSamePixels(&atlas_bitmap, &reference_bitmap, 1);
+}
+
+}  // namespace
+
+TEST(SWCanvasAtlas, MatchesImageRectWithoutColors) {
+  CompareWithReference(false, skity::BlendMode::kModulate, skity::Paint{});
+}
+
+TEST(SWCanvasAtlas, MatchesImageRectWithColors) {
+  for (auto mode : {skity::BlendMode::kModulate, skity::BlendMode::kSrcOver,
+                    skity::BlendMode::kDstIn, skity::BlendMode::kScreen}) {
+    CompareWithReference(true, mode, skity::Paint{});
+  }
+}
+
+TEST(SWCanvasAtlas, AppliesPaintAlphaAndBlendMode) {
+  skity::Paint paint;
+  paint.SetAlphaF(0.5f);
+  paint.SetBlendMode(skity::BlendMode::kPlus);
+  CompareWithReference(true, skity::BlendMode::kModulate, paint);
+}
+
+TEST(SWCanvasAtlas, CullRectRejectsWholeCall) {
+  auto image = MakeAtlasImage();
+  auto sprites = MakeSprites();
+
+  skity::Bitmap bitmap(kSize, kSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_WHITE);
+  canvas->ClipRect(skity::Rect::MakeWH(kSize, kSize));
+
+  skity::Rect cull = skity::Rect::MakeXYWH(1000.f, 1000.f, 10.f, 10.f);
+  canvas->DrawAtlas(image, sprites.xform.data(), sprites.tex.data(), nullptr,
+                    static_cast<int>(sprites.xform.size()),
+                    skity::BlendMode::kModulate, skity::SamplingOptions{},
+                    &cull);
+
+  for (uint32_t y = 0; y < kSize; y++) {
+    for (uint32_t x = 0; x < kSize; x++) {
+      ASSERT_EQ(bitmap.GetPixel(x, y), skity::Color_WHITE);
+    }
+  }
+}
@@ -0,0 +1,143 @@
+// Copyright 2021 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <skity/skity.hpp>
+
+namespace {
+
+constexpr uint32_t kSize = 32;
+
+// a quad made of two triangles sharing its diagonal
+std::shared_ptr<skity::Vertices> MakeQuad(const skity::Rect& rect,
+                                          const skity::Vec2* texs,
+                                          const skity::Color* colors) {
+  skity::Vec2 positions[] = {
+      {rect.Left(), rect.Top()},
+      {rect.Right(), rect.Top()},
+      {rect.Left(), rect.Bottom()},
+      {rect.Right(), rect.Bottom()},
+  };
+  return skity::Vertices::MakeCopy(skity::Vertices::VertexMode::kTriangleStrip,
+                                   4, positions, texs, colors);
+}
+
+// 16 x 16 pixels, every one with its own color
+std::shared_ptr<skity::Image> MakeImage() {
+  auto pixmap = std::make_shared<skity::Pixmap>(
+      16, 16, skity::AlphaType::kPremul_AlphaType, skity::ColorType::kRGBA);
+  skity::Bitmap bitmap(pixmap, false);
+  for (uint32_t y = 0; y < 16; y++) {
+    for (uint32_t x = 0; x < 16; x++) {
+      bitmap.SetPixel(x, y, skity::ColorSetARGB(0xFF, x * 16, y * 16, 0x80));
+    }
+  }
+  return skity::Image::MakeImage(pixmap);
+}
+
+void ExpectNear(skity::Color a, skity::Color b, int32_t tolerance) {
+  for (int32_t shift = 0; shift < 32; shift += 8) {
+    int32_t da = static_cast<int32_t>((a >> shift) & 0xFF);
+    int32_t db = static_cast<int32_t>((b >> shift) & 0xFF);
+    EXPECT_LE(std::abs(da - db), tolerance) << std::hex << a << " " << b;
+  }
+}
+
+}  // namespace
+
+TEST(SWCanvasVertices, SharedEdgeDrawnOnce) {
+  skity::Bitmap bitmap(kSize, kSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_TRANSPARENT);
+
+  skity::Paint paint;
+  paint.SetColor(skity::ColorSetARGB(0x80, 0xFF, 0, 0));
+  canvas->DrawVertices(
+      MakeQuad(skity::Rect::MakeLTRB(4.f, 4.f, 20.f, 20.f), nullptr, nullptr),
+      skity::BlendMode::kModulate, paint);
+
+  skity::Color inside = bitmap.GetPixel(10, 10);
+  EXPECT_GT(ColorGetA(inside), 0u);
+
+  for (uint32_t y = 0; y < kSize; y++) {
+    for (uint32_t x = 0; x < kSize; x++) {
+      bool covered = x >= 4 && x < 20 && y >= 4 && y < 20;
+      ASSERT_EQ(bitmap.GetPixel(x, y),
+                covered ? inside : skity::Color_TRANSPARENT)
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(SWCanvasVertices, InterpolatesColors) {
+  skity::Bitmap bitmap(kSize, kSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_WHITE);
+
+  skity::Color colors[] = {skity::Color_RED, skity::Color_BLUE,
+                           skity::Color_RED, skity::Color_BLUE};
+  canvas->DrawVertices(
+      MakeQuad(skity::Rect::MakeWH(kSize, kSize), nullptr, colors),
+      skity::BlendMode::kModulate, skity::Paint{});
+
+  // the color only depends on x, the pixel centers are at x + 0.5
+  for (uint32_t y = 0; y < kSize; y += 7) {
+    for (uint32_t x = 0; x < kSize; x++) {
+      float t = (x + 0.5f) / kSize;
+      auto blue = static_cast<uint8_t>(t * 255.f + 0.5f);
+      ExpectNear(bitmap.GetPixel(x, y),
+                 skity::ColorSetARGB(0xFF, 0xFF - blue, 0, blue), 2);
+    }
+  }
+}
+
+TEST(SWCanvasVertices, SamplesShaderAtTexs) {
+  skity::Bitmap bitmap(kSize, kSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_WHITE);
+
+  skity::Paint paint;
+  paint.SetShader(skity::Shader::MakeShader(MakeImage()));
+
+  skity::Vec2 texs[] = {{0.f, 0.f}, {16.f, 0.f}, {0.f, 16.f}, {16.f, 16.f}};
+  canvas->DrawVertices(
+      MakeQuad(skity::Rect::MakeWH(kSize, kSize), texs, nullptr),
+      skity::BlendMode::kModulate, paint);
+
+  for (uint32_t y = 0; y < kSize; y++) {
+    for (uint32_t x = 0; x < kSize; x++) {
+      ASSERT_EQ(bitmap.GetPixel(x, y),
+                skity::ColorSetARGB(0xFF, (x / 2) * 16, (y / 2) * 16, 0x80))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(SWCanvasVertices, BlendsShaderWithColors) {
+  skity::Bitmap bitmap(kSize, kSize);
+  auto canvas = skity::Canvas::MakeSoftwareCanvas(&bitmap);
+  canvas->Clear(skity::Color_WHITE);
+
+  skity::Paint paint;
+  paint.SetShader(skity::Shader::MakeShader(MakeImage()));
+
+  skity::Color gray = skity::ColorSetARGB(0xFF, 0x80, 0x80, 0x80);
+  skity::Color colors[] = {gray, gray, gray, gray};
+  skity::Vec2 texs[] = {{0.f, 0.f}, {16.f, 0.f}, {0.f, 16.f}, {16.f, 16.f}};
+  canvas->DrawVertices(
+      MakeQuad(skity::Rect::MakeWH(kSize, kSize), texs, colors),
+      skity::BlendMode::kModulate, paint);
+
+  for (uint32_t y = 0; y < kSize; y += 5) {
+    for (uint32_t x = 0; x < kSize; x += 3) {
+      uint32_t r = (x / 2) * 16 * 0x80 / 255;
+      uint32_t g = (y / 2) * 16 * 0x80 / 255;
+      ExpectNear(bitmap.GetPixel(x, y),
+                 skity::ColorSetARGB(0xFF, r, g, 0x80 * 0x80 / 255), 1);
+    }
+  }
+}